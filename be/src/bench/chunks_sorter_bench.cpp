@@ -159,6 +159,7 @@ struct SortParameters {
     bool low_card = false;
     bool nullable = false;
     int max_buffered_chunks = ChunksSorterTopn::kDefaultBufferedChunks;
+    bool normalized_key = false;
 
     SortParameters() = default;
 
@@ -192,6 +193,7 @@ static void do_bench(benchmark::State& state, SortAlgorithm sorter_algo, Logical
     // state.PauseTiming();
     ChunkSorterBase suite;
     suite.SetUp();
+    config::enable_sort_normalized_key = params.normalized_key;
 
     TypeDescriptor type_desc;
     if (data_type == TYPE_INT) {
@@ -445,6 +447,7 @@ static void do_merge_columnwise(benchmark::State& state, int num_runs, bool null
     }
 
     state.SetItemsProcessed(num_rows);
+    config::enable_sort_normalized_key = false;
     suite.TearDown();
 }
 
@@ -472,6 +475,29 @@ static void BM_fullsort_low_card_nullable(benchmark::State& state) {
     do_bench(state, FullSort, TYPE_INT, state.range(0), state.range(1), params);
 }
 
+// Normalized key, compared with the column-wise sort of the same data above
+static void BM_fullsort_notnull_normalized_key(benchmark::State& state) {
+    SortParameters params;
+    params.normalized_key = true;
+    do_bench(state, FullSort, TYPE_INT, state.range(0), state.range(1), params);
+}
+static void BM_fullsort_nullable_normalized_key(benchmark::State& state) {
+    SortParameters params = SortParameters::with_nullable(true);
+    params.normalized_key = true;
+    do_bench(state, FullSort, TYPE_INT, state.range(0), state.range(1), params);
+}
+static void BM_fullsort_low_card_normalized_key(benchmark::State& state) {
+    SortParameters params = SortParameters::with_low_card(true);
+    params.normalized_key = true;
+    do_bench(state, FullSort, TYPE_INT, state.range(0), state.range(1), params);
+}
+static void BM_fullsort_low_card_nullable_normalized_key(benchmark::State& state) {
+    SortParameters params = SortParameters::with_low_card(true);
+    params.nullable = true;
+    params.normalized_key = true;
+    do_bench(state, FullSort, TYPE_INT, state.range(0), state.range(1), params);
+}
+
 // Sort partial data: ORDER BY xxx LIMIT
 static void BM_topn_limit_heapsort(benchmark::State& state) {
     do_bench(state, HeapSort, TYPE_INT, state.range(0), state.range(1), SortParameters::with_limit(state.range(2)));
@@ -540,6 +566,12 @@ BENCHMARK(BM_fullsort_varchar_column_incr)->Apply(CustomArgsFull);
 BENCHMARK(BM_fullsort_low_card_colinc)->Apply(CustomArgsFull);
 BENCHMARK(BM_fullsort_low_card_nullable)->Apply(CustomArgsFull);
 
+// Normalized-key Sort
+BENCHMARK(BM_fullsort_notnull_normalized_key)->Apply(CustomArgsFull);
+BENCHMARK(BM_fullsort_nullable_normalized_key)->Apply(CustomArgsFull);
+BENCHMARK(BM_fullsort_low_card_normalized_key)->Apply(CustomArgsFull);
+BENCHMARK(BM_fullsort_low_card_nullable_normalized_key)->Apply(CustomArgsFull);
+
 // TopN sort
 BENCHMARK(BM_topn_limit_heapsort)->Apply(CustomArgsLimit);
 BENCHMARK(BM_topn_limit_mergesort_notnull)->Apply(CustomArgsLimit);
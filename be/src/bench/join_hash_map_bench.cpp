@@ -0,0 +1,144 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "common/config.h"
+#include "exec/join_hash_map.h"
+#include "runtime/runtime_state.h"
+#include "runtime/types.h"
+
+namespace starrocks {
+
+// Measure the probe throughput of an inner join on a BIGINT key, by the number of build rows.
+class JoinHashMapProbePerf {
+public:
+    JoinHashMapProbePerf(size_t build_rows, size_t probe_rows) : _build_rows(build_rows), _probe_rows(probe_rows) {}
+
+    void SetUp();
+    void do_probe(benchmark::State& state);
+
+private:
+    std::shared_ptr<RuntimeState> _create_runtime_state() {
+        TUniqueId fragment_id;
+        TQueryOptions query_options;
+        query_options.batch_size = config::vector_chunk_size;
+        TQueryGlobals query_globals;
+        auto runtime_state = std::make_shared<RuntimeState>(fragment_id, query_options, query_globals, nullptr);
+        runtime_state->init_instance_mem_tracker();
+        return runtime_state;
+    }
+
+    size_t _build_rows;
+    size_t _probe_rows;
+    TypeDescriptor _type = TypeDescriptor(TYPE_BIGINT);
+    std::shared_ptr<RuntimeState> _runtime_state;
+    JoinHashTableItems _table_items;
+    HashTableProbeState _probe_state;
+    std::unique_ptr<JoinHashMapForOneKey(TYPE_BIGINT)> _hash_map;
+    std::vector<Columns> _probe_key_columns;
+};
+
+void JoinHashMapProbePerf::SetUp() {
+    _runtime_state = _create_runtime_state();
+    std::mt19937_64 rng(0);
+
+    // build keys are a permutation of [0, build_rows), the dummy row 0 is appended first.
+    std::vector<int64_t> keys(_build_rows);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    auto build_key_column = Int64Column::create();
+    build_key_column->append_default();
+    build_key_column->append_numbers(keys.data(), keys.size() * sizeof(int64_t));
+
+    _table_items.join_type = TJoinOp::INNER_JOIN;
+    _table_items.need_create_tuple_columns = false;
+    _table_items.row_count = _build_rows;
+    _table_items.build_chunk = std::make_shared<Chunk>();
+    _table_items.key_columns.emplace_back(build_key_column);
+    _table_items.join_keys.emplace_back(JoinKeyDesc{&_type, false, nullptr});
+
+    _hash_map = std::make_unique<JoinHashMapForOneKey(TYPE_BIGINT)>(&_table_items, &_probe_state);
+    _hash_map->build_prepare(_runtime_state.get());
+    _hash_map->probe_prepare(_runtime_state.get());
+    CHECK(_hash_map->build(_runtime_state.get()).ok());
+
+    // every probe key matches one build row.
+    std::uniform_int_distribution<int64_t> dist(0, _build_rows - 1);
+    const size_t chunk_size = _runtime_state->chunk_size();
+    for (size_t offset = 0; offset < _probe_rows; offset += chunk_size) {
+        auto probe_key_column = Int64Column::create();
+        for (size_t i = 0; i < std::min(chunk_size, _probe_rows - offset); i++) {
+            probe_key_column->append(dist(rng));
+        }
+        _probe_key_columns.emplace_back(Columns{probe_key_column});
+    }
+}
+
+void JoinHashMapProbePerf::do_probe(benchmark::State& state) {
+    size_t num_matched = 0;
+    for (const auto& key_columns : _probe_key_columns) {
+        auto probe_chunk = std::make_shared<Chunk>();
+        probe_chunk->append_column(key_columns[0], 0);
+        bool has_remain = true;
+        while (has_remain) {
+            auto result_chunk = std::make_shared<Chunk>();
+            _hash_map->probe(_runtime_state.get(), key_columns, &probe_chunk, &result_chunk, &has_remain);
+            num_matched += _probe_state.count;
+        }
+    }
+    benchmark::DoNotOptimize(num_matched);
+}
+
+static void bench_join_probe(benchmark::State& state) {
+    size_t build_rows = state.range(0);
+    int32_t prefetch_distance = state.range(1);
+    size_t probe_rows = 1 << 22;
+
+    auto old_prefetch_distance = config::join_probe_prefetch_distance;
+    config::join_probe_prefetch_distance = prefetch_distance;
+
+    JoinHashMapProbePerf perf(build_rows, probe_rows);
+    perf.SetUp();
+    for (auto _ : state) {
+        perf.do_probe(state);
+    }
+    state.SetItemsProcessed(state.iterations() * probe_rows);
+
+    config::join_probe_prefetch_distance = old_prefetch_distance;
+}
+
+static void process_args(benchmark::internal::Benchmark* b) {
+    // build rows from L2 resident to far larger than LLC, with and without prefetch.
+    for (int64_t build_rows : {1 << 14, 1 << 18, 1 << 22, 1 << 25}) {
+        for (int64_t prefetch_distance : {0, 8, 16, 32}) {
+            b->Args({build_rows, prefetch_distance});
+        }
+    }
+    b->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(bench_join_probe)->Apply(process_args);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
@@ -621,6 +621,13 @@ CONF_Int32(metric_late_materialization_ratio, "1000");
 
 // Max batched bytes for each transmit request. (256KB)
 CONF_Int64(max_transmit_batched_bytes, "262144");
+// A transmit request that exceeds max_transmit_batched_bytes keeps batching until it holds this many rows, so that
+// fewer and larger requests are sent. It is still sent at 4x max_transmit_batched_bytes. 0 means the request is
+// only bounded by bytes.
+CONF_mInt64(max_transmit_batched_rows, "0");
+// Max time in milliseconds that rows are batched in a channel before they are sent, so that a destination
+// receiving few rows of a wide shuffle is not delayed to eos. 0 means unlimited.
+CONF_mInt64(max_transmit_batched_delay_ms, "0");
 
 CONF_Int16(bitmap_max_filter_items, "30");
 
@@ -935,6 +942,10 @@ CONF_Int64(spill_max_log_block_container_bytes, "10737418240"); // 10GB
 // be the same with storage path. Spill will return with error when used size has exceeded
 // the limit.
 CONF_mDouble(spill_max_dir_bytes_ratio, "0.8"); // 80%
+// The max number of chunks read ahead by restore tasks for each spilled input stream. The read-ahead
+// chunks of all the streams of a spiller are also limited by the available memory of the operator,
+// which is divided evenly among the streams being read.
+CONF_mInt32(spill_read_ahead_chunks, "2");
 
 CONF_Int32(internal_service_query_rpc_thread_num, "-1");
 
@@ -1098,4 +1109,83 @@ CONF_Int32(lake_service_max_concurrency, "0");
 
 CONF_mInt64(lake_vacuum_min_batch_delete_size, "1000");
 
+// When the build side of hash join has at least this number of rows, build rows are radix partitioned and
+// reordered by bucket, so that the hash table is built partition by partition in cache and the rows of one
+// bucket are contiguous when probing. 0 means disabled.
+// Disabled by default, since the build rows are reordered by copying, which needs twice the memory of the build side
+// for a moment.
+CONF_mInt64(hash_join_partitioned_build_min_rows, "0");
+// The number of buckets covered by one partition of the partitioned build, its first-array(4 bytes per bucket)
+// should be resident in L2 cache.
+CONF_mInt64(hash_join_partitioned_build_buckets_per_partition, "65536");
+// The max number of threads building the partitioned hash table of broadcast join, the build driver is helped by
+// tasks in the scan executor, which take the slots of the scans of the workgroup. 1 means the hash table is built
+// only by the build driver, which is the default.
+CONF_mInt32(hash_join_parallel_build_dop, "1");
+// When the hash table of hash join doesn't fit in cache, the probe prefetches the bucket and the build row of the
+// probe row this number of rows ahead. 0 means disabled.
+CONF_mInt32(join_probe_prefetch_distance, "16");
+// Size the runtime bloom filter of hash join by the estimated number of distinct build keys rather than the number
+// of build rows, and only keep min/max of the filter if the build keys are dense in [min, max].
+CONF_mBool(enable_adaptive_runtime_bloom_filter, "false");
+// A join runtime filter is evaluated on the probe side only if the ratio of rows passing it is not greater than
+// this value in the last sampling, and a useless runtime filter is sampled less and less frequently.
+CONF_mDouble(runtime_filter_useful_selectivity, "0.5");
+// Bit-pack multi-column fixed-width group by keys into one 4/8/16 bytes integer key when the value ranges of the
+// columns are known to fit, which is denser than the byte-wise fixed size slice key.
+// Off by default until the fallback of nullable and out-of-range keys is covered.
+CONF_mBool(enable_agg_compressed_key, "false");
+// The finalizing blocking aggregation with group by aggregates the input of each driver locally and merges the
+// partial results of all the drivers partition by partition, instead of shuffling the input rows locally.
+CONF_mBool(enable_agg_partitioned_merge, "false");
+// The auto mode of streaming aggregation tracks the moving average of the reduction of the aggregated chunks to
+// leave aggregation early once it stops reducing, and leaves pass-through early to aggregate again when the chunk
+// buffer is kept full by the slow downstream exchange.
+CONF_mBool(enable_streaming_agg_adaptive_reduction, "false");
+// The hash table of streaming aggregation larger than this size is considered out of the last level cache, so
+// it needs a higher reduction to keep aggregating.
+CONF_mInt64(streaming_agg_ht_cache_size, "33554432");
+// Store the small POD states of the aggregate functions with group by, e.g. sum/count/min/max/avg, in an array per
+// function indexed by group id instead of a row per group, so that a batch update of a function only touches its own
+// array and the intermediate states of consecutive groups are serialized by a copy.
+CONF_mBool(enable_agg_columnar_states, "false");
+// The top-n sorters of all the drivers merged into one ORDER BY ... LIMIT share the tightest boundary published by
+// any of them, to prune the input rows and to build the runtime filter pushed down to the scan.
+CONF_mBool(enable_topn_shared_threshold, "true");
+// Sort by the normalized keys of the leading fixed-width ORDER BY columns, which are encoded into memcomparable
+// bytes and sorted as integers or by memcmp at once, instead of sorting the columns one by one.
+CONF_mBool(enable_sort_normalized_key, "false");
+// Sort the integer, date, datetime and decimal columns and normalized keys of at least 1024 rows by LSD radix sort
+// instead of pdqsort.
+CONF_mBool(enable_sort_radix, "false");
+// The spilled sorted runs of a parallel merged sort are merged by all the drivers through the merge path, instead of
+// being merged into one stream by the sorter of each driver first.
+CONF_mBool(enable_sort_spill_parallel_merge, "false");
+// The max number of the spilled sorted runs of a driver merged by the parallel merge, since every run takes the merge
+// buffers of a node in the merge tree. The spiller of a driver with more runs merges them into one stream by itself,
+// which is set up asynchronously once all the data is flushed.
+CONF_mInt32(sort_spill_parallel_merge_max_runs, "8");
+
+// Whether to encode the integer, date and datetime key and sort key columns of new segments by delta of delta
+// encoding, of which each page is encoded as the values, the deltas or the deltas of deltas, whichever is the
+// smallest. Segments written with it enabled can't be read by older versions.
+CONF_mBool(enable_segment_delta_encoding, "false");
+// Whether to encode the float and double columns of new segments by ALP encoding, which stores the values of few
+// decimal digits as bit-packed integers. Segments written with it enabled can't be read by older versions.
+CONF_mBool(enable_segment_alp_encoding, "false");
+// Whether to encode the varchar columns of new segments, which are not dictionary encoded, by FSST encoding, which
+// compresses every string by a symbol table of the page, so that a value could be decompressed on its own. Segments
+// written with it enabled can't be read by older versions.
+CONF_mBool(enable_segment_fsst_encoding, "false");
+// Whether to filter the rows by the equality and IN predicates on the compressed strings of the FSST encoded pages
+// (see enable_segment_fsst_encoding), before the strings of a page are decompressed.
+CONF_mBool(enable_segment_compressed_predicate_filter, "false");
+// Whether to estimate the number of distinct values of each data page of new segments, which is stored in the page
+// zone map and used by enable_segment_predicate_reorder to estimate the selectivity of equality and IN predicates.
+CONF_mBool(enable_zone_map_page_ndv, "false");
+// Whether to estimate the selectivity of the predicates of each column of a segment by the page zone maps, and to
+// evaluate the predicates column by column, the most selective and cheapest column first, so that the other
+// predicate columns and the output columns are read only for the rows surviving the former ones.
+CONF_mBool(enable_segment_predicate_reorder, "false");
+
 } // namespace starrocks::config
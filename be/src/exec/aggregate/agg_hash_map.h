@@ -26,6 +26,7 @@
 #include "common/compiler_util.h"
 #include "exec/aggregate/agg_hash_set.h"
 #include "exec/aggregate/agg_profile.h"
+#include "exec/aggregate/compress_serializer.h"
 #include "gutil/casts.h"
 #include "gutil/strings/fastmem.h"
 #include "runtime/mem_pool.h"
@@ -51,6 +52,10 @@ using Int32AggHashMap = phmap::flat_hash_map<int32_t, AggDataPtr, StdHashWithSee
 template <PhmapSeed seed>
 using Int64AggHashMap = phmap::flat_hash_map<int64_t, AggDataPtr, StdHashWithSeed<int64_t, seed>>;
 template <PhmapSeed seed>
+using UInt32AggHashMap = phmap::flat_hash_map<uint32_t, AggDataPtr, StdHashWithSeed<uint32_t, seed>>;
+template <PhmapSeed seed>
+using UInt64AggHashMap = phmap::flat_hash_map<uint64_t, AggDataPtr, StdHashWithSeed<uint64_t, seed>>;
+template <PhmapSeed seed>
 using Int128AggHashMap = phmap::flat_hash_map<int128_t, AggDataPtr, Hash128WithSeed<seed>>;
 template <PhmapSeed seed>
 using DateAggHashMap = phmap::flat_hash_map<DateValue, AggDataPtr, StdHashWithSeed<DateValue, seed>>;
@@ -868,4 +873,118 @@ struct AggHashMapWithSerializedKeyFixedSize
     int32_t _chunk_size;
 };
 
+// Group by keys of several fixed-width columns which are bit-packed into one integer key,
+// see CompressedKeyLayout.
+template <typename HashMap>
+struct AggHashMapWithCompressedKeyFixedSize
+        : public AggHashMapWithKey<HashMap, AggHashMapWithCompressedKeyFixedSize<HashMap>> {
+    using Base = AggHashMapWithKey<HashMap, AggHashMapWithCompressedKeyFixedSize<HashMap>>;
+    using KeyType = typename HashMap::key_type;
+    using Iterator = typename HashMap::iterator;
+    using ResultVector = typename std::vector<KeyType>;
+
+    // must be set before building the hash map
+    CompressedKeyLayout layout;
+
+    template <class... Args>
+    AggHashMapWithCompressedKeyFixedSize(int chunk_size, Args&&... args)
+            : Base(chunk_size, std::forward<Args>(args)...), _chunk_size(chunk_size) {
+        keys.reserve(chunk_size);
+    }
+
+    AggDataPtr get_null_key_data() { return nullptr; }
+
+    template <typename Func, bool allocate_and_compute_state, bool compute_not_founds>
+    ALWAYS_NOINLINE void compute_agg_prefetch(size_t chunk_size, Buffer<AggDataPtr>* agg_states, Func&& allocate_func,
+                                              std::vector<uint8_t>* not_founds) {
+        hash_values.resize(chunk_size);
+        for (size_t i = 0; i < chunk_size; i++) {
+            hash_values[i] = this->hash_map.hash_function()(keys[i]);
+        }
+
+        size_t __prefetch_index = AGG_HASH_MAP_DEFAULT_PREFETCH_DIST;
+        for (size_t i = 0; i < chunk_size; ++i) {
+            if (__prefetch_index < chunk_size) {
+                this->hash_map.prefetch_hash(hash_values[__prefetch_index++]);
+            }
+            KeyType key = keys[i];
+            if constexpr (allocate_and_compute_state) {
+                auto iter = this->hash_map.lazy_emplace_with_hash(key, hash_values[i], [&](const auto& ctor) {
+                    if constexpr (compute_not_founds) {
+                        (*not_founds)[i] = 1;
+                    }
+                    ctor(key, allocate_func(key));
+                });
+                (*agg_states)[i] = iter->second;
+            } else if constexpr (compute_not_founds) {
+                DCHECK(not_founds);
+                if (auto iter = this->hash_map.find(key, hash_values[i]); iter != this->hash_map.end()) {
+                    (*agg_states)[i] = iter->second;
+                } else {
+                    (*not_founds)[i] = 1;
+                }
+            }
+        }
+    }
+
+    template <typename Func, bool allocate_and_compute_state, bool compute_not_founds>
+    ALWAYS_NOINLINE void compute_agg_noprefetch(size_t chunk_size, Buffer<AggDataPtr>* agg_states,
+                                                Func&& allocate_func, std::vector<uint8_t>* not_founds) {
+        for (size_t i = 0; i < chunk_size; ++i) {
+            KeyType key = keys[i];
+            if constexpr (allocate_and_compute_state) {
+                auto iter = this->hash_map.lazy_emplace(key, [&](const auto& ctor) {
+                    if constexpr (compute_not_founds) {
+                        DCHECK(not_founds);
+                        (*not_founds)[i] = 1;
+                    }
+                    ctor(key, allocate_func(key));
+                });
+                (*agg_states)[i] = iter->second;
+            } else if constexpr (compute_not_founds) {
+                DCHECK(not_founds);
+                if (auto iter = this->hash_map.find(key); iter != this->hash_map.end()) {
+                    (*agg_states)[i] = iter->second;
+                } else {
+                    (*not_founds)[i] = 1;
+                }
+            }
+        }
+    }
+
+    template <typename Func, bool allocate_and_compute_state, bool compute_not_founds>
+    void compute_agg_states(size_t chunk_size, const Columns& key_columns, MemPool* pool, Func&& allocate_func,
+                            Buffer<AggDataPtr>* agg_states, std::vector<uint8_t>* not_founds) {
+        DCHECK(!layout.columns.empty());
+        // Assign not_founds vector when needs compute not founds.
+        if constexpr (compute_not_founds) {
+            DCHECK(not_founds);
+            (*not_founds).assign(chunk_size, 0);
+        }
+
+        keys.resize(chunk_size);
+        bitcompress_serialize(key_columns, layout, chunk_size, keys.data());
+
+        if (this->hash_map.bucket_count() < prefetch_threhold) {
+            this->template compute_agg_noprefetch<Func, allocate_and_compute_state, compute_not_founds>(
+                    chunk_size, agg_states, std::forward<Func>(allocate_func), not_founds);
+        } else {
+            this->template compute_agg_prefetch<Func, allocate_and_compute_state, compute_not_founds>(
+                    chunk_size, agg_states, std::forward<Func>(allocate_func), not_founds);
+        }
+    }
+
+    void insert_keys_to_columns(ResultVector& results, const Columns& key_columns, int32_t chunk_size) {
+        bitcompress_deserialize(key_columns, layout, chunk_size, results.data());
+    }
+
+    static constexpr bool has_single_null_key = false;
+
+    std::vector<KeyType> keys;
+    std::vector<size_t> hash_values;
+    ResultVector results;
+
+    int32_t _chunk_size;
+};
+
 } // namespace starrocks
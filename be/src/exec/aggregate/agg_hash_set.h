@@ -18,6 +18,7 @@
 #include "column/column_helper.h"
 #include "column/hash_set.h"
 #include "column/type_traits.h"
+#include "exec/aggregate/compress_serializer.h"
 #include "gutil/casts.h"
 #include "runtime/mem_pool.h"
 #include "runtime/runtime_state.h"
@@ -38,6 +39,10 @@ using Int32AggHashSet = phmap::flat_hash_set<int32_t, StdHashWithSeed<int32_t, s
 template <PhmapSeed seed>
 using Int64AggHashSet = phmap::flat_hash_set<int64_t, StdHashWithSeed<int64_t, seed>>;
 template <PhmapSeed seed>
+using UInt32AggHashSet = phmap::flat_hash_set<uint32_t, StdHashWithSeed<uint32_t, seed>>;
+template <PhmapSeed seed>
+using UInt64AggHashSet = phmap::flat_hash_set<uint64_t, StdHashWithSeed<uint64_t, seed>>;
+template <PhmapSeed seed>
 using Int128AggHashSet = phmap::flat_hash_set<int128_t, Hash128WithSeed<seed>>;
 template <PhmapSeed seed>
 using DateAggHashSet = phmap::flat_hash_set<DateValue, StdHashWithSeed<DateValue, seed>>;
@@ -511,4 +516,53 @@ struct AggHashSetOfSerializedKeyFixedSize : public AggHashSet<HashSet, AggHashSe
     int32_t _chunk_size;
 };
 
+// Group by keys of several fixed-width columns which are bit-packed into one integer key,
+// see CompressedKeyLayout.
+template <typename HashSet>
+struct AggHashSetOfCompressedKeyFixedSize : public AggHashSet<HashSet, AggHashSetOfCompressedKeyFixedSize<HashSet>> {
+    using Iterator = typename HashSet::iterator;
+    using KeyType = typename HashSet::key_type;
+    using ResultVector = typename std::vector<KeyType>;
+
+    // must be set before building the hash set
+    CompressedKeyLayout layout;
+
+    AggHashSetOfCompressedKeyFixedSize(int32_t chunk_size) : _chunk_size(chunk_size) { keys.reserve(chunk_size); }
+
+    // When compute_and_allocate=false:
+    // Elements queried in HashSet will be added to HashSet
+    // elements that cannot be queried are not processed,
+    // and are mainly used in the first stage of two-stage aggregation when aggr reduction is low
+    template <bool compute_and_allocate>
+    void build_set(size_t chunk_size, const Columns& key_columns, MemPool* pool, std::vector<uint8_t>* not_founds) {
+        DCHECK(!layout.columns.empty());
+        if constexpr (!compute_and_allocate) {
+            DCHECK(not_founds);
+            not_founds->assign(chunk_size, 0);
+        }
+
+        keys.resize(chunk_size);
+        bitcompress_serialize(key_columns, layout, chunk_size, keys.data());
+
+        for (size_t i = 0; i < chunk_size; ++i) {
+            if constexpr (compute_and_allocate) {
+                this->hash_set.insert(keys[i]);
+            } else {
+                (*not_founds)[i] = !this->hash_set.contains(keys[i]);
+            }
+        }
+    }
+
+    void insert_keys_to_columns(ResultVector& results, const Columns& key_columns, int32_t chunk_size) {
+        bitcompress_deserialize(key_columns, layout, chunk_size, results.data());
+    }
+
+    static constexpr bool has_single_null_key = false;
+
+    std::vector<KeyType> keys;
+    ResultVector results;
+
+    int32_t _chunk_size;
+};
+
 } // namespace starrocks
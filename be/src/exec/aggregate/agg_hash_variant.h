@@ -89,7 +89,13 @@ namespace starrocks {
     M(phase1_slice_fx16)             \
     M(phase2_slice_fx4)              \
     M(phase2_slice_fx8)              \
-    M(phase2_slice_fx16)
+    M(phase2_slice_fx16)             \
+    M(phase1_slice_cx4)              \
+    M(phase1_slice_cx8)              \
+    M(phase1_slice_cx16)             \
+    M(phase2_slice_cx4)              \
+    M(phase2_slice_cx8)              \
+    M(phase2_slice_cx16)
 
 // Aggregate Hash maps
 
@@ -165,6 +171,14 @@ using SerializedKeyFixedSize8AggHashMap = AggHashMapWithSerializedKeyFixedSize<F
 template <PhmapSeed seed>
 using SerializedKeyFixedSize16AggHashMap = AggHashMapWithSerializedKeyFixedSize<FixedSize16SliceAggHashMap<seed>>;
 
+// compressed fixed key type.
+template <PhmapSeed seed>
+using CompressedKeyFixedSize4AggHashMap = AggHashMapWithCompressedKeyFixedSize<UInt32AggHashMap<seed>>;
+template <PhmapSeed seed>
+using CompressedKeyFixedSize8AggHashMap = AggHashMapWithCompressedKeyFixedSize<UInt64AggHashMap<seed>>;
+template <PhmapSeed seed>
+using CompressedKeyFixedSize16AggHashMap = AggHashMapWithCompressedKeyFixedSize<Int128AggHashMap<seed>>;
+
 // Hash sets
 //
 template <PhmapSeed seed>
@@ -239,6 +253,14 @@ using SerializedKeyAggHashSetFixedSize8 = AggHashSetOfSerializedKeyFixedSize<Fix
 template <PhmapSeed seed>
 using SerializedKeyAggHashSetFixedSize16 = AggHashSetOfSerializedKeyFixedSize<FixedSize16SliceAggHashSet<seed>>;
 
+// For compressed fixed key type.
+template <PhmapSeed seed>
+using CompressedKeyAggHashSetFixedSize4 = AggHashSetOfCompressedKeyFixedSize<UInt32AggHashSet<seed>>;
+template <PhmapSeed seed>
+using CompressedKeyAggHashSetFixedSize8 = AggHashSetOfCompressedKeyFixedSize<UInt64AggHashSet<seed>>;
+template <PhmapSeed seed>
+using CompressedKeyAggHashSetFixedSize16 = AggHashSetOfCompressedKeyFixedSize<Int128AggHashSet<seed>>;
+
 // aggregate key
 template <class HashMapWithKey>
 struct CombinedFixedSizeKey {
@@ -263,6 +285,29 @@ static_assert(!is_combined_fixed_size_key<Int32TwoLevelAggHashSetOfOneNumberKey<
 static_assert(is_combined_fixed_size_key<SerializedKeyAggHashSetFixedSize4<PhmapSeed1>>);
 static_assert(!is_combined_fixed_size_key<Int32TwoLevelAggHashMapWithOneNumberKey<PhmapSeed1>>);
 
+template <class HashMapWithKey>
+struct CompressedFixedSizeKey {
+    static auto constexpr value = false;
+};
+
+template <typename HashMap>
+struct CompressedFixedSizeKey<AggHashMapWithCompressedKeyFixedSize<HashMap>> {
+    static auto constexpr value = true;
+};
+
+template <typename HashSet>
+struct CompressedFixedSizeKey<AggHashSetOfCompressedKeyFixedSize<HashSet>> {
+    static auto constexpr value = true;
+};
+
+template <typename HashMapOrSetWithKey>
+inline constexpr bool is_compressed_fixed_size_key = CompressedFixedSizeKey<HashMapOrSetWithKey>::value;
+
+static_assert(is_compressed_fixed_size_key<CompressedKeyFixedSize8AggHashMap<PhmapSeed1>>);
+static_assert(!is_compressed_fixed_size_key<SerializedKeyFixedSize8AggHashMap<PhmapSeed1>>);
+static_assert(is_compressed_fixed_size_key<CompressedKeyAggHashSetFixedSize8<PhmapSeed1>>);
+static_assert(!is_compressed_fixed_size_key<SerializedKeyAggHashSetFixedSize8<PhmapSeed1>>);
+
 // 1) For different group by columns type, size, cardinality, volume, we should choose different
 // hash functions and different hashmaps.
 // When runtime, we will only have one hashmap.
@@ -334,7 +379,13 @@ using AggHashMapWithKeyPtr = std::variant<
         std::unique_ptr<Int32TwoLevelAggHashMapWithOneNumberKey<PhmapSeed2>>,
         std::unique_ptr<SerializedKeyFixedSize4AggHashMap<PhmapSeed2>>,
         std::unique_ptr<SerializedKeyFixedSize8AggHashMap<PhmapSeed2>>,
-        std::unique_ptr<SerializedKeyFixedSize16AggHashMap<PhmapSeed2>>>;
+        std::unique_ptr<SerializedKeyFixedSize16AggHashMap<PhmapSeed2>>,
+        std::unique_ptr<CompressedKeyFixedSize4AggHashMap<PhmapSeed1>>,
+        std::unique_ptr<CompressedKeyFixedSize8AggHashMap<PhmapSeed1>>,
+        std::unique_ptr<CompressedKeyFixedSize16AggHashMap<PhmapSeed1>>,
+        std::unique_ptr<CompressedKeyFixedSize4AggHashMap<PhmapSeed2>>,
+        std::unique_ptr<CompressedKeyFixedSize8AggHashMap<PhmapSeed2>>,
+        std::unique_ptr<CompressedKeyFixedSize16AggHashMap<PhmapSeed2>>>;
 
 using AggHashSetWithKeyPtr = std::variant<
         std::unique_ptr<UInt8AggHashSetOfOneNumberKey<PhmapSeed1>>,
@@ -394,7 +445,13 @@ using AggHashSetWithKeyPtr = std::variant<
         std::unique_ptr<SerializedKeyAggHashSetFixedSize16<PhmapSeed1>>,
         std::unique_ptr<SerializedKeyAggHashSetFixedSize4<PhmapSeed2>>,
         std::unique_ptr<SerializedKeyAggHashSetFixedSize8<PhmapSeed2>>,
-        std::unique_ptr<SerializedKeyAggHashSetFixedSize16<PhmapSeed2>>>;
+        std::unique_ptr<SerializedKeyAggHashSetFixedSize16<PhmapSeed2>>,
+        std::unique_ptr<CompressedKeyAggHashSetFixedSize4<PhmapSeed1>>,
+        std::unique_ptr<CompressedKeyAggHashSetFixedSize8<PhmapSeed1>>,
+        std::unique_ptr<CompressedKeyAggHashSetFixedSize16<PhmapSeed1>>,
+        std::unique_ptr<CompressedKeyAggHashSetFixedSize4<PhmapSeed2>>,
+        std::unique_ptr<CompressedKeyAggHashSetFixedSize8<PhmapSeed2>>,
+        std::unique_ptr<CompressedKeyAggHashSetFixedSize16<PhmapSeed2>>>;
 } // namespace detail
 struct AggHashMapVariant {
     enum class Type {
@@ -430,6 +487,10 @@ struct AggHashMapVariant {
         phase1_slice_fx8,
         phase1_slice_fx16,
 
+        phase1_slice_cx4,
+        phase1_slice_cx8,
+        phase1_slice_cx16,
+
         phase2_uint8,
         phase2_int8,
         phase2_int16,
@@ -461,6 +522,10 @@ struct AggHashMapVariant {
         phase2_slice_fx4,
         phase2_slice_fx8,
         phase2_slice_fx16,
+
+        phase2_slice_cx4,
+        phase2_slice_cx8,
+        phase2_slice_cx16,
     };
 
     detail::AggHashMapWithKeyPtr hash_map_with_key;
@@ -564,6 +629,13 @@ struct AggHashSetVariant {
         phase2_slice_fx4,
         phase2_slice_fx8,
         phase2_slice_fx16,
+
+        phase1_slice_cx4,
+        phase1_slice_cx8,
+        phase1_slice_cx16,
+        phase2_slice_cx4,
+        phase2_slice_cx8,
+        phase2_slice_cx16,
     };
 
     detail::AggHashSetWithKeyPtr hash_set_with_key;
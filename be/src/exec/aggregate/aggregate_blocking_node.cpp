@@ -18,9 +18,11 @@
 #include <type_traits>
 #include <variant>
 
+#include "common/config.h"
 #include "exec/aggregator.h"
 #include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
 #include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
+#include "exec/pipeline/aggregate/aggregate_partitioned_merge_source_operator.h"
 #include "exec/pipeline/aggregate/aggregate_streaming_sink_operator.h"
 #include "exec/pipeline/aggregate/aggregate_streaming_source_operator.h"
 #include "exec/pipeline/aggregate/sorted_aggregate_streaming_sink_operator.h"
@@ -239,6 +241,39 @@ pipeline::OpFactories AggregateBlockingNode::_decompose_to_pipeline(pipeline::Op
     return ops_with_source;
 }
 
+pipeline::OpFactories AggregateBlockingNode::_decompose_to_pipeline_with_partitioned_merge(
+        pipeline::OpFactories& ops_with_sink, pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+
+    auto* upstream_source_op = context->source_operator(ops_with_sink);
+    auto degree_of_parallelism = upstream_source_op->degree_of_parallelism();
+    auto merge_context = std::make_shared<AggregatePartitionedMergeContext>(degree_of_parallelism);
+
+    // the sink aggregators output the intermediate states, and the merge aggregators take them as input.
+    auto aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+    aggregator_factory->set_aggr_mode(AM_BLOCKING_PRE_CACHE);
+    auto merge_aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+    merge_aggregator_factory->set_aggr_mode(AM_BLOCKING_POST_CACHE);
+
+    auto agg_sink_op = std::make_shared<AggregateBlockingSinkOperatorFactory>(context->next_operator_id(), id(),
+                                                                              aggregator_factory, nullptr);
+    agg_sink_op->set_partitioned_merge_context(merge_context);
+    auto agg_source_op = std::make_shared<AggregatePartitionedMergeSourceOperatorFactory>(
+            context->next_operator_id(), id(), merge_aggregator_factory, merge_context);
+    context->inherit_upstream_source_properties(agg_source_op.get(), upstream_source_op);
+
+    auto&& rc_rf_probe_collector = std::make_shared<RcRfProbeCollector>(2, std::move(this->runtime_filter_collector()));
+    this->init_runtime_filter_for_operator(agg_sink_op.get(), context, rc_rf_probe_collector);
+    this->init_runtime_filter_for_operator(agg_source_op.get(), context, rc_rf_probe_collector);
+
+    ops_with_sink.push_back(std::move(agg_sink_op));
+    context->add_pipeline(ops_with_sink);
+
+    OpFactories ops_with_source;
+    ops_with_source.push_back(std::move(agg_source_op));
+    return ops_with_source;
+}
+
 pipeline::OpFactories AggregateBlockingNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
 
@@ -262,7 +297,18 @@ pipeline::OpFactories AggregateBlockingNode::decompose_to_pipeline(pipeline::Pip
         });
     };
 
-    if (!sorted_streaming_aggregate) {
+    // Finalize aggregation with group by clause could merge the partial results of the drivers partition by
+    // partition, rather than shuffling the input rows locally.
+    bool partitioned_merge = config::enable_agg_partitioned_merge && !sorted_streaming_aggregate &&
+                             agg_node.need_finalize && has_group_by_keys && could_local_shuffle &&
+                             !use_per_bucket_optimize &&
+                             context->source_operator(ops_with_sink)->degree_of_parallelism() > 1 &&
+                             !(runtime_state()->enable_spill() && runtime_state()->enable_agg_spill()) &&
+                             !context->should_interpolate_cache_operator(id(), ops_with_sink[0]);
+
+    if (partitioned_merge) {
+        // Do nothing.
+    } else if (!sorted_streaming_aggregate) {
         // 1. Finalize aggregation:
         //   - Without group by clause, it cannot be parallelized and need local passthough.
         //   - With group by clause, it can be parallelized and need local shuffle when could_local_shuffle is true.
@@ -288,7 +334,9 @@ pipeline::OpFactories AggregateBlockingNode::decompose_to_pipeline(pipeline::Pip
     use_per_bucket_optimize &= dynamic_cast<LocalExchangeSourceOperatorFactory*>(ops_with_sink.back().get()) == nullptr;
 
     OpFactories ops_with_source;
-    if (sorted_streaming_aggregate) {
+    if (partitioned_merge) {
+        ops_with_source = _decompose_to_pipeline_with_partitioned_merge(ops_with_sink, context);
+    } else if (sorted_streaming_aggregate) {
         ops_with_source =
                 _decompose_to_pipeline<StreamingAggregatorFactory, SortedAggregateStreamingSourceOperatorFactory,
                                        SortedAggregateStreamingSinkOperatorFactory>(ops_with_sink, context, false);
@@ -36,5 +36,7 @@ private:
     template <class AggFactory, class SourceFactory, class SinkFactory>
     pipeline::OpFactories _decompose_to_pipeline(pipeline::OpFactories& ops_with_sink,
                                                  pipeline::PipelineBuilderContext* context, bool per_bucket_optimize);
+    pipeline::OpFactories _decompose_to_pipeline_with_partitioned_merge(pipeline::OpFactories& ops_with_sink,
+                                                                        pipeline::PipelineBuilderContext* context);
 };
 } // namespace starrocks
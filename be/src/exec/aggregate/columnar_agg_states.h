@@ -0,0 +1,133 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "column/column.h"
+#include "exprs/agg/aggregate.h"
+#include "runtime/mem_pool.h"
+
+namespace starrocks {
+
+// ColumnarAggStates keeps the states of each aggregate function in its own arrays indexed by group id
+// (struct-of-arrays), instead of a row of the states of all the functions per group.
+// - The states of one function of consecutive groups are contiguous, so a batch update of the function only
+//   touches a dense array, and the states of the groups output in allocation order could be serialized at once.
+// - The states are allocated in blocks of BLOCK_SIZE groups and never moved, so a state pointer is stable.
+class ColumnarAggStates {
+public:
+    static constexpr uint32_t BLOCK_BITS = 10;
+    static constexpr uint32_t BLOCK_SIZE = 1 << BLOCK_BITS;
+    static constexpr uint32_t BLOCK_MASK = BLOCK_SIZE - 1;
+    // the max size of a state stored in arrays
+    static constexpr size_t MAX_STATE_SIZE = 32;
+    // the group id of the rows without states, whose state pointer is gathered as nullptr
+    static constexpr uint32_t INVALID_GROUP_ID = UINT32_MAX;
+
+    void init(const std::vector<const AggregateFunction*>& functions, MemPool* pool) {
+        _pool = pool;
+        _state_sizes.clear();
+        _state_aligns.clear();
+        for (const auto* function : functions) {
+            _state_sizes.emplace_back(function->size());
+            _state_aligns.emplace_back(std::max<size_t>(function->alignof_size(), 16));
+        }
+        _blocks.assign(functions.size(), {});
+        _num_groups = 0;
+    }
+
+    // Allocate the state slots of a new group and return its group id, the states are not created.
+    uint32_t allocate() {
+        if ((_num_groups & BLOCK_MASK) == 0 && (_num_groups >> BLOCK_BITS) == _blocks_per_function()) {
+            for (size_t i = 0; i < _blocks.size(); i++) {
+                uint8_t* mem = _pool->allocate_aligned(BLOCK_SIZE * _state_sizes[i], _state_aligns[i]);
+                if (mem == nullptr) {
+                    // keep the blocks of all the functions of the same number
+                    for (size_t j = 0; j < i; j++) {
+                        _blocks[j].pop_back();
+                    }
+                    throw std::bad_alloc();
+                }
+                _blocks[i].emplace_back(mem);
+            }
+        }
+        return _num_groups++;
+    }
+
+    // Release the slots of the last allocated group, its states must have been destroyed.
+    void rollback() {
+        DCHECK_GT(_num_groups, 0);
+        _num_groups--;
+    }
+
+    AggDataPtr state(size_t function_index, uint32_t group_id) const {
+        const size_t state_size = _state_sizes[function_index];
+        return _blocks[function_index][group_id >> BLOCK_BITS] + (group_id & BLOCK_MASK) * state_size;
+    }
+
+    // Gather the state pointers of the function_index-th function of the groups.
+    void gather(size_t function_index, const uint32_t* group_ids, size_t num_rows, AggDataPtr* states) const {
+        const auto& blocks = _blocks[function_index];
+        const size_t state_size = _state_sizes[function_index];
+        for (size_t i = 0; i < num_rows; i++) {
+            const uint32_t group_id = group_ids[i];
+            states[i] = group_id == INVALID_GROUP_ID
+                                ? nullptr
+                                : blocks[group_id >> BLOCK_BITS] + (group_id & BLOCK_MASK) * state_size;
+        }
+    }
+
+    // Serialize the states of the function_index-th function of the groups into `to`, the states of a run of
+    // consecutive group ids in the same block are serialized by a single call.
+    void serialize(const AggregateFunction* function, FunctionContext* ctx, size_t function_index,
+                   const uint32_t* group_ids, size_t num_rows, Column* to) const {
+        size_t start = 0;
+        while (start < num_rows) {
+            size_t end = start + 1;
+            while (end < num_rows && group_ids[end] == group_ids[end - 1] + 1 &&
+                   (group_ids[end] & BLOCK_MASK) != 0) {
+                end++;
+            }
+            function->batch_serialize_contiguous(ctx, end - start, state(function_index, group_ids[start]), to);
+            start = end;
+        }
+    }
+
+    size_t num_groups() const { return _num_groups; }
+
+    // The blocks are allocated from the MemPool and freed along with it.
+    void reset() {
+        for (auto& blocks : _blocks) {
+            blocks.clear();
+        }
+        _num_groups = 0;
+    }
+
+private:
+    size_t _blocks_per_function() const { return _blocks.empty() ? 0 : _blocks[0].size(); }
+
+    MemPool* _pool = nullptr;
+    std::vector<size_t> _state_sizes;
+    std::vector<size_t> _state_aligns;
+    // function index -> blocks of the states of the function
+    std::vector<std::vector<AggDataPtr>> _blocks;
+    uint32_t _num_groups = 0;
+};
+
+} // namespace starrocks
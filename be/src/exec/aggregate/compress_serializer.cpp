@@ -0,0 +1,263 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/aggregate/compress_serializer.h"
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "column/column.h"
+#include "column/column_hash.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "gutil/casts.h"
+#include "runtime/time_types.h"
+#include "types/date_value.h"
+#include "types/timestamp_value.h"
+
+namespace starrocks {
+
+bool CompressedKeyLayout::get_type_value_range(LogicalType type, int64_t* min_value, int64_t* max_value) {
+    switch (type) {
+    case TYPE_BOOLEAN:
+        *min_value = 0;
+        *max_value = 1;
+        return true;
+    case TYPE_TINYINT:
+        *min_value = std::numeric_limits<int8_t>::min();
+        *max_value = std::numeric_limits<int8_t>::max();
+        return true;
+    case TYPE_SMALLINT:
+        *min_value = std::numeric_limits<int16_t>::min();
+        *max_value = std::numeric_limits<int16_t>::max();
+        return true;
+    case TYPE_INT:
+    case TYPE_DECIMAL32:
+        *min_value = std::numeric_limits<int32_t>::min();
+        *max_value = std::numeric_limits<int32_t>::max();
+        return true;
+    case TYPE_BIGINT:
+    case TYPE_DECIMAL64:
+    case TYPE_DATETIME:
+        *min_value = std::numeric_limits<int64_t>::min();
+        *max_value = std::numeric_limits<int64_t>::max();
+        return true;
+    case TYPE_DATE:
+        // the julian day of any date until 9999-12-31 is non-negative and takes 23 bits
+        *min_value = 0;
+        *max_value = date::INVALID_DATE;
+        return true;
+    default:
+        return false;
+    }
+}
+
+void CompressedKeyLayout::add_column(LogicalType type, bool is_nullable, int64_t min_value, int64_t max_value) {
+    DCHECK_LE(min_value, max_value);
+    CompressedKeyColumn column;
+    column.type = type;
+    column.is_nullable = is_nullable;
+    column.min_value = min_value;
+    column.max_value = max_value;
+    column.offset = total_bits;
+    uint64_t range = static_cast<uint64_t>(max_value) - static_cast<uint64_t>(min_value);
+    column.value_bits = range == 0 ? 0 : 64 - __builtin_clzll(range);
+    total_bits += column.value_bits + is_nullable;
+    columns.emplace_back(column);
+}
+
+namespace {
+
+template <typename KeyType>
+using UnsignedKeyType = std::conditional_t<std::is_same_v<KeyType, int128_t>, uint128_t, KeyType>;
+
+template <typename CppType>
+inline uint64_t to_uint64(const CppType& value) {
+    if constexpr (std::is_same_v<CppType, DateValue>) {
+        return static_cast<uint64_t>(static_cast<int64_t>(value.julian()));
+    } else if constexpr (std::is_same_v<CppType, TimestampValue>) {
+        return static_cast<uint64_t>(value.timestamp());
+    } else if constexpr (std::is_same_v<CppType, uint8_t>) {
+        // boolean
+        return value != 0;
+    } else {
+        return static_cast<uint64_t>(static_cast<int64_t>(value));
+    }
+}
+
+template <typename CppType>
+inline CppType from_uint64(uint64_t value) {
+    if constexpr (std::is_same_v<CppType, DateValue>) {
+        return DateValue{static_cast<JulianDate>(static_cast<int64_t>(value))};
+    } else if constexpr (std::is_same_v<CppType, TimestampValue>) {
+        return TimestampValue{static_cast<Timestamp>(value)};
+    } else {
+        return static_cast<CppType>(static_cast<int64_t>(value));
+    }
+}
+
+template <LogicalType LT, typename KeyType>
+void serialize_column(const Column* column, const CompressedKeyColumn& layout, size_t num_rows,
+                      UnsignedKeyType<KeyType>* keys) {
+    using UKey = UnsignedKeyType<KeyType>;
+    using ColumnType = RunTimeColumnType<LT>;
+    const uint64_t base = static_cast<uint64_t>(layout.min_value);
+
+    if (column->only_null()) {
+        DCHECK(layout.is_nullable);
+        for (size_t i = 0; i < num_rows; i++) {
+            keys[i] |= UKey(1) << layout.offset;
+        }
+        return;
+    }
+
+    const uint8_t* nulls = nullptr;
+    if (column->is_nullable()) {
+        const auto* nullable_column = down_cast<const NullableColumn*>(column);
+        if (nullable_column->has_null()) {
+            nulls = nullable_column->null_column()->get_data().data();
+        }
+        column = nullable_column->data_column().get();
+    }
+    const auto& data = down_cast<const ColumnType*>(column)->get_data();
+
+    const uint32_t value_offset = layout.offset + layout.is_nullable;
+    if (layout.value_bits == 0) {
+        // the value is always min_value, only the null flag is stored
+        if (nulls != nullptr) {
+            for (size_t i = 0; i < num_rows; i++) {
+                keys[i] |= UKey(nulls[i]) << layout.offset;
+            }
+        }
+    } else if (nulls == nullptr) {
+        for (size_t i = 0; i < num_rows; i++) {
+            uint64_t value = to_uint64(data[i]) - base;
+            DCHECK_LE(value, static_cast<uint64_t>(layout.max_value) - base);
+            keys[i] |= UKey(value) << value_offset;
+        }
+    } else {
+        for (size_t i = 0; i < num_rows; i++) {
+            // the data of a null row is undefined, so it's masked out
+            uint64_t value = nulls[i] ? 0 : to_uint64(data[i]) - base;
+            keys[i] |= (UKey(value) << value_offset) | (UKey(nulls[i]) << layout.offset);
+        }
+    }
+}
+
+template <LogicalType LT, typename KeyType>
+void deserialize_column(Column* column, const CompressedKeyColumn& layout, size_t num_rows,
+                        const UnsignedKeyType<KeyType>* keys) {
+    using ColumnType = RunTimeColumnType<LT>;
+    using CppType = RunTimeCppType<LT>;
+    const uint64_t base = static_cast<uint64_t>(layout.min_value);
+    const uint64_t mask = layout.value_bits >= 64 ? ~uint64_t(0) : (uint64_t(1) << layout.value_bits) - 1;
+    const uint32_t value_offset = layout.offset + layout.is_nullable;
+
+    ColumnType* data_column = nullptr;
+    if (column->is_nullable()) {
+        auto* nullable_column = down_cast<NullableColumn*>(column);
+        auto& null_data = nullable_column->null_column_data();
+        size_t null_begin = null_data.size();
+        null_data.resize(null_begin + num_rows);
+        if (layout.is_nullable) {
+            for (size_t i = 0; i < num_rows; i++) {
+                null_data[null_begin + i] = (keys[i] >> layout.offset) & 1;
+            }
+            nullable_column->set_has_null(true);
+        }
+        data_column = down_cast<ColumnType*>(nullable_column->data_column().get());
+    } else {
+        data_column = down_cast<ColumnType*>(column);
+    }
+
+    auto& data = data_column->get_data();
+    size_t data_begin = data.size();
+    data.resize(data_begin + num_rows);
+    if (layout.value_bits == 0) {
+        for (size_t i = 0; i < num_rows; i++) {
+            data[data_begin + i] = from_uint64<CppType>(base);
+        }
+    } else {
+        for (size_t i = 0; i < num_rows; i++) {
+            uint64_t value = static_cast<uint64_t>(keys[i] >> value_offset) & mask;
+            data[data_begin + i] = from_uint64<CppType>(value + base);
+        }
+    }
+}
+
+#define APPLY_FOR_COMPRESSED_KEY_TYPES(M) \
+    M(TYPE_BOOLEAN)                       \
+    M(TYPE_TINYINT)                       \
+    M(TYPE_SMALLINT)                      \
+    M(TYPE_INT)                           \
+    M(TYPE_DECIMAL32)                     \
+    M(TYPE_BIGINT)                        \
+    M(TYPE_DECIMAL64)                     \
+    M(TYPE_DATETIME)                      \
+    M(TYPE_DATE)
+
+} // namespace
+
+template <typename KeyType>
+void bitcompress_serialize(const Columns& key_columns, const CompressedKeyLayout& layout, size_t num_rows,
+                           KeyType* keys) {
+    DCHECK_EQ(key_columns.size(), layout.columns.size());
+    auto* ukeys = reinterpret_cast<UnsignedKeyType<KeyType>*>(keys);
+    memset(ukeys, 0, sizeof(KeyType) * num_rows);
+    for (size_t i = 0; i < key_columns.size(); i++) {
+        const auto& column_layout = layout.columns[i];
+        switch (column_layout.type) {
+#define M(LT)                                                                                \
+    case LT:                                                                                 \
+        serialize_column<LT, KeyType>(key_columns[i].get(), column_layout, num_rows, ukeys); \
+        break;
+            APPLY_FOR_COMPRESSED_KEY_TYPES(M)
+#undef M
+        default:
+            CHECK(false) << "unsupported type of compressed key: " << column_layout.type;
+        }
+    }
+}
+
+template <typename KeyType>
+void bitcompress_deserialize(const Columns& key_columns, const CompressedKeyLayout& layout, size_t num_rows,
+                             const KeyType* keys) {
+    DCHECK_EQ(key_columns.size(), layout.columns.size());
+    const auto* ukeys = reinterpret_cast<const UnsignedKeyType<KeyType>*>(keys);
+    for (size_t i = 0; i < key_columns.size(); i++) {
+        const auto& column_layout = layout.columns[i];
+        switch (column_layout.type) {
+#define M(LT)                                                                                  \
+    case LT:                                                                                   \
+        deserialize_column<LT, KeyType>(key_columns[i].get(), column_layout, num_rows, ukeys); \
+        break;
+            APPLY_FOR_COMPRESSED_KEY_TYPES(M)
+#undef M
+        default:
+            CHECK(false) << "unsupported type of compressed key: " << column_layout.type;
+        }
+    }
+}
+
+#undef APPLY_FOR_COMPRESSED_KEY_TYPES
+
+template void bitcompress_serialize<uint32_t>(const Columns&, const CompressedKeyLayout&, size_t, uint32_t*);
+template void bitcompress_serialize<uint64_t>(const Columns&, const CompressedKeyLayout&, size_t, uint64_t*);
+template void bitcompress_serialize<int128_t>(const Columns&, const CompressedKeyLayout&, size_t, int128_t*);
+template void bitcompress_deserialize<uint32_t>(const Columns&, const CompressedKeyLayout&, size_t, const uint32_t*);
+template void bitcompress_deserialize<uint64_t>(const Columns&, const CompressedKeyLayout&, size_t, const uint64_t*);
+template void bitcompress_deserialize<int128_t>(const Columns&, const CompressedKeyLayout&, size_t, const int128_t*);
+
+} // namespace starrocks
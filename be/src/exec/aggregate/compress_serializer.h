@@ -0,0 +1,72 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "types/logical_type.h"
+
+namespace starrocks {
+
+// The value range and bit position of one group by column in a compressed key.
+struct CompressedKeyColumn {
+    LogicalType type = TYPE_UNKNOWN;
+    bool is_nullable = false;
+    // all the values of the column are in [min_value, max_value]
+    int64_t min_value = 0;
+    int64_t max_value = 0;
+    // bit offset of the column in the key, the lowest bit is the null flag if the column is nullable
+    uint32_t offset = 0;
+    // number of bits of (value - min_value)
+    uint32_t value_bits = 0;
+};
+
+// CompressedKeyLayout bit-packs several fixed-width group by columns into one uint32/uint64/int128 key,
+// each column takes log2(max_value - min_value + 1) bits plus a null flag bit if it's nullable.
+// Unlike the fixed size slice key, which is the byte-wise serialization of the columns, the packed key
+// doesn't waste any byte on null flags or on the unused high bits of small-range values,
+// e.g. low-cardinality dict codes or dates, so more multi-column group by could use an integer key.
+struct CompressedKeyLayout {
+    std::vector<CompressedKeyColumn> columns;
+    uint32_t total_bits = 0;
+
+    static constexpr uint32_t MAX_KEY_BITS = 128;
+
+    // Returns the value range of the type which could be packed in a compressed key,
+    // false if the type isn't supported.
+    static bool get_type_value_range(LogicalType type, int64_t* min_value, int64_t* max_value);
+
+    // Append a group by column with values in [min_value, max_value].
+    void add_column(LogicalType type, bool is_nullable, int64_t min_value, int64_t max_value);
+
+    bool fits() const { return total_bits <= MAX_KEY_BITS; }
+
+    // size of the integer key type in bytes: 4, 8 or 16
+    size_t key_bytes() const { return total_bits <= 32 ? 4 : (total_bits <= 64 ? 8 : 16); }
+};
+
+// pack the rows of key_columns into keys, KeyType is uint32_t, uint64_t or int128_t.
+template <typename KeyType>
+void bitcompress_serialize(const Columns& key_columns, const CompressedKeyLayout& layout, size_t num_rows,
+                           KeyType* keys);
+
+// unpack the keys and append the values into key_columns.
+template <typename KeyType>
+void bitcompress_deserialize(const Columns& key_columns, const CompressedKeyLayout& layout, size_t num_rows,
+                             const KeyType* keys);
+
+} // namespace starrocks
@@ -24,13 +24,16 @@
 #include "column/vectorized_fwd.h"
 #include "common/config.h"
 #include "common/status.h"
+#include "exec/aggregate/compress_serializer.h"
 #include "exec/exec_node.h"
 #include "exec/pipeline/operator.h"
 #include "exec/spill/spiller.hpp"
 #include "exprs/anyval_util.h"
+#include "exprs/column_ref.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/current_thread.h"
 #include "runtime/descriptors.h"
+#include "runtime/global_dict/types.h"
 #include "types/logical_type.h"
 #include "udf/java/utils.h"
 #include "util/runtime_profile.h"
@@ -67,8 +70,46 @@ bool AggrAutoContext::is_high_reduction(const size_t agg_count, const size_t chu
     return agg_count >= HighReduction * chunk_size;
 }
 
-bool AggrAutoContext::is_low_reduction(const size_t agg_count, const size_t chunk_size) {
-    return agg_count <= LowReduction * chunk_size;
+bool AggrAutoContext::is_low_reduction(const size_t agg_count, const size_t chunk_size, const size_t ht_bytes) {
+    const bool out_of_cache =
+            config::enable_streaming_agg_adaptive_reduction && ht_bytes > config::streaming_agg_ht_cache_size;
+    return agg_count <= (out_of_cache ? LowReductionOutOfCache : LowReduction) * chunk_size;
+}
+
+void AggrAutoContext::update_reduction(const size_t agg_count, const size_t chunk_size) {
+    if (chunk_size == 0) {
+        return;
+    }
+    double reduction = agg_count * 1.0 / chunk_size;
+    avg_reduction = avg_reduction < 0 ? reduction : ReductionDecay * reduction + (1 - ReductionDecay) * avg_reduction;
+}
+
+bool AggrAutoContext::has_low_avg_reduction(const size_t ht_bytes) const {
+    if (avg_reduction < 0) {
+        return false;
+    }
+    const bool out_of_cache = ht_bytes > config::streaming_agg_ht_cache_size;
+    return avg_reduction <= (out_of_cache ? LowReductionOutOfCache : LowReduction);
+}
+
+bool AggrAutoContext::has_high_avg_reduction() const {
+    return avg_reduction >= HighReduction;
+}
+
+bool AggrAutoContext::is_backpressured(const size_t ht_bytes) const {
+    // the downstream can't keep up with passing through, so spending CPU on aggregation is almost free
+    return config::enable_streaming_agg_adaptive_reduction && ht_bytes < MaxHtSize &&
+           backpressure_count >= std::max<size_t>(StableLimit, continuous_limit / 4);
+}
+
+bool AggrAutoContext::should_leave_preagg(const size_t ht_bytes) const {
+    return config::enable_streaming_agg_adaptive_reduction && preagg_count >= StableLimit &&
+           has_low_avg_reduction(ht_bytes);
+}
+
+bool AggrAutoContext::should_leave_selective_preagg(const size_t ht_bytes) const {
+    return config::enable_streaming_agg_adaptive_reduction && selective_preagg_count >= StableLimit &&
+           (has_low_avg_reduction(ht_bytes) || (has_high_avg_reduction() && ht_bytes < MaxHtSize));
 }
 
 Status init_udaf_context(int64_t fid, const std::string& url, const std::string& checksum, const std::string& symbol,
@@ -241,21 +282,37 @@ Status Aggregator::open(RuntimeState* state) {
             });
 
             DCHECK_GT(_agg_fn_ctxs.size(), 0);
-            _max_agg_state_align_size = std::max(_max_agg_state_align_size, _agg_functions[0]->alignof_size());
-            _agg_states_total_size += PAD(_agg_states_total_size, _agg_functions[0]->alignof_size());
-
-            // compute agg state total size and offsets
-            for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
-                _agg_states_offsets[i] = _agg_states_total_size;
-                _agg_states_total_size += _agg_functions[i]->size();
-                _max_agg_state_align_size = std::max(_max_agg_state_align_size, _agg_functions[i]->alignof_size());
-
-                // If not the last aggregate_state, we need pad it so that next aggregate_state will be aligned.
-                if (i + 1 < _agg_fn_ctxs.size()) {
-                    size_t next_state_align_size = _agg_functions[i + 1]->alignof_size();
-                    // Extend total_size to next alignment requirement
-                    // Add padding by rounding up '_agg_states_total_size' to be a multiplier of next_state_align_size.
-                    _agg_states_total_size = ALIGN_TO(_agg_states_total_size, next_state_align_size);
+            _use_columnar_agg_states = _should_use_columnar_agg_states();
+            if (_use_columnar_agg_states) {
+                // the row only holds the key and the group id, the states are in the columnar arrays
+                _agg_states_total_size = ALIGN_TO(_agg_states_total_size, alignof(uint32_t));
+                _group_id_offset = _agg_states_total_size;
+                _agg_states_total_size += sizeof(uint32_t);
+                _max_agg_state_align_size = std::max(_max_agg_state_align_size, alignof(uint32_t));
+                std::fill(_agg_states_offsets.begin(), _agg_states_offsets.end(), 0);
+                _columnar_agg_states.init(_agg_functions, _mem_pool.get());
+                _tmp_group_ids.resize(_state->chunk_size());
+                _tmp_columnar_agg_states.resize(_state->chunk_size());
+                _runtime_profile->add_info_string("ColumnarAggStates", "true");
+            } else {
+                _max_agg_state_align_size = std::max(_max_agg_state_align_size, _agg_functions[0]->alignof_size());
+                _agg_states_total_size += PAD(_agg_states_total_size, _agg_functions[0]->alignof_size());
+
+                // compute agg state total size and offsets
+                for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
+                    _agg_states_offsets[i] = _agg_states_total_size;
+                    _agg_states_total_size += _agg_functions[i]->size();
+                    _max_agg_state_align_size =
+                            std::max(_max_agg_state_align_size, _agg_functions[i]->alignof_size());
+
+                    // If not the last aggregate_state, we need pad it so that next aggregate_state will be aligned.
+                    if (i + 1 < _agg_fn_ctxs.size()) {
+                        size_t next_state_align_size = _agg_functions[i + 1]->alignof_size();
+                        // Extend total_size to next alignment requirement
+                        // Add padding by rounding up '_agg_states_total_size' to be a multiplier of
+                        // next_state_align_size.
+                        _agg_states_total_size = ALIGN_TO(_agg_states_total_size, next_state_align_size);
+                    }
                 }
             }
             _agg_states_total_size = ALIGN_TO(_agg_states_total_size, _max_agg_state_align_size);
@@ -542,6 +599,7 @@ Status Aggregator::_reset_state(RuntimeState* state, bool reset_sink_complete) {
     // _state_allocator holds the entries of the hash_map/hash_set, when iterating a hash_map/set, the _state_allocator
     // is used to access these entries, so we must reset the _state_allocator along with the hash_map/hash_set.
     _state_allocator.reset();
+    _columnar_agg_states.reset();
     return Status::OK();
 }
 
@@ -750,17 +808,21 @@ Status Aggregator::compute_batch_agg_states(Chunk* chunk, size_t chunk_size) {
     bool use_intermediate = _use_intermediate_as_input();
     auto& agg_expr_ctxs = use_intermediate ? _intermediate_agg_expr_ctxs : _agg_expr_ctxs;
 
+    if (_use_columnar_agg_states) {
+        _gather_group_ids(chunk_size);
+    }
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
         // evaluate arguments at i-th agg function
         RETURN_IF_ERROR(evaluate_agg_input_column(chunk, agg_expr_ctxs[i], i));
+        auto& agg_states = _agg_fn_states(i, chunk_size);
         // batch call update or merge
         if (!_is_merge_funcs[i] && !use_intermediate) {
             _agg_functions[i]->update_batch(_agg_fn_ctxs[i], chunk_size, _agg_states_offsets[i],
-                                            _agg_input_raw_columns[i].data(), _tmp_agg_states.data());
+                                            _agg_input_raw_columns[i].data(), agg_states.data());
         } else {
             DCHECK_GE(_agg_input_columns[i].size(), 1);
             _agg_functions[i]->merge_batch(_agg_fn_ctxs[i], _agg_input_columns[i][0]->size(), _agg_states_offsets[i],
-                                           _agg_input_columns[i][0].get(), _tmp_agg_states.data());
+                                           _agg_input_columns[i][0].get(), agg_states.data());
         }
     }
     RETURN_IF_ERROR(check_has_error());
@@ -772,18 +834,22 @@ Status Aggregator::compute_batch_agg_states_with_selection(Chunk* chunk, size_t
     bool use_intermediate = _use_intermediate_as_input();
     auto& agg_expr_ctxs = use_intermediate ? _intermediate_agg_expr_ctxs : _agg_expr_ctxs;
 
+    if (_use_columnar_agg_states) {
+        _gather_group_ids(chunk_size, &_streaming_selection);
+    }
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
         RETURN_IF_ERROR(evaluate_agg_input_column(chunk, agg_expr_ctxs[i], i));
+        auto& agg_states = _agg_fn_states(i, chunk_size);
 
         if (!_is_merge_funcs[i] && !use_intermediate) {
             _agg_functions[i]->update_batch_selectively(_agg_fn_ctxs[i], chunk_size, _agg_states_offsets[i],
-                                                        _agg_input_raw_columns[i].data(), _tmp_agg_states.data(),
+                                                        _agg_input_raw_columns[i].data(), agg_states.data(),
                                                         _streaming_selection);
         } else {
             DCHECK_GE(_agg_input_columns[i].size(), 1);
             _agg_functions[i]->merge_batch_selectively(_agg_fn_ctxs[i], _agg_input_columns[i][0]->size(),
                                                        _agg_states_offsets[i], _agg_input_columns[i][0].get(),
-                                                       _tmp_agg_states.data(), _streaming_selection);
+                                                       agg_states.data(), _streaming_selection);
         }
     }
     RETURN_IF_ERROR(check_has_error());
@@ -1045,24 +1111,59 @@ Columns Aggregator::_create_group_by_columns(size_t num_rows) {
 
 void Aggregator::_serialize_to_chunk(ConstAggDataPtr __restrict state, const Columns& agg_result_columns) {
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
-        _agg_functions[i]->serialize_to_column(_agg_fn_ctxs[i], state + _agg_states_offsets[i],
-                                               agg_result_columns[i].get());
+        _agg_functions[i]->serialize_to_column(_agg_fn_ctxs[i], _agg_fn_state(state, i), agg_result_columns[i].get());
     }
 }
 
 void Aggregator::_finalize_to_chunk(ConstAggDataPtr __restrict state, const Columns& agg_result_columns) {
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
-        _agg_functions[i]->finalize_to_column(_agg_fn_ctxs[i], state + _agg_states_offsets[i],
-                                              agg_result_columns[i].get());
+        _agg_functions[i]->finalize_to_column(_agg_fn_ctxs[i], _agg_fn_state(state, i), agg_result_columns[i].get());
     }
 }
 
 void Aggregator::_destroy_state(AggDataPtr __restrict state) {
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
-        _agg_functions[i]->destroy(_agg_fn_ctxs[i], state + _agg_states_offsets[i]);
+        _agg_functions[i]->destroy(_agg_fn_ctxs[i], _agg_fn_state(state, i));
+    }
+}
+
+bool Aggregator::_should_use_columnar_agg_states() const {
+    if (!config::enable_agg_columnar_states || !_support_columnar_agg_states || _group_by_expr_ctxs.empty() ||
+        _is_only_group_by_columns || _has_udaf) {
+        return false;
+    }
+    // Only the small POD states, e.g. the states of sum/count/min/max/avg, are worth being stored in arrays.
+    // The POD states needn't to be destroyed either, so the arrays are released along with the MemPool.
+    return std::all_of(_agg_functions.begin(), _agg_functions.end(), [](const AggregateFunction* func) {
+        return func->is_pod_state() && func->size() <= ColumnarAggStates::MAX_STATE_SIZE;
+    });
+}
+
+void Aggregator::_gather_group_ids(size_t num_rows, const std::vector<uint8_t>* selection) {
+    DCHECK(_use_columnar_agg_states);
+    if (_tmp_group_ids.size() < num_rows) {
+        _tmp_group_ids.resize(num_rows);
+        _tmp_columnar_agg_states.resize(num_rows);
+    }
+    uint32_t* group_ids = _tmp_group_ids.data();
+    for (size_t i = 0; i < num_rows; i++) {
+        // the states of the rows not selected aren't set by the hash map
+        if (selection != nullptr && (*selection)[i]) {
+            group_ids[i] = ColumnarAggStates::INVALID_GROUP_ID;
+        } else {
+            group_ids[i] = *reinterpret_cast<const uint32_t*>(_tmp_agg_states[i] + _group_id_offset);
+        }
     }
 }
 
+Buffer<AggDataPtr>& Aggregator::_agg_fn_states(size_t i, size_t num_rows) {
+    if (!_use_columnar_agg_states) {
+        return _tmp_agg_states;
+    }
+    _columnar_agg_states.gather(i, _tmp_group_ids.data(), num_rows, _tmp_columnar_agg_states.data());
+    return _tmp_columnar_agg_states;
+}
+
 ChunkPtr Aggregator::_build_output_chunk(const Columns& group_by_columns, const Columns& agg_result_columns,
                                          bool use_intermediate_as_output) {
     ChunkPtr result_chunk = std::make_shared<Chunk>();
@@ -1164,6 +1265,39 @@ bool is_group_columns_fixed_size(std::vector<ExprContext*>& group_by_expr_ctxs,
     return true;
 }
 
+// Build the layout to bit-pack the group by columns into an integer key, the value range of a column is the
+// domain of its type, or the range of the global dict codes if it's a low-cardinality string column.
+bool build_compressed_key_layout(RuntimeState* state, std::vector<ExprContext*>& group_by_expr_ctxs,
+                                 std::vector<ColumnType>& group_by_types, CompressedKeyLayout* layout) {
+    const auto& global_dicts = state->get_query_global_dict_map();
+    for (size_t i = 0; i < group_by_expr_ctxs.size(); i++) {
+        Expr* root = group_by_expr_ctxs[i]->root();
+        LogicalType ltype = root->type().type;
+        int64_t min_value = 0;
+        int64_t max_value = 0;
+        if (!CompressedKeyLayout::get_type_value_range(ltype, &min_value, &max_value)) {
+            return false;
+        }
+        if (ltype == TYPE_INT && root->is_slotref()) {
+            auto iter = global_dicts.find(root->get_column_ref()->slot_id());
+            if (iter != global_dicts.end() && !iter->second.second.empty()) {
+                // the data of a null row may be 0
+                min_value = 0;
+                max_value = 0;
+                for (const auto& [code, _] : iter->second.second) {
+                    min_value = std::min<int64_t>(min_value, code);
+                    max_value = std::max<int64_t>(max_value, code);
+                }
+            }
+        }
+        layout->add_column(ltype, group_by_types[i].is_nullable, min_value, max_value);
+        if (!layout->fits()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 #define CHECK_AGGR_PHASE_DEFAULT()                                                                                    \
     {                                                                                                                 \
         type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice : HashVariantType::Type::phase2_slice; \
@@ -1269,6 +1403,38 @@ void Aggregator::_init_agg_hash_variant(HashVariantType& hash_variant) {
             }
         }
     }
+
+    CompressedKeyLayout compressed_layout;
+    if (config::enable_agg_compressed_key && _group_by_expr_ctxs.size() > 1 &&
+        build_compressed_key_layout(_state, _group_by_expr_ctxs, _group_by_types, &compressed_layout)) {
+        size_t fixed_key_bytes = 0;
+        if (type == HashVariantType::Type::phase1_slice_fx4 || type == HashVariantType::Type::phase2_slice_fx4) {
+            fixed_key_bytes = 4;
+        } else if (type == HashVariantType::Type::phase1_slice_fx8 ||
+                   type == HashVariantType::Type::phase2_slice_fx8) {
+            fixed_key_bytes = 8;
+        } else if (type == HashVariantType::Type::phase1_slice_fx16 ||
+                   type == HashVariantType::Type::phase2_slice_fx16) {
+            fixed_key_bytes = 16;
+        }
+        // the fixed size slice key is used if it's as small as the compressed key, since it's cheaper to serialize
+        if (fixed_key_bytes == 0 || compressed_layout.key_bytes() < fixed_key_bytes) {
+            switch (compressed_layout.key_bytes()) {
+            case 4:
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice_cx4
+                                                 : HashVariantType::Type::phase2_slice_cx4;
+                break;
+            case 8:
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice_cx8
+                                                 : HashVariantType::Type::phase2_slice_cx8;
+                break;
+            default:
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice_cx16
+                                                 : HashVariantType::Type::phase2_slice_cx16;
+                break;
+            }
+        }
+    }
     VLOG_ROW << "hash type is "
              << static_cast<typename std::underlying_type<typename HashVariantType::Type>::type>(type);
     hash_variant.init(_state, type, _agg_stat);
@@ -1278,6 +1444,9 @@ void Aggregator::_init_agg_hash_variant(HashVariantType& hash_variant) {
             variant->has_null_column = has_null_column;
             variant->fixed_byte_size = fixed_byte_size;
         }
+        if constexpr (is_compressed_fixed_size_key<std::decay_t<decltype(*variant)>>) {
+            variant->layout = compressed_layout;
+        }
     });
 }
 
@@ -1357,11 +1526,21 @@ Status Aggregator::convert_hash_map_to_chunk(int32_t chunk_size, ChunkPtr* chunk
 
         {
             SCOPED_TIMER(_agg_stat->agg_append_timer);
+            if (_use_columnar_agg_states) {
+                _gather_group_ids(read_index);
+            }
             if (!use_intermediate) {
                 for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
-                    TRY_CATCH_BAD_ALLOC(_agg_functions[i]->batch_finalize(_agg_fn_ctxs[i], read_index, _tmp_agg_states,
-                                                                          _agg_states_offsets[i],
-                                                                          agg_result_columns[i].get()));
+                    TRY_CATCH_BAD_ALLOC(_agg_functions[i]->batch_finalize(
+                            _agg_fn_ctxs[i], read_index, _agg_fn_states(i, read_index), _agg_states_offsets[i],
+                            agg_result_columns[i].get()));
+                }
+            } else if (_use_columnar_agg_states) {
+                // the groups are output in the allocation order, so their states are mostly contiguous
+                for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+                    TRY_CATCH_BAD_ALLOC(_columnar_agg_states.serialize(_agg_functions[i], _agg_fn_ctxs[i], i,
+                                                                       _tmp_group_ids.data(), read_index,
+                                                                       agg_result_columns[i].get()));
                 }
             } else {
                 for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
@@ -1498,17 +1677,13 @@ void Aggregator::_release_agg_memory() {
         if (hash_map_with_key != nullptr && !skip_destroy) {
             auto null_data_ptr = hash_map_with_key->get_null_key_data();
             if (null_data_ptr != nullptr) {
-                for (int i = 0; i < _agg_functions.size(); i++) {
-                    _agg_functions[i]->destroy(_agg_fn_ctxs[i], null_data_ptr + _agg_states_offsets[i]);
-                }
+                _destroy_state(null_data_ptr);
             }
             auto it = _state_allocator.begin();
             auto end = _state_allocator.end();
 
             while (it != end) {
-                for (int i = 0; i < _agg_functions.size(); i++) {
-                    _agg_functions[i]->destroy(_agg_fn_ctxs[i], it.value() + _agg_states_offsets[i]);
-                }
+                _destroy_state(it.value());
                 it.next();
             }
         }
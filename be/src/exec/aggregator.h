@@ -31,6 +31,7 @@
 #include "common/statusor.h"
 #include "exec/aggregate/agg_hash_variant.h"
 #include "exec/aggregate/agg_profile.h"
+#include "exec/aggregate/columnar_agg_states.h"
 #include "exec/chunk_buffer_memory_manager.h"
 #include "exec/pipeline/context_with_dependency.h"
 #include "exec/pipeline/spill_process_channel.h"
@@ -169,11 +170,26 @@ struct AggrAutoContext {
     static constexpr double HighReduction = 0.9;
     static constexpr size_t MaxHtSize = 64 * 1024 * 1024; // 64 MB
     static constexpr int StableLimit = 5;
+    // Once the hash table outgrows the last level cache, almost every probe is a cache miss, so a chunk is
+    // considered lowly aggregated below this higher reduction.
+    static constexpr double LowReductionOutOfCache = 0.4;
+    // weight of the latest chunk in the moving average of the reduction
+    static constexpr double ReductionDecay = 0.3;
     std::string get_auto_state_string(const AggrAutoState& state);
     size_t get_continuous_limit();
     void update_continuous_limit();
     bool is_high_reduction(const size_t agg_count, const size_t chunk_size);
-    bool is_low_reduction(const size_t agg_count, const size_t chunk_size);
+    bool is_low_reduction(const size_t agg_count, const size_t chunk_size, const size_t ht_bytes);
+    // Update the moving average of the reduction with a chunk of which agg_count rows hit the existing groups.
+    void update_reduction(const size_t agg_count, const size_t chunk_size);
+    bool has_low_avg_reduction(const size_t ht_bytes) const;
+    bool has_high_avg_reduction() const;
+    // The PASS_THROUGH state aggregates again once the chunk buffer has been kept full by the downstream.
+    bool is_backpressured(const size_t ht_bytes) const;
+    // The PREAGG state shifts to ADJUST early once the stream turns to be lowly aggregated.
+    bool should_leave_preagg(const size_t ht_bytes) const;
+    // The SELECTIVE_PREAGG state shifts to ADJUST early once the reduction becomes low or high.
+    bool should_leave_selective_preagg(const size_t ht_bytes) const;
     size_t init_preagg_count = 0;
     size_t adjust_count = 0;
     size_t pass_through_count = 0;
@@ -181,6 +197,10 @@ struct AggrAutoContext {
     size_t preagg_count = 0;
     size_t selective_preagg_count = 0;
     size_t continuous_limit = 100;
+    // the number of PASS_THROUGH chunks after which the chunk buffer is full, i.e. the downstream can't keep up
+    size_t backpressure_count = 0;
+    // moving average of the ratio of input rows hitting the existing groups, negative if not sampled yet
+    double avg_reduction = -1;
 };
 
 struct StreamingHtMinReductionEntry {
@@ -447,6 +467,14 @@ protected:
     size_t _agg_states_total_size = 0;
     // The max align size for all aggregate state
     size_t _max_agg_state_align_size = 1;
+    // Whether the agg states of the hash map are stored in _columnar_agg_states, then a row of _state_allocator
+    // holds the group by key and the group id only, and all the _agg_states_offsets are 0.
+    bool _use_columnar_agg_states = false;
+    // The subclasses managing the agg states by themselves don't support the columnar agg states.
+    bool _support_columnar_agg_states = true;
+    // The offset of the group id in a row of _state_allocator, only for the columnar agg states.
+    size_t _group_id_offset = 0;
+    ColumnarAggStates _columnar_agg_states;
     // The followings are aggregate function information:
     std::vector<FunctionContext*> _agg_fn_ctxs;
     std::vector<const AggregateFunction*> _agg_functions;
@@ -465,6 +493,9 @@ protected:
     std::vector<bool> _is_merge_funcs;
     // In order batch update agg states
     Buffer<AggDataPtr> _tmp_agg_states;
+    // The group ids of _tmp_agg_states and the columnar states of an agg function of them
+    std::vector<uint32_t> _tmp_group_ids;
+    Buffer<AggDataPtr> _tmp_columnar_agg_states;
     std::vector<AggFunctionTypes> _agg_fn_types;
 
     // Exprs used to evaluate conjunct
@@ -535,6 +566,21 @@ protected:
     Columns _create_agg_result_columns(size_t num_rows, bool use_intermediate);
     Columns _create_group_by_columns(size_t num_rows);
 
+    // The state of the i-th agg function of a row of _state_allocator, or of _single_agg_state.
+    AggDataPtr _agg_fn_state(ConstAggDataPtr row, size_t i) const {
+        if (_use_columnar_agg_states) {
+            return _columnar_agg_states.state(i, *reinterpret_cast<const uint32_t*>(row + _group_id_offset));
+        }
+        return const_cast<AggDataPtr>(row) + _agg_states_offsets[i];
+    }
+    bool _should_use_columnar_agg_states() const;
+    // Gather the group ids of the first num_rows rows in _tmp_agg_states, skipping the rows not selected
+    // if selection isn't null.
+    void _gather_group_ids(size_t num_rows, const std::vector<uint8_t>* selection = nullptr);
+    // The states of the i-th agg function of the first num_rows rows in _tmp_agg_states to pass to the function
+    // along with _agg_states_offsets[i], the group ids must have been gathered for the columnar agg states.
+    Buffer<AggDataPtr>& _agg_fn_states(size_t i, size_t num_rows);
+
     void _serialize_to_chunk(ConstAggDataPtr __restrict state, const Columns& agg_result_columns);
     void _finalize_to_chunk(ConstAggDataPtr __restrict state, const Columns& agg_result_columns);
     void _destroy_state(AggDataPtr __restrict state);
@@ -567,18 +613,27 @@ inline AggDataPtr AllocateState<HashMapWithKey>::operator()(const typename HashM
     AggDataPtr agg_state = aggregator->_state_allocator.allocate();
     *reinterpret_cast<typename HashMapWithKey::KeyType*>(agg_state) = key;
     size_t created = 0;
+    bool group_allocated = false;
     size_t aggregate_function_sz = aggregator->_agg_fn_ctxs.size();
     try {
+        if (aggregator->_use_columnar_agg_states) {
+            *reinterpret_cast<uint32_t*>(agg_state + aggregator->_group_id_offset) =
+                    aggregator->_columnar_agg_states.allocate();
+            group_allocated = true;
+        }
         for (int i = 0; i < aggregate_function_sz; i++) {
             aggregator->_agg_functions[i]->create(aggregator->_agg_fn_ctxs[i],
-                                                  agg_state + aggregator->_agg_states_offsets[i]);
+                                                  aggregator->_agg_fn_state(agg_state, i));
             created++;
         }
         return agg_state;
     } catch (std::bad_alloc& e) {
         for (size_t i = 0; i < created; ++i) {
             aggregator->_agg_functions[i]->destroy(aggregator->_agg_fn_ctxs[i],
-                                                   agg_state + aggregator->_agg_states_offsets[i]);
+                                                   aggregator->_agg_fn_state(agg_state, i));
+        }
+        if (group_allocated) {
+            aggregator->_columnar_agg_states.rollback();
         }
         aggregator->_state_allocator.rollback();
         throw;
@@ -589,18 +644,27 @@ template <class HashMapWithKey>
 inline AggDataPtr AllocateState<HashMapWithKey>::operator()(std::nullptr_t) {
     AggDataPtr agg_state = aggregator->_state_allocator.allocate_null_key_data();
     size_t created = 0;
+    bool group_allocated = false;
     size_t aggregate_function_sz = aggregator->_agg_fn_ctxs.size();
     try {
+        if (aggregator->_use_columnar_agg_states) {
+            *reinterpret_cast<uint32_t*>(agg_state + aggregator->_group_id_offset) =
+                    aggregator->_columnar_agg_states.allocate();
+            group_allocated = true;
+        }
         for (int i = 0; i < aggregate_function_sz; i++) {
             aggregator->_agg_functions[i]->create(aggregator->_agg_fn_ctxs[i],
-                                                  agg_state + aggregator->_agg_states_offsets[i]);
+                                                  aggregator->_agg_fn_state(agg_state, i));
             created++;
         }
         return agg_state;
     } catch (std::bad_alloc& e) {
         for (int i = 0; i < created; i++) {
             aggregator->_agg_functions[i]->destroy(aggregator->_agg_fn_ctxs[i],
-                                                   agg_state + aggregator->_agg_states_offsets[i]);
+                                                   aggregator->_agg_fn_state(agg_state, i));
+        }
+        if (group_allocated) {
+            aggregator->_columnar_agg_states.rollback();
         }
         throw;
     }
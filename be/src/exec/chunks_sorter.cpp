@@ -18,6 +18,7 @@
 
 #include "column/column_helper.h"
 #include "column/type_traits.h"
+#include "exec/sorting/sort_helper.h"
 #include "exec/sorting/sort_permute.h"
 #include "exprs/expr.h"
 #include "gutil/casts.h"
@@ -160,6 +161,77 @@ void ChunksSorter::setup_runtime(RuntimeState* state, RuntimeProfile* profile, M
     _output_timer = ADD_TIMER(profile, "OutputTime");
     profile->add_info_string("SortKeys", _sort_keys);
     profile->add_info_string("SortType", _is_topn ? "TopN" : "All");
+    if (_shared_topn_threshold != nullptr) {
+        _shared_topn_filter_rows = ADD_COUNTER(profile, "SharedTopnFilterRows", TUnit::UNIT);
+    }
+}
+
+bool ChunksSorter::_refresh_shared_topn_threshold() {
+    if (_shared_topn_threshold == nullptr) {
+        return false;
+    }
+    if (_shared_topn_threshold->get(&_shared_topn_threshold_version, &_shared_topn_threshold_columns)) {
+        // the datums refer to the threshold columns, which are never modified once published
+        _shared_topn_threshold_values.clear();
+        for (const auto& column : _shared_topn_threshold_columns) {
+            _shared_topn_threshold_values.emplace_back(column->get(0));
+        }
+    }
+    return !_shared_topn_threshold_columns.empty();
+}
+
+int ChunksSorter::_compare_with_shared_topn_threshold(const Columns& order_by_columns, size_t row_id) const {
+    DCHECK(!_shared_topn_threshold_columns.empty());
+    return compare_chunk_row(_sort_desc, order_by_columns, _shared_topn_threshold_columns, row_id, 0);
+}
+
+void ChunksSorter::_compare_with_shared_topn_threshold(const Columns& order_by_columns,
+                                                       CompareVector* cmp_result) const {
+    DCHECK(!_shared_topn_threshold_values.empty());
+    cmp_result->assign(order_by_columns[0]->size(), 0);
+    compare_columns(order_by_columns, *cmp_result, _shared_topn_threshold_values, _sort_desc);
+}
+
+void ChunksSorter::_publish_shared_topn_threshold(const Columns& order_by_columns, size_t row_id) {
+    if (_shared_topn_threshold == nullptr) {
+        return;
+    }
+    if (_refresh_shared_topn_threshold() && _compare_with_shared_topn_threshold(order_by_columns, row_id) >= 0) {
+        return;
+    }
+    _shared_topn_threshold->update(order_by_columns, row_id);
+}
+
+void SharedTopnThreshold::update(const Columns& order_by_columns, size_t row_id) {
+    for (const auto& column : order_by_columns) {
+        if (column->is_constant()) {
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> l(_mutex);
+    if (!_threshold.empty() && compare_chunk_row(_sort_desc, order_by_columns, _threshold, row_id, 0) >= 0) {
+        return;
+    }
+    Columns threshold;
+    threshold.reserve(order_by_columns.size());
+    for (const auto& column : order_by_columns) {
+        auto row = column->clone_empty();
+        row->append(*column, row_id, 1);
+        threshold.emplace_back(std::move(row));
+    }
+    _threshold = std::move(threshold);
+    _version.fetch_add(1, std::memory_order_release);
+}
+
+bool SharedTopnThreshold::get(int64_t* version, Columns* threshold) const {
+    if (_version.load(std::memory_order_acquire) == *version) {
+        return false;
+    }
+    std::lock_guard<std::mutex> l(_mutex);
+    *version = _version.load(std::memory_order_relaxed);
+    *threshold = _threshold;
+    return true;
 }
 
 StatusOr<ChunkPtr> ChunksSorter::materialize_chunk_before_sort(Chunk* chunk, TupleDescriptor* materialized_tuple_desc,
@@ -14,7 +14,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 #include "column/column_helper.h"
 #include "column/vectorized_fwd.h"
@@ -91,6 +94,30 @@ using ChunksSorterPtr = std::shared_ptr<ChunksSorter>;
 using ChunksSorters = std::vector<ChunksSorterPtr>;
 
 // Sort Chunks in memory with specified order by rules.
+// SharedTopnThreshold is the boundary of a top-n shared by the sorters of all the drivers whose outputs are merged
+// into one top-n. Each sorter publishes its own (offset + limit)-th row once it has that many rows, and any row
+// succeeding the tightest published boundary can't be in the global top-n, so it could be dropped by every sorter
+// and by the scan through the runtime filter, even if the sorter itself hasn't seen enough rows yet.
+class SharedTopnThreshold {
+public:
+    explicit SharedTopnThreshold(const SortDescs& sort_desc) : _sort_desc(sort_desc) {}
+
+    // Publish the row_id-th row of order_by_columns, it's kept only if it precedes the current threshold.
+    void update(const Columns& order_by_columns, size_t row_id);
+
+    // Copy the one-row columns of the threshold into *threshold if it has been updated after *version,
+    // returns false if nothing changed.
+    bool get(int64_t* version, Columns* threshold) const;
+
+private:
+    const SortDescs _sort_desc;
+    mutable std::mutex _mutex;
+    // one row of the order by columns, empty until the first update
+    Columns _threshold;
+    std::atomic<int64_t> _version = 0;
+};
+using SharedTopnThresholdPtr = std::shared_ptr<SharedTopnThreshold>;
+
 class ChunksSorter {
 public:
     static constexpr int USE_HEAP_SORTER_LIMIT_SZ = 1024;
@@ -129,9 +156,19 @@ public:
     // get_next only works after done().
     [[nodiscard]] virtual Status get_next(ChunkPtr* chunk, bool* eos) = 0;
 
+    // Provides the chunks of a sorted run, returns false if no data is ready, see merge_path::MergePathChunkProvider.
+    using SortedRunProvider = std::function<bool(bool only_check_if_has_data, ChunkPtr* chunk, bool* eos)>;
+    // Returns a provider per spilled sorted run, which are merged in parallel by the caller instead of being merged
+    // into one stream by get_next. Only works in the spillable full sorter whose spiller restores by sorted runs,
+    // and returns empty otherwise, e.g. the spiller has too many runs, which are then restored by get_next.
+    virtual std::vector<SortedRunProvider> spilled_sorted_run_providers() { return {}; }
+
     // RuntimeFilter generate by ChunkSorter only works in TopNSorter and HeapSorter
     virtual std::vector<JoinRuntimeFilter*>* runtime_filters(ObjectPool* pool) { return nullptr; }
 
+    // Share the top-n threshold with the sorters of the other drivers, only works in TopNSorter and HeapSorter.
+    void set_shared_topn_threshold(SharedTopnThresholdPtr threshold) { _shared_topn_threshold = std::move(threshold); }
+
     // Return accurate output rows of this operator
     virtual size_t get_output_rows() const = 0;
 
@@ -155,6 +192,17 @@ public:
 protected:
     size_t _get_number_of_order_by_columns() const { return _sort_exprs->size(); }
 
+    // Refresh the local copy of the shared top-n threshold, returns false if no threshold has been published.
+    bool _refresh_shared_topn_threshold();
+    // Returns > 0 if the row_id-th row of order_by_columns succeeds the local copy of the shared threshold,
+    // i.e. the threshold is tighter than the row, which must have been refreshed.
+    int _compare_with_shared_topn_threshold(const Columns& order_by_columns, size_t row_id) const;
+    // Compare every row of order_by_columns with the local copy of the shared threshold into cmp_result.
+    void _compare_with_shared_topn_threshold(const Columns& order_by_columns, CompareVector* cmp_result) const;
+    // Publish the row_id-th row of order_by_columns as the boundary of this sorter if it's tighter than the
+    // shared threshold known by this sorter, so the lock is seldom taken.
+    void _publish_shared_topn_threshold(const Columns& order_by_columns, size_t row_id);
+
     RuntimeState* _state;
 
     // sort rules
@@ -169,6 +217,12 @@ protected:
     RuntimeProfile::Counter* _sort_timer = nullptr;
     RuntimeProfile::Counter* _merge_timer = nullptr;
     RuntimeProfile::Counter* _output_timer = nullptr;
+    RuntimeProfile::Counter* _shared_topn_filter_rows = nullptr;
+
+    SharedTopnThresholdPtr _shared_topn_threshold;
+    int64_t _shared_topn_threshold_version = 0;
+    Columns _shared_topn_threshold_columns;
+    std::vector<Datum> _shared_topn_threshold_values;
 
     size_t _revocable_mem_bytes = 0;
     spill::SpillStrategy _spill_strategy = spill::SpillStrategy::NO_SPILL;
@@ -43,6 +43,13 @@ Status ChunksSorterHeapSort::update(RuntimeState* state, const ChunkPtr& chunk)
     chunk_holder->ref();
     DeferOp defer([&] { chunk_holder->unref(); });
     int row_sz = chunk_holder->value()->chunk->num_rows();
+    if (_use_shared_threshold()) {
+        row_sz = _filter_data_by_shared_threshold(chunk_holder, row_sz);
+        if (row_sz == 0) {
+            return Status::OK();
+        }
+    }
+
     if (_sort_heap == nullptr) {
         _sort_heap = std::make_unique<CommonCursorSortHeap>(detail::ChunkCursorComparator(_sort_desc));
         // avoid exaggerated limit + offset, for an example select * from t order by col limit 9223372036854775800,1
@@ -108,10 +115,44 @@ Status ChunksSorterHeapSort::update(RuntimeState* state, const ChunkPtr& chunk)
             }
         }
     }
+    // publish the heap top to the sorters of the other drivers once the heap is full
+    if (_sort_heap->size() == _number_of_rows_to_sort()) {
+        const auto& top_cursor = _sort_heap->top();
+        _publish_shared_topn_threshold(top_cursor.data_segment()->order_by_columns, top_cursor.row_id());
+    }
     // TODO: merge chunk if necessary
     return Status::OK();
 }
 
+bool ChunksSorterHeapSort::_use_shared_threshold() {
+    if (!_refresh_shared_topn_threshold()) {
+        return false;
+    }
+    if (_sort_heap == nullptr || _sort_heap->size() < _number_of_rows_to_sort()) {
+        return true;
+    }
+    const auto& top_cursor = _sort_heap->top();
+    return _compare_with_shared_topn_threshold(top_cursor.data_segment()->order_by_columns, top_cursor.row_id()) > 0;
+}
+
+int ChunksSorterHeapSort::_filter_data_by_shared_threshold(detail::ChunkHolder* chunk_holder, int row_sz) {
+    ScopedTimer<MonotonicStopWatch> timer(_sort_filter_costs);
+    CompareVector cmp_result;
+    _compare_with_shared_topn_threshold(chunk_holder->value()->order_by_columns, &cmp_result);
+
+    // Any other driver has got (offset + limit) rows not succeeding the threshold, so the rows equal to the
+    // threshold are not needed for the row number top-n either, the same as the rows equal to the heap top.
+    Filter filter(row_sz);
+    for (int i = 0; i < row_sz; ++i) {
+        filter[i] = cmp_result[i] < 0;
+    }
+    int rows_afterfilter_sz = chunk_holder->value()->chunk->filter(filter);
+    if (_shared_topn_filter_rows != nullptr) {
+        COUNTER_UPDATE(_shared_topn_filter_rows, row_sz - rows_afterfilter_sz);
+    }
+    return rows_afterfilter_sz;
+}
+
 size_t ChunksSorterHeapSort::get_output_rows() const {
     return _merged_segment.chunk->num_rows();
 }
@@ -161,18 +202,26 @@ Status ChunksSorterHeapSort::get_next(ChunkPtr* chunk, bool* eos) {
 }
 
 std::vector<JoinRuntimeFilter*>* ChunksSorterHeapSort::runtime_filters(ObjectPool* pool) {
-    if (_sort_heap == nullptr || _sort_heap->size() < _number_of_rows_to_sort()) {
-        return nullptr;
-    }
+    ColumnPtr top_cursor_column;
+    int cursor_rid;
+    if (_use_shared_threshold()) {
+        // the threshold published by the other drivers is tighter
+        top_cursor_column = _shared_topn_threshold_columns[0];
+        cursor_rid = 0;
+    } else {
+        if (_sort_heap == nullptr || _sort_heap->size() < _number_of_rows_to_sort()) {
+            return nullptr;
+        }
 
-    // avoid limit 0
-    if (_sort_heap->empty()) {
-        return nullptr;
-    }
+        // avoid limit 0
+        if (_sort_heap->empty()) {
+            return nullptr;
+        }
 
-    const auto& top_cursor = _sort_heap->top();
-    const int cursor_rid = top_cursor.row_id();
-    const auto& top_cursor_column = top_cursor.data_segment()->order_by_columns[0];
+        const auto& top_cursor = _sort_heap->top();
+        cursor_rid = top_cursor.row_id();
+        top_cursor_column = top_cursor.data_segment()->order_by_columns[0];
+    }
     bool is_close_interval = _sort_desc.num_columns() != 1;
 
     if (_runtime_filter.empty()) {
@@ -261,6 +261,11 @@ private:
     template <LogicalType TYPE>
     void _do_filter_data_for_type(detail::ChunkHolder* chunk_holder, Filter* filter, int row_sz);
 
+    // Whether the threshold shared by the other drivers is tighter than the heap top.
+    bool _use_shared_threshold();
+    // Filter out the rows not preceding the threshold shared by the other drivers.
+    int _filter_data_by_shared_threshold(detail::ChunkHolder* chunk_holder, int row_sz);
+
     std::vector<JoinRuntimeFilter*> _runtime_filter;
 
     using CursorContainer = std::vector<detail::ChunkRowCursor>;
@@ -108,19 +108,25 @@ Status ChunksSorterTopn::do_done(RuntimeState* state) {
 }
 
 std::vector<JoinRuntimeFilter*>* ChunksSorterTopn::runtime_filters(ObjectPool* pool) {
-    if (!_init_merged_segment) {
-        return nullptr;
-    }
-
     const size_t max_value_row_id = _get_number_of_rows_to_sort() - 1;
-    const auto& order_by_column = _merged_segment.order_by_columns[0];
-
     // if we want build runtime filter,
     // we should reserve at least "rows_to_sort" rows
-    if (max_value_row_id >= order_by_column->size()) {
+    const bool has_boundary = _init_merged_segment && max_value_row_id < _merged_segment.chunk->num_rows();
+
+    ColumnPtr order_by_column;
+    size_t current_max_value_row_id;
+    if (_refresh_shared_topn_threshold() &&
+        (!has_boundary ||
+         _compare_with_shared_topn_threshold(_merged_segment.order_by_columns, max_value_row_id) > 0)) {
+        // the threshold published by the other drivers is tighter
+        order_by_column = _shared_topn_threshold_columns[0];
+        current_max_value_row_id = 0;
+    } else if (has_boundary) {
+        order_by_column = _merged_segment.order_by_columns[0];
+        current_max_value_row_id = _topn_type == TTopNType::RANK ? order_by_column->size() - 1 : max_value_row_id;
+    } else {
         return nullptr;
     }
-    size_t current_max_value_row_id = _topn_type == TTopNType::RANK ? order_by_column->size() - 1 : max_value_row_id;
     // _topn_type != TTopNType::RANK means we need reserve the max_value
     bool is_close_interval = _topn_type == TTopNType::RANK || _sort_desc.num_columns() != 1;
 
@@ -184,9 +190,34 @@ Status ChunksSorterTopn::_sort_chunks(RuntimeState* state) {
     // the second ordered group contains both permutations.second and _merged_segment
     RETURN_IF_ERROR(_merge_sort_data_as_merged_segment(state, permutations, segments));
 
+    // Step 4: publish the boundary of this sorter to the sorters of the other drivers
+    const size_t rows_to_sort = _get_number_of_rows_to_sort();
+    if (_init_merged_segment && _merged_segment.chunk->num_rows() >= rows_to_sort) {
+        _publish_shared_topn_threshold(_merged_segment.order_by_columns, rows_to_sort - 1);
+    }
+
     return Status::OK();
 }
 
+bool ChunksSorterTopn::_compare_with_shared_threshold(const DataSegments& segments,
+                                                      std::vector<CompareVector>* cmp_results) {
+    if (!_refresh_shared_topn_threshold()) {
+        return false;
+    }
+    const size_t rows_to_sort = _get_number_of_rows_to_sort();
+    if (_init_merged_segment && _merged_segment.chunk->num_rows() >= rows_to_sort &&
+        _compare_with_shared_topn_threshold(_merged_segment.order_by_columns, rows_to_sort - 1) <= 0) {
+        return false;
+    }
+
+    SCOPED_TIMER(_sort_filter_timer);
+    cmp_results->resize(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+        _compare_with_shared_topn_threshold(segments[i].order_by_columns, &(*cmp_results)[i]);
+    }
+    return true;
+}
+
 Status ChunksSorterTopn::_build_sorting_data(RuntimeState* state, Permutation& permutation_second,
                                              DataSegments& segments) {
     SCOPED_TIMER(_build_timer);
@@ -212,14 +243,27 @@ Status ChunksSorterTopn::_build_sorting_data(RuntimeState* state, Permutation& p
         // This time, just initialized permutations.second.
         permutation_second.resize(row_count);
 
+        // The rows succeeding the threshold shared by the other drivers are dropped.
+        std::vector<CompareVector> shared_cmp_results;
+        const bool use_shared_threshold = _compare_with_shared_threshold(segments, &shared_cmp_results);
+
         uint32_t perm_index = 0;
         for (uint32_t i = 0; i < segments.size(); ++i) {
             uint32_t num = segments[i].chunk->num_rows();
             for (uint32_t j = 0; j < num; ++j) {
+                if (use_shared_threshold && shared_cmp_results[i][j] > 0) {
+                    continue;
+                }
                 permutation_second[perm_index] = {i, j};
                 ++perm_index;
             }
         }
+        if (use_shared_threshold) {
+            permutation_second.resize(perm_index);
+            if (_shared_topn_filter_rows) {
+                COUNTER_UPDATE(_shared_topn_filter_rows, row_count - perm_index);
+            }
+        }
     }
 
     return Status::OK();
@@ -295,6 +339,30 @@ Status ChunksSorterTopn::_filter_and_sort_data(RuntimeState* state, std::pair<Pe
                     _merged_segment.get_filter_array(segments, 1, filter_array, _sort_desc, smaller_num, include_num));
         }
 
+        // Drop the rows succeeding the threshold shared by the other drivers if it's tighter than ours.
+        std::vector<CompareVector> shared_cmp_results;
+        if (_compare_with_shared_threshold(segments, &shared_cmp_results)) {
+            size_t shared_filtered_rows = 0;
+            for (size_t i = 0; i < segments.size(); ++i) {
+                for (size_t j = 0; j < filter_array[i].size(); ++j) {
+                    if (shared_cmp_results[i][j] <= 0) {
+                        continue;
+                    }
+                    if (filter_array[i][j] == DataSegment::SMALLER_THAN_MIN_OF_SEGMENT) {
+                        --smaller_num;
+                        ++shared_filtered_rows;
+                    } else if (filter_array[i][j] == DataSegment::INCLUDE_IN_SEGMENT) {
+                        --include_num;
+                        ++shared_filtered_rows;
+                    }
+                    filter_array[i][j] = DataSegment::LARGER_THAN_MAX_OF_SEGMENT;
+                }
+            }
+            if (_shared_topn_filter_rows) {
+                COUNTER_UPDATE(_shared_topn_filter_rows, shared_filtered_rows);
+            }
+        }
+
         size_t filtered_rows = 0;
         for (auto& segment : segments) {
             filtered_rows += segment.chunk->num_rows();
@@ -369,8 +437,9 @@ Status ChunksSorterTopn::_merge_sort_data_as_merged_segment(RuntimeState* state,
 
     if (_init_merged_segment) {
         RETURN_IF_ERROR(_hybrid_sort_common(state, new_permutation, segments));
-    } else {
+    } else if (!new_permutation.second.empty()) {
         // The first batch chunks, just new_permutation.second.
+        // It may be empty if all the rows are dropped by the shared threshold.
         RETURN_IF_ERROR(_hybrid_sort_first_time(state, new_permutation.second, segments));
         _init_merged_segment = true;
     }
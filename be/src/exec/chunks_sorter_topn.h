@@ -110,6 +110,10 @@ private:
                                                             std::pair<Permutation, Permutation>& new_permutation,
                                                             DataSegments& segments);
 
+    // Compare the rows of segments with the shared threshold if it's tighter than the boundary of this sorter,
+    // returns false if the shared threshold couldn't prune more rows than the boundary of this sorter.
+    bool _compare_with_shared_threshold(const DataSegments& segments, std::vector<CompareVector>* cmp_results);
+
     [[nodiscard]] Status _partial_sort_col_wise(RuntimeState* state, std::pair<Permutation, Permutation>& permutations,
                                                 DataSegments& segments);
 
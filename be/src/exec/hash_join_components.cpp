@@ -16,6 +16,8 @@
 
 #include "column/vectorized_fwd.h"
 #include "exec/hash_joiner.h"
+#include "util/defer_op.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -86,10 +88,26 @@ Status HashJoinBuilder::append_chunk(RuntimeState* state, const ChunkPtr& chunk)
     return Status::OK();
 }
 
-Status HashJoinBuilder::build(RuntimeState* state) {
-    SCOPED_TIMER(_hash_joiner.build_metrics().build_ht_timer);
-    TRY_CATCH_BAD_ALLOC(RETURN_IF_ERROR(_ht.build(state)));
-    _ready = true;
+Status HashJoinBuilder::build(RuntimeState* state, JoinBuildCallback callback) {
+    auto* build_ht_timer = _hash_joiner.build_metrics().build_ht_timer;
+    const int64_t start_ns = MonotonicNanos();
+    JoinBuildCallback on_finish = nullptr;
+    if (callback != nullptr) {
+        on_finish = [this, build_ht_timer, start_ns, callback = std::move(callback)](const Status& status) {
+            COUNTER_UPDATE(build_ht_timer, MonotonicNanos() - start_ns);
+            _ready = status.ok();
+            callback(status);
+        };
+    }
+    DeferOp update_timer([&]() {
+        if (!_ht.is_build_async()) {
+            COUNTER_UPDATE(build_ht_timer, MonotonicNanos() - start_ns);
+        }
+    });
+    TRY_CATCH_BAD_ALLOC(RETURN_IF_ERROR(_ht.build(state, std::move(on_finish))));
+    if (!_ht.is_build_async()) {
+        _ready = true;
+    }
     return Status::OK();
 }
 
@@ -61,7 +61,8 @@ public:
 
     Status append_chunk(RuntimeState* state, const ChunkPtr& chunk);
 
-    Status build(RuntimeState* state);
+    // See JoinHashTable::build.
+    Status build(RuntimeState* state, JoinBuildCallback callback = nullptr);
 
     size_t hash_table_row_count() { return _ht.get_row_count(); }
 
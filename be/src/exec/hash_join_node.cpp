@@ -22,6 +22,7 @@
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exec/hash_joiner.h"
 #include "exec/pipeline/chunk_accumulate_operator.h"
 #include "exec/pipeline/exchange/exchange_source_operator.h"
@@ -918,12 +919,20 @@ Status HashJoinNode::_do_publish_runtime_filters(RuntimeState* state, int64_t li
         JoinRuntimeFilter* filter = RuntimeFilterHelper::create_runtime_bloom_filter(_pool, build_type);
         if (filter == nullptr) continue;
         filter->set_join_mode(rf_desc->join_mode());
-        filter->init(_ht.get_row_count());
         int expr_order = rf_desc->build_expr_order();
         ColumnPtr column = _ht.get_key_columns()[expr_order];
         bool eq_null = _is_null_safes[expr_order];
+        size_t ndv = _ht.get_row_count();
+        if (config::enable_adaptive_runtime_bloom_filter) {
+            ndv = std::min(ndv, RuntimeFilterHelper::estimate_runtime_bloom_filter_ndv({column}, build_type,
+                                                                                      kHashJoinKeyColumnOffset));
+        }
+        filter->init(ndv);
         RETURN_IF_ERROR(RuntimeFilterHelper::fill_runtime_bloom_filter(column, build_type, filter,
                                                                        kHashJoinKeyColumnOffset, eq_null));
+        if (config::enable_adaptive_runtime_bloom_filter) {
+            filter->use_min_max_only_if_dense(ndv);
+        }
         rf_desc->set_runtime_filter(filter);
     }
 
@@ -23,12 +23,16 @@
 #include "column/vectorized_fwd.h"
 #include "common/statusor.h"
 #include "exec/hash_join_components.h"
+#include "exec/pipeline/fragment_context.h"
+#include "exec/pipeline/query_context.h"
 #include "exec/spill/spiller.hpp"
+#include "exec/workgroup/scan_executor.h"
 #include "exprs/column_ref.h"
 #include "exprs/expr.h"
 #include "exprs/runtime_filter_bank.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
+#include "runtime/exec_env.h"
 #include "runtime/runtime_filter_worker.h"
 #include "simd/simd.h"
 #include "util/debug_util.h"
@@ -54,6 +58,7 @@ void HashJoinBuildMetrics::prepare(RuntimeProfile* runtime_profile) {
     build_buckets_counter = ADD_COUNTER(runtime_profile, "BuildBuckets", TUnit::UNIT);
     runtime_filter_num = ADD_COUNTER(runtime_profile, "RuntimeFilterNum", TUnit::UNIT);
     build_keys_per_bucket = ADD_COUNTER(runtime_profile, "BuildKeysPerBucket%", TUnit::UNIT);
+    build_partitions_counter = ADD_COUNTER(runtime_profile, "BuildPartitions", TUnit::UNIT);
     hash_table_memory_usage = ADD_COUNTER(runtime_profile, "HashTableMemoryUsage", TUnit::BYTES);
 }
 
@@ -168,7 +173,31 @@ void HashJoiner::_init_hash_table_param(HashTableParam* param) {
             param->join_keys.emplace_back(JoinKeyDesc{&expr->type(), _is_null_safes[i], nullptr});
         }
     }
+
+    RuntimeState* state = _runtime_state;
+    param->build_cancel_checker = [state]() { return state->is_cancelled(); };
+
+    // The broadcast hash table is built by only one driver and shared by all probers, so the build is helped by
+    // tasks in the scan executor of the workgroup. A helper does nothing once the query is released, the build
+    // driver or the other helpers finish the remaining tasks.
+    if (_hash_join_node.distribution_mode == TJoinDistributionMode::BROADCAST &&
+        config::hash_join_parallel_build_dop > 1 && _runtime_state->fragment_ctx() != nullptr &&
+        _runtime_state->query_ctx() != nullptr) {
+        workgroup::WorkGroupPtr wg = _runtime_state->fragment_ctx()->workgroup();
+        std::weak_ptr<pipeline::QueryContext> wp = _runtime_state->query_ctx()->weak_from_this();
+        param->build_task_submitter = [wg, state, wp](std::function<void()>&& func) {
+            workgroup::ScanTask task(wg.get(), [state, wp, func = std::move(func)]() {
+                if (auto sp = wp.lock()) {
+                    SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(state->instance_mem_tracker());
+                    func();
+                }
+            });
+            return ExecEnv::GetInstance()->scan_executor()->submit(std::move(task));
+        };
+        param->build_parallelism = config::hash_join_parallel_build_dop;
+    }
 }
+
 Status HashJoiner::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk) {
     if (_phase != HashJoinPhase::BUILD) {
         return Status::OK();
@@ -208,17 +237,42 @@ Status HashJoiner::append_spill_task(RuntimeState* state, std::function<StatusOr
     return Status::OK();
 }
 
-Status HashJoiner::build_ht(RuntimeState* state) {
+Status HashJoiner::build_ht(RuntimeState* state, JoinBuildCallback callback) {
     if (_phase == HashJoinPhase::BUILD) {
-        RETURN_IF_ERROR(_hash_join_builder->build(state));
-        size_t bucket_size = _hash_join_builder->hash_table().get_bucket_size();
-        COUNTER_SET(build_metrics().build_buckets_counter, static_cast<int64_t>(bucket_size));
-        COUNTER_SET(build_metrics().build_keys_per_bucket, static_cast<int64_t>(100 * avg_keys_per_bucket()));
+        JoinBuildCallback on_finish = nullptr;
+        if (callback != nullptr) {
+            on_finish = [this, callback = std::move(callback)](const Status& status) {
+                if (status.ok()) {
+                    _update_build_ht_counters();
+                }
+                callback(status);
+            };
+        }
+        RETURN_IF_ERROR(_hash_join_builder->build(state, std::move(on_finish)));
+        if (!is_build_ht_async()) {
+            _update_build_ht_counters();
+        }
     }
 
     return Status::OK();
 }
 
+void HashJoiner::_update_build_ht_counters() {
+    size_t bucket_size = _hash_join_builder->hash_table().get_bucket_size();
+    COUNTER_SET(build_metrics().build_buckets_counter, static_cast<int64_t>(bucket_size));
+    COUNTER_SET(build_metrics().build_keys_per_bucket, static_cast<int64_t>(100 * avg_keys_per_bucket()));
+    COUNTER_SET(build_metrics().build_partitions_counter,
+                static_cast<int64_t>(_hash_join_builder->hash_table().get_partition_num()));
+}
+
+bool HashJoiner::is_build_ht_async() const {
+    return _hash_join_builder->hash_table().is_build_async();
+}
+
+bool HashJoiner::has_running_build_helpers() const {
+    return _hash_join_builder->hash_table().has_running_build_helpers();
+}
+
 bool HashJoiner::need_input() const {
     // when _buffered_chunk accumulates several chunks to form into a large enough chunk, it is moved into
     // _probe_chunk for probe operations.
@@ -157,6 +157,7 @@ struct HashJoinBuildMetrics {
     RuntimeProfile::Counter* build_buckets_counter = nullptr;
     RuntimeProfile::Counter* runtime_filter_num = nullptr;
     RuntimeProfile::Counter* build_keys_per_bucket = nullptr;
+    RuntimeProfile::Counter* build_partitions_counter = nullptr;
     RuntimeProfile::Counter* hash_table_memory_usage = nullptr;
 
     void prepare(RuntimeProfile* runtime_profile);
@@ -206,7 +207,11 @@ public:
 
     [[nodiscard]] Status append_spill_task(RuntimeState* state, std::function<StatusOr<ChunkPtr>()>& spill_task);
 
-    [[nodiscard]] Status build_ht(RuntimeState* state);
+    // If the hash table is built by helper threads after returning, is_build_ht_async() is true and |callback|
+    // is called with the status of the build.
+    [[nodiscard]] Status build_ht(RuntimeState* state, JoinBuildCallback callback = nullptr);
+    bool is_build_ht_async() const;
+    bool has_running_build_helpers() const;
     // probe phase
     [[nodiscard]] Status push_chunk(RuntimeState* state, ChunkPtr&& chunk);
     [[nodiscard]] StatusOr<ChunkPtr> pull_chunk(RuntimeState* state);
@@ -312,6 +317,8 @@ private:
 
     void _init_hash_table_param(HashTableParam* param);
 
+    void _update_build_ht_counters();
+
     [[nodiscard]] Status _prepare_key_columns(Columns& key_columns, const ChunkPtr& chunk,
                                               const vector<ExprContext*>& expr_ctxs) {
         key_columns.resize(0);
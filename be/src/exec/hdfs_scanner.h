@@ -43,6 +43,9 @@ struct HdfsScanStats {
 
     int64_t expr_filter_ns = 0;
     int64_t column_read_ns = 0;
+    // row groups skipped by the min/max of the runtime filters updated after the reader was opened,
+    // e.g. the tightening boundary of a top-n
+    int64_t runtime_filter_skip_groups = 0;
     int64_t column_convert_ns = 0;
     int64_t reader_init_ns = 0;
 
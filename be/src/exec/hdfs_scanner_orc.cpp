@@ -18,6 +18,7 @@
 
 #include "exec/exec_node.h"
 #include "exec/iceberg/iceberg_delete_builder.h"
+#include "exprs/runtime_filter_bank.h"
 #include "formats/orc/orc_chunk_reader.h"
 #include "formats/orc/orc_input_stream.h"
 #include "formats/orc/orc_memory_pool.h"
@@ -39,6 +40,11 @@ public:
                               const std::map<uint32_t, orc::BloomFilterIndex>& bloomFilters) override;
     bool filterMinMax(size_t rowGroupIdx, const std::unordered_map<uint64_t, orc::proto::RowIndex>& rowIndexes,
                       const std::map<uint32_t, orc::BloomFilterIndex>& bloomFilter);
+    // The search argument is built from the runtime filters arrived before the reader is opened, but a runtime
+    // filter may be tightened later, e.g. the boundary of a top-n, so its current min/max is checked again when
+    // the row groups of each stripe are picked.
+    bool filterRuntimeFilterMinMax(size_t rowGroupIdx,
+                                   const std::unordered_map<uint64_t, orc::proto::RowIndex>& rowIndexes);
     bool filterOnPickStringDictionary(const std::unordered_map<uint64_t, orc::StringDictionary*>& sdicts) override;
 
     bool is_slot_evaluated(SlotId id) { return _dict_filter_eval_cache.find(id) != _dict_filter_eval_cache.end(); }
@@ -163,6 +169,45 @@ bool OrcRowReaderFilter::filterMinMax(size_t rowGroupIdx,
     }
     return false;
 }
+bool OrcRowReaderFilter::filterRuntimeFilterMinMax(
+        size_t rowGroupIdx, const std::unordered_map<uint64_t, orc::proto::RowIndex>& rowIndexes) {
+    std::vector<SlotDescriptor*> min_max_slots(1);
+    const std::vector<SlotDescriptor*>& slots = _scanner_ctx.tuple_desc->slots();
+    int64_t tz_offset_in_seconds = _reader->tzoffset_in_seconds() - _writer_tzoffset_in_seconds;
+
+    for (auto& it : _scanner_ctx.runtime_filter_collector->descriptors()) {
+        RuntimeFilterProbeDescriptor* rf_desc = it.second;
+        const JoinRuntimeFilter* filter = rf_desc->runtime_filter();
+        SlotId probe_slot_id;
+        if (filter == nullptr || filter->has_null() || !rf_desc->is_probe_slot_ref(&probe_slot_id)) continue;
+        SlotDescriptor* slot = nullptr;
+        for (SlotDescriptor* s : slots) {
+            if (s->id() == probe_slot_id) {
+                slot = s;
+                break;
+            }
+        }
+        if (slot == nullptr) continue;
+        int32_t column_index = _reader->get_column_id_by_slot_name(slot->col_name());
+        if (column_index < 0) continue;
+        auto row_idx_iter = rowIndexes.find(column_index);
+        if (row_idx_iter == rowIndexes.end()) continue;
+
+        min_max_slots[0] = slot;
+        ChunkPtr min_chunk = ChunkHelper::new_chunk(min_max_slots, 0);
+        ChunkPtr max_chunk = ChunkHelper::new_chunk(min_max_slots, 0);
+        const orc::proto::ColumnStatistics& stats = row_idx_iter->second.entry(rowGroupIdx).statistics();
+        Status st = OrcMinMaxDecoder::decode(slot, stats, min_chunk->columns()[0], max_chunk->columns()[0],
+                                             tz_offset_in_seconds);
+        if (!st.ok()) continue;
+        if (RuntimeFilterHelper::filter_zonemap_with_min_max(slot->type().type, filter, min_chunk->columns()[0].get(),
+                                                             max_chunk->columns()[0].get())) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool OrcRowReaderFilter::filterOnPickRowGroup(size_t rowGroupIdx,
                                               const std::unordered_map<uint64_t, orc::proto::RowIndex>& rowIndexes,
                                               const std::map<uint32_t, orc::BloomFilterIndex>& bloomFilters) {
@@ -172,6 +217,14 @@ bool OrcRowReaderFilter::filterOnPickRowGroup(size_t rowGroupIdx,
             return true;
         }
     }
+    if (_scanner_ctx.runtime_filter_collector != nullptr) {
+        if (filterRuntimeFilterMinMax(rowGroupIdx, rowIndexes)) {
+            VLOG_FILE << "OrcRowReaderFilter: skip row group " << rowGroupIdx << " by runtime filter, stripe "
+                      << _current_stripe_index;
+            _scanner_ctx.stats->runtime_filter_skip_groups += 1;
+            return true;
+        }
+    }
     return false;
 }
 
@@ -536,6 +589,7 @@ void HdfsOrcScanner::do_update_counter(HdfsScanProfile* profile) {
     RuntimeProfile::Counter* delete_file_per_scan_counter = nullptr;
     RuntimeProfile::Counter* stripe_sizes_counter = nullptr;
     RuntimeProfile::Counter* stripe_number_counter = nullptr;
+    RuntimeProfile::Counter* runtime_filter_skip_groups = nullptr;
     RuntimeProfile* root = profile->runtime_profile;
 
     ADD_COUNTER(root, kORCProfileSectionPrefix, TUnit::NONE);
@@ -554,6 +608,10 @@ void HdfsOrcScanner::do_update_counter(HdfsScanProfile* profile) {
         COUNTER_UPDATE(stripe_sizes_counter, v);
     }
     COUNTER_UPDATE(stripe_number_counter, _app_stats.stripe_sizes.size());
+
+    runtime_filter_skip_groups =
+            ADD_CHILD_COUNTER(root, "RowGroupSkipByRuntimeFilter", TUnit::UNIT, kORCProfileSectionPrefix);
+    COUNTER_UPDATE(runtime_filter_skip_groups, _app_stats.runtime_filter_skip_groups);
 }
 
 } // namespace starrocks
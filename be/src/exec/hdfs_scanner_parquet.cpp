@@ -61,6 +61,8 @@ void HdfsParquetScanner::do_update_counter(HdfsScanProfile* profile) {
     RuntimeProfile::Counter* has_page_statistics = nullptr;
     // page skip
     RuntimeProfile::Counter* page_skip = nullptr;
+    // row groups skipped by the runtime filters updated while reading
+    RuntimeProfile::Counter* runtime_filter_skip_groups = nullptr;
     // round-by-round
     RuntimeProfile::Counter* group_min_round_cost = nullptr;
 
@@ -89,6 +91,8 @@ void HdfsParquetScanner::do_update_counter(HdfsScanProfile* profile) {
 
     has_page_statistics = ADD_CHILD_COUNTER(root, "HasPageStatistics", TUnit::UNIT, kParquetProfileSectionPrefix);
     page_skip = ADD_CHILD_COUNTER(root, "PageSkipCounter", TUnit::UNIT, kParquetProfileSectionPrefix);
+    runtime_filter_skip_groups =
+            ADD_CHILD_COUNTER(root, "GroupSkipByRuntimeFilter", TUnit::UNIT, kParquetProfileSectionPrefix);
     group_min_round_cost = ADD_CHILD_COUNTER(root, "GroupMinRound", TUnit::UNIT, kParquetProfileSectionPrefix);
 
     COUNTER_UPDATE(request_bytes_read, _app_stats.request_bytes_read);
@@ -107,6 +111,7 @@ void HdfsParquetScanner::do_update_counter(HdfsScanProfile* profile) {
     int64_t page_stats = _app_stats.has_page_statistics ? 1 : 0;
     COUNTER_UPDATE(has_page_statistics, page_stats);
     COUNTER_UPDATE(page_skip, _app_stats.page_skip);
+    COUNTER_UPDATE(runtime_filter_skip_groups, _app_stats.runtime_filter_skip_groups);
     COUNTER_UPDATE(group_min_round_cost, _app_stats.group_min_round_cost);
 }
 
@@ -18,12 +18,16 @@
 #include <runtime/descriptors.h>
 
 #include <memory>
+#include <mutex>
 
 #include "column/vectorized_fwd.h"
 #include "common/statusor.h"
 #include "exec/hash_join_node.h"
+#include "exprs/column_ref.h"
+#include "runtime/current_thread.h"
 #include "serde/column_array_serde.h"
 #include "simd/simd.h"
+#include "util/bit_util.h"
 
 namespace starrocks {
 
@@ -73,6 +77,311 @@ void HashTableProbeState::consider_probe_time_locality() {
     ++probe_chunks;
 }
 
+Status JoinHashTableItems::partition_build_rows(bool reorder_build_slice, std::function<void()> finish) {
+    // Rows which are not linked into the hash table(having null in not null-safe keys) are moved to the tail,
+    // they are still needed by the output of right/full outer join.
+    const uint32_t null_bucket = bucket_size;
+    build_buckets[0] = null_bucket;
+
+    // bucket_size is a power of 2, see JoinHashMapHelper::calc_bucket_size.
+    const int64_t expect_buckets_per_partition =
+            BitUtil::next_power_of_two(std::max<int64_t>(1, config::hash_join_partitioned_build_buckets_per_partition));
+    const uint32_t buckets_per_partition = std::min<int64_t>(bucket_size, expect_buckets_per_partition);
+    const uint32_t partition_shift = __builtin_ctz(buckets_per_partition);
+    const uint32_t num_partitions = (bucket_size >> partition_shift) + 1; // the last one is for null rows
+    const uint32_t num_ranges = std::max<int64_t>(1, std::min<int64_t>(build_parallelism, row_count / 4096 + 1));
+    const uint32_t rows_per_range = (row_count + num_ranges - 1) / num_ranges;
+
+    // The intermediate results shared by the stages, which may outlive this call.
+    struct PartitionContext {
+        std::vector<std::vector<uint32_t>> range_cursors;
+        std::vector<uint32_t> partition_offsets;
+        Buffer<uint32_t> partition_rows;
+        // order[new_row] = old_row, and the dummy row 0 keeps its position.
+        Buffer<uint32_t> order;
+        Columns build_columns;
+        // the key columns not referring to the build chunk
+        std::vector<size_t> other_key_columns;
+    };
+    auto ctx = std::make_shared<PartitionContext>();
+    ctx->range_cursors.assign(num_ranges, std::vector<uint32_t>(num_partitions, 0));
+    ctx->build_columns = build_chunk->columns();
+    for (size_t i = 0; i < key_columns.size(); i++) {
+        if (join_keys[i].col_ref == nullptr) {
+            ctx->other_key_columns.emplace_back(i);
+        }
+    }
+
+    std::vector<JoinBuildStage> stages;
+    // Pass 1: scatter rows into partitions, there are few partitions so the scatter is cache friendly.
+    // Rows are split into ranges, and each range is scattered independently after its histogram is counted.
+    stages.push_back(
+            {num_ranges,
+             [this, ctx, rows_per_range, partition_shift](size_t range) {
+                 const uint32_t begin = 1 + range * rows_per_range;
+                 const uint32_t end = std::min<uint32_t>(row_count + 1, begin + rows_per_range);
+                 auto& histogram = ctx->range_cursors[range];
+                 for (uint32_t row = begin; row < end; row++) {
+                     histogram[build_buckets[row] >> partition_shift]++;
+                 }
+             },
+             [this, ctx, num_ranges, num_partitions]() {
+                 auto& partition_offsets = ctx->partition_offsets;
+                 partition_offsets.assign(num_partitions + 1, 0);
+                 for (uint32_t p = 0; p < num_partitions; p++) {
+                     uint32_t offset = partition_offsets[p];
+                     for (uint32_t range = 0; range < num_ranges; range++) {
+                         uint32_t count = ctx->range_cursors[range][p];
+                         ctx->range_cursors[range][p] = offset;
+                         offset += count;
+                     }
+                     partition_offsets[p + 1] = offset;
+                 }
+                 ctx->partition_rows.resize(row_count);
+             }});
+    stages.push_back({num_ranges,
+                      [this, ctx, rows_per_range, partition_shift](size_t range) {
+                          const uint32_t begin = 1 + range * rows_per_range;
+                          const uint32_t end = std::min<uint32_t>(row_count + 1, begin + rows_per_range);
+                          auto& cursors = ctx->range_cursors[range];
+                          for (uint32_t row = begin; row < end; row++) {
+                              ctx->partition_rows[cursors[build_buckets[row] >> partition_shift]++] = row;
+                          }
+                      },
+                      [this, ctx]() {
+                          ctx->range_cursors.clear();
+                          ctx->order.resize(row_count + 1);
+                          ctx->order[0] = 0;
+                          next[0] = 0;
+                      }});
+
+    // Pass 2: order rows by bucket inside each partition and link them, only buckets of this partition are
+    // touched, so partitions are processed independently.
+    stages.push_back({num_partitions,
+                      [this, ctx, num_partitions, partition_shift, buckets_per_partition](size_t p) {
+                          const auto& buckets = build_buckets;
+                          const auto& partition_rows = ctx->partition_rows;
+                          auto& order = ctx->order;
+                          const uint32_t begin = ctx->partition_offsets[p];
+                          const uint32_t end = ctx->partition_offsets[p + 1];
+                          if (p == num_partitions - 1) {
+                              // null rows keep the original order and are not linked.
+                              for (uint32_t k = begin; k < end; k++) {
+                                  order[k + 1] = partition_rows[k];
+                                  next[k + 1] = 0;
+                              }
+                              return;
+                          }
+                          const uint32_t bucket_base = p << partition_shift;
+                          std::vector<uint32_t> bucket_offsets(buckets_per_partition + 1, 0);
+                          for (uint32_t k = begin; k < end; k++) {
+                              bucket_offsets[buckets[partition_rows[k]] - bucket_base + 1]++;
+                          }
+                          bucket_offsets[0] = begin + 1;
+                          for (uint32_t b = 0; b < buckets_per_partition; b++) {
+                              bucket_offsets[b + 1] += bucket_offsets[b];
+                          }
+                          for (uint32_t k = begin; k < end; k++) {
+                              uint32_t row = partition_rows[k];
+                              order[bucket_offsets[buckets[row] - bucket_base]++] = row;
+                          }
+                          // Link in reverse order, so the chain of each bucket is ascending.
+                          for (uint32_t row = end; row > begin; row--) {
+                              const uint32_t bucket = buckets[order[row]];
+                              next[row] = first[bucket];
+                              first[bucket] = row;
+                          }
+                      },
+                      [this, ctx]() {
+                          ctx->partition_rows.clear();
+                          ctx->partition_rows.shrink_to_fit();
+                          build_buckets.clear();
+                          build_buckets.shrink_to_fit();
+                      }});
+
+    // Pass 3: reorder the build rows, each column is reordered by a task, and key columns referring to the build
+    // chunk are fetched again after it.
+    const size_t num_build_columns = ctx->build_columns.size();
+    const size_t num_other_key_columns = ctx->other_key_columns.size();
+    const size_t num_reorder_tasks = num_build_columns + num_other_key_columns + (build_key_column != nullptr) +
+                                     !build_key256.empty() + (reorder_build_slice && !build_slice.empty());
+    stages.push_back({num_reorder_tasks,
+                      [this, ctx, num_build_columns](size_t task) {
+                          const auto& order = ctx->order;
+                          const uint32_t num_rows = row_count + 1;
+                          auto reorder_column = [&](const ColumnPtr& column) -> ColumnPtr {
+                              ColumnPtr dest = column->clone_empty();
+                              dest->append_selective(*column, order.data(), 0, num_rows);
+                              return dest;
+                          };
+                          if (task < num_build_columns) {
+                              ctx->build_columns[task] = reorder_column(ctx->build_columns[task]);
+                              return;
+                          }
+                          task -= num_build_columns;
+                          if (task < ctx->other_key_columns.size()) {
+                              size_t i = ctx->other_key_columns[task];
+                              key_columns[i] = reorder_column(key_columns[i]);
+                              return;
+                          }
+                          task -= ctx->other_key_columns.size();
+                          if (build_key_column != nullptr && task-- == 0) {
+                              build_key_column = reorder_column(build_key_column);
+                              return;
+                          }
+                          if (!build_key256.empty() && task-- == 0) {
+                              Buffer<JoinKey256> keys(num_rows);
+                              for (uint32_t row = 0; row < num_rows; row++) {
+                                  keys[row] = build_key256[order[row]];
+                              }
+                              build_key256.swap(keys);
+                              return;
+                          }
+                          Buffer<JoinHashedSlice> slices(num_rows);
+                          for (uint32_t row = 0; row < num_rows; row++) {
+                              slices[row] = build_slice[order[row]];
+                          }
+                          build_slice.swap(slices);
+                      },
+                      [this, ctx, num_partitions, finish = std::move(finish)]() {
+                          ChunkPtr new_build_chunk = build_chunk->clone_empty_with_slot();
+                          for (size_t i = 0; i < ctx->build_columns.size(); i++) {
+                              new_build_chunk->get_column_by_index(i).swap(ctx->build_columns[i]);
+                          }
+                          build_chunk = std::move(new_build_chunk);
+                          for (size_t i = 0; i < key_columns.size(); i++) {
+                              if (join_keys[i].col_ref != nullptr) {
+                                  key_columns[i] = build_chunk->get_column_by_slot_id(join_keys[i].col_ref->slot_id());
+                              }
+                          }
+                          ctx->order.clear();
+                          ctx->order.shrink_to_fit();
+                          partition_num = num_partitions - 1;
+                          calculate_ht_info(build_key_bytes);
+                          if (finish != nullptr) {
+                              finish();
+                          }
+                      }});
+
+    // Helpers may finish the build after returning, which is only allowed if someone is told by the callback.
+    JoinBuildTaskSubmitter submitter = build_callback != nullptr ? build_task_submitter : nullptr;
+    build_runner = std::make_shared<JoinBuildStageRunner>(std::move(stages), std::move(submitter), build_parallelism,
+                                                          build_cancel_checker);
+    Status status;
+    build_pending = !build_runner->run(build_callback, &status);
+    return status;
+}
+
+JoinBuildStageRunner::JoinBuildStageRunner(std::vector<JoinBuildStage> stages, JoinBuildTaskSubmitter submitter,
+                                           int32_t parallelism, JoinBuildCancelChecker cancel_checker)
+        : _stages(std::move(stages)),
+          _progress(std::make_unique<StageProgress[]>(_stages.size())),
+          _submitter(std::move(submitter)),
+          _parallelism(std::max(1, parallelism)),
+          _cancel_checker(std::move(cancel_checker)) {
+    for (size_t i = 0; i < _stages.size(); i++) {
+        _progress[i].num_tasks = _stages[i].num_tasks;
+    }
+}
+
+bool JoinBuildStageRunner::run(JoinBuildCallback callback, Status* status) {
+    _callback = std::move(callback);
+    _start_stage(0);
+    if (_handoff.fetch_add(1) == 1) {
+        *status = _status;
+        return true;
+    }
+    return false;
+}
+
+void JoinBuildStageRunner::_start_stage(size_t stage) {
+    if (stage == _stages.size()) {
+        _finish();
+        return;
+    }
+    const size_t num_tasks = _progress[stage].num_tasks;
+    if (num_tasks == 0) {
+        _finish_stage(stage);
+        return;
+    }
+    if (_submitter != nullptr && _parallelism > 1 && num_tasks > 1) {
+        const size_t num_helpers = std::min<size_t>(_parallelism, num_tasks) - 1;
+        for (size_t i = 0; i < num_helpers; i++) {
+            _num_running_helpers++;
+            bool submitted = _submitter([self = shared_from_this(), stage]() {
+                self->_run_tasks(stage);
+                self->_num_running_helpers--;
+            });
+            if (!submitted) {
+                _num_running_helpers--;
+                break;
+            }
+        }
+    }
+    // The helpers which start late find no task left, so a busy executor degrades to the serial build.
+    _run_tasks(stage);
+}
+
+void JoinBuildStageRunner::_run_tasks(size_t stage) {
+    auto& progress = _progress[stage];
+    size_t i;
+    while ((i = progress.next_task.fetch_add(1)) < progress.num_tasks) {
+        if (!_failed && _cancel_checker != nullptr && _cancel_checker()) {
+            _set_failed(Status::Cancelled("hash join build is cancelled"));
+        }
+        if (!_failed) {
+            auto status = [&]() -> Status {
+                TRY_CATCH_BAD_ALLOC(_stages[stage].task(i));
+                return Status::OK();
+            }();
+            if (!status.ok()) {
+                _set_failed(status);
+            }
+        }
+        if (progress.num_finished.fetch_add(1) + 1 == progress.num_tasks) {
+            _finish_stage(stage);
+            return;
+        }
+    }
+}
+
+void JoinBuildStageRunner::_finish_stage(size_t stage) {
+    if (!_failed && _stages[stage].finish != nullptr) {
+        auto status = [&]() -> Status {
+            TRY_CATCH_BAD_ALLOC(_stages[stage].finish());
+            return Status::OK();
+        }();
+        if (!status.ok()) {
+            _set_failed(status);
+        }
+    }
+    if (_failed) {
+        _finish();
+        return;
+    }
+    _start_stage(stage + 1);
+}
+
+void JoinBuildStageRunner::_finish() {
+    // Release the intermediate results held by the stages, no task is left to run.
+    for (auto& stage : _stages) {
+        stage.task = nullptr;
+        stage.finish = nullptr;
+    }
+    if (_handoff.fetch_add(1) == 1) {
+        auto callback = std::move(_callback);
+        callback(_status);
+    }
+}
+
+void JoinBuildStageRunner::_set_failed(const Status& status) {
+    std::lock_guard<std::mutex> l(_mutex);
+    if (_status.ok()) {
+        _status = status;
+    }
+    _failed = true;
+}
+
 void SerializedJoinBuildFunc::prepare(RuntimeState* state, JoinHashTableItems* table_items) {
     table_items->bucket_size = JoinHashMapHelper::calc_bucket_size(table_items->row_count + 1);
     table_items->first.resize(table_items->bucket_size, 0);
@@ -135,15 +444,14 @@ void SerializedJoinBuildFunc::_build_columns(JoinHashTableItems* table_items, Ha
                                              const Columns& data_columns, uint32_t start, uint32_t count,
                                              uint8_t** ptr) {
     for (size_t i = 0; i < count; i++) {
-        table_items->build_slice[start + i] = JoinHashMapHelper::get_hash_key(data_columns, start + i, *ptr);
-        probe_state->buckets[i] = JoinHashMapHelper::calc_bucket_num<Slice>(table_items->build_slice[start + i],
-                                                                            table_items->bucket_size);
-        *ptr += table_items->build_slice[start + i].size;
+        auto& key = table_items->build_slice[start + i];
+        key = JoinHashedSlice(JoinHashMapHelper::get_hash_key(data_columns, start + i, *ptr));
+        probe_state->buckets[i] = JoinHashMapHelper::calc_bucket_num<JoinHashedSlice>(key, table_items->bucket_size);
+        *ptr += key.size;
     }
 
     for (size_t i = 0; i < count; i++) {
-        table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-        table_items->first[probe_state->buckets[i]] = start + i;
+        table_items->link_build_row(start + i, probe_state->buckets[i]);
     }
 }
 
@@ -161,19 +469,173 @@ void SerializedJoinBuildFunc::_build_nullable_columns(JoinHashTableItems* table_
 
     for (size_t i = 0; i < count; i++) {
         if (probe_state->is_nulls[i] == 0) {
-            table_items->build_slice[start + i] = JoinHashMapHelper::get_hash_key(data_columns, start + i, *ptr);
-            probe_state->buckets[i] = JoinHashMapHelper::calc_bucket_num<Slice>(table_items->build_slice[start + i],
-                                                                                table_items->bucket_size);
-            *ptr += table_items->build_slice[start + i].size;
+            auto& key = table_items->build_slice[start + i];
+            key = JoinHashedSlice(JoinHashMapHelper::get_hash_key(data_columns, start + i, *ptr));
+            probe_state->buckets[i] =
+                    JoinHashMapHelper::calc_bucket_num<JoinHashedSlice>(key, table_items->bucket_size);
+            *ptr += key.size;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (probe_state->is_nulls[i] == 0) {
+            table_items->link_build_row(start + i, probe_state->buckets[i]);
+        }
+    }
+}
+
+void FixedSize256JoinBuildFunc::prepare(RuntimeState* state, JoinHashTableItems* table_items) {
+    table_items->bucket_size = JoinHashMapHelper::calc_bucket_size(table_items->row_count + 1);
+    table_items->first.resize(table_items->bucket_size, 0);
+    table_items->next.resize(table_items->row_count + 1, 0);
+    table_items->build_key256.resize(table_items->row_count + 1);
+}
+
+void FixedSize256JoinBuildFunc::construct_hash_table(RuntimeState* state, JoinHashTableItems* table_items,
+                                                     HashTableProbeState* probe_state) {
+    uint32_t row_count = table_items->row_count;
+
+    // prepare columns
+    Columns data_columns;
+    NullColumns null_columns;
+    for (size_t i = 0; i < table_items->key_columns.size(); i++) {
+        if (table_items->join_keys[i].is_null_safe_equal) {
+            data_columns.emplace_back(table_items->key_columns[i]);
+        } else if (table_items->key_columns[i]->is_nullable()) {
+            auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[i]);
+            data_columns.emplace_back(nullable_column->data_column());
+            if (table_items->key_columns[i]->has_null()) {
+                null_columns.emplace_back(nullable_column->null_column());
+            }
+        } else {
+            data_columns.emplace_back(table_items->key_columns[i]);
+        }
+    }
+
+    // serialize and build hash table
+    uint32_t quo = row_count / state->chunk_size();
+    uint32_t rem = row_count % state->chunk_size();
+
+    if (!null_columns.empty()) {
+        for (size_t i = 0; i < quo; i++) {
+            _build_nullable_columns(table_items, probe_state, data_columns, null_columns, 1 + state->chunk_size() * i,
+                                    state->chunk_size());
+        }
+        _build_nullable_columns(table_items, probe_state, data_columns, null_columns, 1 + state->chunk_size() * quo,
+                                rem);
+    } else {
+        for (size_t i = 0; i < quo; i++) {
+            _build_columns(table_items, probe_state, data_columns, 1 + state->chunk_size() * i, state->chunk_size());
+        }
+        _build_columns(table_items, probe_state, data_columns, 1 + state->chunk_size() * quo, rem);
+    }
+    table_items->calculate_ht_info(table_items->build_key256.size() * sizeof(CppType));
+}
+
+void FixedSize256JoinBuildFunc::_build_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
+                                               const Columns& data_columns, uint32_t start, uint32_t count) {
+    auto& data = table_items->build_key256;
+    JoinHashMapHelper::serialize_fixed_size_keys(data_columns, reinterpret_cast<uint8_t*>(&data[start]),
+                                                 sizeof(CppType), start, count);
+    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items->bucket_size, &probe_state->buckets, start, count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        table_items->link_build_row(start + i, probe_state->buckets[i]);
+    }
+}
+
+void FixedSize256JoinBuildFunc::_build_nullable_columns(JoinHashTableItems* table_items,
+                                                        HashTableProbeState* probe_state, const Columns& data_columns,
+                                                        const NullColumns& null_columns, uint32_t start,
+                                                        uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        probe_state->is_nulls[i] = null_columns[0]->get_data()[start + i];
+    }
+    for (uint32_t i = 1; i < null_columns.size(); i++) {
+        for (uint32_t j = 0; j < count; j++) {
+            probe_state->is_nulls[j] |= null_columns[i]->get_data()[start + j];
         }
     }
 
+    auto& data = table_items->build_key256;
+    JoinHashMapHelper::serialize_fixed_size_keys(data_columns, reinterpret_cast<uint8_t*>(&data[start]),
+                                                 sizeof(CppType), start, count);
+    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items->bucket_size, &probe_state->buckets, start, count);
+
     for (size_t i = 0; i < count; i++) {
         if (probe_state->is_nulls[i] == 0) {
-            table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-            table_items->first[probe_state->buckets[i]] = start + i;
+            table_items->link_build_row(start + i, probe_state->buckets[i]);
+        }
+    }
+}
+
+void FixedSize256JoinProbeFunc::lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state) {
+    // prepare columns
+    Columns data_columns;
+    NullColumns null_columns;
+
+    for (size_t i = 0; i < probe_state->key_columns->size(); i++) {
+        if (table_items.join_keys[i].is_null_safe_equal) {
+            if ((*probe_state->key_columns)[i]->is_nullable()) {
+                data_columns.emplace_back((*probe_state->key_columns)[i]);
+            } else {
+                auto tmp_column = NullableColumn::create((*probe_state->key_columns)[i],
+                                                         NullColumn::create(probe_state->probe_row_count, 0));
+                data_columns.emplace_back(tmp_column);
+            }
+        } else if ((*probe_state->key_columns)[i]->is_nullable()) {
+            auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[i]);
+            data_columns.emplace_back(nullable_column->data_column());
+            if ((*probe_state->key_columns)[i]->has_null()) {
+                null_columns.emplace_back(nullable_column->null_column());
+            }
+        } else {
+            data_columns.emplace_back((*probe_state->key_columns)[i]);
+        }
+    }
+
+    // serialize and init search
+    if (!null_columns.empty()) {
+        _probe_nullable_column(table_items, probe_state, data_columns, null_columns);
+    } else {
+        _probe_column(table_items, probe_state, data_columns);
+    }
+    probe_state->consider_probe_time_locality();
+}
+
+void FixedSize256JoinProbeFunc::_probe_column(const JoinHashTableItems& table_items, HashTableProbeState* probe_state,
+                                              const Columns& data_columns) {
+    uint32_t row_count = probe_state->probe_row_count;
+
+    auto& data = probe_state->probe_key256;
+    JoinHashMapHelper::serialize_fixed_size_keys(data_columns, reinterpret_cast<uint8_t*>(data.data()),
+                                                 sizeof(CppType), 0, row_count);
+    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, row_count);
+
+    JoinHashMapHelper::lookup_first_build_rows(table_items, probe_state, row_count, nullptr);
+}
+
+void FixedSize256JoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& table_items,
+                                                       HashTableProbeState* probe_state, const Columns& data_columns,
+                                                       const NullColumns& null_columns) {
+    uint32_t row_count = probe_state->probe_row_count;
+
+    for (uint32_t i = 0; i < row_count; i++) {
+        probe_state->is_nulls[i] = null_columns[0]->get_data()[i];
+    }
+    for (uint32_t i = 1; i < null_columns.size(); i++) {
+        for (uint32_t j = 0; j < row_count; j++) {
+            probe_state->is_nulls[j] |= null_columns[i]->get_data()[j];
         }
     }
+    probe_state->null_array = &null_columns[0]->get_data();
+
+    auto& data = probe_state->probe_key256;
+    JoinHashMapHelper::serialize_fixed_size_keys(data_columns, reinterpret_cast<uint8_t*>(data.data()),
+                                                 sizeof(CppType), 0, row_count);
+    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, row_count);
+
+    JoinHashMapHelper::lookup_first_build_rows(table_items, probe_state, row_count, probe_state->is_nulls.data());
 }
 
 void SerializedJoinProbeFunc::lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state) {
@@ -218,15 +680,13 @@ void SerializedJoinProbeFunc::_probe_column(const JoinHashTableItems& table_item
     uint32_t row_count = probe_state->probe_row_count;
 
     for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->probe_slice[i] = JoinHashMapHelper::get_hash_key(data_columns, i, ptr);
-        probe_state->buckets[i] =
-                JoinHashMapHelper::calc_bucket_num<Slice>(probe_state->probe_slice[i], table_items.bucket_size);
-        ptr += probe_state->probe_slice[i].size;
+        auto& key = probe_state->probe_slice[i];
+        key = JoinHashedSlice(JoinHashMapHelper::get_hash_key(data_columns, i, ptr));
+        probe_state->buckets[i] = JoinHashMapHelper::calc_bucket_num<JoinHashedSlice>(key, table_items.bucket_size);
+        ptr += key.size;
     }
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_first_build_rows(table_items, probe_state, row_count, nullptr);
 }
 
 void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& table_items,
@@ -246,20 +706,18 @@ void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& t
     probe_state->null_array = &null_columns[0]->get_data();
     for (uint32_t i = 0; i < row_count; i++) {
         if (probe_state->is_nulls[i] == 0) {
-            probe_state->probe_slice[i] = JoinHashMapHelper::get_hash_key(data_columns, i, ptr);
+            probe_state->probe_slice[i] = JoinHashedSlice(JoinHashMapHelper::get_hash_key(data_columns, i, ptr));
             ptr += probe_state->probe_slice[i].size;
         }
     }
 
     for (uint32_t i = 0; i < row_count; i++) {
         if (probe_state->is_nulls[i] == 0) {
-            probe_state->buckets[i] =
-                    JoinHashMapHelper::calc_bucket_num<Slice>(probe_state->probe_slice[i], table_items.bucket_size);
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-        } else {
-            probe_state->next[i] = 0;
+            probe_state->buckets[i] = JoinHashMapHelper::calc_bucket_num<JoinHashedSlice>(probe_state->probe_slice[i],
+                                                                                          table_items.bucket_size);
         }
     }
+    JoinHashMapHelper::lookup_first_build_rows(table_items, probe_state, row_count, probe_state->is_nulls.data());
 }
 
 JoinHashTable JoinHashTable::clone_readable_table() {
@@ -339,6 +797,9 @@ void JoinHashTable::create(const HashTableParam& param) {
         _table_items->right_to_nullable = true;
     }
     _table_items->join_keys = param.join_keys;
+    _table_items->build_task_submitter = param.build_task_submitter;
+    _table_items->build_parallelism = param.build_parallelism;
+    _table_items->build_cancel_checker = param.build_cancel_checker;
 
     const auto& probe_desc = *param.probe_row_desc;
     for (const auto& tuple_desc : probe_desc.tuple_descriptors()) {
@@ -421,11 +882,14 @@ int64_t JoinHashTable::mem_usage() const {
     if (_table_items->build_key_column != nullptr) {
         usage += _table_items->build_key_column->memory_usage();
     }
-    usage += _table_items->build_slice.size() * sizeof(Slice);
+    usage += _table_items->build_slice.capacity() * sizeof(JoinHashedSlice);
+    usage += _table_items->build_key256.capacity() * sizeof(JoinKey256);
     return usage;
 }
 
-Status JoinHashTable::build(RuntimeState* state) {
+Status JoinHashTable::build(RuntimeState* state, JoinBuildCallback callback) {
+    _table_items->build_callback = std::move(callback);
+    _table_items->build_pending = false;
     RETURN_IF_ERROR(_table_items->build_chunk->upgrade_if_overflow());
     _table_items->has_large_column = _table_items->build_chunk->has_large_column();
 
@@ -448,7 +912,7 @@ Status JoinHashTable::build(RuntimeState* state) {
         _##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(_table_items.get(), _probe_state.get()); \
         _##NAME->build_prepare(state);                                                                                \
         _##NAME->probe_prepare(state);                                                                                \
-        _##NAME->build(state);                                                                                        \
+        RETURN_IF_ERROR(_##NAME->build(state));                                                                       \
         break;
         APPLY_FOR_JOIN_VARIANTS(M)
 #undef M
@@ -694,10 +1158,11 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
     }
 
     size_t total_size_in_byte = 0;
+    size_t null_safe_key_count = 0;
 
     for (auto& join_key : _table_items->join_keys) {
         if (join_key.is_null_safe_equal) {
-            total_size_in_byte += 1;
+            null_safe_key_count++;
         }
         size_t s = _get_size_of_fixed_and_contiguous_type(join_key.type->type);
         if (s > 0) {
@@ -706,6 +1171,8 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
             return JoinHashMapType::slice;
         }
     }
+    // null flags of null-safe-equal keys are packed into a bitmap, see JoinHashMapHelper::serialize_fixed_size_keys.
+    total_size_in_byte += (null_safe_key_count + 7) / 8;
 
     if (total_size_in_byte <= 4) {
         return JoinHashMapType::fixed32;
@@ -716,6 +1183,9 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
     if (total_size_in_byte <= 16) {
         return JoinHashMapType::fixed128;
     }
+    if (total_size_in_byte <= sizeof(JoinKey256)) {
+        return JoinHashMapType::fixed256;
+    }
 
     return JoinHashMapType::slice;
 }
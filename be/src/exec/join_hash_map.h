@@ -20,14 +20,18 @@
 #include <runtime/descriptors.h>
 #include <runtime/runtime_state.h>
 
+#include <atomic>
 #include <coroutine>
 #include <cstdint>
+#include <functional>
+#include <mutex>
 #include <set>
 
 #include "column/chunk.h"
 #include "column/column_hash.h"
 #include "column/column_helper.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "util/phmap/phmap.h"
 
 #if defined(__aarch64__)
@@ -57,7 +61,8 @@ class ColumnRef;
     M(slice)                       \
     M(fixed32)                     \
     M(fixed64)                     \
-    M(fixed128)
+    M(fixed128)                    \
+    M(fixed256)
 
 enum class JoinHashMapType {
     empty,
@@ -78,12 +83,47 @@ enum class JoinHashMapType {
     keydecimal128,
     slice,
     fixed32, // 4 bytes
-    fixed64, // 8 bytes
-    fixed128 // 16 bytes
+    fixed64,  // 8 bytes
+    fixed128, // 16 bytes
+    fixed256  // 32 bytes
 };
 
 enum class JoinMatchFlag { NORMAL, ALL_NOT_MATCH, ALL_MATCH_ONE, MOST_MATCH_ONE };
 
+// Composite fixed-size join key which is wider than 16 bytes and has no corresponding column type,
+// e.g. three BIGINTs or BIGINT+DATETIME+INT.
+template <size_t N>
+struct JoinFixedSizeKey {
+    uint8_t data[N];
+
+    bool operator==(const JoinFixedSizeKey& rhs) const { return memcmp(data, rhs.data, N) == 0; }
+};
+using JoinKey256 = JoinFixedSizeKey<32>;
+
+// Variable-length join key with its hash value and first bytes inlined, so that walking a bucket chain rejects keys
+// of different hash values or prefixes without touching the key bytes, and keys no longer than the prefix are
+// compared without touching them at all.
+struct JoinHashedSlice {
+    const char* data = nullptr;
+    uint32_t size = 0;
+    uint32_t hash = 0;
+    // the first bytes of the key, padded with zeros.
+    uint64_t prefix = 0;
+
+    JoinHashedSlice() = default;
+    explicit JoinHashedSlice(const Slice& slice);
+
+    Slice slice() const { return {data, size}; }
+
+    bool operator==(const JoinHashedSlice& rhs) const {
+        if (hash != rhs.hash || prefix != rhs.prefix || size != rhs.size) {
+            return false;
+        }
+        return size <= sizeof(prefix) ||
+               memcmp(data + sizeof(prefix), rhs.data + sizeof(prefix), size - sizeof(prefix)) == 0;
+    }
+};
+
 struct JoinKeyDesc {
     const TypeDescriptor* type = nullptr;
     bool is_null_safe_equal;
@@ -95,6 +135,65 @@ struct HashTableSlotDescriptor {
     bool need_output;
 };
 
+// Submit a task of the hash table build to run in another thread, return false if it can't be submitted.
+using JoinBuildTaskSubmitter = std::function<bool(std::function<void()>&&)>;
+// Called with the status of the partitioned build by the helper thread finishing it.
+using JoinBuildCallback = std::function<void(const Status&)>;
+// Return true if the query is cancelled, then the tasks of the partitioned build left are skipped.
+using JoinBuildCancelChecker = std::function<bool()>;
+
+// A stage of the partitioned build, task(0) ... task(num_tasks - 1) may run in parallel, and then finish() runs in
+// the thread finishing the last task.
+struct JoinBuildStage {
+    size_t num_tasks = 0;
+    std::function<void(size_t)> task;
+    std::function<void()> finish;
+};
+
+// Runs the stages of the partitioned build one after another. The tasks of a stage are run by the thread starting
+// the stage together with the helpers submitted for it, and the thread finishing the last task starts the next stage.
+// So no thread waits for another: the build driver returns once the tasks left are taken by helpers, and the helper
+// finishing the last stage calls the callback.
+class JoinBuildStageRunner : public std::enable_shared_from_this<JoinBuildStageRunner> {
+public:
+    JoinBuildStageRunner(std::vector<JoinBuildStage> stages, JoinBuildTaskSubmitter submitter, int32_t parallelism,
+                         JoinBuildCancelChecker cancel_checker = nullptr);
+
+    // Return true if all the stages are finished before returning, and their status is set to |status|.
+    // Otherwise |callback| is called with the status by the helper finishing them.
+    bool run(JoinBuildCallback callback, Status* status);
+
+    // The submitted helpers which are not finished, they may still access the state of the fragment.
+    bool has_running_helpers() const { return _num_running_helpers > 0; }
+
+private:
+    void _start_stage(size_t stage);
+    void _run_tasks(size_t stage);
+    void _finish_stage(size_t stage);
+    void _finish();
+    void _set_failed(const Status& status);
+
+    struct StageProgress {
+        size_t num_tasks = 0;
+        std::atomic<size_t> next_task = 0;
+        std::atomic<size_t> num_finished = 0;
+    };
+
+    std::vector<JoinBuildStage> _stages;
+    std::unique_ptr<StageProgress[]> _progress;
+    JoinBuildTaskSubmitter _submitter;
+    const int32_t _parallelism;
+    JoinBuildCancelChecker _cancel_checker;
+
+    std::atomic<bool> _failed = false;
+    std::mutex _mutex;
+    Status _status;
+    JoinBuildCallback _callback;
+    // Increased by run() when it returns and by _finish(), the second one reports the status.
+    std::atomic<int32_t> _handoff = 0;
+    std::atomic<int32_t> _num_running_helpers = 0;
+};
+
 struct JoinHashTableItems {
     //TODO: memory continus problem?
     ChunkPtr build_chunk = nullptr;
@@ -113,8 +212,10 @@ struct JoinHashTableItems {
     // about the bucket-chained hash table of this kind.
     Buffer<uint32_t> first;
     Buffer<uint32_t> next;
-    Buffer<Slice> build_slice;
+    Buffer<JoinHashedSlice> build_slice;
     ColumnPtr build_key_column = nullptr;
+    // packed build keys of fixed256, which can not be held by a column.
+    Buffer<JoinKey256> build_key256;
     uint32_t bucket_size = 0;
     uint32_t row_count = 0; // real row count
     size_t build_column_count = 0;
@@ -127,11 +228,44 @@ struct JoinHashTableItems {
     float keys_per_bucket = 0;
     size_t used_buckets = 0;
     bool cache_miss_serious = false;
+    // the hash table doesn't fit in cache, probing it benefits from software prefetch.
+    bool probe_prefetch = false;
+    // number of partitions of the partitioned build, 0 means the build rows are not partitioned.
+    uint32_t partition_num = 0;
+    // If true, construct_hash_table only records the bucket of each build row in `build_buckets`,
+    // and rows are linked in partition_build_rows.
+    bool partitioned_build = false;
+    Buffer<uint32_t> build_buckets;
+    size_t build_key_bytes = 0;
+    // The partitioned build is run by at most `build_parallelism` threads, the build driver and
+    // the helpers submitted by `build_task_submitter`. The helpers are only used if `build_callback` is set,
+    // since the build may be finished by a helper after partition_build_rows returns, which is told by
+    // `build_pending`.
+    JoinBuildTaskSubmitter build_task_submitter = nullptr;
+    int32_t build_parallelism = 1;
+    JoinBuildCancelChecker build_cancel_checker = nullptr;
+    JoinBuildCallback build_callback = nullptr;
+    bool build_pending = false;
+    std::shared_ptr<JoinBuildStageRunner> build_runner = nullptr;
 
     float get_keys_per_bucket() const { return keys_per_bucket; }
     bool ht_cache_miss_serious() const { return cache_miss_serious; }
 
+    void link_build_row(uint32_t row, uint32_t bucket) {
+        if (partitioned_build) {
+            build_buckets[row] = bucket;
+        } else {
+            next[row] = first[bucket];
+            first[bucket] = row;
+        }
+    }
+
     void calculate_ht_info(size_t key_bytes) {
+        if (partitioned_build && partition_num == 0) {
+            // rows are not linked yet.
+            build_key_bytes = key_bytes;
+            return;
+        }
         if (used_buckets == 0) { // to avoid redo
             for (const auto value : first) {
                 used_buckets += value != 0;
@@ -140,13 +274,23 @@ struct JoinHashTableItems {
             size_t probe_bytes = key_bytes + row_count * sizeof(uint32_t);
             cache_miss_serious = ((probe_bytes > (1UL << 25) && keys_per_bucket > 1.5) || probe_bytes > (1UL << 26)) &&
                                  row_count > (1UL << 18);
+            probe_prefetch = probe_bytes + bucket_size * sizeof(uint32_t) > (1UL << 20);
         }
     }
 
+    // Radix partition build rows by the high bits of their bucket numbers and then sort rows by bucket inside each
+    // partition, both of which are done on cache-sized pieces. Build rows(and the packed keys) are reordered, and
+    // `first`/`next` are linked so that rows of the same bucket are contiguous.
+    // `build_buckets` holds the bucket number of each build row, and `bucket_size` for rows not linked.
+    // `build_slice` is reordered only if |reorder_build_slice|, it's not needed if the slices are rebuilt from the
+    // reordered key column by |finish|, which is run after the rows are reordered.
+    Status partition_build_rows(bool reorder_build_slice, std::function<void()> finish);
+
     TJoinOp::type join_type = TJoinOp::INNER_JOIN;
 
     std::unique_ptr<MemPool> build_pool = nullptr;
     std::vector<JoinKeyDesc> join_keys;
+
 };
 
 struct HashTableProbeState {
@@ -156,9 +300,10 @@ struct HashTableProbeState {
     Buffer<uint32_t> build_index;
     Buffer<uint32_t> probe_index;
     Buffer<uint32_t> next;
-    Buffer<Slice> probe_slice;
+    Buffer<JoinHashedSlice> probe_slice;
     Buffer<uint8_t>* null_array = nullptr;
     ColumnPtr probe_key_column;
+    Buffer<JoinKey256> probe_key256;
     const Columns* key_columns = nullptr;
 
     // when exec right join
@@ -213,6 +358,8 @@ struct HashTableProbeState {
     };
     uint32_t match_count = 0;
     int active_coroutines = 0;
+    // probe rows whose build rows are prefetched ahead, 0 means no prefetch.
+    uint32_t prefetch_distance = 0;
     // used to adaptively detect time locality
     size_t probe_chunks = 0;
     uint32_t detect_step = 1;
@@ -229,6 +376,7 @@ struct HashTableProbeState {
               probe_slice(rhs.probe_slice),
               null_array(rhs.null_array),
               probe_key_column(rhs.probe_key_column == nullptr ? nullptr : rhs.probe_key_column->clone()),
+              probe_key256(rhs.probe_key256),
               key_columns(rhs.key_columns),
               build_match_index(rhs.build_match_index),
               probe_match_index(rhs.probe_match_index),
@@ -272,6 +420,10 @@ struct HashTableParam {
     std::set<SlotId> predicate_slots;
     std::vector<JoinKeyDesc> join_keys;
 
+    JoinBuildTaskSubmitter build_task_submitter = nullptr;
+    int32_t build_parallelism = 1;
+    JoinBuildCancelChecker build_cancel_checker = nullptr;
+
     RuntimeProfile::Counter* search_ht_timer = nullptr;
     RuntimeProfile::Counter* output_build_column_timer = nullptr;
     RuntimeProfile::Counter* output_probe_column_timer = nullptr;
@@ -312,6 +464,17 @@ struct JoinKeyHash<Slice> {
     std::size_t operator()(const Slice& slice) const { return crc_hash_32(slice.data, slice.size, CRC_SEED); }
 };
 
+// The hash value is computed once when the key is created.
+template <>
+struct JoinKeyHash<JoinHashedSlice> {
+    std::size_t operator()(const JoinHashedSlice& key) const { return key.hash; }
+};
+
+inline JoinHashedSlice::JoinHashedSlice(const Slice& slice)
+        : data(slice.data), size(slice.size), hash(JoinKeyHash<Slice>()(slice)) {
+    memcpy(&prefix, data, std::min<size_t>(size, sizeof(prefix)));
+}
+
 class JoinHashMapHelper {
 public:
     // maxinum bucket size
@@ -341,6 +504,31 @@ public:
         }
     }
 
+    // probe_state->next[i] = first[buckets[i]], the first build row of the bucket of each probe row, and 0 for rows
+    // in |is_nulls|. If the hash table doesn't fit in cache, `first` of the bucket some rows ahead is prefetched, so
+    // that these random accesses are overlapped instead of stalling one by one.
+    static void lookup_first_build_rows(const JoinHashTableItems& table_items, HashTableProbeState* probe_state,
+                                        uint32_t row_count, const uint8_t* is_nulls) {
+        const uint32_t distance = table_items.probe_prefetch ? std::max(0, config::join_probe_prefetch_distance) : 0;
+        probe_state->prefetch_distance = distance;
+
+        const uint32_t* first = table_items.first.data();
+        const uint32_t* buckets = probe_state->buckets.data();
+        uint32_t* next = probe_state->next.data();
+        if (distance == 0) {
+            for (uint32_t i = 0; i < row_count; i++) {
+                next[i] = (is_nulls == nullptr || is_nulls[i] == 0) ? first[buckets[i]] : 0;
+            }
+            return;
+        }
+        for (uint32_t i = 0; i < row_count; i++) {
+            if (i + distance < row_count) {
+                __builtin_prefetch(first + buckets[i + distance], 0, 3);
+            }
+            next[i] = (is_nulls == nullptr || is_nulls[i] == 0) ? first[buckets[i]] : 0;
+        }
+    }
+
     static Slice get_hash_key(const Columns& key_columns, size_t row_idx, uint8_t* buffer) {
         size_t byte_size = 0;
         for (const auto& key_column : key_columns) {
@@ -357,27 +545,73 @@ public:
         using ColumnType = typename RunTimeTypeTraits<LT>::ColumnType;
 
         auto& data = reinterpret_cast<ColumnType*>(fixed_size_key_column)->get_data();
-        auto* buf = reinterpret_cast<uint8_t*>(&data[start]);
+        serialize_fixed_size_keys(key_columns, reinterpret_cast<uint8_t*>(&data[start]), sizeof(CppType), start,
+                                  count);
+    }
+
+    // Combine keys into fixed size keys of |byte_interval| bytes, written into |buf| which holds |count| keys.
+    // Only the columns of null-safe-equal keys are nullable here, and their null flags are packed into a bitmap
+    // after all the key values instead of taking one byte per key, so that the null value are always zero.
+    static void serialize_fixed_size_keys(const Columns& key_columns, uint8_t* buf, size_t byte_interval,
+                                          uint32_t start, uint32_t count) {
+        size_t null_bitmap_offset = 0;
+        for (const auto& key_col : key_columns) {
+            null_bitmap_offset += fixed_size_of_key_column(*key_col);
+        }
 
-        const size_t byte_interval = sizeof(CppType);
         size_t byte_offset = 0;
+        size_t null_bit = 0;
         for (const auto& key_col : key_columns) {
-            size_t offset = key_col->serialize_batch_at_interval(buf, byte_offset, byte_interval, start, count);
-            byte_offset += offset;
+            if (!key_col->is_nullable()) {
+                byte_offset += key_col->serialize_batch_at_interval(buf, byte_offset, byte_interval, start, count);
+                continue;
+            }
+
+            auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(key_col);
+            const auto& data_column = nullable_column->data_column();
+            size_t value_size = data_column->serialize_batch_at_interval(buf, byte_offset, byte_interval, start, count);
+            const auto& null_data = nullable_column->immutable_null_column_data();
+            const uint8_t mask = 1u << (null_bit & 7);
+            uint8_t* bitmap = buf + null_bitmap_offset + (null_bit >> 3);
+            for (uint32_t i = 0; i < count; i++) {
+                uint8_t* key = buf + i * byte_interval;
+                if (null_data[start + i]) {
+                    memset(key + byte_offset, 0, value_size);
+                    bitmap[i * byte_interval] |= mask;
+                } else {
+                    bitmap[i * byte_interval] &= ~mask;
+                }
+            }
+            byte_offset += value_size;
+            null_bit++;
         }
     }
+
+    // The bytes of one key value, excluding the null flag of nullable column.
+    static size_t fixed_size_of_key_column(const Column& key_col) {
+        if (key_col.is_nullable()) {
+            return down_cast<const NullableColumn&>(key_col).data_column()->type_size();
+        }
+        return key_col.type_size();
+    }
 };
 
+// String keys are hashed once into JoinHashedSlice, see JoinHashedSlice.
+template <LogicalType LT>
+using JoinKeyCppType = std::conditional_t<lt_is_string<LT>, JoinHashedSlice, typename RunTimeTypeTraits<LT>::CppType>;
+
 template <LogicalType LT>
 class JoinBuildFunc {
 public:
-    using CppType = typename RunTimeTypeTraits<LT>::CppType;
+    using CppType = JoinKeyCppType<LT>;
     using ColumnType = typename RunTimeTypeTraits<LT>::ColumnType;
 
     static void prepare(RuntimeState* runtime, JoinHashTableItems* table_items);
     static const Buffer<CppType>& get_key_data(const JoinHashTableItems& table_items);
     static void construct_hash_table(RuntimeState* state, JoinHashTableItems* table_items,
                                      HashTableProbeState* probe_state);
+    // Create the string keys referring to the key column, they are created again after the column is reordered.
+    static void init_build_slice(JoinHashTableItems* table_items);
 };
 
 template <LogicalType LT>
@@ -415,10 +649,36 @@ private:
                                         uint32_t count);
 };
 
+// Build func for fixed256, keys are packed the same way as FixedSizeJoinBuildFunc but kept in
+// JoinHashTableItems::build_key256 since there is no column type of 32 bytes.
+class FixedSize256JoinBuildFunc {
+public:
+    using CppType = JoinKey256;
+
+    static void prepare(RuntimeState* state, JoinHashTableItems* table_items);
+    static const Buffer<CppType>& get_key_data(const JoinHashTableItems& table_items) {
+        return table_items.build_key256;
+    }
+    static void construct_hash_table(RuntimeState* state, JoinHashTableItems* table_items,
+                                     HashTableProbeState* probe_state);
+
+private:
+    static void _build_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
+                               const Columns& data_columns, uint32_t start, uint32_t count);
+
+    static void _build_nullable_columns(JoinHashTableItems* table_items, HashTableProbeState* probe_state,
+                                        const Columns& data_columns, const NullColumns& null_columns, uint32_t start,
+                                        uint32_t count);
+};
+
 class SerializedJoinBuildFunc {
 public:
+    using CppType = JoinHashedSlice;
+
     static void prepare(RuntimeState* state, JoinHashTableItems* table_items);
-    static const Buffer<Slice>& get_key_data(const JoinHashTableItems& table_items) { return table_items.build_slice; }
+    static const Buffer<JoinHashedSlice>& get_key_data(const JoinHashTableItems& table_items) {
+        return table_items.build_slice;
+    }
     static void construct_hash_table(RuntimeState* state, JoinHashTableItems* table_items,
                                      HashTableProbeState* probe_state);
 
@@ -434,10 +694,14 @@ private:
 template <LogicalType LT>
 class JoinProbeFunc {
 public:
-    using CppType = typename RunTimeTypeTraits<LT>::CppType;
+    using CppType = JoinKeyCppType<LT>;
     using ColumnType = typename RunTimeTypeTraits<LT>::ColumnType;
 
-    static void prepare(RuntimeState* state, HashTableProbeState* probe_state) {}
+    static void prepare(RuntimeState* state, HashTableProbeState* probe_state) {
+        if constexpr (lt_is_string<LT>) {
+            probe_state->probe_slice.resize(state->chunk_size());
+        }
+    }
     static void lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
     static const Buffer<CppType>& get_key_data(const HashTableProbeState& probe_state);
     static bool equal(const CppType& x, const CppType& y) { return x == y; }
@@ -482,9 +746,38 @@ private:
                                        const Columns& data_columns, const NullColumns& null_columns);
 };
 
+class FixedSize256JoinProbeFunc {
+public:
+    using CppType = JoinKey256;
+
+    static void prepare(RuntimeState* state, HashTableProbeState* probe_state) {
+        probe_state->is_nulls.resize(state->chunk_size());
+        probe_state->probe_key256.resize(state->chunk_size());
+    }
+
+    // serialize and calculate hash values for probe keys.
+    static void lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
+
+    static const Buffer<CppType>& get_key_data(const HashTableProbeState& probe_state) {
+        return probe_state.probe_key256;
+    }
+
+    static bool equal(const CppType& x, const CppType& y) { return x == y; }
+
+private:
+    static void _probe_column(const JoinHashTableItems& table_items, HashTableProbeState* probe_state,
+                              const Columns& data_columns);
+    static void _probe_nullable_column(const JoinHashTableItems& table_items, HashTableProbeState* probe_state,
+                                       const Columns& data_columns, const NullColumns& null_columns);
+};
+
 class SerializedJoinProbeFunc {
 public:
-    static const Buffer<Slice>& get_key_data(const HashTableProbeState& probe_state) { return probe_state.probe_slice; }
+    using CppType = JoinHashedSlice;
+
+    static const Buffer<JoinHashedSlice>& get_key_data(const HashTableProbeState& probe_state) {
+        return probe_state.probe_slice;
+    }
 
     static void prepare(RuntimeState* state, HashTableProbeState* probe_state) {
         probe_state->probe_pool = std::make_unique<MemPool>();
@@ -494,7 +787,7 @@ public:
 
     static void lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
 
-    static bool equal(const Slice& x, const Slice& y) { return x == y; }
+    static bool equal(const JoinHashedSlice& x, const JoinHashedSlice& y) { return x == y; }
 
 private:
     static void _probe_column(const JoinHashTableItems& table_items, HashTableProbeState* probe_state,
@@ -512,7 +805,7 @@ public:
 
     void build_prepare(RuntimeState* state) { return; }
     void probe_prepare(RuntimeState* state) { return; }
-    void build(RuntimeState* state) { return; }
+    Status build(RuntimeState* state) { return Status::OK(); }
     void probe(RuntimeState* state, const Columns& key_columns, ChunkPtr* probe_chunk, ChunkPtr* chunk,
                bool* has_remain) {
         DCHECK_EQ(0, _table_items->row_count);
@@ -597,7 +890,7 @@ private:
 template <LogicalType LT, class BuildFunc, class ProbeFunc>
 class JoinHashMap {
 public:
-    using CppType = typename RunTimeTypeTraits<LT>::CppType;
+    using CppType = typename BuildFunc::CppType;
 
     explicit JoinHashMap(JoinHashTableItems* table_items, HashTableProbeState* probe_state)
             : _table_items(table_items), _probe_state(probe_state) {}
@@ -605,7 +898,7 @@ public:
     void build_prepare(RuntimeState* state);
     void probe_prepare(RuntimeState* state);
 
-    void build(RuntimeState* state);
+    Status build(RuntimeState* state);
     void probe(RuntimeState* state, const Columns& key_columns, ChunkPtr* probe_chunk, ChunkPtr* chunk,
                bool* has_remain);
     void probe_remain(RuntimeState* state, ChunkPtr* chunk, bool* has_remain);
@@ -736,6 +1029,8 @@ private:
 #define JoinHashMapForDirectMapping(LT) JoinHashMap<LT, DirectMappingJoinBuildFunc<LT>, DirectMappingJoinProbeFunc<LT>>
 #define JoinHashMapForFixedSizeKey(LT) JoinHashMap<LT, FixedSizeJoinBuildFunc<LT>, FixedSizeJoinProbeFunc<LT>>
 #define JoinHashMapForSerializedKey(LT) JoinHashMap<LT, SerializedJoinBuildFunc, SerializedJoinProbeFunc>
+// There is no logical type for the 32 bytes packed key, so TYPE_UNKNOWN is only a placeholder here.
+#define JoinHashMapForFixedSize256Key() JoinHashMap<TYPE_UNKNOWN, FixedSize256JoinBuildFunc, FixedSize256JoinProbeFunc>
 
 class JoinHashTable {
 public:
@@ -759,7 +1054,14 @@ public:
     void create(const HashTableParam& param);
     void close();
 
-    [[nodiscard]] Status build(RuntimeState* state);
+    // If the partitioned build is finished by helper threads after returning, is_build_async() is true and
+    // |callback| is called with the status of the build.
+    [[nodiscard]] Status build(RuntimeState* state, JoinBuildCallback callback = nullptr);
+    bool is_build_async() const { return _table_items->build_pending; }
+    // The helper threads of the build may still access the state of the fragment.
+    bool has_running_build_helpers() const {
+        return _table_items->build_runner != nullptr && _table_items->build_runner->has_running_helpers();
+    }
     void reset_probe_state(RuntimeState* state);
     [[nodiscard]] Status probe(RuntimeState* state, const Columns& key_columns, ChunkPtr* probe_chunk, ChunkPtr* chunk,
                                bool* eos);
@@ -775,6 +1077,7 @@ public:
     size_t get_probe_column_count() const { return _table_items->probe_column_count; }
     size_t get_build_column_count() const { return _table_items->build_column_count; }
     size_t get_bucket_size() const { return _table_items->bucket_size; }
+    uint32_t get_partition_num() const { return _table_items->partition_num; }
     float get_keys_per_bucket() const;
     void remove_duplicate_index(Filter* filter);
 
@@ -814,6 +1117,7 @@ private:
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_INT)> _fixed32 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_BIGINT)> _fixed64 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_LARGEINT)> _fixed128 = nullptr;
+    std::unique_ptr<JoinHashMapForFixedSize256Key()> _fixed256 = nullptr;
 
     JoinHashMapType _hash_map_type = JoinHashMapType::empty;
     bool _need_create_tuple_columns = true;
@@ -26,33 +26,51 @@ void JoinBuildFunc<LT>::prepare(RuntimeState* runtime, JoinHashTableItems* table
     table_items->bucket_size = JoinHashMapHelper::calc_bucket_size(table_items->row_count + 1);
     table_items->first.resize(table_items->bucket_size, 0);
     table_items->next.resize(table_items->row_count + 1, 0);
+    if constexpr (lt_is_string<LT>) {
+        table_items->build_slice.resize(table_items->row_count + 1);
+    }
 }
 
 template <LogicalType LT>
 const Buffer<typename JoinBuildFunc<LT>::CppType>& JoinBuildFunc<LT>::get_key_data(
         const JoinHashTableItems& table_items) {
-    ColumnPtr data_column;
-    if (table_items.key_columns[0]->is_nullable()) {
-        auto* null_column = ColumnHelper::as_raw_column<NullableColumn>(table_items.key_columns[0]);
-        data_column = null_column->data_column();
+    if constexpr (lt_is_string<LT>) {
+        return table_items.build_slice;
     } else {
-        data_column = table_items.key_columns[0];
+        ColumnPtr data_column;
+        if (table_items.key_columns[0]->is_nullable()) {
+            auto* null_column = ColumnHelper::as_raw_column<NullableColumn>(table_items.key_columns[0]);
+            data_column = null_column->data_column();
+        } else {
+            data_column = table_items.key_columns[0];
+        }
+        return ColumnHelper::as_raw_column<ColumnType>(data_column)->get_data();
     }
+}
 
+template <LogicalType LT>
+void JoinBuildFunc<LT>::init_build_slice(JoinHashTableItems* table_items) {
     if constexpr (lt_is_string<LT>) {
+        const Column* data_column = ColumnHelper::get_data_column(table_items->key_columns[0].get());
+        auto init = [&](const Buffer<Slice>& slices) {
+            for (size_t i = 0; i < table_items->row_count + 1; i++) {
+                table_items->build_slice[i] = JoinHashedSlice(slices[i]);
+            }
+        };
         if (UNLIKELY(data_column->is_large_binary())) {
-            return ColumnHelper::as_raw_column<LargeBinaryColumn>(data_column)->get_data();
+            init(down_cast<const LargeBinaryColumn*>(data_column)->get_data());
         } else {
-            return ColumnHelper::as_raw_column<BinaryColumn>(data_column)->get_data();
+            init(down_cast<const BinaryColumn*>(data_column)->get_data());
         }
-    } else {
-        return ColumnHelper::as_raw_column<ColumnType>(data_column)->get_data();
     }
 }
 
 template <LogicalType LT>
 void JoinBuildFunc<LT>::construct_hash_table(RuntimeState* state, JoinHashTableItems* table_items,
                                              HashTableProbeState* probe_state) {
+    if constexpr (lt_is_string<LT>) {
+        init_build_slice(table_items);
+    }
     auto& data = get_key_data(*table_items);
     if (table_items->key_columns[0]->is_nullable()) {
         auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[0]);
@@ -60,15 +78,13 @@ void JoinBuildFunc<LT>::construct_hash_table(RuntimeState* state, JoinHashTableI
         for (size_t i = 1; i < table_items->row_count + 1; i++) {
             if (null_array[i] == 0) {
                 uint32_t bucket_num = JoinHashMapHelper::calc_bucket_num<CppType>(data[i], table_items->bucket_size);
-                table_items->next[i] = table_items->first[bucket_num];
-                table_items->first[bucket_num] = i;
+                table_items->link_build_row(i, bucket_num);
             }
         }
     } else {
         for (size_t i = 1; i < table_items->row_count + 1; i++) {
             uint32_t bucket_num = JoinHashMapHelper::calc_bucket_num<CppType>(data[i], table_items->bucket_size);
-            table_items->next[i] = table_items->first[bucket_num];
-            table_items->first[bucket_num] = i;
+            table_items->link_build_row(i, bucket_num);
         }
     }
     table_items->calculate_ht_info(table_items->key_columns[0]->byte_size());
@@ -180,8 +196,7 @@ void FixedSizeJoinBuildFunc<LT>::_build_columns(JoinHashTableItems* table_items,
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items->bucket_size, &probe_state->buckets, start, count);
 
     for (uint32_t i = 0; i < count; i++) {
-        table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-        table_items->first[probe_state->buckets[i]] = start + i;
+        table_items->link_build_row(start + i, probe_state->buckets[i]);
     }
 }
 
@@ -206,8 +221,7 @@ void FixedSizeJoinBuildFunc<LT>::_build_nullable_columns(JoinHashTableItems* tab
 
     for (size_t i = 0; i < count; i++) {
         if (probe_state->is_nulls[i] == 0) {
-            table_items->next[start + i] = table_items->first[probe_state->buckets[i]];
-            table_items->first[probe_state->buckets[i]] = start + i;
+            table_items->link_build_row(start + i, probe_state->buckets[i]);
         }
     }
 }
@@ -262,35 +276,39 @@ const Buffer<typename DirectMappingJoinProbeFunc<LT>::CppType>& DirectMappingJoi
 template <LogicalType LT>
 void JoinProbeFunc<LT>::lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state) {
     size_t probe_row_count = probe_state->probe_row_count;
+    if constexpr (lt_is_string<LT>) {
+        const Column* data_column = ColumnHelper::get_data_column((*probe_state->key_columns)[0].get());
+        auto init = [&](const Buffer<Slice>& slices) {
+            for (size_t i = 0; i < probe_row_count; i++) {
+                probe_state->probe_slice[i] = JoinHashedSlice(slices[i]);
+            }
+        };
+        if (UNLIKELY(data_column->is_large_binary())) {
+            init(down_cast<const LargeBinaryColumn*>(data_column)->get_data());
+        } else {
+            init(down_cast<const BinaryColumn*>(data_column)->get_data());
+        }
+    }
     auto& data = get_key_data(*probe_state);
-    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, data.size());
+    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0,
+                                                 probe_row_count);
 
     if ((*probe_state->key_columns)[0]->is_nullable()) {
         auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[0]);
 
         if (nullable_column->has_null()) {
             auto& null_array = nullable_column->null_column()->get_data();
-            for (size_t i = 0; i < probe_row_count; i++) {
-                if (null_array[i] == 0) {
-                    probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-                } else {
-                    probe_state->next[i] = 0;
-                }
-            }
+            JoinHashMapHelper::lookup_first_build_rows(table_items, probe_state, probe_row_count, null_array.data());
             probe_state->null_array = &nullable_column->null_column()->get_data();
         } else {
-            for (size_t i = 0; i < probe_row_count; i++) {
-                probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-            }
+            JoinHashMapHelper::lookup_first_build_rows(table_items, probe_state, probe_row_count, nullptr);
             probe_state->null_array = nullptr;
         }
         probe_state->consider_probe_time_locality();
         return;
     }
 
-    for (size_t i = 0; i < probe_row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_first_build_rows(table_items, probe_state, probe_row_count, nullptr);
     probe_state->consider_probe_time_locality();
     probe_state->null_array = nullptr;
 }
@@ -298,12 +316,16 @@ void JoinProbeFunc<LT>::lookup_init(const JoinHashTableItems& table_items, HashT
 template <LogicalType LT>
 const Buffer<typename JoinProbeFunc<LT>::CppType>& JoinProbeFunc<LT>::get_key_data(
         const HashTableProbeState& probe_state) {
-    if ((*probe_state.key_columns)[0]->is_nullable()) {
-        auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>((*probe_state.key_columns)[0]);
-        return ColumnHelper::as_raw_column<ColumnType>(nullable_column->data_column())->get_data();
-    }
+    if constexpr (lt_is_string<LT>) {
+        return probe_state.probe_slice;
+    } else {
+        if ((*probe_state.key_columns)[0]->is_nullable()) {
+            auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>((*probe_state.key_columns)[0]);
+            return ColumnHelper::as_raw_column<ColumnType>(nullable_column->data_column())->get_data();
+        }
 
-    return ColumnHelper::as_raw_column<ColumnType>((*probe_state.key_columns)[0])->get_data();
+        return ColumnHelper::as_raw_column<ColumnType>((*probe_state.key_columns)[0])->get_data();
+    }
 }
 
 template <LogicalType LT>
@@ -351,9 +373,7 @@ void FixedSizeJoinProbeFunc<LT>::_probe_column(const JoinHashTableItems& table_i
     const auto& data = get_key_data(*probe_state);
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, row_count);
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_first_build_rows(table_items, probe_state, row_count, nullptr);
 }
 
 template <LogicalType LT>
@@ -377,13 +397,7 @@ void FixedSizeJoinProbeFunc<LT>::_probe_nullable_column(const JoinHashTableItems
     const auto& data = get_key_data(*probe_state);
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size, &probe_state->buckets, 0, row_count);
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        if (probe_state->is_nulls[i] == 0) {
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-        } else {
-            probe_state->next[i] = 0;
-        }
-    }
+    JoinHashMapHelper::lookup_first_build_rows(table_items, probe_state, row_count, probe_state->is_nulls.data());
 }
 
 template <LogicalType LT, class BuildFunc, class ProbeFunc>
@@ -411,8 +425,29 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::probe_prepare(RuntimeState* state) {
 }
 
 template <LogicalType LT, class BuildFunc, class ProbeFunc>
-void JoinHashMap<LT, BuildFunc, ProbeFunc>::build(RuntimeState* state) {
+Status JoinHashMap<LT, BuildFunc, ProbeFunc>::build(RuntimeState* state) {
+    // direct mapping hash table is small enough, and its bucket is not computed by hash.
+    if constexpr (!std::is_same_v<BuildFunc, DirectMappingJoinBuildFunc<LT>>) {
+        int64_t min_rows = config::hash_join_partitioned_build_min_rows;
+        _table_items->partitioned_build = min_rows > 0 && _table_items->row_count >= min_rows;
+    }
+    if (_table_items->partitioned_build) {
+        // rows not linked keep the bucket `bucket_size`.
+        _table_items->build_buckets.assign(_table_items->row_count + 1, _table_items->bucket_size);
+    }
     BuildFunc().construct_hash_table(state, _table_items, _probe_state);
+    if (_table_items->partitioned_build) {
+        // the serialized keys are in build_pool, which is not reordered, so only their slices are reordered.
+        bool reorder_build_slice = true;
+        std::function<void()> finish = nullptr;
+        if constexpr (std::is_same_v<BuildFunc, JoinBuildFunc<LT>> && lt_is_string<LT>) {
+            // the string keys refer to the key column, which is reordered, so the slices are rebuilt from it.
+            reorder_build_slice = false;
+            finish = [table_items = _table_items]() { BuildFunc::init_build_slice(table_items); };
+        }
+        return _table_items->partition_build_rows(reorder_build_slice, std::move(finish));
+    }
+    return Status::OK();
 }
 
 template <LogicalType LT, class BuildFunc, class ProbeFunc>
@@ -978,6 +1013,15 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::_search_ht_impl(RuntimeState* state,
     XXH_PREFETCH(y);              \
     co_await std::suspend_always{};
 
+// Prefetch the first build row of the probe row `prefetch_distance` rows ahead, so that the key comparison and the
+// chain walk of this row are overlapped with the cache misses of the following rows.
+#define PREFETCH_BUILD_ROW(i)                                                                             \
+    if (_probe_state->prefetch_distance > 0 && (i) + _probe_state->prefetch_distance < probe_row_count) { \
+        size_t prefetch_index = _probe_state->next[(i) + _probe_state->prefetch_distance];                \
+        XXH_PREFETCH(build_data.data() + prefetch_index);                                                 \
+        XXH_PREFETCH(_table_items->next.data() + prefetch_index);                                         \
+    }
+
 // When a probe row corresponds to multiple Build rows,
 // a Probe Chunk may generate multiple ResultChunks,
 // so each probe will have search one more row to determine whether it has reached the boundary,
@@ -1067,6 +1111,7 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::_probe_from_ht(RuntimeState* state,
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW(i)
         if constexpr (first_probe) {
             _probe_state->probe_match_filter[i] = 0;
         }
@@ -1212,6 +1257,7 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_outer_join(R
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW(i)
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             _probe_state->probe_index[match_count] = i;
@@ -1293,6 +1339,7 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_semi_join(Ru
     size_t match_count = 0;
     size_t probe_row_count = _probe_state->probe_row_count;
     for (size_t i = 0; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW(i)
         size_t index = _probe_state->next[i];
         if (index == 0) {
             continue;
@@ -1324,6 +1371,7 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_anti_join(Ru
     if (_table_items->join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN && _probe_state->null_array != nullptr) {
         // process left anti join from not in
         for (size_t i = 0; i < probe_row_count; i++) {
+            PREFETCH_BUILD_ROW(i)
             size_t index = _probe_state->next[i];
             if ((*_probe_state->null_array)[i] == 1) {
                 continue;
@@ -1350,6 +1398,7 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_anti_join(Ru
         }
     } else {
         for (size_t i = 0; i < probe_row_count; i++) {
+            PREFETCH_BUILD_ROW(i)
             size_t index = _probe_state->next[i];
             if (index == 0) {
                 _probe_state->probe_index[match_count] = i;
@@ -1461,6 +1510,7 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_outer_join(
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW(i)
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             continue;
@@ -1531,6 +1581,7 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_semi_join(R
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW(i)
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             continue;
@@ -1594,6 +1645,7 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::_probe_from_ht_for_right_anti_join(R
                                                                                const Buffer<CppType>& probe_data) {
     size_t probe_row_count = _probe_state->probe_row_count;
     for (size_t i = 0; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW(i)
         size_t index = _probe_state->next[i];
         if (index == 0) {
             continue;
@@ -1652,6 +1704,7 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::_probe_from_ht_for_full_outer_join(R
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW(i)
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             _probe_state->probe_index[match_count] = i;
@@ -1744,6 +1797,7 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_semi_join_wi
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW(i)
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             continue;
@@ -1821,6 +1875,7 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::_probe_from_ht_for_null_aware_anti_j
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW(i)
         _probe_state->cur_row_match_count = 0;
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
@@ -1984,6 +2039,7 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW(i)
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             continue;
@@ -2059,6 +2115,7 @@ void JoinHashMap<LT, BuildFunc, ProbeFunc>::_probe_from_ht_for_left_outer_left_a
 
     size_t probe_row_count = _probe_state->probe_row_count;
     for (; i < probe_row_count; i++) {
+        PREFETCH_BUILD_ROW(i)
         size_t build_index = _probe_state->next[i];
         if (build_index == 0) {
             _probe_state->probe_index[match_count] = i;
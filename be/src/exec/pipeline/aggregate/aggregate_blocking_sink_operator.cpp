@@ -20,6 +20,7 @@
 #include "column/column_helper.h"
 #include "column/vectorized_fwd.h"
 #include "runtime/current_thread.h"
+#include "util/hash_util.hpp"
 
 namespace starrocks::pipeline {
 
@@ -32,6 +33,9 @@ Status AggregateBlockingSinkOperator::prepare(RuntimeState* state) {
                                 _aggregator->limit() != -1 &&                 // has limit
                                 _aggregator->conjunct_ctxs().empty() &&       // no 'having' clause
                                 _aggregator->get_aggr_phase() == AggrPhase2); // phase 2, keep it to make things safe
+    // each driver only sees part of the input when the partial results are merged by partitions, so it can't
+    // stop inserting new groups at the limit.
+    _agg_group_by_with_limit &= _merge_context == nullptr;
     return Status::OK();
 }
 
@@ -67,11 +71,70 @@ Status AggregateBlockingSinkOperator::set_finishing(RuntimeState* state) {
     }
     COUNTER_UPDATE(_aggregator->input_row_count(), _aggregator->num_input_rows());
 
+    if (_merge_context != nullptr) {
+        RETURN_IF_ERROR(_partition_hash_map(state));
+    }
+
     _aggregator->sink_complete();
     _is_finished = true;
     return Status::OK();
 }
 
+Status AggregateBlockingSinkOperator::_partition_hash_map(RuntimeState* state) {
+    const int32_t num_partitions = _merge_context->num_partitions();
+    const size_t num_group_by_columns = _aggregator->group_by_expr_ctxs().size();
+    const size_t chunk_size = state->chunk_size();
+    AggregatePartitionedMergeContext::PartitionChunks partitions(num_partitions);
+
+    std::vector<uint32_t> hash_values;
+    std::vector<uint32_t> partition_row_indexes;
+    std::vector<uint32_t> partition_offsets(num_partitions + 1);
+    while (!_aggregator->is_ht_eos()) {
+        ChunkPtr chunk = std::make_shared<Chunk>();
+        RETURN_IF_ERROR(_aggregator->convert_hash_map_to_chunk(chunk_size, &chunk));
+        const size_t num_rows = chunk->num_rows();
+        if (num_rows == 0) {
+            continue;
+        }
+
+        // the group by columns are ahead of the aggregate function columns
+        hash_values.assign(num_rows, HashUtil::FNV_SEED);
+        for (size_t i = 0; i < num_group_by_columns; i++) {
+            chunk->get_column_by_index(i)->fnv_hash(hash_values.data(), 0, num_rows);
+        }
+
+        // group the row indexes by partition
+        std::fill(partition_offsets.begin(), partition_offsets.end(), 0);
+        for (size_t i = 0; i < num_rows; i++) {
+            hash_values[i] %= num_partitions;
+            partition_offsets[hash_values[i] + 1]++;
+        }
+        for (int32_t i = 0; i < num_partitions; i++) {
+            partition_offsets[i + 1] += partition_offsets[i];
+        }
+        partition_row_indexes.resize(num_rows);
+        for (size_t i = 0; i < num_rows; i++) {
+            partition_row_indexes[partition_offsets[hash_values[i]]++] = i;
+        }
+
+        uint32_t from = 0;
+        for (int32_t i = 0; i < num_partitions; i++) {
+            uint32_t size = partition_offsets[i] - from;
+            if (size > 0) {
+                auto& chunks = partitions[i];
+                if (chunks.empty() || chunks.back()->num_rows() + size > chunk_size) {
+                    chunks.emplace_back(chunk->clone_empty_with_slot(chunk_size));
+                }
+                chunks.back()->append_selective(*chunk, partition_row_indexes.data(), from, size);
+            }
+            from = partition_offsets[i];
+        }
+    }
+
+    _merge_context->add_partitions(_driver_sequence, std::move(partitions));
+    return Status::OK();
+}
+
 Status AggregateBlockingSinkOperator::reset_state(RuntimeState* state, const std::vector<ChunkPtr>& refill_chunks) {
     _is_finished = false;
     return _aggregator->reset_state(state, refill_chunks, this);
@@ -127,6 +190,9 @@ OperatorPtr AggregateBlockingSinkOperatorFactory::create(int32_t degree_of_paral
     // init operator
     auto aggregator = _aggregator_factory->get_or_create(driver_sequence);
     auto op = std::make_shared<AggregateBlockingSinkOperator>(aggregator, this, _id, _plan_node_id, driver_sequence);
+    if (_merge_context != nullptr) {
+        op->set_partitioned_merge_context(_merge_context);
+    }
     return op;
 }
 
@@ -18,6 +18,7 @@
 #include <utility>
 
 #include "exec/aggregator.h"
+#include "exec/pipeline/aggregate/aggregate_partitioned_merge_source_operator.h"
 #include "exec/pipeline/operator.h"
 #include "runtime/runtime_state.h"
 
@@ -45,6 +46,12 @@ public:
     [[nodiscard]] Status push_chunk(RuntimeState* state, const ChunkPtr& chunk) override;
     [[nodiscard]] Status reset_state(RuntimeState* state, const std::vector<ChunkPtr>& refill_chunks) override;
 
+    // Output the intermediate states partitioned by the group by keys into merge_context when finishing,
+    // instead of to the AggregateBlockingSourceOperator of the same driver.
+    void set_partitioned_merge_context(AggregatePartitionedMergeContextPtr merge_context) {
+        _merge_context = std::move(merge_context);
+    }
+
 protected:
     // It is used to perform aggregation algorithms shared by
     // AggregateBlockingSourceOperator. It is
@@ -54,10 +61,13 @@ protected:
     AggregatorPtr _aggregator = nullptr;
 
 private:
+    [[nodiscard]] Status _partition_hash_map(RuntimeState* state);
+
     // Whether prev operator has no output
     std::atomic_bool _is_finished = false;
     // whether enable aggregate group by limit optimize
     bool _agg_group_by_with_limit = false;
+    AggregatePartitionedMergeContextPtr _merge_context;
 };
 
 class AggregateBlockingSinkOperatorFactory final : public OperatorFactory {
@@ -73,7 +83,12 @@ public:
 
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override;
 
+    void set_partitioned_merge_context(AggregatePartitionedMergeContextPtr merge_context) {
+        _merge_context = std::move(merge_context);
+    }
+
 private:
     AggregatorFactoryPtr _aggregator_factory;
+    AggregatePartitionedMergeContextPtr _merge_context;
 };
 } // namespace starrocks::pipeline
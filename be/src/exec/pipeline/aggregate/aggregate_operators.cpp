@@ -16,6 +16,7 @@
 
 #include "aggregate_blocking_sink_operator.cpp"
 #include "aggregate_blocking_source_operator.cpp"
+#include "aggregate_partitioned_merge_source_operator.cpp"
 #include "aggregate_distinct_blocking_sink_operator.cpp"
 #include "aggregate_distinct_blocking_source_operator.cpp"
 #include "aggregate_distinct_streaming_sink_operator.cpp"
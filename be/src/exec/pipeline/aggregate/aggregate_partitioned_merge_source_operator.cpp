@@ -0,0 +1,110 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/pipeline/aggregate/aggregate_partitioned_merge_source_operator.h"
+
+#include "exec/exec_node.h"
+#include "runtime/current_thread.h"
+
+namespace starrocks::pipeline {
+
+Status AggregatePartitionedMergeSourceOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(SourceOperator::prepare(state));
+    RETURN_IF_ERROR(_aggregator->prepare(state, state->obj_pool(), _unique_metrics.get()));
+    return _aggregator->open(state);
+}
+
+bool AggregatePartitionedMergeSourceOperator::has_output() const {
+    return _merge_context->is_sink_complete() && !_aggregator->is_ht_eos();
+}
+
+bool AggregatePartitionedMergeSourceOperator::is_finished() const {
+    return _merge_context->is_sink_complete() && _aggregator->is_sink_complete() && _aggregator->is_ht_eos();
+}
+
+Status AggregatePartitionedMergeSourceOperator::set_finished(RuntimeState* state) {
+    return _aggregator->set_finished();
+}
+
+void AggregatePartitionedMergeSourceOperator::close(RuntimeState* state) {
+    auto* counter = ADD_COUNTER(_unique_metrics, "HashTableMemoryUsage", TUnit::BYTES);
+    counter->set(_aggregator->hash_map_memory_usage());
+    _aggregator->unref(state);
+    SourceOperator::close(state);
+}
+
+Status AggregatePartitionedMergeSourceOperator::_merge_next_chunk(RuntimeState* state) {
+    const int32_t partition = _driver_sequence;
+    while (_merge_sink_driver < _merge_context->num_partitions()) {
+        const auto& chunks = _merge_context->partition_chunks(_merge_sink_driver, partition);
+        if (_merge_chunk_index >= chunks.size()) {
+            _merge_sink_driver++;
+            _merge_chunk_index = 0;
+            continue;
+        }
+
+        const auto& chunk = chunks[_merge_chunk_index++];
+        const auto chunk_size = chunk->num_rows();
+        RETURN_IF_ERROR(_aggregator->evaluate_groupby_exprs(chunk.get()));
+
+        SCOPED_TIMER(_aggregator->agg_compute_timer());
+        TRY_CATCH_BAD_ALLOC(_aggregator->build_hash_map(chunk_size));
+        TRY_CATCH_BAD_ALLOC(_aggregator->try_convert_to_two_level_map());
+        RETURN_IF_ERROR(_aggregator->compute_batch_agg_states(chunk.get(), chunk_size));
+
+        _aggregator->update_num_input_rows(chunk_size);
+        return _aggregator->check_has_error();
+    }
+
+    _finish_merge();
+    return Status::OK();
+}
+
+void AggregatePartitionedMergeSourceOperator::_finish_merge() {
+    COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+    // If hash map is empty, we don't need to return value
+    if (_aggregator->hash_map_variant().size() == 0) {
+        _aggregator->set_ht_eos();
+    }
+    _aggregator->it_hash() = _aggregator->_state_allocator.begin();
+    COUNTER_UPDATE(_aggregator->input_row_count(), _aggregator->num_input_rows());
+    _aggregator->sink_complete();
+}
+
+StatusOr<ChunkPtr> AggregatePartitionedMergeSourceOperator::pull_chunk(RuntimeState* state) {
+    RETURN_IF_CANCELLED(state);
+
+    // merge one chunk at a time so that the driver could yield between the chunks.
+    if (!_aggregator->is_sink_complete()) {
+        RETURN_IF_ERROR(_merge_next_chunk(state));
+        return nullptr;
+    }
+
+    const auto chunk_size = state->chunk_size();
+    ChunkPtr chunk = std::make_shared<Chunk>();
+    RETURN_IF_ERROR(_aggregator->convert_hash_map_to_chunk(chunk_size, &chunk));
+
+    const int64_t old_size = chunk->num_rows();
+    eval_runtime_bloom_filters(chunk.get());
+
+    // For having
+    RETURN_IF_ERROR(eval_conjuncts_and_in_filters(_aggregator->conjunct_ctxs(), chunk.get()));
+    _aggregator->update_num_rows_returned(-(old_size - static_cast<int64_t>(chunk->num_rows())));
+
+    DCHECK_CHUNK(chunk);
+
+    return std::move(chunk);
+}
+
+} // namespace starrocks::pipeline
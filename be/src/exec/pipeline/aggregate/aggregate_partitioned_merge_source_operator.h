@@ -0,0 +1,128 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "exec/aggregator.h"
+#include "exec/pipeline/source_operator.h"
+
+namespace starrocks::pipeline {
+
+// AggregatePartitionedMergeContext is shared by all the sink and source drivers of a finalizing blocking
+// aggregation, which merges the partial results of the drivers partition by partition instead of shuffling
+// the input rows locally by the group by keys.
+// - Sink driver i aggregates its own input into intermediate states, and splits them into num_partitions
+//   partitions by the hash of the group by keys when it finishes.
+// - Source driver j merges partition j of all the sink drivers and finalizes it, once all the sink drivers
+//   have finished. Each group is merged by exactly one source driver, so no lock is needed.
+class AggregatePartitionedMergeContext {
+public:
+    using PartitionChunks = std::vector<std::vector<ChunkPtr>>;
+
+    explicit AggregatePartitionedMergeContext(int32_t num_partitions)
+            : _num_partitions(num_partitions), _partitions(num_partitions) {}
+
+    int32_t num_partitions() const { return _num_partitions; }
+
+    // Called once by each sink driver when it finishes, partitions[j] is the chunks of partition j.
+    void add_partitions(int32_t sink_driver_sequence, PartitionChunks&& partitions) {
+        DCHECK_LT(sink_driver_sequence, _num_partitions);
+        DCHECK_EQ(partitions.size(), _num_partitions);
+        _partitions[sink_driver_sequence] = std::move(partitions);
+        _num_finished_sinks.fetch_add(1, std::memory_order_release);
+    }
+
+    bool is_sink_complete() const { return _num_finished_sinks.load(std::memory_order_acquire) == _num_partitions; }
+
+    // Only valid after is_sink_complete() returns true.
+    const std::vector<ChunkPtr>& partition_chunks(int32_t sink_driver_sequence, int32_t partition) const {
+        return _partitions[sink_driver_sequence][partition];
+    }
+
+private:
+    const int32_t _num_partitions;
+    // sink driver sequence -> partition -> chunks, each element is only written by its sink driver.
+    std::vector<PartitionChunks> _partitions;
+    std::atomic<int32_t> _num_finished_sinks = 0;
+};
+using AggregatePartitionedMergeContextPtr = std::shared_ptr<AggregatePartitionedMergeContext>;
+
+// Merges the partition of the same driver sequence from all the sink drivers, and outputs the finalized result.
+class AggregatePartitionedMergeSourceOperator final : public SourceOperator {
+public:
+    AggregatePartitionedMergeSourceOperator(AggregatorPtr aggregator, AggregatePartitionedMergeContextPtr context,
+                                            OperatorFactory* factory, int32_t id, int32_t plan_node_id,
+                                            int32_t driver_sequence)
+            : SourceOperator(factory, id, "aggregate_partitioned_merge_source", plan_node_id, false,
+                             driver_sequence),
+              _aggregator(std::move(aggregator)),
+              _merge_context(std::move(context)) {
+        _aggregator->set_aggr_phase(AggrPhase2);
+        _aggregator->ref();
+    }
+
+    ~AggregatePartitionedMergeSourceOperator() override = default;
+
+    bool has_output() const override;
+    bool is_finished() const override;
+
+    [[nodiscard]] Status set_finished(RuntimeState* state) override;
+
+    [[nodiscard]] Status prepare(RuntimeState* state) override;
+    void close(RuntimeState* state) override;
+
+    [[nodiscard]] StatusOr<ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+private:
+    // Merge the next chunk of the partition into the hash map.
+    [[nodiscard]] Status _merge_next_chunk(RuntimeState* state);
+    void _finish_merge();
+
+    // It only merges the intermediate states of its own partition, and isn't shared with the sink operators.
+    AggregatorPtr _aggregator = nullptr;
+    AggregatePartitionedMergeContextPtr _merge_context;
+
+    // the position of the next chunk to merge
+    int32_t _merge_sink_driver = 0;
+    size_t _merge_chunk_index = 0;
+};
+
+class AggregatePartitionedMergeSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    AggregatePartitionedMergeSourceOperatorFactory(int32_t id, int32_t plan_node_id,
+                                                   AggregatorFactoryPtr aggregator_factory,
+                                                   AggregatePartitionedMergeContextPtr context)
+            : SourceOperatorFactory(id, "aggregate_partitioned_merge_source", plan_node_id),
+              _aggregator_factory(std::move(aggregator_factory)),
+              _merge_context(std::move(context)) {}
+
+    ~AggregatePartitionedMergeSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
+        DCHECK_EQ(degree_of_parallelism, _merge_context->num_partitions());
+        return std::make_shared<AggregatePartitionedMergeSourceOperator>(
+                _aggregator_factory->get_or_create(driver_sequence), _merge_context, this, _id, _plan_node_id,
+                driver_sequence);
+    }
+
+private:
+    AggregatorFactoryPtr _aggregator_factory = nullptr;
+    AggregatePartitionedMergeContextPtr _merge_context;
+};
+
+} // namespace starrocks::pipeline
@@ -14,6 +14,7 @@
 
 #include "aggregate_streaming_sink_operator.h"
 
+#include <algorithm>
 #include <variant>
 
 #include "column/vectorized_fwd.h"
@@ -29,12 +30,20 @@ Status AggregateStreamingSinkOperator::prepare(RuntimeState* state) {
     if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::LIMITED_MEM) {
         _limited_mem_state.limited_memory_size = config::streaming_agg_limited_memory_size;
     }
+    _auto_state_switch_counter = ADD_COUNTER(_unique_metrics, "AutoStateSwitchCount", TUnit::UNIT);
+    _auto_to_pass_through_counter = ADD_COUNTER(_unique_metrics, "AutoToPassThroughCount", TUnit::UNIT);
+    _auto_to_preagg_counter = ADD_COUNTER(_unique_metrics, "AutoToPreaggCount", TUnit::UNIT);
+    _auto_backpressure_counter = ADD_COUNTER(_unique_metrics, "AutoBackpressureCount", TUnit::UNIT);
     return _aggregator->open(state);
 }
 
 void AggregateStreamingSinkOperator::close(RuntimeState* state) {
     auto* counter = ADD_COUNTER(_unique_metrics, "HashTableMemoryUsage", TUnit::BYTES);
     counter->set(_aggregator->hash_map_memory_usage());
+    if (_auto_context.avg_reduction >= 0) {
+        _unique_metrics->add_info_string("AutoAvgReduction", std::to_string(_auto_context.avg_reduction));
+        _unique_metrics->add_info_string("AutoLastState", _auto_context.get_auto_state_string(_auto_state));
+    }
     _aggregator->unref(state);
     Operator::close(state);
 }
@@ -149,20 +158,38 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_selective_preaggregation(c
     return Status::OK();
 }
 
+void AggregateStreamingSinkOperator::_switch_auto_state(AggrAutoState new_state) {
+    VLOG_ROW << "auto agg: " << _auto_context.get_auto_state_string(_auto_state) << " -> "
+             << _auto_context.get_auto_state_string(new_state) << ", avg reduction " << _auto_context.avg_reduction;
+    _auto_state = new_state;
+    COUNTER_UPDATE(_auto_state_switch_counter, 1);
+    if (new_state == AggrAutoState::PASS_THROUGH) {
+        COUNTER_UPDATE(_auto_to_pass_through_counter, 1);
+    } else if (new_state == AggrAutoState::PREAGG || new_state == AggrAutoState::FORCE_PREAGG) {
+        COUNTER_UPDATE(_auto_to_preagg_counter, 1);
+    }
+}
+
 /* A state machine autoly chooses different preaggregation modes. If the initial preaggregation cannot insert
  * more data into hash table, the state shifts from INIT_PREAGG to ADJUST. The ADJUST state has 3 branches:
  * (1) If continuous AggrAutoContext::StableLimit chunks are lowly aggregated, shifting to PASS_THROUGH state;
  * (2) Else if continuous AggrAutoContext::StableLimit chunks are highly aggregated, shifting to PREAGG state;
  * (3) otherwise or the ADJUST state sustains continuous_limit times, shifting to SELECTIVE_PREAGG state.
+ * A chunk is lowly aggregated with a higher reduction if the hash table is out of the last level cache, since
+ * probing it costs a cache miss per row.
  *
  * PASS_THROUGH state sustains continuous_limit times, it will force doing preaggregation if the hash table's size <
  * MaxHtSize, otherwise it will go to ADJUST state. Doing FORCE_PREAGG aims freshening the hash table with new coming
- * rows, helping to aggregating new coming chunks with limiting the size of hash table.
+ * rows, helping to aggregating new coming chunks with limiting the size of hash table. If the chunk buffer is kept
+ * full by the downstream, the network rather than the aggregation is the bottleneck, so PASS_THROUGH ends early to
+ * try reducing the rows to send.
  *
  * FORCE_PREAGG/PREAGG state aggregates AggrAutoContext::PreaggLimit chunks, then going to ADJUST state. PreaggLimit
- * should be small enough to limit the size of hash table.
+ * should be small enough to limit the size of hash table. PREAGG goes to ADJUST early once the moving average of the
+ * reduction becomes low.
  *
- * SELECTIVE_PREAGG state aggregates continuous_limit chunks, then shifting to ADJUST state.
+ * SELECTIVE_PREAGG state aggregates continuous_limit chunks, then shifting to ADJUST state, or shifts early once
+ * the moving average of the reduction becomes low or high.
  */
 Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const ChunkPtr& chunk, const size_t chunk_size) {
     size_t allocated_bytes = _aggregator->hash_map_variant().allocated_memory_usage(_aggregator->mem_pool());
@@ -188,10 +215,8 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const ChunkPtr& chunk
             COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
             break;
         } else {
-            _auto_state = AggrAutoState::ADJUST;
+            _switch_auto_state(AggrAutoState::ADJUST);
             _auto_context.adjust_count = 0;
-            VLOG_ROW << "auto agg: " << _auto_context.get_auto_state_string(AggrAutoState::INIT_PREAGG) << " "
-                     << _auto_context.init_preagg_count << " -> " << _auto_context.get_auto_state_string(_auto_state);
         }
     }
     case AggrAutoState::ADJUST: {
@@ -202,17 +227,16 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const ChunkPtr& chunk
         }
 
         size_t hit_count = SIMD::count_zero(_aggregator->streaming_selection());
-        if (_auto_context.adjust_count < continuous_limit && _auto_context.is_low_reduction(hit_count, chunk_size)) {
+        _auto_context.update_reduction(hit_count, chunk_size);
+        if (_auto_context.adjust_count < continuous_limit &&
+            _auto_context.is_low_reduction(hit_count, chunk_size, allocated_bytes)) {
             RETURN_IF_ERROR(_push_chunk_by_force_streaming(chunk));
             _auto_context.pass_through_count++;
             _auto_context.preagg_count = 0;
             _auto_context.selective_preagg_count = 0;
             if (_auto_context.pass_through_count == AggrAutoContext::StableLimit) {
-                _auto_state = AggrAutoState::PASS_THROUGH;
-                VLOG_ROW << "auto agg: continuous " << AggrAutoContext::StableLimit << " low reduction "
-                         << hit_count * 1.0 / chunk_size << " "
-                         << _auto_context.get_auto_state_string(AggrAutoState::ADJUST) << " -> "
-                         << _auto_context.get_auto_state_string(_auto_state);
+                _switch_auto_state(AggrAutoState::PASS_THROUGH);
+                _auto_context.backpressure_count = 0;
             }
 
         } else if (_auto_context.adjust_count < continuous_limit &&
@@ -224,12 +248,8 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const ChunkPtr& chunk
             _auto_context.pass_through_count = 0;
             _auto_context.selective_preagg_count = 0;
             if (_auto_context.preagg_count == AggrAutoContext::StableLimit) {
-                _auto_state = AggrAutoState::PREAGG;
+                _switch_auto_state(AggrAutoState::PREAGG);
                 _auto_context.preagg_count = 0;
-                VLOG_ROW << "auto agg: continuous " << AggrAutoContext::StableLimit << " high reduction "
-                         << hit_count * 1.0 / chunk_size << " "
-                         << _auto_context.get_auto_state_string(AggrAutoState::ADJUST) << " -> "
-                         << _auto_context.get_auto_state_string(_auto_state);
             }
         } else {
             RETURN_IF_ERROR(_push_chunk_by_selective_preaggregation(chunk, chunk_size, false));
@@ -237,10 +257,7 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const ChunkPtr& chunk
             _auto_context.pass_through_count = 0;
             _auto_context.preagg_count = 0;
             if (_auto_context.selective_preagg_count == AggrAutoContext::StableLimit) {
-                _auto_state = AggrAutoState::SELECTIVE_PREAGG;
-                VLOG_ROW << "auto agg: continuous " << AggrAutoContext::StableLimit << " "
-                         << _auto_context.get_auto_state_string(AggrAutoState::ADJUST)
-                         << _auto_context.get_auto_state_string(_auto_state);
+                _switch_auto_state(AggrAutoState::SELECTIVE_PREAGG);
             }
         }
         break;
@@ -248,47 +265,59 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const ChunkPtr& chunk
     case AggrAutoState::PASS_THROUGH: {
         RETURN_IF_ERROR(_push_chunk_by_force_streaming(chunk));
         _auto_context.pass_through_count++;
-        if (_auto_context.pass_through_count > continuous_limit) {
-            _auto_state =
-                    allocated_bytes < AggrAutoContext::MaxHtSize ? AggrAutoState::FORCE_PREAGG : AggrAutoState::ADJUST;
+        if (config::enable_streaming_agg_adaptive_reduction && _aggregator->is_chunk_buffer_full()) {
+            _auto_context.backpressure_count++;
+        }
+        const bool backpressured = _auto_context.is_backpressured(allocated_bytes);
+        if (_auto_context.pass_through_count > continuous_limit || backpressured) {
+            _switch_auto_state(allocated_bytes < AggrAutoContext::MaxHtSize ? AggrAutoState::FORCE_PREAGG
+                                                                            : AggrAutoState::ADJUST);
             _auto_context.pass_through_count = 0;
             _auto_context.preagg_count = 0;
             _auto_context.adjust_count = 0;
-
-            VLOG_ROW << "auto agg: continuous " << continuous_limit << " "
-                     << _auto_context.get_auto_state_string(AggrAutoState::PASS_THROUGH) << " -> "
-                     << _auto_context.get_auto_state_string(_auto_state);
-            _auto_context.update_continuous_limit();
+            _auto_context.backpressure_count = 0;
+            if (backpressured) {
+                COUNTER_UPDATE(_auto_backpressure_counter, 1);
+            } else {
+                _auto_context.update_continuous_limit();
+            }
         }
         break;
     }
     case AggrAutoState::FORCE_PREAGG:
     case AggrAutoState::PREAGG: {
+        const size_t ht_size = _aggregator->hash_map_variant().size();
         RETURN_IF_ERROR(_push_chunk_by_force_preaggregation(chunk, chunk_size));
+        if (!_aggregator->is_none_group_by_exprs()) {
+            // the rows not creating new groups hit the existing ones
+            const size_t new_groups = _aggregator->hash_map_variant().size() - ht_size;
+            _auto_context.update_reduction(chunk_size - std::min(new_groups, chunk_size), chunk_size);
+        }
         _auto_context.preagg_count++;
         auto limit = _auto_state == AggrAutoState::FORCE_PREAGG ? AggrAutoContext::ForcePreaggLimit
                                                                 : AggrAutoContext::PreaggLimit;
-        if (_auto_context.preagg_count > limit) {
-            auto current_state = _auto_context.get_auto_state_string(_auto_state);
-            _auto_state = AggrAutoState::ADJUST;
+        // stop aggregating a stream which has turned to be lowly aggregated without waiting PreaggLimit chunks
+        const bool low_reduction =
+                _auto_state == AggrAutoState::PREAGG && _auto_context.should_leave_preagg(allocated_bytes);
+        if (_auto_context.preagg_count > limit || low_reduction) {
+            _switch_auto_state(AggrAutoState::ADJUST);
             _auto_context.preagg_count = 0;
             _auto_context.adjust_count = 0;
-            VLOG_ROW << "auto agg: continuous " << AggrAutoContext::PreaggLimit << " " << current_state << " -> "
-                     << _auto_context.get_auto_state_string(_auto_state);
         }
         break;
     }
     case AggrAutoState::SELECTIVE_PREAGG: {
         RETURN_IF_ERROR(_push_chunk_by_selective_preaggregation(chunk, chunk_size, true));
+        _auto_context.update_reduction(SIMD::count_zero(_aggregator->streaming_selection()), chunk_size);
         _auto_context.selective_preagg_count++;
-        if (_auto_context.selective_preagg_count > continuous_limit) {
-            _auto_state = AggrAutoState::ADJUST;
+        const bool stable = _auto_context.should_leave_selective_preagg(allocated_bytes);
+        if (_auto_context.selective_preagg_count > continuous_limit || stable) {
+            _switch_auto_state(AggrAutoState::ADJUST);
             _auto_context.selective_preagg_count = 0;
             _auto_context.adjust_count = 0;
-            VLOG_ROW << "auto agg: continuous " << continuous_limit << " "
-                     << _auto_context.get_auto_state_string(AggrAutoState::SELECTIVE_PREAGG) << " -> "
-                     << _auto_context.get_auto_state_string(_auto_state);
-            _auto_context.update_continuous_limit();
+            if (!stable) {
+                _auto_context.update_continuous_limit();
+            }
         }
         break;
     }
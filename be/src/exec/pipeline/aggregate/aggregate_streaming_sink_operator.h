@@ -65,6 +65,9 @@ private:
     // Invoked by push_chunk  if current mode is TStreamingPreaggregationMode::LIMITED
     [[nodiscard]] Status _push_chunk_by_limited_memory(const ChunkPtr& chunk, const size_t chunk_size);
 
+    // Shift the state of the auto mode and record the transition in the profile.
+    void _switch_auto_state(AggrAutoState new_state);
+
     // It is used to perform aggregation algorithms shared by
     // AggregateStreamingSourceOperator. It is
     // - prepared at SinkOperator::prepare(),
@@ -76,6 +79,12 @@ private:
     AggrAutoState _auto_state{};
     AggrAutoContext _auto_context;
     LimitedMemAggState _limited_mem_state;
+
+    RuntimeProfile::Counter* _auto_state_switch_counter = nullptr;
+    RuntimeProfile::Counter* _auto_to_pass_through_counter = nullptr;
+    RuntimeProfile::Counter* _auto_to_preagg_counter = nullptr;
+    // times of leaving PASS_THROUGH early because the chunk buffer is kept full by the downstream
+    RuntimeProfile::Counter* _auto_backpressure_counter = nullptr;
 };
 
 class AggregateStreamingSinkOperatorFactory final : public OperatorFactory {
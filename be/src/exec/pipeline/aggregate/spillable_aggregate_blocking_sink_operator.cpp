@@ -25,6 +25,7 @@
 #include "gen_cpp/InternalService_types.h"
 #include "runtime/current_thread.h"
 #include "storage/chunk_helper.h"
+#include "util/compression/compression_utils.h"
 
 namespace starrocks::pipeline {
 bool SpillableAggregateBlockingSinkOperator::need_input() const {
@@ -297,6 +298,9 @@ Status SpillableAggregateBlockingSinkOperatorFactory::prepare(RuntimeState* stat
     _spill_options->name = "agg-blocking-spill";
     _spill_options->plan_node_id = _plan_node_id;
     _spill_options->encode_level = state->spill_encode_level();
+    _spill_options->compress_type = CompressionUtils::to_compression_pb(state->spill_compression_type());
+    _spill_options->serde_type = state->enable_spill_column_encoding() ? spill::SerdeType::ENCODED_BY_COLUMN
+                                                                      : spill::SerdeType::BY_COLUMN;
 
     return Status::OK();
 }
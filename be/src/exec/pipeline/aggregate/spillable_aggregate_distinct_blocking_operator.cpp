@@ -18,6 +18,7 @@
 
 #include "exec/sorted_streaming_aggregator.h"
 #include "exec/spill/spiller.hpp"
+#include "util/compression/compression_utils.h"
 
 namespace starrocks::pipeline {
 bool SpillableAggregateDistinctBlockingSinkOperator::need_input() const {
@@ -147,6 +148,9 @@ Status SpillableAggregateDistinctBlockingSinkOperatorFactory::prepare(RuntimeSta
     _spill_options->name = "agg-distinct-blocking-spill";
     _spill_options->plan_node_id = _plan_node_id;
     _spill_options->encode_level = state->spill_encode_level();
+    _spill_options->compress_type = CompressionUtils::to_compression_pb(state->spill_compression_type());
+    _spill_options->serde_type = state->enable_spill_column_encoding() ? spill::SerdeType::ENCODED_BY_COLUMN
+                                                                      : spill::SerdeType::BY_COLUMN;
 
     return Status::OK();
 }
@@ -16,6 +16,7 @@
 
 #include <arpa/inet.h>
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -25,6 +26,7 @@
 #include "common/config.h"
 #include "exec/pipeline/exchange/shuffler.h"
 #include "exec/pipeline/exchange/sink_buffer.h"
+#include "exec/pipeline/exchange/transmit_request_batch.h"
 #include "exprs/expr.h"
 #include "runtime/data_stream_mgr.h"
 #include "runtime/descriptors.h"
@@ -35,6 +37,7 @@
 #include "service/brpc.h"
 #include "util/compression/block_compression.h"
 #include "util/compression/compression_utils.h"
+#include "util/time.h"
 
 namespace starrocks::pipeline {
 
@@ -54,7 +57,8 @@ public:
               _enable_exchange_pass_through(enable_exchange_pass_through),
               _enable_exchange_perf(enable_exchange_perf),
               _pass_through_context(pass_through_chunk_buffer, fragment_instance_id, dest_node_id),
-              _chunks(num_shuffles) {}
+              _chunks(num_shuffles),
+              _chunk_start_ms(num_shuffles, 0) {}
 
     // Initialize channel.
     // Returns OK if successful, error indication otherwise.
@@ -82,6 +86,13 @@ public:
     Status add_rows_selective(Chunk* chunk, int32_t driver_sequence, const uint32_t* row_indexes, uint32_t from,
                               uint32_t size, RuntimeState* state);
 
+    // Send all the rows batched in this channel if some of them have waited longer than
+    // max_transmit_batched_delay_ms.
+    Status send_stale_rows(RuntimeState* state, int64_t now_ms);
+
+    // The time when the oldest rows batched in this channel are added, -1 if there are no rows batched.
+    int64_t oldest_batched_ms() const;
+
     // Flush buffered rows and close channel. This function don't wait the response
     // of close operation, client should call close_wait() to finish channel's close.
     // We split one close operation into two phases in order to make multiple channels
@@ -105,6 +116,9 @@ private:
     bool _check_use_pass_through();
     void _prepare_pass_through();
 
+    bool _has_stale_rows(int64_t now_ms) const;
+    Status _send_request(RuntimeState* state, bool eos);
+
     ExchangeSinkOperator* _parent;
 
     const TNetworkAddress _brpc_dest_addr;
@@ -125,8 +139,10 @@ private:
     // If pipeline level shuffle is disable, the size of _chunks
     // always be 1
     std::vector<std::unique_ptr<Chunk>> _chunks;
+    // The time when the first row is appended to each of _chunks, only set if max_transmit_batched_delay_ms is set
+    std::vector<int64_t> _chunk_start_ms;
     PTransmitChunkParamsPtr _chunk_request;
-    size_t _current_request_bytes = 0;
+    TransmitRequestBatch _request_batch;
 
     bool _is_inited = false;
     bool _use_pass_through = false;
@@ -199,6 +215,9 @@ Status ExchangeSinkOperator::Channel::add_rows_selective(Chunk* chunk, int32_t d
         // we only clear column data, because we need to reuse column schema
         _chunks[driver_sequence]->set_num_rows(0);
     }
+    if (_chunks[driver_sequence]->num_rows() == 0 && config::max_transmit_batched_delay_ms > 0) {
+        _chunk_start_ms[driver_sequence] = MonotonicMillis();
+    }
 
     {
         SCOPED_TIMER(_parent->_shuffle_chunk_append_timer);
@@ -232,15 +251,17 @@ Status ExchangeSinkOperator::Channel::send_one_chunk(RuntimeState* state, const
         }
     }
 
+    const int64_t now_ms = MonotonicMillis();
     // If chunk is not null, append it to request
     if (chunk != nullptr) {
+        size_t request_bytes = 0;
         if (_use_pass_through) {
             size_t chunk_size = serde::ProtobufChunkSerde::max_serialized_size(*chunk);
             // -1 means disable pipeline level shuffle
             TRY_CATCH_BAD_ALLOC(
                     _pass_through_context.append_chunk(_parent->_sender_id, chunk, chunk_size,
                                                        _parent->_is_pipeline_level_shuffle ? driver_sequence : -1));
-            _current_request_bytes += chunk_size;
+            request_bytes = chunk_size;
             COUNTER_UPDATE(_parent->_bytes_pass_through_counter, chunk_size);
             COUNTER_SET(_parent->_pass_through_buffer_peak_mem_usage, _pass_through_context.total_bytes());
         } else {
@@ -249,31 +270,78 @@ Status ExchangeSinkOperator::Channel::send_one_chunk(RuntimeState* state, const
             }
             auto pchunk = _chunk_request->add_chunks();
             TRY_CATCH_BAD_ALLOC(RETURN_IF_ERROR(_parent->serialize_chunk(chunk, pchunk, &_is_first_chunk)));
-            _current_request_bytes += pchunk->data().size();
+            request_bytes = pchunk->data().size();
         }
+        _request_batch.add(request_bytes, chunk->num_rows(), now_ms);
     }
 
     // Try to accumulate enough bytes before sending a RPC. When eos is true we should send
     // last packet
-    if (_current_request_bytes > config::max_transmit_batched_bytes || eos) {
-        _chunk_request->set_eos(eos);
-        _chunk_request->set_use_pass_through(_use_pass_through);
-        if (auto delta_statistic = state->intermediate_query_statistic()) {
-            delta_statistic->to_pb(_chunk_request->mutable_query_statistics());
-        }
-        butil::IOBuf attachment;
-        int64_t attachment_physical_bytes = _parent->construct_brpc_attachment(_chunk_request, attachment);
-        TransmitChunkInfo info = {this->_fragment_instance_id, _brpc_stub,     std::move(_chunk_request), attachment,
-                                  attachment_physical_bytes,   _brpc_dest_addr};
-        RETURN_IF_ERROR(_parent->_buffer->add_request(info));
-        _current_request_bytes = 0;
-        _chunk_request.reset();
+    if (eos || _request_batch.is_full(now_ms)) {
+        RETURN_IF_ERROR(_send_request(state, eos));
         *is_real_sent = true;
     }
 
     return Status::OK();
 }
 
+Status ExchangeSinkOperator::Channel::_send_request(RuntimeState* state, bool eos) {
+    _chunk_request->set_eos(eos);
+    _chunk_request->set_use_pass_through(_use_pass_through);
+    if (auto delta_statistic = state->intermediate_query_statistic()) {
+        delta_statistic->to_pb(_chunk_request->mutable_query_statistics());
+    }
+    butil::IOBuf attachment;
+    int64_t attachment_physical_bytes = _parent->construct_brpc_attachment(_chunk_request, attachment);
+    TransmitChunkInfo info = {this->_fragment_instance_id, _brpc_stub,     std::move(_chunk_request), attachment,
+                              attachment_physical_bytes,   _brpc_dest_addr};
+    RETURN_IF_ERROR(_parent->_buffer->add_request(info));
+    _request_batch.reset();
+    _chunk_request.reset();
+    return Status::OK();
+}
+
+bool ExchangeSinkOperator::Channel::_has_stale_rows(int64_t now_ms) const {
+    if (_request_batch.is_stale(now_ms)) {
+        return true;
+    }
+    for (size_t i = 0; i < _chunks.size(); ++i) {
+        if (_chunks[i] != nullptr && _chunks[i]->num_rows() > 0 &&
+            TransmitRequestBatch::is_stale_since(_chunk_start_ms[i], now_ms)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int64_t ExchangeSinkOperator::Channel::oldest_batched_ms() const {
+    int64_t oldest_ms = _request_batch.rows() > 0 ? _request_batch.start_ms() : -1;
+    for (size_t i = 0; i < _chunks.size(); ++i) {
+        if (_chunks[i] != nullptr && _chunks[i]->num_rows() > 0 && (oldest_ms < 0 || _chunk_start_ms[i] < oldest_ms)) {
+            oldest_ms = _chunk_start_ms[i];
+        }
+    }
+    return oldest_ms;
+}
+
+Status ExchangeSinkOperator::Channel::send_stale_rows(RuntimeState* state, int64_t now_ms) {
+    if (!_has_stale_rows(now_ms)) {
+        return Status::OK();
+    }
+    // Send the rows of all the driver sequences in one request rather than only the stale ones.
+    for (int32_t driver_sequence = 0; driver_sequence < _chunks.size(); ++driver_sequence) {
+        auto& chunk = _chunks[driver_sequence];
+        if (chunk != nullptr && chunk->num_rows() > 0) {
+            RETURN_IF_ERROR(send_one_chunk(state, chunk.get(), driver_sequence, false));
+            chunk->set_num_rows(0);
+        }
+    }
+    if (_chunk_request != nullptr && _request_batch.rows() > 0) {
+        RETURN_IF_ERROR(_send_request(state, false));
+    }
+    return Status::OK();
+}
+
 Status ExchangeSinkOperator::Channel::send_chunk_request(RuntimeState* state, PTransmitChunkParamsPtr chunk_request,
                                                          const butil::IOBuf& attachment,
                                                          int64_t attachment_physical_bytes) {
@@ -474,6 +542,15 @@ bool ExchangeSinkOperator::need_input() const {
     return !is_finished() && _buffer != nullptr && !_buffer->is_full();
 }
 
+bool ExchangeSinkOperator::need_flush() const {
+    // The batched rows are sent once they become stale even if no more chunk is pushed.
+    return need_input() && _has_stale_rows(MonotonicMillis());
+}
+
+Status ExchangeSinkOperator::flush(RuntimeState* state) {
+    return _send_stale_rows(state);
+}
+
 bool ExchangeSinkOperator::pending_finish() const {
     return _buffer != nullptr && !_buffer->is_finished();
 }
@@ -492,6 +569,10 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const ChunkPtr& chu
     if (num_rows == 0) {
         return Status::OK();
     }
+    if (_oldest_batched_ms < 0 && config::max_transmit_batched_delay_ms > 0) {
+        // the rows of this chunk may be batched, and they are not older than now.
+        _oldest_batched_ms = MonotonicMillis();
+    }
     DCHECK_LE(num_rows, state->chunk_size());
 
     Chunk temp_chunk;
@@ -527,20 +608,11 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const ChunkPtr& chu
             // 2. serialize input chunk to pchunk
             TRY_CATCH_BAD_ALLOC(
                     RETURN_IF_ERROR(serialize_chunk(send_chunk, pchunk, &_is_first_chunk, _channels.size())));
-            _current_request_bytes += pchunk->data().size();
-            // 3. if request bytes exceede the threshold, send current request
-            if (_current_request_bytes > config::max_transmit_batched_bytes) {
-                butil::IOBuf attachment;
-                int64_t attachment_physical_bytes = construct_brpc_attachment(_chunk_request, attachment);
-                for (auto idx : _channel_indices) {
-                    if (!_channels[idx]->use_pass_through()) {
-                        PTransmitChunkParamsPtr copy = std::make_shared<PTransmitChunkParams>(*_chunk_request);
-                        RETURN_IF_ERROR(
-                                _channels[idx]->send_chunk_request(state, copy, attachment, attachment_physical_bytes));
-                    }
-                }
-                _current_request_bytes = 0;
-                _chunk_request.reset();
+            const int64_t now_ms = MonotonicMillis();
+            _request_batch.add(pchunk->data().size(), send_chunk->num_rows(), now_ms);
+            // 3. if request is full, send current request
+            if (_request_batch.is_full(now_ms)) {
+                RETURN_IF_ERROR(_send_broadcast_request(state));
             }
         }
     } else if (_part_type == TPartitionType::RANDOM) {
@@ -630,6 +702,48 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const ChunkPtr& chu
             }
         }
     }
+
+    // The channels receiving few rows of a wide shuffle may batch their rows for long.
+    return _send_stale_rows(state);
+}
+
+Status ExchangeSinkOperator::_send_broadcast_request(RuntimeState* state) {
+    butil::IOBuf attachment;
+    int64_t attachment_physical_bytes = construct_brpc_attachment(_chunk_request, attachment);
+    for (auto idx : _channel_indices) {
+        if (!_channels[idx]->use_pass_through()) {
+            PTransmitChunkParamsPtr copy = std::make_shared<PTransmitChunkParams>(*_chunk_request);
+            RETURN_IF_ERROR(_channels[idx]->send_chunk_request(state, copy, attachment, attachment_physical_bytes));
+        }
+    }
+    _request_batch.reset();
+    _chunk_request.reset();
+    return Status::OK();
+}
+
+bool ExchangeSinkOperator::_has_stale_rows(int64_t now_ms) const {
+    return _oldest_batched_ms >= 0 && TransmitRequestBatch::is_stale_since(_oldest_batched_ms, now_ms);
+}
+
+Status ExchangeSinkOperator::_send_stale_rows(RuntimeState* state) {
+    // Scanning all the channels is not free for a wide shuffle, so it is only done once the oldest batched rows
+    // become stale.
+    const int64_t now_ms = MonotonicMillis();
+    if (!_has_stale_rows(now_ms)) {
+        return Status::OK();
+    }
+    if (_chunk_request != nullptr && _request_batch.is_stale(now_ms)) {
+        RETURN_IF_ERROR(_send_broadcast_request(state));
+    }
+    int64_t oldest_ms = _chunk_request != nullptr && _request_batch.rows() > 0 ? _request_batch.start_ms() : -1;
+    for (auto& [_, channel] : _instance_id2channel) {
+        RETURN_IF_ERROR(channel->send_stale_rows(state, now_ms));
+        const int64_t channel_oldest_ms = channel->oldest_batched_ms();
+        if (channel_oldest_ms >= 0 && (oldest_ms < 0 || channel_oldest_ms < oldest_ms)) {
+            oldest_ms = channel_oldest_ms;
+        }
+    }
+    _oldest_batched_ms = oldest_ms;
     return Status::OK();
 }
 
@@ -649,7 +763,7 @@ Status ExchangeSinkOperator::set_finishing(RuntimeState* state) {
             PTransmitChunkParamsPtr copy = std::make_shared<PTransmitChunkParams>(*_chunk_request);
             RETURN_IF_ERROR(channel->send_chunk_request(state, copy, attachment, attachment_physical_bytes));
         }
-        _current_request_bytes = 0;
+        _request_batch.reset();
         _chunk_request.reset();
     }
     Status status = Status::OK();
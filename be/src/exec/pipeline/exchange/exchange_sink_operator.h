@@ -24,6 +24,7 @@
 #include "exec/data_sink.h"
 #include "exec/pipeline/exchange/shuffler.h"
 #include "exec/pipeline/exchange/sink_buffer.h"
+#include "exec/pipeline/exchange/transmit_request_batch.h"
 #include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/operator.h"
 #include "gen_cpp/data.pb.h"
@@ -63,6 +64,10 @@ public:
 
     bool need_input() const override;
 
+    bool need_flush() const override;
+
+    Status flush(RuntimeState* state) override;
+
     bool is_finished() const override;
 
     bool pending_finish() const override;
@@ -90,6 +95,11 @@ private:
         return sz > runtime_state()->chunk_size() * 512;
     }
 
+    Status _send_broadcast_request(RuntimeState* state);
+    bool _has_stale_rows(int64_t now_ms) const;
+    // Send the rows that have been batched longer than max_transmit_batched_delay_ms.
+    Status _send_stale_rows(RuntimeState* state);
+
 private:
     class Channel;
 
@@ -159,7 +169,9 @@ private:
 
     // Only used when broadcast
     PTransmitChunkParamsPtr _chunk_request;
-    size_t _current_request_bytes = 0;
+    TransmitRequestBatch _request_batch;
+    // No rows batched in the channels or in _chunk_request are older than this time, -1 if there are no rows batched.
+    int64_t _oldest_batched_ms = -1;
 
     bool _is_first_chunk = true;
 
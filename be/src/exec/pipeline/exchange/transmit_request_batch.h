@@ -0,0 +1,79 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/config.h"
+
+namespace starrocks::pipeline {
+
+// The bytes, rows and age of the chunks batched in one transmit request.
+//
+// A request is sent once it exceeds max_transmit_batched_bytes. If max_transmit_batched_rows is set, a request
+// keeps growing past the byte threshold until it holds that many rows, so that a shuffle sends fewer and larger
+// requests; the growth is bounded by kMaxCoalescedBytesFactor times the byte threshold and by
+// max_transmit_batched_delay_ms. If max_transmit_batched_delay_ms is set, the rows that have waited that long are
+// stale and are sent even below the byte threshold.
+class TransmitRequestBatch {
+public:
+    static constexpr int64_t kMaxCoalescedBytesFactor = 4;
+
+    void add(size_t bytes, size_t rows, int64_t now_ms) {
+        if (_rows == 0) {
+            _start_ms = now_ms;
+        }
+        _bytes += bytes;
+        _rows += rows;
+    }
+
+    void reset() {
+        _bytes = 0;
+        _rows = 0;
+        _start_ms = 0;
+    }
+
+    size_t bytes() const { return _bytes; }
+    size_t rows() const { return _rows; }
+    // the time when the first rows are added, only valid if rows() > 0
+    int64_t start_ms() const { return _start_ms; }
+
+    bool is_full(int64_t now_ms) const {
+        const int64_t max_bytes = config::max_transmit_batched_bytes;
+        if (_bytes <= max_bytes) {
+            return false;
+        }
+        const int64_t max_rows = config::max_transmit_batched_rows;
+        if (max_rows <= 0 || _rows >= max_rows) {
+            return true;
+        }
+        return _bytes > max_bytes * kMaxCoalescedBytesFactor || is_stale(now_ms);
+    }
+
+    bool is_stale(int64_t now_ms) const { return _rows > 0 && is_stale_since(_start_ms, now_ms); }
+
+    static bool is_stale_since(int64_t start_ms, int64_t now_ms) {
+        const int64_t max_delay_ms = config::max_transmit_batched_delay_ms;
+        return max_delay_ms > 0 && now_ms - start_ms >= max_delay_ms;
+    }
+
+private:
+    size_t _bytes = 0;
+    size_t _rows = 0;
+    int64_t _start_ms = 0;
+};
+
+} // namespace starrocks::pipeline
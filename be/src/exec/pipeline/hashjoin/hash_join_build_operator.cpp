@@ -17,6 +17,7 @@
 #include <utility>
 
 #include "exec/pipeline/query_context.h"
+#include "exec/pipeline/fragment_context.h"
 #include "runtime/current_thread.h"
 #include "runtime/runtime_filter_worker.h"
 namespace starrocks::pipeline {
@@ -75,13 +76,45 @@ size_t HashJoinBuildOperator::output_amplification_factor() const {
 }
 
 Status HashJoinBuildOperator::set_finishing(RuntimeState* state) {
-    DeferOp op([this]() { _is_finished = true; });
-
     if (state->is_cancelled()) {
+        _is_finished = true;
         return Status::Cancelled("runtime state is cancelled");
     }
-    RETURN_IF_ERROR(_join_builder->build_ht(state));
 
+    // The partitioned build of a large broadcast hash table is finished by helper threads, and the driver
+    // waits for it in the poller instead of blocking the pipeline thread.
+    _is_building = true;
+    std::weak_ptr<QueryContext> wp = state->query_ctx()->weak_from_this();
+    auto on_build_finished = [this, state, wp](const Status& build_status) {
+        if (auto sp = wp.lock()) {
+            SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(state->instance_mem_tracker());
+            SCOPED_THREAD_LOCAL_OPERATOR_MEM_TRACKER_SETTER(this);
+            Status status = build_status;
+            if (status.ok() && state->is_cancelled()) {
+                status = Status::Cancelled("runtime state is cancelled");
+            }
+            if (status.ok()) {
+                status = _finish_build(state);
+            }
+            if (!status.ok() && state->fragment_ctx() != nullptr) {
+                state->fragment_ctx()->cancel(status);
+            }
+        }
+        _is_finished = true;
+        _is_building = false;
+    };
+
+    Status status = _join_builder->build_ht(state, std::move(on_build_finished));
+    if (status.ok() && _join_builder->is_build_ht_async()) {
+        return Status::OK();
+    }
+    _is_building = false;
+    DeferOp op([this]() { _is_finished = true; });
+    RETURN_IF_ERROR(status);
+    return _finish_build(state);
+}
+
+Status HashJoinBuildOperator::_finish_build(RuntimeState* state) {
     size_t merger_index = _driver_sequence;
     // Broadcast Join only has one build operator.
     DCHECK(_distribution_mode != TJoinDistributionMode::BROADCAST || _driver_sequence == 0);
@@ -45,10 +45,11 @@ public:
         return false;
     }
 
-    bool need_input() const override { return !is_finished(); }
+    bool need_input() const override { return !is_finished() && !_is_building; }
 
     Status set_finishing(RuntimeState* state) override;
     bool is_finished() const override { return _is_finished || _join_builder->is_finished(); }
+    bool pending_finish() const override { return _is_building || _join_builder->has_running_build_helpers(); }
 
     Status push_chunk(RuntimeState* state, const ChunkPtr& chunk) override;
     StatusOr<ChunkPtr> pull_chunk(RuntimeState* state) override;
@@ -60,10 +61,15 @@ public:
     size_t output_amplification_factor() const override;
 
 protected:
+    // Creates the runtime filters and enters the probe phase once the hash table is built.
+    Status _finish_build(RuntimeState* state);
+
     HashJoinerPtr _join_builder;
     PartialRuntimeFilterMerger* _partial_rf_merger;
     mutable size_t _avg_keys_per_bucket = 0;
     std::atomic<bool> _is_finished = false;
+    // Whether the hash table is being built by helper threads after set_finishing returned.
+    std::atomic<bool> _is_building = false;
 
     const TJoinDistributionMode::type _distribution_mode;
 };
@@ -31,6 +31,7 @@
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/runtime_state.h"
 #include "util/bit_util.h"
+#include "util/compression/compression_utils.h"
 #include "util/defer_op.h"
 
 namespace starrocks::pipeline {
@@ -64,7 +65,8 @@ size_t SpillableHashJoinBuildOperator::estimated_memory_reserved() {
 }
 
 bool SpillableHashJoinBuildOperator::need_input() const {
-    return !is_finished() && !(_join_builder->spiller()->is_full() || _join_builder->spill_channel()->has_task());
+    return !is_finished() && !_is_building &&
+           !(_join_builder->spiller()->is_full() || _join_builder->spill_channel()->has_task());
 }
 
 Status SpillableHashJoinBuildOperator::set_finishing(RuntimeState* state) {
@@ -248,6 +250,9 @@ Status SpillableHashJoinBuildOperatorFactory::prepare(RuntimeState* state) {
     _spill_options->name = "hash-join-build";
     _spill_options->plan_node_id = _plan_node_id;
     _spill_options->encode_level = state->spill_encode_level();
+    _spill_options->compress_type = CompressionUtils::to_compression_pb(state->spill_compression_type());
+    _spill_options->serde_type = state->enable_spill_column_encoding() ? spill::SerdeType::ENCODED_BY_COLUMN
+                                                                      : spill::SerdeType::BY_COLUMN;
     // TODO: Our current adaptive dop for non-broadcast functions will also result in a build hash_joiner corresponding to multiple prob hash_join prober.
     //
     _spill_options->read_shared =
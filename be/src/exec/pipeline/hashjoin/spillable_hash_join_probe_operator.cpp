@@ -34,6 +34,7 @@
 #include "gutil/casts.h"
 #include "runtime/current_thread.h"
 #include "runtime/runtime_state.h"
+#include "util/compression/compression_utils.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks::pipeline {
@@ -501,6 +502,9 @@ Status SpillableHashJoinProbeOperatorFactory::prepare(RuntimeState* state) {
     _spill_options->name = "hash-join-probe";
     _spill_options->plan_node_id = _plan_node_id;
     _spill_options->encode_level = state->spill_encode_level();
+    _spill_options->compress_type = CompressionUtils::to_compression_pb(state->spill_compression_type());
+    _spill_options->serde_type = state->enable_spill_column_encoding() ? spill::SerdeType::ENCODED_BY_COLUMN
+                                                                      : spill::SerdeType::BY_COLUMN;
 
     return Status::OK();
 }
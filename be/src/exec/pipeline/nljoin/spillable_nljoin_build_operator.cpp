@@ -19,6 +19,7 @@
 #include "exec/spill/options.h"
 #include "exec/spill/spiller.hpp"
 #include "gen_cpp/InternalService_types.h"
+#include "util/compression/compression_utils.h"
 
 namespace starrocks::pipeline {
 Status SpillableNLJoinBuildOperator::prepare(RuntimeState* state) {
@@ -98,6 +99,9 @@ Status SpillableNLJoinBuildOperatorFactory::prepare(RuntimeState* state) {
     _spill_options->plan_node_id = _plan_node_id;
     _spill_options->read_shared = true;
     _spill_options->encode_level = state->spill_encode_level();
+    _spill_options->compress_type = CompressionUtils::to_compression_pb(state->spill_compression_type());
+    _spill_options->serde_type = state->enable_spill_column_encoding() ? spill::SerdeType::ENCODED_BY_COLUMN
+                                                                      : spill::SerdeType::BY_COLUMN;
 
     return Status::OK();
 }
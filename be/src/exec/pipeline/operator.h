@@ -104,6 +104,14 @@ public:
     // output chunks will be produced
     virtual bool is_finished() const = 0;
 
+    // Whether this sink operator holds output which should be flushed without waiting for more input,
+    // e.g. the rows batched by the exchange sink for too long. It's also called by the poller, so it must be
+    // cheap and without side effects, and the driver waiting for input is scheduled to call flush() if it's true.
+    virtual bool need_flush() const { return false; }
+
+    // Flush the output held by this sink operator, called by the driver in the executor thread.
+    virtual Status flush(RuntimeState* state) { return Status::OK(); }
+
     // pending_finish returns whether this operator still has reference to the object owned by the operator or FragmentContext.
     // It can ONLY be called after calling set_finished().
     // When a driver's sink operator is finished, the driver should wait for pending i/o task completion.
@@ -402,6 +402,19 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state, int w
         }
         _first_unfinished = new_first_unfinished;
 
+        // the sink may hold output which shouldn't wait for more input
+        if (!sink_operator()->is_finished() && sink_operator()->need_flush()) {
+            auto& sink_op = _operators.back();
+            SCOPED_THREAD_LOCAL_OPERATOR_MEM_TRACKER_SETTER(sink_op);
+            SCOPED_TIMER(sink_op->_push_timer);
+            return_status = sink_op->flush(runtime_state);
+            if (!return_status.ok()) {
+                sink_op->common_metrics()->add_info_string("ErrorMsg", return_status.get_error_msg());
+                LOG(WARNING) << "flush returns not ok status " << return_status.to_string();
+                return return_status;
+            }
+        }
+
         if (sink_operator()->is_finished()) {
             finish_operators(runtime_state);
             set_driver_state(is_still_pending_finish() ? DriverState::PENDING_FINISH : DriverState::FINISH);
@@ -405,7 +405,7 @@ public:
         }
 
         // INPUT_EMPTY
-        if (!source_operator()->is_finished() && !source_operator()->has_output()) {
+        if (!source_operator()->is_finished() && !source_operator()->has_output() && !sink_operator()->need_flush()) {
             set_driver_state(DriverState::INPUT_EMPTY);
             return false;
         }
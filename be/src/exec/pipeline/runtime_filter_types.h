@@ -17,6 +17,7 @@
 #include <mutex>
 #include <utility>
 
+#include "common/config.h"
 #include "common/statusor.h"
 #include "exec/hash_join_node.h"
 #include "exprs/expr_context.h"
@@ -323,7 +324,6 @@ public:
             LogicalType build_type = desc->build_expr_type();
             JoinRuntimeFilter* filter = RuntimeFilterHelper::create_runtime_bloom_filter(_pool, build_type);
             if (filter == nullptr) continue;
-            filter->init(row_count);
             filter->set_join_mode(desc->join_mode());
             desc->set_runtime_filter(filter);
         }
@@ -363,6 +363,19 @@ public:
                 desc->set_runtime_filter(nullptr);
                 continue;
             }
+            size_t ndv = row_count;
+            if (config::enable_adaptive_runtime_bloom_filter) {
+                Columns columns;
+                for (auto& opt_params : _partial_bloom_filter_build_params) {
+                    auto& column = opt_params[i].value().column;
+                    if (column != nullptr && !column->empty()) {
+                        columns.emplace_back(column);
+                    }
+                }
+                ndv = std::min(ndv, RuntimeFilterHelper::estimate_runtime_bloom_filter_ndv(
+                                            columns, desc->build_expr_type(), kHashJoinKeyColumnOffset));
+            }
+            desc->runtime_filter()->init(ndv);
             for (auto& opt_params : _partial_bloom_filter_build_params) {
                 auto& opt_param = opt_params[i];
                 DCHECK(opt_param.has_value());
@@ -378,6 +391,9 @@ public:
                     break;
                 }
             }
+            if (config::enable_adaptive_runtime_bloom_filter && desc->runtime_filter() != nullptr) {
+                desc->runtime_filter()->use_min_max_only_if_dense(ndv);
+            }
         }
         return Status::OK();
     }
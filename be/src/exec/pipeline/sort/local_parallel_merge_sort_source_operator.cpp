@@ -15,8 +15,11 @@
 #include "exec/pipeline/sort/local_parallel_merge_sort_source_operator.h"
 
 #include <algorithm>
+#include <iterator>
 #include <sstream>
 
+#include "common/config.h"
+#include "exec/spill/spiller.h"
 #include "exprs/expr.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
@@ -57,6 +60,7 @@ bool LocalParallelMergeSortSourceOperator::is_finished() const {
 
 StatusOr<ChunkPtr> LocalParallelMergeSortSourceOperator::pull_chunk(RuntimeState* state) {
     ChunkPtr chunk = _merger->try_get_next(_merge_parallel_id);
+    RETURN_IF_ERROR(_sort_context->spill_task_status());
 
     if (_merger->is_finished()) {
         _is_finished = true;
@@ -92,18 +96,46 @@ OperatorPtr LocalParallelMergeSortSourceOperatorFactory::create(int32_t degree_o
         });
     };
 
+    // The spilled sorted runs of the sorters are merged directly by the parallel merge, instead of being merged
+    // into one stream by each sorter, which is a serial tail after a large sort spills.
+    auto restore_by_sorted_runs = [](ChunksSorter* chunks_sorter) {
+        if (config::enable_sort_spill_parallel_merge && chunks_sorter->spiller() != nullptr) {
+            chunks_sorter->spiller()->set_restore_by_sorted_runs(config::sort_spill_parallel_merge_max_runs);
+        }
+    };
+    auto make_chunk_providers_expander = [](std::vector<ChunksSorter*> chunks_sorters) {
+        return [chunks_sorters = std::move(chunks_sorters)](
+                       std::vector<merge_path::MergePathChunkProvider> chunk_providers) {
+            DCHECK_EQ(chunks_sorters.size(), chunk_providers.size());
+            std::vector<merge_path::MergePathChunkProvider> expanded;
+            for (size_t i = 0; i < chunks_sorters.size(); i++) {
+                auto run_providers = chunks_sorters[i]->spilled_sorted_run_providers();
+                if (run_providers.empty()) {
+                    expanded.emplace_back(std::move(chunk_providers[i]));
+                } else {
+                    std::move(run_providers.begin(), run_providers.end(), std::back_inserter(expanded));
+                }
+            }
+            return expanded;
+        };
+    };
+
     if (_is_gathered) {
         if (_mergers.empty()) {
             std::vector<merge_path::MergePathChunkProvider> chunk_providers;
+            std::vector<ChunksSorter*> chunks_sorters;
             for (int i = 0; i < degree_of_parallelism; i++) {
                 auto* chunks_sorter = sort_context->get_chunks_sorter(i);
                 DCHECK(chunks_sorter != nullptr);
+                restore_by_sorted_runs(chunks_sorter);
                 chunk_providers.emplace_back(chunk_provider_factory(chunks_sorter));
+                chunks_sorters.emplace_back(chunks_sorter);
             }
             _mergers.push_back(std::make_unique<merge_path::MergePathCascadeMerger>(
                     _state->chunk_size(), degree_of_parallelism, sort_context->sort_exprs(), sort_context->sort_descs(),
                     _tuple_desc, sort_context->topn_type(), sort_context->offset(), sort_context->limit(),
                     chunk_providers));
+            _mergers.back()->set_chunk_providers_expander(make_chunk_providers_expander(std::move(chunks_sorters)));
         }
         return std::make_shared<LocalParallelMergeSortSourceOperator>(
                 this, _id, _plan_node_id, driver_sequence, sort_context.get(), _is_gathered, _mergers[0].get());
@@ -111,10 +143,12 @@ OperatorPtr LocalParallelMergeSortSourceOperatorFactory::create(int32_t degree_o
         std::vector<merge_path::MergePathChunkProvider> chunk_providers;
         auto* chunks_sorter = sort_context->get_chunks_sorter(0);
         DCHECK(chunks_sorter != nullptr);
+        restore_by_sorted_runs(chunks_sorter);
         chunk_providers.emplace_back(chunk_provider_factory(chunks_sorter));
         _mergers.push_back(std::make_unique<merge_path::MergePathCascadeMerger>(
                 _state->chunk_size(), 1, sort_context->sort_exprs(), sort_context->sort_descs(), _tuple_desc,
                 sort_context->topn_type(), sort_context->offset(), sort_context->limit(), chunk_providers));
+        _mergers.back()->set_chunk_providers_expander(make_chunk_providers_expander({chunks_sorter}));
         return std::make_shared<LocalParallelMergeSortSourceOperator>(this, _id, _plan_node_id, driver_sequence,
                                                                       sort_context.get(), _is_gathered,
                                                                       _mergers[driver_sequence].get());
@@ -16,6 +16,7 @@
 
 #include <memory>
 
+#include "common/config.h"
 #include "exec/chunks_sorter.h"
 #include "exec/chunks_sorter_full_sort.h"
 #include "exec/chunks_sorter_heap_sort.h"
@@ -132,6 +133,9 @@ OperatorPtr PartitionSortSinkOperatorFactory::create(int32_t dop, int32_t driver
     }
 
     auto sort_context = _sort_context_factory->create(driver_sequence);
+    if (_limit >= 0 && _topn_type != TTopNType::DENSE_RANK && config::enable_topn_shared_threshold) {
+        chunks_sorter->set_shared_topn_threshold(sort_context->shared_topn_threshold());
+    }
     sort_context->add_partition_chunks_sorter(chunks_sorter);
     auto ope = std::make_shared<PartitionSortSinkOperator>(this, _id, _plan_node_id, driver_sequence, chunks_sorter,
                                                            _sort_exec_exprs, _order_by_types, _materialized_tuple_desc,
@@ -58,6 +58,15 @@ bool SortContext::is_partition_ready() const {
 
 void SortContext::cancel() {}
 
+Status SortContext::spill_task_status() const {
+    for (const auto& sorter : _chunks_sorter_partitions) {
+        if (sorter->spiller() != nullptr) {
+            RETURN_IF_ERROR(sorter->spiller()->task_status());
+        }
+    }
+    return Status::OK();
+}
+
 StatusOr<ChunkPtr> SortContext::pull_chunk() {
     RETURN_IF_ERROR(_init_merger());
 
@@ -45,7 +45,8 @@ public:
               _limit(limit),
               _sort_exprs(sort_exprs),
               _sort_desc(sort_descs),
-              _build_runtime_filters(build_runtime_filters) {}
+              _build_runtime_filters(build_runtime_filters),
+              _shared_topn_threshold(std::make_shared<SharedTopnThreshold>(sort_descs)) {}
     ~SortContext() override = default;
 
     void close(RuntimeState* state) override;
@@ -62,12 +63,16 @@ public:
     int64_t limit() const { return _limit; }
     const std::vector<ExprContext*>& sort_exprs() const { return _sort_exprs; }
     const SortDescs& sort_descs() const { return _sort_desc; }
+    // The top-n threshold shared by the sorters of all the partitions merged by this context.
+    const SharedTopnThresholdPtr& shared_topn_threshold() const { return _shared_topn_threshold; }
 
     void finish_partition(uint64_t partition_rows);
     bool is_partition_sort_finished() const;
     bool is_output_finished() const;
     bool is_partition_ready() const;
     void cancel();
+    // Returns the first error of the spill tasks of the sorters, e.g. the errors of restoring the spilled runs.
+    Status spill_task_status() const;
 
     [[nodiscard]] StatusOr<ChunkPtr> pull_chunk();
 
@@ -95,6 +100,7 @@ private:
     int64_t _required_rows = 0;
     bool _merger_inited = false;
     const std::vector<RuntimeFilterBuildDescriptor*>& _build_runtime_filters;
+    const SharedTopnThresholdPtr _shared_topn_threshold;
     // used for set runtime filter collector
     std::once_flag _set_collector_flag;
 };
@@ -291,7 +291,9 @@ private:
     buffer_range buffer[2];
 };
 
-SortedStreamingAggregator::SortedStreamingAggregator(AggregatorParamsPtr params) : Aggregator(std::move(params)) {}
+SortedStreamingAggregator::SortedStreamingAggregator(AggregatorParamsPtr params) : Aggregator(std::move(params)) {
+    _support_columnar_agg_states = false;
+}
 
 SortedStreamingAggregator::~SortedStreamingAggregator() {
     if (_state) {
@@ -841,6 +841,10 @@ void MergePathCascadeMerger::_forward_stage(const detail::Stage& stage, int32_t
 void MergePathCascadeMerger::_init() {
     DCHECK(_stage == detail::Stage::INIT);
 
+    if (_chunk_providers_expander) {
+        _chunk_providers = _chunk_providers_expander(std::move(_chunk_providers));
+    }
+
     _init_late_materialization();
 
     std::vector<detail::NodePtr> leaf_nodes;
@@ -161,6 +161,13 @@ class MergePathCascadeMerger;
  */
 using MergePathChunkProvider = std::function<bool(bool only_check_if_has_data, ChunkPtr* chunk, bool* eos)>;
 
+/**
+ * Expands the providers passed through the ctor when the merge starts, i.e. all the inputs have been sorted,
+ * e.g. the provider of a spilled sorter is replaced by the providers of its spilled sorted runs.
+ */
+using MergePathChunkProvidersExpander =
+        std::function<std::vector<MergePathChunkProvider>(std::vector<MergePathChunkProvider> chunk_providers)>;
+
 namespace detail {
 
 class MergeNode;
@@ -394,6 +401,11 @@ public:
 
     void bind_profile(const int32_t parallel_idx, RuntimeProfile* profile);
 
+    // Must be set before the merge starts.
+    void set_chunk_providers_expander(MergePathChunkProvidersExpander expander) {
+        _chunk_providers_expander = std::move(expander);
+    }
+
     size_t add_original_chunk(ChunkPtr&& chunk);
     detail::Metrics& get_metrics(const int32_t parallel_idx) { return _metrics[parallel_idx]; }
 
@@ -448,7 +460,8 @@ private:
     const TTopNType::type _topn_type;
     const int64_t _offset;
     const int64_t _limit;
-    const std::vector<MergePathChunkProvider> _chunk_providers;
+    std::vector<MergePathChunkProvider> _chunk_providers;
+    MergePathChunkProvidersExpander _chunk_providers_expander;
     Action _finish_merge_action;
 
     // All operations of _stage and _process_cnts must under the protection of _status_m, the critical section
@@ -0,0 +1,122 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "column/datum.h"
+#include "types/date_value.h"
+#include "types/timestamp_value.h"
+
+namespace starrocks {
+
+// The min number of rows to sort by radix sort, a smaller range is cheaper to sort by pdqsort
+// than to scan the histograms.
+static constexpr size_t kRadixSortMinRows = 1024;
+
+// OrderedKeyTraits maps a fixed-width value to an unsigned integer key of the same order.
+template <typename T>
+struct OrderedKeyTraits {
+    static constexpr bool supported = false;
+};
+
+#define ORDERED_KEY_TRAITS(CPP_TYPE, KEY_TYPE, SIGNED) \
+    template <>                                        \
+    struct OrderedKeyTraits<CPP_TYPE> {                \
+        static constexpr bool supported = true;        \
+        static constexpr bool is_signed = SIGNED;      \
+        using KeyType = KEY_TYPE;                      \
+    };
+
+ORDERED_KEY_TRAITS(uint8_t, uint8_t, false)
+ORDERED_KEY_TRAITS(int8_t, uint8_t, true)
+ORDERED_KEY_TRAITS(int16_t, uint16_t, true)
+ORDERED_KEY_TRAITS(int32_t, uint32_t, true)
+ORDERED_KEY_TRAITS(int64_t, uint64_t, true)
+ORDERED_KEY_TRAITS(int128_t, uint128_t, true)
+ORDERED_KEY_TRAITS(DateValue, uint32_t, true)
+ORDERED_KEY_TRAITS(TimestampValue, uint64_t, true)
+#undef ORDERED_KEY_TRAITS
+
+// Flip the sign bit of a signed value, so that the unsigned keys are in the same order as the values.
+template <typename T>
+inline typename OrderedKeyTraits<T>::KeyType to_ordered_key(const T& value) {
+    using Traits = OrderedKeyTraits<T>;
+    using KeyType = typename Traits::KeyType;
+    KeyType key;
+    if constexpr (std::is_same_v<T, DateValue>) {
+        key = static_cast<KeyType>(value.julian());
+    } else if constexpr (std::is_same_v<T, TimestampValue>) {
+        key = static_cast<KeyType>(value.timestamp());
+    } else {
+        key = static_cast<KeyType>(value);
+    }
+    if constexpr (Traits::is_signed) {
+        key ^= KeyType(1) << (sizeof(KeyType) * 8 - 1);
+    }
+    return key;
+}
+
+// LSD radix sort of the items by the unsigned integer key returned by get_key, one byte per pass.
+// The histograms of all the bytes are built in one scan, and the passes of the bytes that are the same in all the
+// items are skipped, e.g. the high bytes of small values or the padding of normalized keys.
+// @param buffer scratch space of at least the same size as the items
+template <typename Item, typename GetKey>
+void radix_sort(Item* items, size_t num_items, Item* buffer, GetKey get_key) {
+    using KeyType = std::decay_t<decltype(get_key(*items))>;
+    constexpr size_t kNumPasses = sizeof(KeyType);
+    if (num_items <= 1) {
+        return;
+    }
+
+    std::vector<std::array<uint32_t, 256>> histograms(kNumPasses);
+    for (auto& histogram : histograms) {
+        histogram.fill(0);
+    }
+    for (size_t i = 0; i < num_items; i++) {
+        const KeyType key = get_key(items[i]);
+        for (size_t pass = 0; pass < kNumPasses; pass++) {
+            histograms[pass][static_cast<uint8_t>(key >> (pass * 8))]++;
+        }
+    }
+
+    Item* src = items;
+    Item* dst = buffer;
+    for (size_t pass = 0; pass < kNumPasses; pass++) {
+        auto& offsets = histograms[pass];
+        if (offsets[static_cast<uint8_t>(get_key(src[0]) >> (pass * 8))] == num_items) {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (auto& count : offsets) {
+            uint32_t next = offset + count;
+            count = offset;
+            offset = next;
+        }
+        for (size_t i = 0; i < num_items; i++) {
+            dst[offsets[static_cast<uint8_t>(get_key(src[i]) >> (pass * 8))]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+    if (src != items) {
+        std::copy(src, src + num_items, items);
+    }
+}
+
+} // namespace starrocks
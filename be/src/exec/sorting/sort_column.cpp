@@ -27,6 +27,8 @@
 #include "column/map_column.h"
 #include "column/nullable_column.h"
 #include "column/struct_column.h"
+#include "common/config.h"
+#include "exec/sorting/radix_sort.h"
 #include "exec/sorting/sort_helper.h"
 #include "exec/sorting/sort_permute.h"
 #include "exec/sorting/sorting.h"
@@ -117,6 +119,11 @@ public:
     template <typename T>
     Status do_visit(const FixedLengthColumnBase<T>& column) {
         DCHECK_GE(column.size(), _permutation.size());
+        if constexpr (OrderedKeyTraits<T>::supported) {
+            if (config::enable_sort_radix && _range.second - _range.first >= kRadixSortMinRows) {
+                return _radix_sort_and_tie(column);
+            }
+        }
         using ItemType = InlinePermuteItem<T>;
 
         auto cmp = [&](const ItemType& lhs, const ItemType& rhs) {
@@ -148,6 +155,57 @@ public:
     }
 
 private:
+    // Sort the integer, date, datetime and decimal values by their ordered unsigned keys, which are inverted for
+    // descending order. The large ranges of the tie are sorted by radix sort, and the small ones by pdqsort.
+    template <typename T>
+    Status _radix_sort_and_tie(const FixedLengthColumnBase<T>& column) {
+        using KeyType = typename OrderedKeyTraits<T>::KeyType;
+        using ItemType = InlinePermuteItem<KeyType>;
+        const auto& data = column.get_data();
+        const KeyType mask = _sort_desc.asc_order() ? 0 : ~KeyType(0);
+
+        InlinePermutation<KeyType> inlined(_permutation.size());
+        for (size_t i = _range.first; i < _range.second; i++) {
+            const uint32_t index = _permutation[i].index_in_chunk;
+            inlined[i].inline_value = to_ordered_key<T>(data[index]) ^ mask;
+            inlined[i].index_in_chunk = index;
+        }
+
+        InlinePermutation<KeyType> buffer;
+        auto get_key = [](const ItemType& item) { return item.inline_value; };
+        TieIterator iterator(_tie, _range.first, _range.second);
+        while (iterator.next()) {
+            if (UNLIKELY(_cancel.load(std::memory_order_acquire))) {
+                return Status::Cancelled("Sort cancelled");
+            }
+            const int range_first = iterator.range_first;
+            const int range_last = iterator.range_last;
+            const size_t num_rows = range_last - range_first;
+            if (num_rows <= 1) {
+                continue;
+            }
+
+            if (num_rows >= kRadixSortMinRows) {
+                buffer.resize(std::max(buffer.size(), num_rows));
+                radix_sort(inlined.data() + range_first, num_rows, buffer.data(), get_key);
+            } else {
+                ::pdqsort(inlined.begin() + range_first, inlined.begin() + range_last,
+                          [](const ItemType& lhs, const ItemType& rhs) { return lhs.inline_value < rhs.inline_value; });
+            }
+            if (_build_tie) {
+                _tie[range_first] = 0;
+                for (int i = range_first + 1; i < range_last; i++) {
+                    _tie[i] &= inlined[i - 1].inline_value == inlined[i].inline_value;
+                }
+            }
+        }
+
+        for (size_t i = _range.first; i < _range.second; i++) {
+            _permutation[i].index_in_chunk = inlined[i].index_in_chunk;
+        }
+        return Status::OK();
+    }
+
     const std::atomic<bool>& _cancel;
     const SortDesc& _sort_desc;
     SmallPermutation& _permutation;
@@ -422,6 +480,15 @@ Status sort_and_tie_columns(const std::atomic<bool>& cancel, const Columns& colu
     std::pair<int, int> range{0, num_rows};
     SmallPermutation small_perm = create_small_permutation(num_rows);
 
+    if (config::enable_sort_normalized_key && columns.size() > 1) {
+        bool sorted = false;
+        RETURN_IF_ERROR(sort_and_tie_columns_by_normalized_key(cancel, columns, sort_desc, &small_perm, &sorted));
+        if (sorted) {
+            restore_small_permutation(small_perm, *permutation);
+            return Status::OK();
+        }
+    }
+
     for (int col_index = 0; col_index < columns.size(); col_index++) {
         ColumnPtr column = columns[col_index];
         bool build_tie = col_index != columns.size() - 1;
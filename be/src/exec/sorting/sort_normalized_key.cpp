@@ -0,0 +1,240 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "column/column.h"
+#include "column/column_visitor_adapter.h"
+#include "column/datum.h"
+#include "column/decimalv3_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "exec/sorting/radix_sort.h"
+#include "exec/sorting/sort_permute.h"
+#include "exec/sorting/sorting.h"
+#include "gutil/endian.h"
+#include "util/orlp/pdqsort.h"
+
+namespace starrocks {
+
+namespace {
+
+// the max size of a normalized key, the leading columns exceeding it are sorted column-wise
+constexpr size_t MAX_NORMALIZED_KEY_SIZE = 32;
+
+// the columns of the sort keys which could be normalized, and the type of their values
+template <typename ColumnType>
+struct NormalizedKeyTraits {
+    static constexpr bool supported = false;
+};
+
+#define NORMALIZED_KEY_TRAITS(COLUMN, CPP_TYPE) \
+    template <>                                 \
+    struct NormalizedKeyTraits<COLUMN> {        \
+        static constexpr bool supported = true; \
+        using CppType = CPP_TYPE;               \
+    };
+
+NORMALIZED_KEY_TRAITS(BooleanColumn, uint8_t)
+NORMALIZED_KEY_TRAITS(Int8Column, int8_t)
+NORMALIZED_KEY_TRAITS(Int16Column, int16_t)
+NORMALIZED_KEY_TRAITS(Int32Column, int32_t)
+NORMALIZED_KEY_TRAITS(Int64Column, int64_t)
+NORMALIZED_KEY_TRAITS(Int128Column, int128_t)
+NORMALIZED_KEY_TRAITS(DateColumn, DateValue)
+NORMALIZED_KEY_TRAITS(TimestampColumn, TimestampValue)
+NORMALIZED_KEY_TRAITS(Decimal32Column, int32_t)
+NORMALIZED_KEY_TRAITS(Decimal64Column, int64_t)
+NORMALIZED_KEY_TRAITS(Decimal128Column, int128_t)
+#undef NORMALIZED_KEY_TRAITS
+
+// Encode the values of a column into a fixed-width part of the normalized keys, so that comparing the keys
+// by memcmp is equivalent to comparing the rows by the encoded columns:
+// - a nullable column starts with a null byte, which is 0 for null if nulls go first, or 1 otherwise.
+// - the value is stored in big-endian with the sign bit flipped, and all the bits are inverted for descending
+//   order. The value bytes of a null row are zero, so the nulls are equal to each other.
+// The keys are not written if keys is nullptr, which only checks whether the column is supported.
+class NormalizedKeyEncoder final : public ColumnVisitorAdapter<NormalizedKeyEncoder> {
+public:
+    NormalizedKeyEncoder(const SortDesc& sort_desc, uint8_t* keys, size_t key_size, size_t offset)
+            : ColumnVisitorAdapter(this), _sort_desc(sort_desc), _keys(keys), _key_size(key_size), _offset(offset) {}
+
+    size_t width() const { return _width; }
+
+    Status do_visit(const NullableColumn& column) {
+        if (_nulls != nullptr) {
+            return Status::NotSupported("nested nullable column");
+        }
+        const auto& data_column = column.data_column();
+        const uint8_t* nulls = column.null_column()->get_data().data();
+        if (_keys != nullptr) {
+            const uint8_t null_byte = _sort_desc.is_null_first() ? 0 : 1;
+            for (size_t i = 0; i < column.size(); i++) {
+                _keys[i * _key_size + _offset] = nulls[i] ? null_byte : (1 - null_byte);
+            }
+        }
+        _nulls = column.has_null() ? nulls : nullptr;
+        _offset++;
+        _width++;
+        return data_column->accept(this);
+    }
+
+    template <typename ColumnType>
+    Status do_visit(const ColumnType& column) {
+        if constexpr (NormalizedKeyTraits<ColumnType>::supported) {
+            using CppType = typename NormalizedKeyTraits<ColumnType>::CppType;
+            using UnsignedType = typename OrderedKeyTraits<CppType>::KeyType;
+            constexpr size_t value_size = sizeof(UnsignedType);
+            _width += value_size;
+            if (_keys == nullptr) {
+                return Status::OK();
+            }
+
+            const auto& data = column.get_data();
+            const UnsignedType mask = _sort_desc.asc_order() ? 0 : ~UnsignedType(0);
+            uint8_t* key = _keys + _offset;
+            for (size_t i = 0; i < data.size(); i++, key += _key_size) {
+                UnsignedType value = 0;
+                if (_nulls == nullptr || !_nulls[i]) {
+                    value = to_ordered_key<CppType>(data[i]) ^ mask;
+                }
+                for (size_t b = 0; b < value_size; b++) {
+                    key[b] = static_cast<uint8_t>(value >> (8 * (value_size - 1 - b)));
+                }
+            }
+            return Status::OK();
+        } else {
+            return Status::NotSupported("unsupported column of normalized key");
+        }
+    }
+
+private:
+    const SortDesc& _sort_desc;
+    uint8_t* _keys;
+    const size_t _key_size;
+    size_t _offset;
+    size_t _width = 0;
+    const uint8_t* _nulls = nullptr;
+};
+
+template <typename KeyType>
+struct NormalizedKeyItem {
+    KeyType key;
+    uint32_t index;
+};
+
+inline uint64_t load_key64(const uint8_t* key) {
+    return BigEndian::Load64(key);
+}
+
+inline uint128_t load_key128(const uint8_t* key) {
+    return (static_cast<uint128_t>(BigEndian::Load64(key)) << 64) | BigEndian::Load64(key + 8);
+}
+
+// Sort the rows by integer keys, which is much cheaper to compare and swap than the memcmp of the keys,
+// and could be sorted by radix sort if there are many rows.
+template <typename KeyType, typename LoadFunc>
+void sort_by_integer_keys(const std::vector<uint8_t>& keys, size_t key_size, LoadFunc load_key,
+                          SmallPermutation* permutation, Tie* tie) {
+    const size_t num_rows = permutation->size();
+    std::vector<NormalizedKeyItem<KeyType>> items(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        items[i].key = load_key(keys.data() + i * key_size);
+        items[i].index = i;
+    }
+    if (config::enable_sort_radix && num_rows >= kRadixSortMinRows) {
+        std::vector<NormalizedKeyItem<KeyType>> buffer(num_rows);
+        radix_sort(items.data(), num_rows, buffer.data(), [](const auto& item) { return item.key; });
+    } else {
+        ::pdqsort(items.begin(), items.end(), [](const auto& lhs, const auto& rhs) { return lhs.key < rhs.key; });
+    }
+    for (size_t i = 0; i < num_rows; i++) {
+        (*permutation)[i].index_in_chunk = items[i].index;
+        (*tie)[i] = i > 0 && items[i].key == items[i - 1].key;
+    }
+}
+
+} // namespace
+
+Status sort_and_tie_columns_by_normalized_key(const std::atomic<bool>& cancel, const Columns& columns,
+                                              const SortDescs& sort_desc, SmallPermutation* permutation,
+                                              bool* sorted) {
+    *sorted = false;
+    const size_t num_rows = permutation->size();
+
+    // pick the leading columns whose normalized keys fit in MAX_NORMALIZED_KEY_SIZE
+    size_t num_key_columns = 0;
+    size_t key_width = 0;
+    for (; num_key_columns < columns.size(); num_key_columns++) {
+        const auto& column = columns[num_key_columns];
+        if (column->is_constant()) {
+            break;
+        }
+        NormalizedKeyEncoder encoder(sort_desc.get_column_desc(num_key_columns), nullptr, 0, 0);
+        if (!column->accept(&encoder).ok() || key_width + encoder.width() > MAX_NORMALIZED_KEY_SIZE) {
+            break;
+        }
+        key_width += encoder.width();
+    }
+    // a single column is sorted by its own type, which is as cheap as the normalized key
+    if (num_key_columns < 2) {
+        return Status::OK();
+    }
+
+    // pad the key to a multiple of 8 bytes, so that a key of 8 or 16 bytes could be sorted as integers
+    const size_t key_size = (key_width + 7) / 8 * 8;
+    std::vector<uint8_t> keys(num_rows * key_size, 0);
+    size_t offset = 0;
+    for (size_t i = 0; i < num_key_columns; i++) {
+        NormalizedKeyEncoder encoder(sort_desc.get_column_desc(i), keys.data(), key_size, offset);
+        RETURN_IF_ERROR(columns[i]->accept(&encoder));
+        offset += encoder.width();
+    }
+    if (UNLIKELY(cancel.load(std::memory_order_acquire))) {
+        return Status::Cancelled("Sort cancelled");
+    }
+
+    Tie tie(num_rows, 0);
+    if (key_size == 8) {
+        sort_by_integer_keys<uint64_t>(keys, key_size, load_key64, permutation, &tie);
+    } else if (key_size == 16) {
+        sort_by_integer_keys<uint128_t>(keys, key_size, load_key128, permutation, &tie);
+    } else {
+        const uint8_t* data = keys.data();
+        ::pdqsort(permutation->begin(), permutation->end(), [&](SmallPermuteItem lhs, SmallPermuteItem rhs) {
+            return memcmp(data + lhs.index_in_chunk * key_size, data + rhs.index_in_chunk * key_size, key_size) < 0;
+        });
+        for (size_t i = 1; i < num_rows; i++) {
+            tie[i] = memcmp(data + (*permutation)[i].index_in_chunk * key_size,
+                            data + (*permutation)[i - 1].index_in_chunk * key_size, key_size) == 0;
+        }
+    }
+
+    // the rows of equal keys are sorted by the remaining columns
+    std::pair<int, int> range{0, num_rows};
+    for (size_t col_index = num_key_columns; col_index < columns.size(); col_index++) {
+        ColumnPtr column = columns[col_index];
+        bool build_tie = col_index != columns.size() - 1;
+        RETURN_IF_ERROR(sort_and_tie_column(cancel, column, sort_desc.get_column_desc(col_index), *permutation, tie,
+                                            range, build_tie));
+    }
+
+    *sorted = true;
+    return Status::OK();
+}
+
+} // namespace starrocks
@@ -41,6 +41,13 @@ Status sort_and_tie_column(const std::atomic<bool>& cancel, const ColumnPtr& col
 Status sort_and_tie_columns(const std::atomic<bool>& cancel, const Columns& columns, const SortDescs& sort_desc,
                             Permutation* permutation);
 
+// Sort multiple columns by normalized keys, which encode the leading fixed-width columns into memcomparable
+// bytes, then sort the rows of equal keys by the remaining columns in column-wise.
+// @param sorted false if less than two leading columns could be encoded, and the permutation isn't touched
+Status sort_and_tie_columns_by_normalized_key(const std::atomic<bool>& cancel, const Columns& columns,
+                                              const SortDescs& sort_desc, SmallPermutation* permutation,
+                                              bool* sorted);
+
 // Sort multiple columns, and stable
 Status stable_sort_and_tie_columns(const std::atomic<bool>& cancel, const Columns& columns, const SortDescs& sort_desc,
                                    SmallPermutation* permutation);
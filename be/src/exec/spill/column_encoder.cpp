@@ -0,0 +1,418 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/spill/column_encoder.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/column_hash.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "gutil/port.h"
+#include "gutil/strings/fastmem.h"
+#include "serde/column_array_serde.h"
+#include "util/bit_packing.inline.h"
+#include "util/bit_stream_utils.inline.h"
+#include "util/bit_util.h"
+#include "util/faststring.h"
+#include "util/phmap/phmap.h"
+
+namespace starrocks::spill {
+
+namespace {
+
+enum EncodingKind : uint8_t {
+    // fallback to ColumnArraySerde
+    RAW = 0,
+    NULLABLE = 1,
+    // frame-of-reference and bit-packing
+    FOR = 2,
+    BINARY_PLAIN = 3,
+    BINARY_DICT = 4,
+};
+
+// strings are dictionary encoded only if there are at most 1/DICT_MIN_ROWS_PER_VALUE distinct values of the rows
+constexpr size_t DICT_MIN_ROWS_PER_VALUE = 4;
+constexpr size_t DICT_MAX_SIZE = 1 << 16;
+
+template <typename T>
+void put_value(std::string* buffer, T value) {
+    buffer->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// reads the encoded data with bounds checking
+class EncodedReader {
+public:
+    EncodedReader(const uint8_t** data, const uint8_t* end) : _data(data), _end(end) {}
+
+    Status check(size_t size) const {
+        if (UNLIKELY(static_cast<size_t>(_end - *_data) < size)) {
+            return Status::Corruption(fmt::format("spilled column is truncated, expected at least {} bytes, left {}",
+                                                  size, _end - *_data));
+        }
+        return Status::OK();
+    }
+
+    Status read(void* dst, size_t size) {
+        RETURN_IF_ERROR(check(size));
+        memcpy(dst, *_data, size);
+        *_data += size;
+        return Status::OK();
+    }
+
+    template <typename T>
+    Status read_value(T* value) {
+        return read(value, sizeof(T));
+    }
+
+    const uint8_t* pos() const { return *_data; }
+    void skip(size_t size) { *_data += size; }
+
+private:
+    const uint8_t** _data;
+    const uint8_t* _end;
+};
+
+// [min value: sizeof(T)][bit width: 1 byte][bit-packed (value - min)]
+// the values are stored as is if the bit width can not be narrowed.
+template <typename T>
+void put_for(std::string* buffer, const T* values, size_t num_values) {
+    static_assert(std::is_integral_v<T>);
+    using UT = std::make_unsigned_t<T>;
+    constexpr int type_bits = sizeof(T) * 8;
+    T min_value = 0;
+    T max_value = 0;
+    if (num_values > 0) {
+        auto [min_it, max_it] = std::minmax_element(values, values + num_values);
+        min_value = *min_it;
+        max_value = *max_it;
+    }
+    const auto range = static_cast<UT>(static_cast<UT>(max_value) - static_cast<UT>(min_value));
+    const int bit_width = range == 0 ? 0 : BitUtil::Log2Floor64(range) + 1;
+    put_value(buffer, min_value);
+    put_value(buffer, static_cast<uint8_t>(bit_width));
+    if (bit_width == type_bits) {
+        buffer->append(reinterpret_cast<const char*>(values), num_values * sizeof(T));
+    } else if (bit_width > 0) {
+        faststring packed;
+        BitWriter writer(&packed);
+        for (size_t i = 0; i < num_values; i++) {
+            writer.PutValue(static_cast<UT>(static_cast<UT>(values[i]) - static_cast<UT>(min_value)), bit_width);
+        }
+        writer.Flush();
+        buffer->append(reinterpret_cast<const char*>(packed.data()), packed.size());
+    }
+}
+
+template <typename T>
+Status get_for(EncodedReader* reader, size_t num_values, T* values) {
+    static_assert(std::is_integral_v<T>);
+    using UT = std::make_unsigned_t<T>;
+    constexpr int type_bits = sizeof(T) * 8;
+    T min_value;
+    uint8_t bit_width;
+    RETURN_IF_ERROR(reader->read_value(&min_value));
+    RETURN_IF_ERROR(reader->read_value(&bit_width));
+    if (bit_width == type_bits) {
+        return reader->read(values, num_values * sizeof(T));
+    }
+    if (bit_width == 0) {
+        std::fill(values, values + num_values, min_value);
+        return Status::OK();
+    }
+    if (UNLIKELY(bit_width > type_bits)) {
+        return Status::Corruption(fmt::format("invalid bit width {} of spilled {} bytes values", bit_width, sizeof(T)));
+    }
+    const size_t packed_size = (num_values * bit_width + 7) / 8;
+    RETURN_IF_ERROR(reader->check(packed_size));
+    auto* unpacked = reinterpret_cast<UT*>(values);
+    int64_t num_unpacked = BitPacking::UnpackValues(bit_width, reader->pos(), packed_size, num_values, unpacked).second;
+    if (UNLIKELY(num_unpacked != static_cast<int64_t>(num_values))) {
+        return Status::Corruption("failed to unpack spilled values");
+    }
+    reader->skip(packed_size);
+    for (size_t i = 0; i < num_values; i++) {
+        unpacked[i] = static_cast<UT>(unpacked[i] + static_cast<UT>(min_value));
+    }
+    return Status::OK();
+}
+
+bool is_for_encodable(const Column& column) {
+    if (column.is_nullable() || column.is_constant()) {
+        return false;
+    }
+    if (!column.is_numeric() && !column.is_date() && !column.is_timestamp() && !column.is_decimal()) {
+        return false;
+    }
+    const size_t type_size = column.type_size();
+    return type_size == 1 || type_size == 2 || type_size == 4 || type_size == 8;
+}
+
+// [num rows: 4 bytes][type size: 1 byte][values of type size, frame-of-reference encoded]
+// floating point values are encoded with their bit patterns, the encoding is lossless but seldom narrows them.
+void encode_fixed(const Column& column, std::string* buffer) {
+    const auto num_rows = static_cast<uint32_t>(column.size());
+    const auto type_size = static_cast<uint8_t>(column.type_size());
+    put_value(buffer, num_rows);
+    put_value(buffer, type_size);
+    const uint8_t* data = column.raw_data();
+    switch (type_size) {
+    case 1:
+        put_for(buffer, reinterpret_cast<const int8_t*>(data), num_rows);
+        break;
+    case 2:
+        put_for(buffer, reinterpret_cast<const int16_t*>(data), num_rows);
+        break;
+    case 4:
+        put_for(buffer, reinterpret_cast<const int32_t*>(data), num_rows);
+        break;
+    default:
+        DCHECK_EQ(8, type_size);
+        put_for(buffer, reinterpret_cast<const int64_t*>(data), num_rows);
+        break;
+    }
+}
+
+Status decode_fixed(EncodedReader* reader, Column* column) {
+    uint32_t num_rows;
+    uint8_t type_size;
+    RETURN_IF_ERROR(reader->read_value(&num_rows));
+    RETURN_IF_ERROR(reader->read_value(&type_size));
+    if (UNLIKELY(!is_for_encodable(*column) || type_size != column->type_size())) {
+        return Status::Corruption(fmt::format("spilled values of {} bytes mismatch the column {}", type_size,
+                                              column->get_name()));
+    }
+    const size_t old_size = column->size();
+    column->resize_uninitialized(old_size + num_rows);
+    uint8_t* data = column->mutable_raw_data() + old_size * type_size;
+    switch (type_size) {
+    case 1:
+        return get_for(reader, num_rows, reinterpret_cast<int8_t*>(data));
+    case 2:
+        return get_for(reader, num_rows, reinterpret_cast<int16_t*>(data));
+    case 4:
+        return get_for(reader, num_rows, reinterpret_cast<int32_t*>(data));
+    default:
+        return get_for(reader, num_rows, reinterpret_cast<int64_t*>(data));
+    }
+}
+
+// BINARY_DICT: [num rows: 4 bytes][dict size: 4 bytes][dict value lengths][dict value bytes][codes]
+// BINARY_PLAIN: [num rows: 4 bytes][value lengths][value bytes]
+// the lengths and codes are frame-of-reference encoded.
+void encode_binary(const BinaryColumn& column, std::string* buffer) {
+    const size_t num_rows = column.size();
+    const auto& offsets = column.get_offset();
+
+    phmap::flat_hash_map<Slice, uint32_t, SliceHash, SliceNormalEqual> dict;
+    std::vector<Slice> dict_values;
+    std::vector<uint32_t> codes(num_rows);
+    const size_t max_dict_size = std::min(num_rows / DICT_MIN_ROWS_PER_VALUE, DICT_MAX_SIZE);
+    bool use_dict = true;
+    for (size_t i = 0; i < num_rows; i++) {
+        auto [it, inserted] = dict.try_emplace(column.get_slice(i), dict_values.size());
+        if (inserted) {
+            dict_values.emplace_back(it->first);
+            if (dict_values.size() > max_dict_size) {
+                use_dict = false;
+                break;
+            }
+        }
+        codes[i] = it->second;
+    }
+
+    std::vector<uint32_t> lengths;
+    if (use_dict) {
+        buffer->push_back(BINARY_DICT);
+        put_value(buffer, static_cast<uint32_t>(num_rows));
+        put_value(buffer, static_cast<uint32_t>(dict_values.size()));
+        lengths.reserve(dict_values.size());
+        for (const auto& value : dict_values) {
+            lengths.emplace_back(value.size);
+        }
+        put_for(buffer, lengths.data(), lengths.size());
+        for (const auto& value : dict_values) {
+            buffer->append(value.data, value.size);
+        }
+        put_for(buffer, codes.data(), num_rows);
+    } else {
+        buffer->push_back(BINARY_PLAIN);
+        put_value(buffer, static_cast<uint32_t>(num_rows));
+        lengths.resize(num_rows);
+        for (size_t i = 0; i < num_rows; i++) {
+            lengths[i] = offsets[i + 1] - offsets[i];
+        }
+        put_for(buffer, lengths.data(), num_rows);
+        buffer->append(reinterpret_cast<const char*>(column.get_bytes().data()) + offsets[0],
+                       offsets[num_rows] - offsets[0]);
+    }
+}
+
+Status decode_binary(EncodedReader* reader, bool use_dict, Column* column) {
+    if (UNLIKELY(!column->is_binary())) {
+        return Status::Corruption(fmt::format("spilled strings mismatch the column {}", column->get_name()));
+    }
+    auto* binary_column = down_cast<BinaryColumn*>(column);
+    uint32_t num_rows;
+    RETURN_IF_ERROR(reader->read_value(&num_rows));
+
+    std::vector<uint32_t> lengths;
+    std::vector<Slice> dict_values;
+    std::vector<uint32_t> codes;
+    size_t total_bytes = 0;
+    if (use_dict) {
+        uint32_t dict_size;
+        RETURN_IF_ERROR(reader->read_value(&dict_size));
+        if (UNLIKELY(dict_size > DICT_MAX_SIZE)) {
+            return Status::Corruption(fmt::format("invalid dict size {} of spilled strings", dict_size));
+        }
+        lengths.resize(dict_size);
+        RETURN_IF_ERROR(get_for(reader, dict_size, lengths.data()));
+        dict_values.reserve(dict_size);
+        for (uint32_t length : lengths) {
+            RETURN_IF_ERROR(reader->check(length));
+            dict_values.emplace_back(reader->pos(), length);
+            reader->skip(length);
+        }
+        codes.resize(num_rows);
+        RETURN_IF_ERROR(get_for(reader, num_rows, codes.data()));
+        for (uint32_t code : codes) {
+            if (UNLIKELY(code >= dict_size)) {
+                return Status::Corruption(fmt::format("invalid dict code {} of spilled strings", code));
+            }
+            total_bytes += dict_values[code].size;
+        }
+    } else {
+        lengths.resize(num_rows);
+        RETURN_IF_ERROR(get_for(reader, num_rows, lengths.data()));
+        for (uint32_t length : lengths) {
+            total_bytes += length;
+        }
+        RETURN_IF_ERROR(reader->check(total_bytes));
+    }
+
+    auto& offsets = binary_column->get_offset();
+    auto& bytes = binary_column->get_bytes();
+    const size_t old_bytes = bytes.size();
+    bytes.resize(old_bytes + total_bytes);
+    offsets.reserve(offsets.size() + num_rows);
+    uint8_t* dst = bytes.data() + old_bytes;
+    if (use_dict) {
+        for (uint32_t code : codes) {
+            const Slice& value = dict_values[code];
+            strings::memcpy_inlined(dst, value.data, value.size);
+            dst += value.size;
+            offsets.emplace_back(dst - bytes.data());
+        }
+    } else {
+        memcpy(dst, reader->pos(), total_bytes);
+        reader->skip(total_bytes);
+        auto offset = offsets.back();
+        for (uint32_t length : lengths) {
+            offset += length;
+            offsets.emplace_back(offset);
+        }
+    }
+    binary_column->invalidate_slice_cache();
+    return Status::OK();
+}
+
+// [serialized size: 8 bytes][ColumnArraySerde serialized column]
+Status encode_raw(const Column& column, std::string* buffer) {
+    const size_t old_size = buffer->size();
+    buffer->resize(old_size + sizeof(uint64_t) + serde::ColumnArraySerde::max_serialized_size(column));
+    auto* begin = reinterpret_cast<uint8_t*>(buffer->data()) + old_size + sizeof(uint64_t);
+    uint8_t* end = serde::ColumnArraySerde::serialize(column, begin);
+    if (UNLIKELY(end == nullptr)) {
+        return Status::InternalError("unsupported column occurs in spill serialize phase");
+    }
+    UNALIGNED_STORE64(buffer->data() + old_size, end - begin);
+    buffer->resize(end - reinterpret_cast<uint8_t*>(buffer->data()));
+    return Status::OK();
+}
+
+Status decode_raw(EncodedReader* reader, Column* column) {
+    uint64_t serialized_size;
+    RETURN_IF_ERROR(reader->read_value(&serialized_size));
+    RETURN_IF_ERROR(reader->check(serialized_size));
+    const uint8_t* end = serde::ColumnArraySerde::deserialize(reader->pos(), column);
+    if (UNLIKELY(end != reader->pos() + serialized_size)) {
+        return Status::Corruption(fmt::format("spilled column {} size mismatch, expected {}", column->get_name(),
+                                              serialized_size));
+    }
+    reader->skip(serialized_size);
+    return Status::OK();
+}
+
+} // namespace
+
+Status ColumnEncoder::encode(const Column& column, std::string* buffer) {
+    if (column.is_nullable()) {
+        const auto& nullable_column = down_cast<const NullableColumn&>(column);
+        buffer->push_back(NULLABLE);
+        // the null flags are 0 or 1, so they are bit-packed into 1 bit, or 0 bit if there is no null
+        RETURN_IF_ERROR(encode(*nullable_column.null_column(), buffer));
+        return encode(*nullable_column.data_column(), buffer);
+    }
+    if (is_for_encodable(column)) {
+        buffer->push_back(FOR);
+        encode_fixed(column, buffer);
+        return Status::OK();
+    }
+    if (column.is_binary()) {
+        encode_binary(down_cast<const BinaryColumn&>(column), buffer);
+        return Status::OK();
+    }
+    buffer->push_back(RAW);
+    return encode_raw(column, buffer);
+}
+
+Status ColumnEncoder::decode(const uint8_t** data, const uint8_t* end, Column* column) {
+    EncodedReader reader(data, end);
+    uint8_t kind;
+    RETURN_IF_ERROR(reader.read_value(&kind));
+    switch (kind) {
+    case NULLABLE: {
+        if (UNLIKELY(!column->is_nullable())) {
+            return Status::Corruption(fmt::format("spilled nullable data mismatch the column {}", column->get_name()));
+        }
+        auto* nullable_column = down_cast<NullableColumn*>(column);
+        RETURN_IF_ERROR(decode(data, end, nullable_column->mutable_null_column()));
+        RETURN_IF_ERROR(decode(data, end, nullable_column->mutable_data_column()));
+        if (UNLIKELY(nullable_column->null_column()->size() != nullable_column->data_column()->size())) {
+            return Status::Corruption("spilled null flags mismatch the data");
+        }
+        nullable_column->update_has_null();
+        return Status::OK();
+    }
+    case FOR:
+        return decode_fixed(&reader, column);
+    case BINARY_PLAIN:
+        return decode_binary(&reader, false, column);
+    case BINARY_DICT:
+        return decode_binary(&reader, true, column);
+    case RAW:
+        return decode_raw(&reader, column);
+    default:
+        return Status::Corruption(fmt::format("unknown encoding {} of spilled column", kind));
+    }
+}
+
+} // namespace starrocks::spill
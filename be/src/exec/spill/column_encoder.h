@@ -0,0 +1,40 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+
+#include "column/column.h"
+#include "common/status.h"
+
+namespace starrocks::spill {
+
+// Lightweight per-column encodings of spilled chunks:
+// - integer-like fixed length columns are frame-of-reference encoded and bit-packed,
+// - low cardinality strings are dictionary encoded with bit-packed codes,
+//   other strings store bit-packed lengths followed by the raw bytes,
+// - nullable columns encode the null flags (bit-packed to 1 bit) and the data column separately,
+// - the other columns fall back to ColumnArraySerde.
+// The format is private to spill: it is only read back by the process which wrote it.
+class ColumnEncoder {
+public:
+    // append the encoded |column| to |buffer|
+    static Status encode(const Column& column, std::string* buffer);
+
+    // decode one column from [*data, end) and append it to |column|, *data is advanced past the encoded column
+    static Status decode(const uint8_t** data, const uint8_t* end, Column* column);
+};
+
+} // namespace starrocks::spill
@@ -18,6 +18,7 @@
 #include <memory>
 #include <utility>
 
+#include "common/config.h"
 #include "exec/spill/block_manager.h"
 #include "exec/spill/serde.h"
 #include "exec/spill/spiller.h"
@@ -27,8 +28,6 @@
 
 namespace starrocks::spill {
 
-static const int chunk_buffer_max_size = 2;
-
 class UnionAllSpilledInputStream final : public SpillInputStream {
 public:
     UnionAllSpilledInputStream(InputStreamPtr left, InputStreamPtr right) {
@@ -139,13 +138,26 @@ InputStreamPtr SpillInputStream::as_stream(std::vector<ChunkPtr> chunks, Spiller
     return std::make_shared<RawChunkInputStream>(chunks, spiller);
 }
 
+bool ReadAheadBudget::is_full(size_t num_chunks, size_t buffer_bytes) const {
+    if (num_chunks >= std::max(config::spill_read_ahead_chunks, 1)) {
+        return true;
+    }
+    size_t max_bytes = stream_max_bytes();
+    return max_bytes > 0 && num_chunks > 0 && buffer_bytes >= max_bytes;
+}
+
+// BufferedInputStream reads ahead the chunks of the underlying stream in restore tasks, so that the disk io
+// is overlapped with the processing of the restored chunks. The read-ahead chunks are limited by the
+// ReadAheadBudget of the spiller, which the stream takes a share of until it reaches EOF.
 class BufferedInputStream : public SpillInputStream {
 public:
-    BufferedInputStream(int capacity, InputStreamPtr stream, Spiller* spiller)
-            : _capacity(capacity), _input_stream(std::move(stream)), _spiller(spiller) {}
-    ~BufferedInputStream() override = default;
+    BufferedInputStream(InputStreamPtr stream, Spiller* spiller)
+            : _input_stream(std::move(stream)), _read_ahead_budget(spiller->read_ahead_budget()), _spiller(spiller) {
+        _read_ahead_budget->add_stream();
+    }
+    ~BufferedInputStream() override { _release_budget(); }
 
-    bool is_buffer_full() { return _chunk_buffer.get_size() >= _capacity; }
+    bool is_buffer_full() { return _read_ahead_budget->is_full(_chunk_buffer.get_size(), _buffer_bytes); }
     // The ChunkProvider in sort operator needs to use has_chunk to check whether the data is ready,
     // if the InputStream is in the eof state, it also needs to return true to driver ChunkSortCursor into the stage of obtaining data.
     bool has_chunk() { return !_chunk_buffer.empty() || eof(); }
@@ -171,12 +183,22 @@ private:
         // _release is only invoked when _acquire successes, here add a DCHECK to check it.
         DCHECK(result);
     }
+    // give the share of the read-ahead budget back to the other streams once no more chunk will be read.
+    void _release_budget() {
+        bool expected = false;
+        if (_budget_released.compare_exchange_strong(expected, true)) {
+            _read_ahead_budget->remove_stream();
+        }
+    }
 
 private:
-    int _capacity;
+    // memory usage of the chunks in _chunk_buffer
+    std::atomic_size_t _buffer_bytes = 0;
     InputStreamPtr _input_stream;
     UnboundedBlockingQueue<ChunkUniquePtr> _chunk_buffer;
     std::atomic_bool _is_prefetching = false;
+    std::shared_ptr<ReadAheadBudget> _read_ahead_budget;
+    std::atomic_bool _budget_released = false;
     Spiller* _spiller = nullptr;
 };
 
@@ -187,6 +209,7 @@ StatusOr<ChunkUniquePtr> BufferedInputStream::read_from_buffer() {
     }
     ChunkUniquePtr res;
     CHECK(_chunk_buffer.try_get(&res));
+    _buffer_bytes -= res->memory_usage();
     COUNTER_ADD(_spiller->metrics().input_stream_peak_memory_usage, -res->memory_usage());
     return res;
 }
@@ -196,7 +219,11 @@ StatusOr<ChunkUniquePtr> BufferedInputStream::get_next(SerdeContext& ctx) {
         return read_from_buffer();
     }
     CHECK(!_is_prefetching);
-    return _input_stream->get_next(ctx);
+    auto res = _input_stream->get_next(ctx);
+    if (res.status().is_end_of_file()) {
+        _release_budget();
+    }
+    return res;
 }
 
 Status BufferedInputStream::prefetch(SerdeContext& ctx) {
@@ -210,16 +237,21 @@ Status BufferedInputStream::prefetch(SerdeContext& ctx) {
     }
     DeferOp defer([this]() { _release(); });
 
-    auto res = _input_stream->get_next(ctx);
-    if (res.ok()) {
-        COUNTER_ADD(_spiller->metrics().input_stream_peak_memory_usage, res.value()->memory_usage());
+    // read ahead until the buffer is full, the consumer may take chunks from the buffer concurrently.
+    do {
+        auto res = _input_stream->get_next(ctx);
+        if (res.status().is_end_of_file()) {
+            mark_is_eof();
+            _release_budget();
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(res.status());
+        size_t chunk_bytes = res.value()->memory_usage();
+        _buffer_bytes += chunk_bytes;
+        COUNTER_ADD(_spiller->metrics().input_stream_peak_memory_usage, chunk_bytes);
         _chunk_buffer.put(std::move(res.value()));
-        return Status::OK();
-    } else if (res.status().is_end_of_file()) {
-        mark_is_eof();
-        return Status::OK();
-    }
-    return res.status();
+    } while (!is_buffer_full());
+    return Status::OK();
 }
 
 class UnorderedInputStream : public SpillInputStream {
@@ -273,6 +305,18 @@ StatusOr<ChunkUniquePtr> UnorderedInputStream::get_next(SerdeContext& ctx) {
 
 void UnorderedInputStream::close() {}
 
+// Create a buffered stream per block, the read-ahead memory budget is shared by all the blocks.
+static std::vector<InputStreamPtr> create_sorted_run_streams(const std::vector<BlockPtr>& input_blocks,
+                                                             const SerdePtr& serde, Spiller* spiller) {
+    std::vector<InputStreamPtr> streams;
+    for (const auto& block : input_blocks) {
+        std::vector<BlockPtr> blocks{block};
+        auto stream = std::make_shared<UnorderedInputStream>(blocks, serde);
+        streams.emplace_back(std::make_shared<BufferedInputStream>(std::move(stream), spiller));
+    }
+    return streams;
+}
+
 class OrderedInputStream : public SpillInputStream {
 public:
     OrderedInputStream(std::vector<BlockPtr> blocks, RuntimeState* state)
@@ -306,12 +350,8 @@ Status OrderedInputStream::init(SerdePtr serde, const SortExecExprs* sort_exprs,
     std::vector<starrocks::ChunkProvider> chunk_providers;
     DCHECK(!_input_blocks.empty());
 
-    for (auto& block : _input_blocks) {
-        std::vector<BlockPtr> blocks{block};
-        auto stream = std::make_shared<BufferedInputStream>(
-                chunk_buffer_max_size, std::make_shared<UnorderedInputStream>(blocks, serde), spiller);
-        _input_streams.emplace_back(std::move(stream));
-        auto input_stream = _input_streams.back();
+    _input_streams = create_sorted_run_streams(_input_blocks, serde, spiller);
+    for (auto& input_stream : _input_streams) {
         auto chunk_provider = [input_stream, this](ChunkUniquePtr* output, bool* eos) {
             if (output == nullptr || eos == nullptr) {
                 return input_stream->is_ready();
@@ -370,7 +410,7 @@ Status OrderedInputStream::prefetch(SerdeContext& ctx) {
 
 StatusOr<InputStreamPtr> BlockGroup::as_unordered_stream(const SerdePtr& serde, Spiller* spiller) {
     auto stream = std::make_shared<UnorderedInputStream>(_blocks, serde);
-    return std::make_shared<BufferedInputStream>(chunk_buffer_max_size, std::move(stream), spiller);
+    return std::make_shared<BufferedInputStream>(std::move(stream), spiller);
 }
 
 StatusOr<InputStreamPtr> BlockGroup::as_ordered_stream(RuntimeState* state, const SerdePtr& serde, Spiller* spiller,
@@ -384,4 +424,11 @@ StatusOr<InputStreamPtr> BlockGroup::as_ordered_stream(RuntimeState* state, cons
     return stream;
 }
 
+StatusOr<std::vector<InputStreamPtr>> BlockGroup::as_sorted_run_streams(const SerdePtr& serde, Spiller* spiller) {
+    if (_blocks.empty()) {
+        return std::vector<InputStreamPtr>{};
+    }
+    return create_sorted_run_streams(_blocks, serde, spiller);
+}
+
 } // namespace starrocks::spill
\ No newline at end of file
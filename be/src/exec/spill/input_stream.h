@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <utility>
 
@@ -56,6 +57,35 @@ private:
     std::atomic_bool _eof = false;
 };
 
+// ReadAheadBudget limits the chunks read ahead by the buffered input streams of a spiller.
+// Each stream buffers at most config::spill_read_ahead_chunks chunks, and the memory budget of the spiller
+// is divided evenly among its streams not finished yet, e.g. the sorted runs of an ordered stream or the
+// partitions restored at the same time. A stream always buffers at least one chunk.
+class ReadAheadBudget {
+public:
+    // 0 means no limit other than the number of chunks
+    void set_max_bytes(size_t max_bytes) { _max_bytes = max_bytes; }
+    size_t max_bytes() const { return _max_bytes; }
+
+    void add_stream() { _num_streams.fetch_add(1, std::memory_order_relaxed); }
+    void remove_stream() { _num_streams.fetch_sub(1, std::memory_order_relaxed); }
+    size_t num_streams() const { return _num_streams.load(std::memory_order_relaxed); }
+
+    // the memory budget of each stream, 0 means no limit.
+    size_t stream_max_bytes() const {
+        if (_max_bytes == 0) {
+            return 0;
+        }
+        return std::max<size_t>(_max_bytes / std::max<size_t>(num_streams(), 1), 1);
+    }
+
+    bool is_full(size_t num_chunks, size_t buffer_bytes) const;
+
+private:
+    size_t _max_bytes = 0;
+    std::atomic_size_t _num_streams = 0;
+};
+
 // Note: not thread safe
 class BlockGroup {
 public:
@@ -63,11 +93,16 @@ public:
 
     void append(BlockPtr block) { _blocks.emplace_back(std::move(block)); }
 
+    size_t num_blocks() const { return _blocks.size(); }
+
     StatusOr<InputStreamPtr> as_unordered_stream(const SerdePtr& serde, Spiller* spiller);
 
     StatusOr<InputStreamPtr> as_ordered_stream(RuntimeState* state, const SerdePtr& serde, Spiller* spiller,
                                                const SortExecExprs* sort_exprs, const SortDescs* sort_descs);
 
+    // a stream per block, each of which is a sorted run if the data is spilled in order
+    StatusOr<std::vector<InputStreamPtr>> as_sorted_run_streams(const SerdePtr& serde, Spiller* spiller);
+
     void clear() { _blocks.clear(); }
 
 private:
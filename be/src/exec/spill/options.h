@@ -20,6 +20,7 @@
 #include "exec/sort_exec_exprs.h"
 #include "exec/sorting/sorting.h"
 #include "exec/spill/block_manager.h"
+#include "exec/spill/serde.h"
 
 namespace starrocks::spill {
 struct SpilledChunkBuildSchema {
@@ -86,7 +87,9 @@ struct SpilledOptions {
 
     int32_t plan_node_id = 0;
 
-    CompressionTypePB compress_type = CompressionTypePB::LZ4;
+    // block compression applied on the serialized chunk, NO_COMPRESSION means disabled
+    CompressionTypePB compress_type = CompressionTypePB::NO_COMPRESSION;
+    SerdeType serde_type = SerdeType::BY_COLUMN;
 
     size_t min_spilled_size = 1 * 1024 * 1024;
 
@@ -14,6 +14,10 @@
 
 #include "exec/spill/serde.h"
 
+#include <fmt/format.h>
+
+#include "common/config.h"
+#include "exec/spill/column_encoder.h"
 #include "exec/spill/options.h"
 #include "exec/spill/spiller.h"
 #include "gen_cpp/types.pb.h"
@@ -21,9 +25,64 @@
 #include "runtime/runtime_state.h"
 #include "serde/column_array_serde.h"
 #include "serde/encode_context.h"
+#include "util/compression/block_compression.h"
 
 namespace starrocks::spill {
 
+namespace {
+// try to compress ctx.serialize_buffer into ctx.compress_buffer,
+// return false if the data is left uncompressed because the compression ratio is too low.
+StatusOr<bool> try_compress(Spiller* spiller, const BlockCompressionCodec* codec, SerdeContext& ctx) {
+    const auto& serialize_buffer = ctx.serialize_buffer;
+    if (serialize_buffer.empty() || codec->exceed_max_input_size(serialize_buffer.size())) {
+        return false;
+    }
+    SCOPED_TIMER(spiller->metrics().compress_timer);
+    auto& compress_buffer = ctx.compress_buffer;
+    compress_buffer.resize(codec->max_compressed_len(serialize_buffer.size()));
+    Slice compressed_slice(compress_buffer.data(), compress_buffer.size());
+    RETURN_IF_ERROR(codec->compress(Slice(serialize_buffer), &compressed_slice));
+    // the same threshold as the exchange sink, it is not worth paying for decompression on restore
+    // if the data can hardly be compressed.
+    double compress_ratio = static_cast<double>(serialize_buffer.size()) / compressed_slice.size;
+    if (compress_ratio <= config::rpc_compress_ratio_threshold) {
+        return false;
+    }
+    compress_buffer.resize(compressed_slice.size);
+    return true;
+}
+
+// read the stored data of |stored_size| bytes into ctx.serialize_buffer,
+// the data is decompressed if |uncompressed_size| is not 0.
+Status read_stored_data(Spiller* spiller, const BlockCompressionCodec* codec, SerdeContext& ctx, BlockReader* reader,
+                        size_t stored_size, size_t uncompressed_size) {
+    auto& serialize_buffer = ctx.serialize_buffer;
+    if (uncompressed_size == 0) {
+        serialize_buffer.resize(stored_size);
+        SCOPED_TIMER(spiller->metrics().read_io_timer);
+        return reader->read_fully(serialize_buffer.data(), stored_size);
+    }
+    if (UNLIKELY(codec == nullptr)) {
+        return Status::Corruption("spilled data is compressed but no codec is set");
+    }
+    auto& compress_buffer = ctx.compress_buffer;
+    compress_buffer.resize(stored_size);
+    {
+        SCOPED_TIMER(spiller->metrics().read_io_timer);
+        RETURN_IF_ERROR(reader->read_fully(compress_buffer.data(), stored_size));
+    }
+    SCOPED_TIMER(spiller->metrics().decompress_timer);
+    serialize_buffer.resize(uncompressed_size);
+    Slice decompressed_slice(serialize_buffer.data(), serialize_buffer.size());
+    RETURN_IF_ERROR(codec->decompress(Slice(compress_buffer), &decompressed_slice));
+    if (UNLIKELY(decompressed_slice.size != uncompressed_size)) {
+        return Status::Corruption(fmt::format("spilled data decompressed size mismatch, expected: {}, actual: {}",
+                                              uncompressed_size, decompressed_slice.size));
+    }
+    return Status::OK();
+}
+} // namespace
+
 class ColumnarSerde : public Serde {
 public:
     ColumnarSerde(Spiller* parent, ChunkBuilder chunk_builder, std::shared_ptr<serde::EncodeContext> encode_context)
@@ -36,6 +95,7 @@ public:
             auto encode_level = _parent->options().encode_level;
             _encode_context = serde::EncodeContext::get_encode_context_shared_ptr(column_number, encode_level);
         }
+        RETURN_IF_ERROR(get_block_compression_codec(_parent->options().compress_type, &_compress_codec));
         return Status::OK();
     }
 
@@ -66,6 +126,8 @@ private:
     // here a std::shared_mutex is used to ensure concurrency safety.
     std::shared_mutex _mutex;
     std::shared_ptr<serde::EncodeContext> _encode_context;
+    // codec of the spilled data, nullptr if compression is disabled
+    const BlockCompressionCodec* _compress_codec = nullptr;
 };
 
 size_t ColumnarSerde::_max_serialized_size(const ChunkPtr& chunk) const {
@@ -94,8 +156,7 @@ Status ColumnarSerde::serialize(SerdeContext& ctx, const ChunkPtr& chunk, BlockP
 
     const auto& columns = chunk->columns();
 
-    std::unique_ptr<uint8_t[]> meta_buf;
-    size_t meta_len;
+    std::vector<uint32_t> encode_levels;
     if (_encode_context == nullptr) {
         SCOPED_TIMER(_parent->metrics().serialize_timer);
         for (const auto& column : columns) {
@@ -105,14 +166,9 @@ Status ColumnarSerde::serialize(SerdeContext& ctx, const ChunkPtr& chunk, BlockP
             }
         }
         serialize_buffer.resize(buf - head);
-        // only 8 bytes for serialized size if encoding is disable
-        meta_len = sizeof(size_t);
-        meta_buf.reset(new uint8_t[meta_len]);
-        uint8_t* tmp_buf = meta_buf.get();
-        UNALIGNED_STORE64(tmp_buf, serialize_buffer.size());
     } else {
         SCOPED_TIMER(_parent->metrics().serialize_timer);
-        auto encode_levels = _get_encode_levels();
+        encode_levels = _get_encode_levels();
         std::vector<std::pair<uint64_t, uint64_t>>
                 column_stats; // used to record raw_bytes and encoded_bytes for each column
         column_stats.reserve(columns.size());
@@ -132,32 +188,52 @@ Status ColumnarSerde::serialize(SerdeContext& ctx, const ChunkPtr& chunk, BlockP
         _update_encode_stats(column_stats);
 
         serialize_buffer.resize(buf - head + padding_size);
-        // 8 bytes for encoded size, 4 bytes for each column's encode level
-        // @TODO(silverbullet233): encode levels can be further encoded to save space if necessary.
-        meta_len = sizeof(size_t) + columns.size() * sizeof(uint32_t);
-        meta_buf.reset(new uint8_t[meta_len]);
-        // fill encoded size
-        uint8_t* tmp_buf = meta_buf.get();
-        UNALIGNED_STORE64(tmp_buf, serialize_buffer.size());
-        tmp_buf += sizeof(size_t);
-        // fill encode level
-        for (auto encode_level : encode_levels) {
-            UNALIGNED_STORE32(tmp_buf, encode_level);
-            tmp_buf += sizeof(uint32_t);
+    }
+
+    // the stored data is either serialize_buffer or its compressed form in compress_buffer
+    size_t uncompressed_size = 0;
+    const std::string* stored_buffer = &serialize_buffer;
+    if (_compress_codec != nullptr) {
+        ASSIGN_OR_RETURN(bool compressed, try_compress(_parent, _compress_codec, ctx));
+        if (compressed) {
+            uncompressed_size = serialize_buffer.size();
+            stored_buffer = &ctx.compress_buffer;
         }
     }
 
+    // 8 bytes for stored size,
+    // 8 bytes for uncompressed size if compression is enabled, 0 means the data is stored uncompressed,
+    // 4 bytes for each column's encode level if encoding is enabled.
+    // @TODO(silverbullet233): encode levels can be further encoded to save space if necessary.
+    size_t meta_len = sizeof(size_t) + encode_levels.size() * sizeof(uint32_t);
+    if (_compress_codec != nullptr) {
+        meta_len += sizeof(size_t);
+    }
+    std::unique_ptr<uint8_t[]> meta_buf(new uint8_t[meta_len]);
+    uint8_t* tmp_buf = meta_buf.get();
+    UNALIGNED_STORE64(tmp_buf, stored_buffer->size());
+    tmp_buf += sizeof(size_t);
+    if (_compress_codec != nullptr) {
+        UNALIGNED_STORE64(tmp_buf, uncompressed_size);
+        tmp_buf += sizeof(size_t);
+    }
+    for (auto encode_level : encode_levels) {
+        UNALIGNED_STORE32(tmp_buf, encode_level);
+        tmp_buf += sizeof(uint32_t);
+    }
+
     std::vector<Slice> data;
     data.emplace_back(Slice(meta_buf.get(), meta_len));
-    data.emplace_back(Slice(serialize_buffer.data(), serialize_buffer.size()));
+    data.emplace_back(Slice(stored_buffer->data(), stored_buffer->size()));
     {
         SCOPED_TIMER(_parent->metrics().write_io_timer);
         RETURN_IF_ERROR(block->append(data));
     }
-    COUNTER_UPDATE(_parent->metrics().flush_bytes, meta_len + serialize_buffer.size());
-    _parent->metrics().total_spill_bytes->fetch_add(meta_len + serialize_buffer.size());
+    COUNTER_UPDATE(_parent->metrics().flush_bytes, meta_len + stored_buffer->size());
+    _parent->metrics().total_spill_bytes->fetch_add(meta_len + stored_buffer->size());
     TRACE_SPILL_LOG << "serialize chunk to block: " << block->debug_string()
-                    << ", original size: " << chunk->bytes_usage() << ", encoded size: " << serialize_buffer.size();
+                    << ", original size: " << chunk->bytes_usage() << ", encoded size: " << serialize_buffer.size()
+                    << ", stored size: " << stored_buffer->size();
     return Status::OK();
 }
 
@@ -168,6 +244,12 @@ StatusOr<ChunkUniquePtr> ColumnarSerde::deserialize(SerdeContext& ctx, BlockRead
         RETURN_IF_ERROR(reader->read_fully(&encoded_size, sizeof(size_t)));
     }
     size_t read_bytes = sizeof(size_t) + encoded_size;
+    size_t uncompressed_size = 0;
+    if (_compress_codec != nullptr) {
+        SCOPED_TIMER(_parent->metrics().read_io_timer);
+        RETURN_IF_ERROR(reader->read_fully(&uncompressed_size, sizeof(size_t)));
+        read_bytes += sizeof(size_t);
+    }
     std::vector<uint32_t> encode_levels;
     auto chunk = _chunk_builder();
     auto& columns = chunk->columns();
@@ -181,14 +263,8 @@ StatusOr<ChunkUniquePtr> ColumnarSerde::deserialize(SerdeContext& ctx, BlockRead
         }
         read_bytes += columns.size() * sizeof(uint32_t);
     }
+    RETURN_IF_ERROR(read_stored_data(_parent, _compress_codec, ctx, reader, encoded_size, uncompressed_size));
     auto& serialize_buffer = ctx.serialize_buffer;
-    serialize_buffer.resize(encoded_size);
-
-    auto buf = reinterpret_cast<uint8_t*>(serialize_buffer.data());
-    {
-        SCOPED_TIMER(_parent->metrics().read_io_timer);
-        RETURN_IF_ERROR(reader->read_fully(buf, encoded_size));
-    }
 
     const uint8_t* read_cursor = reinterpret_cast<uint8_t*>(serialize_buffer.data());
     if (_encode_context == nullptr) {
@@ -208,7 +284,105 @@ StatusOr<ChunkUniquePtr> ColumnarSerde::deserialize(SerdeContext& ctx, BlockRead
     return chunk;
 }
 
+// EncodedColumnarSerde encodes each column with ColumnEncoder, the encoded chunk is block compressed then.
+class EncodedColumnarSerde : public Serde {
+public:
+    EncodedColumnarSerde(Spiller* parent, ChunkBuilder chunk_builder)
+            : Serde(parent), _chunk_builder(std::move(chunk_builder)) {}
+    ~EncodedColumnarSerde() override = default;
+
+    Status prepare() override {
+        return get_block_compression_codec(_parent->options().compress_type, &_compress_codec);
+    }
+
+    Status serialize(SerdeContext& ctx, const ChunkPtr& chunk, BlockPtr block) override;
+    StatusOr<ChunkUniquePtr> deserialize(SerdeContext& ctx, BlockReader* reader) override;
+
+private:
+    ChunkBuilder _chunk_builder;
+    // codec of the spilled data, nullptr if compression is disabled
+    const BlockCompressionCodec* _compress_codec = nullptr;
+};
+
+Status EncodedColumnarSerde::serialize(SerdeContext& ctx, const ChunkPtr& chunk, BlockPtr block) {
+    auto& serialize_buffer = ctx.serialize_buffer;
+    serialize_buffer.clear();
+    serialize_buffer.reserve(chunk->bytes_usage());
+    {
+        SCOPED_TIMER(_parent->metrics().serialize_timer);
+        for (const auto& column : chunk->columns()) {
+            RETURN_IF_ERROR(ColumnEncoder::encode(*column, &serialize_buffer));
+        }
+    }
+
+    size_t uncompressed_size = 0;
+    const std::string* stored_buffer = &serialize_buffer;
+    if (_compress_codec != nullptr) {
+        ASSIGN_OR_RETURN(bool compressed, try_compress(_parent, _compress_codec, ctx));
+        if (compressed) {
+            uncompressed_size = serialize_buffer.size();
+            stored_buffer = &ctx.compress_buffer;
+        }
+    }
+
+    // 8 bytes for stored size, 8 bytes for uncompressed size, 0 means the data is stored uncompressed.
+    uint8_t meta_buf[sizeof(size_t) * 2];
+    UNALIGNED_STORE64(meta_buf, stored_buffer->size());
+    UNALIGNED_STORE64(meta_buf + sizeof(size_t), uncompressed_size);
+
+    std::vector<Slice> data;
+    data.emplace_back(Slice(meta_buf, sizeof(meta_buf)));
+    data.emplace_back(Slice(stored_buffer->data(), stored_buffer->size()));
+    {
+        SCOPED_TIMER(_parent->metrics().write_io_timer);
+        RETURN_IF_ERROR(block->append(data));
+    }
+    COUNTER_UPDATE(_parent->metrics().flush_bytes, sizeof(meta_buf) + stored_buffer->size());
+    _parent->metrics().total_spill_bytes->fetch_add(sizeof(meta_buf) + stored_buffer->size());
+    TRACE_SPILL_LOG << "serialize chunk to block: " << block->debug_string()
+                    << ", original size: " << chunk->bytes_usage() << ", encoded size: " << serialize_buffer.size()
+                    << ", stored size: " << stored_buffer->size();
+    return Status::OK();
+}
+
+StatusOr<ChunkUniquePtr> EncodedColumnarSerde::deserialize(SerdeContext& ctx, BlockReader* reader) {
+    size_t meta[2];
+    {
+        SCOPED_TIMER(_parent->metrics().read_io_timer);
+        RETURN_IF_ERROR(reader->read_fully(meta, sizeof(meta)));
+    }
+    const size_t stored_size = meta[0];
+    const size_t uncompressed_size = meta[1];
+    RETURN_IF_ERROR(read_stored_data(_parent, _compress_codec, ctx, reader, stored_size, uncompressed_size));
+
+    auto chunk = _chunk_builder();
+    {
+        SCOPED_TIMER(_parent->metrics().deserialize_timer);
+        const auto& serialize_buffer = ctx.serialize_buffer;
+        const auto* read_cursor = reinterpret_cast<const uint8_t*>(serialize_buffer.data());
+        const uint8_t* end = read_cursor + serialize_buffer.size();
+        for (auto& column : chunk->columns()) {
+            RETURN_IF_ERROR(ColumnEncoder::decode(&read_cursor, end, column.get()));
+        }
+        if (UNLIKELY(read_cursor != end)) {
+            return Status::Corruption(fmt::format("{} bytes are left after deserializing the spilled chunk",
+                                                  end - read_cursor));
+        }
+    }
+    COUNTER_UPDATE(_parent->metrics().restore_bytes, sizeof(meta) + stored_size);
+    TRACE_SPILL_LOG << "deserialize chunk from block: " << reader->debug_string() << ", stored size: " << stored_size
+                    << ", original size: " << chunk->bytes_usage();
+    return chunk;
+}
+
 StatusOr<SerdePtr> Serde::create_serde(Spiller* parent) {
-    return std::make_shared<ColumnarSerde>(parent, parent->chunk_builder(), nullptr);
+    switch (parent->options().serde_type) {
+    case SerdeType::BY_COLUMN:
+        return std::make_shared<ColumnarSerde>(parent, parent->chunk_builder(), nullptr);
+    case SerdeType::ENCODED_BY_COLUMN:
+        return std::make_shared<EncodedColumnarSerde>(parent, parent->chunk_builder());
+    }
+    return Status::InternalError(
+            fmt::format("unknown spill serde type {}", static_cast<int>(parent->options().serde_type)));
 }
 } // namespace starrocks::spill
@@ -25,11 +25,16 @@ namespace starrocks::spill {
 class ChunkBuilder;
 
 enum class SerdeType {
+    // columns are serialized by ColumnArraySerde
     BY_COLUMN,
+    // columns are encoded by ColumnEncoder with dictionary and bit-packing encodings
+    ENCODED_BY_COLUMN,
 };
 
 struct SerdeContext {
     std::string serialize_buffer;
+    // scratch buffer for block compression of serialize_buffer
+    std::string compress_buffer;
 };
 class Spiller;
 // Serde is used to serialize and deserialize spilled data.
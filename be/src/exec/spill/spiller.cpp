@@ -32,6 +32,7 @@
 #include "exec/sort_exec_exprs.h"
 #include "exec/spill/input_stream.h"
 #include "exec/spill/mem_table.h"
+#include "exec/spill/operator_mem_resource_manager.h"
 #include "exec/spill/options.h"
 #include "exec/spill/spiller.hpp"
 #include "gutil/port.h"
@@ -58,6 +59,8 @@ SpillProcessMetrics::SpillProcessMetrics(RuntimeProfile* profile, std::atomic_in
     restore_bytes = ADD_CHILD_COUNTER(profile, "BytesRestoreFromDisk", TUnit::BYTES, parent);
     serialize_timer = ADD_CHILD_TIMER(profile, "SerializeTime", parent);
     deserialize_timer = ADD_CHILD_TIMER(profile, "DeserializeTime", parent);
+    compress_timer = ADD_CHILD_TIMER(profile, "CompressTime", parent);
+    decompress_timer = ADD_CHILD_TIMER(profile, "DecompressTime", parent);
     mem_table_peak_memory_usage = profile->AddHighWaterMarkCounter(
             "MemTablePeakMemoryBytes", TUnit::BYTES, RuntimeProfile::Counter::create_strategy(TUnit::BYTES), parent);
     input_stream_peak_memory_usage = profile->AddHighWaterMarkCounter(
@@ -103,6 +106,7 @@ Status Spiller::prepare(RuntimeState* state) {
 
     _block_group = std::make_shared<spill::BlockGroup>();
     _block_manager = _opts.block_manager;
+    _read_ahead_budget->set_max_bytes(OperatorMemoryResourceManager::operator_avaliable_memory_bytes(state));
 
     return Status::OK();
 }
@@ -146,6 +150,23 @@ std::vector<std::shared_ptr<SpillerReader> > Spiller::get_partition_spill_reader
     return res;
 }
 
+StatusOr<std::vector<std::shared_ptr<SpillerReader> > > Spiller::get_sorted_run_readers() {
+    DCHECK(!_opts.is_unordered);
+    auto* writer = _writer->as<RawSpillerWriter*>();
+    ASSIGN_OR_RETURN(auto streams, writer->block_group().as_sorted_run_streams(_serde, this));
+
+    std::vector<std::shared_ptr<SpillerReader> > res;
+    for (auto& stream : streams) {
+        res.emplace_back(std::make_shared<SpillerReader>(this));
+        res.back()->set_stream(std::move(stream));
+    }
+    return res;
+}
+
+size_t Spiller::num_sorted_runs() {
+    return _writer->as<RawSpillerWriter*>()->block_group().num_blocks();
+}
+
 Status Spiller::_acquire_input_stream(RuntimeState* state) {
     std::shared_ptr<SpillInputStream> input_stream;
 
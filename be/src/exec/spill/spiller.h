@@ -72,6 +72,10 @@ public:
     RuntimeProfile::Counter* serialize_timer = nullptr;
     // time spent to deserialize data after read it from disk
     RuntimeProfile::Counter* deserialize_timer = nullptr;
+    // time spent to compress serialized data before flush it to disk
+    RuntimeProfile::Counter* compress_timer = nullptr;
+    // time spent to decompress data after read it from disk
+    RuntimeProfile::Counter* decompress_timer = nullptr;
     // peak memory usage of mem table
     RuntimeProfile::HighWaterMarkCounter* mem_table_peak_memory_usage = nullptr;
     // peak memory usage of input stream
@@ -146,14 +150,16 @@ public:
     // prepared for as read
     template <class TaskExecutor, class MemGuard>
     Status flush(RuntimeState* state, TaskExecutor&& executor, MemGuard&& guard);
-    template <class MemGuard>
-    Status set_flush_all_call_back(const FlushAllCallBack& callback, RuntimeState* state, IOTaskExecutor& executor,
+    template <class TaskExecutor, class MemGuard>
+    Status set_flush_all_call_back(const FlushAllCallBack& callback, RuntimeState* state, TaskExecutor& executor,
                                    const MemGuard& guard) {
         auto flush_call_back = [this, callback, state, &executor, guard]() {
             auto defer = DeferOp([&]() { guard.scoped_end(); });
             RETURN_IF(!guard.scoped_begin(), Status::Cancelled("cancelled"));
+            // decided before the callback, which may start the reader of the spilled data.
+            const bool restore_by_sorted_runs = _decide_restore_by_sorted_runs();
             RETURN_IF_ERROR(callback());
-            if (!_is_cancel && spilled()) {
+            if (!_is_cancel && spilled() && !restore_by_sorted_runs) {
                 RETURN_IF_ERROR(_acquire_input_stream(state));
                 RETURN_IF_ERROR(trigger_restore(state, executor, guard));
             }
@@ -197,18 +203,43 @@ public:
     std::vector<std::shared_ptr<SpillerReader>> get_partition_spill_readers(
             const std::vector<const SpillPartitionInfo*>& parititons);
 
+    // The spilled sorted runs are restored by get_sorted_run_readers instead of being merged into one ordered
+    // stream by restore(), so that the runs could be merged by the caller in parallel. Must be set before flush.
+    // If more than max_runs runs are spilled, they are still merged into one ordered stream, whose restore is
+    // triggered by the flush-all callback as usual.
+    void set_restore_by_sorted_runs(size_t max_runs) {
+        _restore_by_sorted_runs = true;
+        _max_sorted_runs = max_runs;
+    }
+    // Only valid after all the data has been flushed.
+    bool restore_by_sorted_runs() const { return _restore_by_sorted_runs; }
+
+    // Returns a reader per spilled sorted run, only valid after all the data has been flushed.
+    StatusOr<std::vector<std::shared_ptr<SpillerReader>>> get_sorted_run_readers();
+    size_t num_sorted_runs();
+
     const std::unique_ptr<SpillerWriter>& writer() { return _writer; }
     const std::shared_ptr<SpillerReader>& reader() { return _reader; }
 
     const std::shared_ptr<spill::Serde>& serde() { return _serde; }
     BlockManager* block_manager() { return _block_manager; }
     const ChunkBuilder& chunk_builder() { return _chunk_builder; }
+    // limits the chunks read ahead by restore tasks, shared by all the input streams of the spiller
+    const std::shared_ptr<spill::ReadAheadBudget>& read_ahead_budget() { return _read_ahead_budget; }
 
     Status reset_state(RuntimeState* state);
 
 private:
     Status _acquire_input_stream(RuntimeState* state);
 
+    // Too many sorted runs would take too many merge buffers of the caller, so they are merged here instead.
+    bool _decide_restore_by_sorted_runs() {
+        if (_restore_by_sorted_runs && spilled() && num_sorted_runs() > _max_sorted_runs) {
+            _restore_by_sorted_runs = false;
+        }
+        return _restore_by_sorted_runs;
+    }
+
     Status _decrease_running_flush_tasks();
 
 private:
@@ -231,6 +262,10 @@ private:
     std::shared_ptr<spill::Serde> _serde;
     spill::BlockManager* _block_manager = nullptr;
     std::shared_ptr<spill::BlockGroup> _block_group;
+    // held by the input streams too, which may outlive the spiller in restore tasks
+    std::shared_ptr<spill::ReadAheadBudget> _read_ahead_budget = std::make_shared<spill::ReadAheadBudget>();
+    std::atomic_bool _restore_by_sorted_runs = false;
+    size_t _max_sorted_runs = 0;
 
     std::atomic_bool _is_cancel = false;
 };
@@ -109,6 +109,60 @@ Status SpillableChunksSorterFullSort::get_next(ChunkPtr* chunk, bool* eos) {
     return Status::OK();
 }
 
+std::vector<ChunksSorter::SortedRunProvider> SpillableChunksSorterFullSort::spilled_sorted_run_providers() {
+    std::vector<SortedRunProvider> providers;
+    // the spiller merges too many runs into one ordered stream by itself, which is restored by get_next
+    if (!_spiller->spilled() || !_spiller->restore_by_sorted_runs()) {
+        return providers;
+    }
+
+    Status st = _create_sorted_run_providers(&providers);
+    if (!st.ok()) {
+        // the spilled data can't be restored by get_next either, so the error is reported through the spiller
+        _spiller->update_spilled_task_status(std::move(st));
+        providers.clear();
+        providers.emplace_back([](bool only_check_if_has_data, ChunkPtr* chunk, bool* eos) {
+            if (!only_check_if_has_data) {
+                *eos = true;
+            }
+            return true;
+        });
+    }
+    return providers;
+}
+
+Status SpillableChunksSorterFullSort::_create_sorted_run_providers(std::vector<SortedRunProvider>* providers) {
+    ASSIGN_OR_RETURN(auto readers, _spiller->get_sorted_run_readers());
+    for (auto& reader : readers) {
+        RETURN_IF_ERROR(reader->trigger_restore(_state, io_executor(), TRACKER_WITH_SPILLER_GUARD(_state, _spiller)));
+        providers->emplace_back([this, reader](bool only_check_if_has_data, ChunkPtr* chunk, bool* eos) {
+            // a failed restore task leaves the stream not ready, so the error is checked first
+            const bool failed = !_spiller->task_status().ok();
+            if (!failed && !reader->has_output_data()) {
+                return false;
+            }
+            if (only_check_if_has_data) {
+                return true;
+            }
+            if (failed) {
+                *eos = true;
+                return true;
+            }
+            auto chunk_st = reader->restore(_state, io_executor(), TRACKER_WITH_SPILLER_GUARD(_state, _spiller));
+            if (!chunk_st.ok()) {
+                if (!chunk_st.status().is_end_of_file()) {
+                    _spiller->update_spilled_task_status(Status(chunk_st.status()));
+                }
+                *eos = true;
+                return true;
+            }
+            *chunk = std::move(chunk_st.value());
+            return true;
+        });
+    }
+    return Status::OK();
+}
+
 size_t SpillableChunksSorterFullSort::reserved_bytes(const ChunkPtr& chunk) {
     if (chunk) {
         return chunk->memory_usage() + (_unsorted_chunk != nullptr ? _unsorted_chunk->memory_usage() * 2 : 0);
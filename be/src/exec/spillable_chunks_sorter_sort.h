@@ -33,6 +33,7 @@ public:
     Status update(RuntimeState* state, const ChunkPtr& chunk) override;
     Status do_done(RuntimeState* state) override;
     Status get_next(ChunkPtr* chunk, bool* eos) override;
+    std::vector<SortedRunProvider> spilled_sorted_run_providers() override;
     size_t reserved_bytes(const ChunkPtr& chunk) override;
 
     void cancel() override;
@@ -46,6 +47,8 @@ private:
 
     Status _get_result_from_spiller(ChunkPtr* chunk, bool* eos);
 
+    Status _create_sorted_run_providers(std::vector<SortedRunProvider>* providers);
+
     size_t _process_staging_unsorted_chunk_idx = 0;
     // used in spill
     size_t _process_sorted_chunk_idx = 0;
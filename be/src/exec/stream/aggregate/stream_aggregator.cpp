@@ -43,6 +43,7 @@ void append_prev_result(ChunkPtr result_chunk, const Columns& group_by_columns,
 
 StreamAggregator::StreamAggregator(AggregatorParamsPtr params) : Aggregator(std::move(params)) {
     _count_agg_idx = _params->count_agg_idx;
+    _support_columnar_agg_states = false;
 }
 
 Status StreamAggregator::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile* runtime_profile) {
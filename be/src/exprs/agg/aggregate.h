@@ -84,6 +84,16 @@ public:
     virtual void batch_serialize(FunctionContext* ctx, size_t chunk_size, const Buffer<AggDataPtr>& agg_states,
                                  size_t state_offsets, Column* to) const = 0;
 
+    // batch serialize num_states aggregate states stored contiguously from |states|,
+    // e.g. the columnar states of consecutive groups
+    virtual void batch_serialize_contiguous(FunctionContext* ctx, size_t num_states, ConstAggDataPtr __restrict states,
+                                            Column* to) const {
+        const size_t state_size = size();
+        for (size_t i = 0; i < num_states; i++) {
+            serialize_to_column(ctx, states + i * state_size, to);
+        }
+    }
+
     // Change the aggregation state to final result if necessary
     virtual void finalize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const = 0;
 
@@ -417,6 +427,13 @@ public:
             static_cast<const Derived*>(this)->finalize_to_column(ctx, agg_states[i] + state_offset, to);
         }
     }
+
+    void batch_serialize_contiguous(FunctionContext* ctx, size_t num_states, ConstAggDataPtr __restrict states,
+                                    Column* to) const override {
+        for (size_t i = 0; i < num_states; i++) {
+            static_cast<const Derived*>(this)->serialize_to_column(ctx, states + i * sizeof(State), to);
+        }
+    }
 };
 
 using AggregateFunctionPtr = std::shared_ptr<AggregateFunction>;
@@ -117,6 +117,21 @@ public:
         }
     }
 
+    void batch_serialize_contiguous(FunctionContext* ctx, size_t num_states, ConstAggDataPtr __restrict states,
+                                    Column* to) const override {
+        using State = AggregateCountFunctionState<IsWindowFunc>;
+        Buffer<int64_t>& result_data = down_cast<Int64Column*>(to)->get_data();
+        if constexpr (sizeof(State) == sizeof(int64_t)) {
+            // the state is exactly the count, so the contiguous states are a count array
+            const auto* counts = reinterpret_cast<const int64_t*>(states);
+            result_data.insert(result_data.end(), counts, counts + num_states);
+        } else {
+            for (size_t i = 0; i < num_states; i++) {
+                result_data.emplace_back(this->data(states + i * sizeof(State)).count);
+            }
+        }
+    }
+
     void finalize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const override {
         DCHECK(to->is_numeric());
         down_cast<Int64Column*>(to)->append(this->data(state).count);
@@ -140,6 +140,15 @@ public:
         }
     }
 
+    void batch_serialize_contiguous(FunctionContext* ctx, size_t num_states, ConstAggDataPtr __restrict states,
+                                    Column* to) const override {
+        // the state is exactly the sum, so the contiguous states are a sum array
+        static_assert(sizeof(SumAggregateState<ResultType>) == sizeof(ResultType));
+        auto& result_data = down_cast<ResultColumnType*>(to)->get_data();
+        const auto* sums = reinterpret_cast<const ResultType*>(states);
+        result_data.insert(result_data.end(), sums, sums + num_states);
+    }
+
     void finalize_to_column([[maybe_unused]] FunctionContext* ctx, ConstAggDataPtr __restrict state,
                             Column* to) const override {
         DCHECK(to->is_numeric() || to->is_decimal());
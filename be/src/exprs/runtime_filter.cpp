@@ -122,6 +122,27 @@ void SimdBlockFilter::merge(const SimdBlockFilter& bf) {
     }
 }
 
+void SimdBlockFilter::init_full() {
+    free(_directory);
+    _directory = nullptr;
+    init(1);
+    memset(_directory, 0xff, get_alloc_size());
+}
+
+bool SimdBlockFilter::full() const {
+    if (_directory == nullptr) {
+        return false;
+    }
+    const auto* words = reinterpret_cast<const uint32_t*>(_directory);
+    const size_t num_words = get_alloc_size() / sizeof(uint32_t);
+    for (size_t i = 0; i < num_words; i++) {
+        if (words[i] != 0xffffffff) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // For scalar version:
 void SimdBlockFilter::make_mask(uint32_t key, uint32_t* masks) const {
     for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
@@ -188,10 +209,13 @@ size_t JoinRuntimeFilter::deserialize(int serialize_version, const uint8_t* data
 
     if (_num_hash_partitions == 0) {
         offset += _bf.deserialize(data + offset);
+        _min_max_only = _bf.full();
     } else {
+        _min_max_only = true;
         for (size_t i = 0; i < _num_hash_partitions; i++) {
             SimdBlockFilter bf;
             offset += bf.deserialize(data + offset);
+            _min_max_only &= bf.full();
             _hash_partition_bf.emplace_back(std::move(bf));
         }
     }
@@ -164,6 +164,11 @@ public:
     bool check_equal(const SimdBlockFilter& bf) const;
     uint32_t directory_mask() const { return _directory_mask; }
 
+    // reset to the smallest filter with all the bits set, every hash passes it.
+    void init_full();
+    // whether all the bits are set, a full filter can not filter out anything.
+    bool full() const;
+
 private:
     // The number of bits to set in a tiny Bloom filter block
 
@@ -313,18 +318,27 @@ public:
     virtual void merge(const JoinRuntimeFilter* rf) {
         _has_null |= rf->_has_null;
         _bf.merge(rf->_bf);
+        _min_max_only &= rf->_min_max_only;
     }
 
     virtual void concat(JoinRuntimeFilter* rf) {
         _has_null |= rf->_has_null;
         _hash_partition_bf.emplace_back(std::move(rf->_bf));
         _num_hash_partitions = _hash_partition_bf.size();
+        _min_max_only = (_num_hash_partitions == 1 || _min_max_only) && rf->_min_max_only;
         _join_mode = rf->_join_mode;
         _size += rf->_size;
     }
     virtual bool check_equal(const JoinRuntimeFilter& rf) const;
     virtual JoinRuntimeFilter* create_empty(ObjectPool* pool) = 0;
 
+    // Called after the filter is filled with all the build keys, whose number of distinct values is `ndv`.
+    // If the keys are dense in [min, max], the bloom filter can hardly filter out more rows than min/max,
+    // so it is replaced by a tiny full one and only min/max is evaluated.
+    virtual void use_min_max_only_if_dense(size_t ndv) {}
+    // the bloom filter is full, only min/max takes effect.
+    bool min_max_only() const { return _min_max_only; }
+
 protected:
     void _update_version() { _rf_version++; }
 
@@ -335,6 +349,7 @@ protected:
     size_t _num_hash_partitions = 0;
     std::vector<SimdBlockFilter> _hash_partition_bf;
     bool _always_true = false;
+    bool _min_max_only = false;
     size_t _rf_version = 0;
 };
 
@@ -402,7 +417,7 @@ public:
         _bf.init(_size);
     }
 
-    size_t compute_hash(CppType value) const {
+    static size_t compute_hash(CppType value) {
         if constexpr (IsSlice<CppType>) {
             return SliceHash()(value);
         } else {
@@ -459,7 +474,8 @@ public:
     std::string debug_string() const override {
         LogicalType ltype = Type;
         std::stringstream ss;
-        ss << "RuntimeBF(type = " << ltype << ", bfsize = " << _size << ", has_null = " << _has_null;
+        ss << "RuntimeBF(type = " << ltype << ", bfsize = " << _size << ", has_null = " << _has_null
+           << ", min_max_only = " << _min_max_only;
         if constexpr (std::is_integral_v<CppType> || std::is_floating_point_v<CppType>) {
             if constexpr (!std::is_same_v<CppType, __int128>) {
                 ss << ", _min = " << _min << ", _max = " << _max;
@@ -582,6 +598,27 @@ public:
         return offset;
     }
 
+    void use_min_max_only_if_dense(size_t ndv) override {
+        if constexpr (std::is_integral_v<CppType>) {
+            if (_num_hash_partitions != 0 || _min > _max) {
+                return;
+            }
+            // width of [min, max] minus 1, it doesn't overflow even for int128.
+            using RangeType = unsigned __int128;
+            RangeType range = static_cast<RangeType>(static_cast<__int128>(_max)) -
+                              static_cast<RangeType>(static_cast<__int128>(_min));
+            // The keys are dense only if they cover almost all the values in [min, max], i.e. the width is at most
+            // 5% larger than ndv, otherwise the bloom filter still drops the probe rows in the holes of the range.
+            if (range >= static_cast<RangeType>(ndv) * 2) {
+                return;
+            }
+            if ((range + 1) * 20 <= static_cast<RangeType>(ndv) * 21) {
+                _bf.init_full();
+                _min_max_only = true;
+            }
+        }
+    }
+
     bool check_equal(const JoinRuntimeFilter& base_rf) const override {
         if (!JoinRuntimeFilter::check_equal(base_rf)) return false;
         const auto& rf = static_cast<const RuntimeBloomFilter<Type>&>(base_rf);
@@ -819,7 +856,9 @@ private:
             } else {
                 auto* input_data = down_cast<const ColumnType*>(const_column->data_column().get())->get_data().data();
                 _evaluate_min_max(input_data, _selection, 1);
-                _rf_test_data<hash_partition>(_selection, input_data, _hash_values, 0);
+                if (!_min_max_only) {
+                    _rf_test_data<hash_partition>(_selection, input_data, _hash_values, 0);
+                }
             }
             uint8_t sel = _selection[0];
             memset(_selection, sel, size);
@@ -832,11 +871,11 @@ private:
                 for (int i = 0; i < size; i++) {
                     if (null_data[i]) {
                         _selection[i] = _has_null;
-                    } else {
+                    } else if (!_min_max_only) {
                         _rf_test_data<hash_partition>(_selection, input_data, _hash_values, i);
                     }
                 }
-            } else {
+            } else if (!_min_max_only) {
                 for (int i = 0; i < size; ++i) {
                     _rf_test_data<hash_partition>(_selection, input_data, _hash_values, i);
                 }
@@ -844,8 +883,10 @@ private:
         } else {
             auto* input_data = down_cast<const ColumnType*>(input_column)->get_data().data();
             _evaluate_min_max(input_data, _selection, size);
-            for (int i = 0; i < size; ++i) {
-                _rf_test_data<hash_partition>(_selection, input_data, _hash_values, i);
+            if (!_min_max_only) {
+                for (int i = 0; i < size; ++i) {
+                    _rf_test_data<hash_partition>(_selection, input_data, _hash_values, i);
+                }
             }
         }
     }
@@ -17,6 +17,7 @@
 #include <thread>
 
 #include "column/column.h"
+#include "common/config.h"
 #include "exec/pipeline/runtime_filter_types.h"
 #include "exprs/in_const_predicate.hpp"
 #include "exprs/literal.h"
@@ -28,6 +29,7 @@
 #include "runtime/runtime_filter_cache.h"
 #include "runtime/runtime_state.h"
 #include "simd/simd.h"
+#include "types/hll.h"
 #include "types/logical_type.h"
 #include "types/logical_type_infra.h"
 #include "util/time.h"
@@ -152,6 +154,40 @@ Status RuntimeFilterHelper::fill_runtime_bloom_filter(const ColumnPtr& column, L
     return Status::OK();
 }
 
+struct FilterNdvEstimator {
+    template <LogicalType ltype>
+    auto operator()(const ColumnPtr& column, size_t column_offset, HyperLogLog* hll) {
+        if (column->is_nullable()) {
+            auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(column);
+            const auto& data_array = GetContainer<ltype>().get_data(nullable_column->data_column().get());
+            for (size_t j = column_offset; j < data_array.size(); j++) {
+                if (!nullable_column->is_null(j)) {
+                    hll->update(RuntimeBloomFilter<ltype>::compute_hash(data_array[j]));
+                }
+            }
+        } else {
+            const auto& data_array = GetContainer<ltype>().get_data(column.get());
+            for (size_t j = column_offset; j < data_array.size(); j++) {
+                hll->update(RuntimeBloomFilter<ltype>::compute_hash(data_array[j]));
+            }
+        }
+        return nullptr;
+    }
+};
+
+size_t RuntimeFilterHelper::estimate_runtime_bloom_filter_ndv(const Columns& columns, LogicalType type,
+                                                              size_t column_offset) {
+    HyperLogLog hll;
+    for (const auto& column : columns) {
+        // large binary column is not supported by runtime bloom filter.
+        if (column->has_large_column()) {
+            continue;
+        }
+        type_dispatch_filter(type, nullptr, FilterNdvEstimator(), column, column_offset, &hll);
+    }
+    return hll.estimate_cardinality();
+}
+
 StatusOr<ExprContext*> RuntimeFilterHelper::rewrite_runtime_filter_in_cross_join_node(ObjectPool* pool,
                                                                                       ExprContext* conjunct,
                                                                                       Chunk* chunk) {
@@ -285,6 +321,13 @@ Status RuntimeFilterProbeDescriptor::prepare(RuntimeState* state, const RowDescr
     _latency_timer = ADD_COUNTER(p, strings::Substitute("JoinRuntimeFilter/$0/latency", _filter_id), TUnit::TIME_NS);
     // not set yet.
     _latency_timer->set((int64_t)(-1));
+    _input_rows_counter =
+            ADD_COUNTER(p, strings::Substitute("JoinRuntimeFilter/$0/InputRows", _filter_id), TUnit::UNIT);
+    _output_rows_counter =
+            ADD_COUNTER(p, strings::Substitute("JoinRuntimeFilter/$0/OutputRows", _filter_id), TUnit::UNIT);
+    _skipped_rows_counter =
+            ADD_COUNTER(p, strings::Substitute("JoinRuntimeFilter/$0/SkippedRows", _filter_id), TUnit::UNIT);
+    _runtime_profile = p;
     return Status::OK();
 }
 
@@ -337,6 +380,8 @@ std::string RuntimeFilterProbeDescriptor::debug_string() const {
 }
 
 static const int default_runtime_filter_wait_timeout_ms = 1000;
+// a useless runtime filter is sampled at least once every 2^kMaxUselessSampleBackoff sampling rounds.
+static constexpr uint32_t kMaxUselessSampleBackoff = 5;
 
 RuntimeFilterProbeCollector::RuntimeFilterProbeCollector() : _wait_timeout_ms(default_runtime_filter_wait_timeout_ms) {}
 
@@ -386,6 +431,16 @@ void RuntimeFilterProbeCollector::do_evaluate(Chunk* chunk, RuntimeBloomFilterEv
     }
 
     auto& seletivity_map = eval_context.selectivity;
+    for (auto& [filter_id, rf_desc] : _descriptors) {
+        const JoinRuntimeFilter* filter = rf_desc->runtime_filter();
+        if (filter == nullptr || filter->always_true()) {
+            continue;
+        }
+        auto is_selected = [rf_desc = rf_desc](const auto& kv) { return kv.second == rf_desc; };
+        if (std::none_of(seletivity_map.begin(), seletivity_map.end(), is_selected)) {
+            rf_desc->update_skipped_rows(chunk->num_rows());
+        }
+    }
     if (seletivity_map.empty()) {
         return;
     }
@@ -410,6 +465,7 @@ void RuntimeFilterProbeCollector::do_evaluate(Chunk* chunk, RuntimeBloomFilterEv
 
         auto true_count = SIMD::count_nonzero(selection);
         eval_context.run_filter_nums += 1;
+        rf_desc->update_rows_counters(chunk->num_rows(), true_count);
 
         if (true_count == 0) {
             chunk->set_num_rows(0);
@@ -487,6 +543,7 @@ void RuntimeFilterProbeCollector::update_selectivity(Chunk* chunk, RuntimeBloomF
             _runtime_state->func_version() <= 3 || !_runtime_state->enable_pipeline_engine();
     auto& seletivity_map = eval_context.selectivity;
     use_merged_selection = true;
+    const size_t sample_round = eval_context.sample_rounds++;
 
     seletivity_map.clear();
     for (auto& kv : _descriptors) {
@@ -495,6 +552,13 @@ void RuntimeFilterProbeCollector::update_selectivity(Chunk* chunk, RuntimeBloomF
         if (filter == nullptr || filter->always_true()) {
             continue;
         }
+        // back off sampling the runtime filter that was useless in the last sampling rounds.
+        uint32_t& useless_rounds = eval_context.useless_sample_rounds[rf_desc->filter_id()];
+        const uint32_t sample_interval = 1U << std::min(useless_rounds, kMaxUselessSampleBackoff);
+        if ((sample_round & (sample_interval - 1)) != 0) {
+            rf_desc->update_skipped_rows(chunk_size);
+            continue;
+        }
         auto& selection = eval_context.running_context.use_merged_selection
                                   ? eval_context.running_context.merged_selection
                                   : eval_context.running_context.selection;
@@ -507,8 +571,12 @@ void RuntimeFilterProbeCollector::update_selectivity(Chunk* chunk, RuntimeBloomF
         filter->evaluate(column.get(), &eval_context.running_context);
         auto true_count = SIMD::count_nonzero(selection);
         eval_context.run_filter_nums += 1;
+        rf_desc->update_rows_counters(chunk_size, true_count);
         double selectivity = true_count * 1.0 / chunk_size;
-        if (selectivity <= 0.5) {                          // useful filter
+        if (selectivity > config::runtime_filter_useful_selectivity) { // useless filter
+            useless_rounds++;
+        } else { // useful filter
+            useless_rounds = 0;
             if (selectivity < _early_return_selectivity) { // very useful filter, could early return
                 seletivity_map.clear();
                 seletivity_map.emplace(selectivity, rf_desc);
@@ -647,6 +715,10 @@ void RuntimeFilterProbeDescriptor::set_runtime_filter(const JoinRuntimeFilter* r
     if (_ready_timestamp == 0 && rf != nullptr && _latency_timer != nullptr) {
         _ready_timestamp = UnixMillis();
         _latency_timer->set((_ready_timestamp - _open_timestamp) * 1000);
+        if (!_is_topn_filter) {
+            _runtime_profile->add_info_string(strings::Substitute("JoinRuntimeFilter/$0/Type", _filter_id),
+                                              rf->min_max_only() ? "MinMax" : "Bloom");
+        }
     }
 }
 
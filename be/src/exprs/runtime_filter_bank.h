@@ -56,6 +56,9 @@ public:
     static JoinRuntimeFilter* create_runtime_bloom_filter(ObjectPool* pool, LogicalType type);
     static Status fill_runtime_bloom_filter(const ColumnPtr& column, LogicalType type, JoinRuntimeFilter* filter,
                                             size_t column_offset, bool eq_null);
+    // estimate the number of distinct non-null values in columns, which is used to size the runtime bloom filter
+    // instead of the number of rows of the hash table, since the build side may have lots of duplicated keys.
+    static size_t estimate_runtime_bloom_filter_ndv(const Columns& columns, LogicalType type, size_t column_offset);
 
     static StatusOr<ExprContext*> rewrite_runtime_filter_in_cross_join_node(ObjectPool* pool, ExprContext* conjunct,
                                                                             Chunk* chunk);
@@ -161,6 +164,17 @@ public:
     const TRuntimeFilterBuildJoinMode::type join_mode() const { return _join_mode; };
     const std::vector<int32_t>* bucketseq_to_partition() const { return &_bucketseq_to_partition; }
     const std::vector<ExprContext*>* partition_by_expr_contexts() const { return &_partition_by_exprs_contexts; }
+    void update_rows_counters(size_t input_rows, size_t output_rows) {
+        if (_input_rows_counter != nullptr) {
+            _input_rows_counter->update(input_rows);
+            _output_rows_counter->update(output_rows);
+        }
+    }
+    void update_skipped_rows(size_t rows) {
+        if (_skipped_rows_counter != nullptr) {
+            _skipped_rows_counter->update(rows);
+        }
+    }
 
 private:
     friend class HashJoinNode;
@@ -176,6 +190,12 @@ private:
     JoinRuntimeFilter::RunningContext _runtime_filter_ctx;
     // we want to measure when this runtime filter is applied since it's opened.
     RuntimeProfile::Counter* _latency_timer = nullptr;
+    // the number of rows evaluated by this runtime filter and the number of rows passing it.
+    RuntimeProfile::Counter* _input_rows_counter = nullptr;
+    RuntimeProfile::Counter* _output_rows_counter = nullptr;
+    // the number of rows this runtime filter is not evaluated on, because it is not selective enough.
+    RuntimeProfile::Counter* _skipped_rows_counter = nullptr;
+    RuntimeProfile* _runtime_profile = nullptr;
     int64_t _open_timestamp = 0;
     int64_t _ready_timestamp = 0;
     TRuntimeFilterBuildJoinMode::type _join_mode;
@@ -193,6 +213,11 @@ struct RuntimeBloomFilterEvalContext {
 
     std::map<double, RuntimeFilterProbeDescriptor*> selectivity;
     size_t input_chunk_nums = 0;
+    // the number of sampling rounds, in which the selectivity of runtime filters is updated.
+    size_t sample_rounds = 0;
+    // filter id -> the number of consecutive sampling rounds in which the runtime filter is useless. A useless
+    // runtime filter is sampled again only after 2^n rounds, so it costs little even in sampling rounds.
+    std::map<int32_t, uint32_t> useless_sample_rounds;
     int run_filter_nums = 0;
     JoinRuntimeFilter::RunningContext running_context;
     RuntimeProfile::Counter* join_runtime_filter_timer = nullptr;
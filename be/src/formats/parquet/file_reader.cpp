@@ -178,6 +178,10 @@ StatusOr<bool> FileReader::_filter_group(const tparquet::RowGroup& row_group) {
     }
 
     // filter by min/max in runtime filter.
+    return _filter_group_with_runtime_filters(row_group);
+}
+
+StatusOr<bool> FileReader::_filter_group_with_runtime_filters(const tparquet::RowGroup& row_group) {
     if (_scanner_ctx->runtime_filter_collector) {
         std::vector<SlotDescriptor*> min_max_slots(1);
 
@@ -447,6 +451,7 @@ Status FileReader::_init_group_readers() {
     _group_reader_param.lazy_column_coalesce_counter = fd_scanner_ctx.lazy_column_coalesce_counter;
 
     int64_t row_group_first_row = 0;
+    _runtime_filters_version = _get_runtime_filters_version();
     // select and create row group readers.
     for (size_t i = 0; i < _file_metadata->t_metadata().row_groups.size(); i++) {
         bool selected = _select_row_group(_file_metadata->t_metadata().row_groups[i]);
@@ -478,6 +483,7 @@ Status FileReader::_init_group_readers() {
         }
     }
     _row_group_size = _row_group_readers.size();
+    _runtime_filtered_row_groups.assign(_row_group_size, false);
 
     // initialize row group readers.
     for (auto& r : _row_group_readers) {
@@ -520,6 +526,46 @@ Status FileReader::_prepare_cur_row_group() {
     return r->prepare();
 }
 
+size_t FileReader::_get_runtime_filters_version() const {
+    size_t version = 0;
+    if (_scanner_ctx->runtime_filter_collector) {
+        for (auto& it : _scanner_ctx->runtime_filter_collector->descriptors()) {
+            const JoinRuntimeFilter* filter = it.second->runtime_filter();
+            if (filter != nullptr) {
+                // the arrival of a runtime filter counts as an update too
+                version += filter->rf_version() + 1;
+            }
+        }
+    }
+    return version;
+}
+
+Status FileReader::_prepare_next_row_group() {
+    // The row groups were filtered by the runtime filters when they were selected, but a runtime filter may arrive
+    // or be tightened later, e.g. the boundary of a top-n, so all the row groups not read yet are filtered again
+    // once per update.
+    const size_t runtime_filters_version = _get_runtime_filters_version();
+    if (runtime_filters_version != _runtime_filters_version) {
+        _runtime_filters_version = runtime_filters_version;
+        for (size_t i = _cur_row_group_idx; i < _row_group_size; i++) {
+            if (_runtime_filtered_row_groups[i]) {
+                continue;
+            }
+            const auto* row_group = _row_group_readers[i]->row_group_metadata();
+            ASSIGN_OR_RETURN(bool filtered, _filter_group_with_runtime_filters(*row_group));
+            _runtime_filtered_row_groups[i] = filtered;
+        }
+    }
+    while (_cur_row_group_idx < _row_group_size && _runtime_filtered_row_groups[_cur_row_group_idx]) {
+        _scanner_ctx->stats->runtime_filter_skip_groups += 1;
+        _cur_row_group_idx++;
+    }
+    if (_cur_row_group_idx < _row_group_size) {
+        RETURN_IF_ERROR(_prepare_cur_row_group());
+    }
+    return Status::OK();
+}
+
 Status FileReader::get_next(ChunkPtr* chunk) {
     if (_is_file_filtered) {
         return Status::EndOfFile("");
@@ -541,10 +587,8 @@ Status FileReader::get_next(ChunkPtr* chunk) {
             if (status.is_end_of_file()) {
                 _row_group_readers[_cur_row_group_idx]->close();
                 _cur_row_group_idx++;
-                if (_cur_row_group_idx < _row_group_size) {
-                    // prepare new group
-                    RETURN_IF_ERROR(_prepare_cur_row_group());
-                }
+                // prepare new group
+                RETURN_IF_ERROR(_prepare_next_row_group());
                 return Status::OK();
             }
         } else {
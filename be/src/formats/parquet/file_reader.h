@@ -70,6 +70,16 @@ private:
     // filter row group by min/max conjuncts
     StatusOr<bool> _filter_group(const tparquet::RowGroup& row_group);
 
+    // filter row group by min/max in runtime filters
+    StatusOr<bool> _filter_group_with_runtime_filters(const tparquet::RowGroup& row_group);
+
+    // sum of the versions of the runtime filters, which is increased whenever any of them arrives or is updated
+    size_t _get_runtime_filters_version() const;
+
+    // skip the row groups filtered by the runtime filters updated after they were selected,
+    // and prepare the first row group not filtered.
+    Status _prepare_next_row_group();
+
     // get row group to read
     // if scan range conatain the first byte in the row group, will be read
     // TODO: later modify the larger block should be read
@@ -112,6 +122,10 @@ private:
     std::vector<std::shared_ptr<GroupReader>> _row_group_readers;
     size_t _cur_row_group_idx = 0;
     size_t _row_group_size = 0;
+    // version of the runtime filters when the row groups were filtered last time
+    size_t _runtime_filters_version = 0;
+    // whether the row group is filtered by the runtime filters updated after it was selected
+    std::vector<bool> _runtime_filtered_row_groups;
 
     size_t _total_row_count = 0;
     size_t _scan_row_count = 0;
@@ -346,6 +346,15 @@ public:
 
     int32_t spill_encode_level() const { return _query_options.spill_encode_level; }
 
+    TCompressionType::type spill_compression_type() const {
+        return _query_options.__isset.spill_compression_type ? _query_options.spill_compression_type
+                                                             : TCompressionType::NO_COMPRESSION;
+    }
+
+    bool enable_spill_column_encoding() const {
+        return _query_options.__isset.enable_spill_column_encoding && _query_options.enable_spill_column_encoding;
+    }
+
     bool error_if_overflow() const {
         return _query_options.__isset.overflow_mode && _query_options.overflow_mode == TOverflowMode::REPORT_ERROR;
     }
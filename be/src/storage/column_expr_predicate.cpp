@@ -3,6 +3,7 @@
 #include <utility>
 
 #include "column/column_helper.h"
+#include "column/column_viewer.h"
 #include "common/status.h"
 #include "common/statusor.h"
 #include "exprs/binary_predicate.h"
@@ -14,6 +15,7 @@
 #include "runtime/descriptors.h"
 #include "runtime/runtime_state.h"
 #include "storage/column_predicate.h"
+#include "storage/rowset/ngram_tokenizer.h"
 #include "types/logical_type.h"
 
 namespace starrocks {
@@ -178,6 +180,38 @@ bool ColumnExprPredicate::zone_map_filter(const ZoneMapDetail& detail) const {
     return false;
 }
 
+bool ColumnExprPredicate::get_pattern_literals(std::vector<PatternLiteral>* literals) const {
+    // the predicates converted by convert_to() are evaluated on the casted values
+    if (_expr_ctxs.size() != 1) {
+        return false;
+    }
+    ExprContext* ctx = _expr_ctxs[0];
+    Expr* root = ctx->root();
+    const std::string& fn_name = root->fn().name.function_name;
+    const bool is_like = fn_name == "like";
+    if ((!is_like && fn_name != "regexp") || root->get_num_children() != 2 ||
+        root->get_child(0)->node_type() != TExprNodeType::SLOT_REF || !root->get_child(1)->is_constant()) {
+        return false;
+    }
+    auto pattern_or = root->get_child(1)->evaluate_const(ctx);
+    if (!pattern_or.ok() || pattern_or.value() == nullptr || pattern_or.value()->size() == 0) {
+        return false;
+    }
+    ColumnViewer<TYPE_VARCHAR> viewer(pattern_or.value());
+    if (viewer.is_null(0)) {
+        return false;
+    }
+    Slice pattern = viewer.value(0);
+    std::vector<PatternLiteral> pattern_literals;
+    bool extracted = is_like ? NgramTokenizer::extract_like_literals(pattern, &pattern_literals)
+                             : NgramTokenizer::extract_regex_literals(pattern, &pattern_literals);
+    if (!extracted) {
+        return false;
+    }
+    literals->insert(literals->end(), pattern_literals.begin(), pattern_literals.end());
+    return true;
+}
+
 Status ColumnExprPredicate::convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
                                        ObjectPool* obj_pool) const {
     TypeDescriptor input_type = TypeDescriptor::from_storage_type_info(target_type_info.get());
@@ -44,6 +44,8 @@ public:
     bool support_bloom_filter() const override { return false; }
     PredicateType type() const override { return PredicateType::kExpr; }
     bool can_vectorized() const override { return true; }
+    // the literals of `col LIKE 'pattern'` and `col REGEXP 'pattern'`
+    bool get_pattern_literals(std::vector<PatternLiteral>* literals) const override;
 
     [[nodiscard]] Status convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
                                     ObjectPool* obj_pool) const override;
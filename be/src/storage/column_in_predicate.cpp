@@ -22,6 +22,7 @@
 #include "storage/in_predicate_utils.h"
 #include "storage/rowset/bitmap_index_reader.h"
 #include "storage/rowset/bloom_filter.h"
+#include "util/fsst.h"
 
 namespace starrocks {
 
@@ -295,6 +296,27 @@ public:
         return false;
     }
 
+    bool evaluate_compressed(const FsstSymbolTable& table, const Slice* compressed_values, size_t num_values,
+                             uint8_t* selection) const override {
+        // only the varchar pages are compressed by symbols
+        if constexpr (field_type != TYPE_VARCHAR) {
+            return false;
+        } else {
+            std::vector<faststring> compressed(_slices.size());
+            ItemHashSet<Slice> targets;
+            size_t i = 0;
+            for (const Slice& v : _slices) {
+                table.compress(v, &compressed[i]);
+                targets.emplace(compressed[i].data(), compressed[i].size());
+                i++;
+            }
+            for (i = 0; i < num_values; i++) {
+                selection[i] &= targets.contains(compressed_values[i]);
+            }
+            return true;
+        }
+    }
+
     bool can_vectorized() const override { return false; }
 
     PredicateType type() const override { return PredicateType::kInList; }
@@ -46,6 +46,8 @@ class RuntimeState;
 class SlotDescriptor;
 class BitmapIndexIterator;
 class BloomFilter;
+class FsstSymbolTable;
+struct PatternLiteral;
 } // namespace starrocks
 
 namespace starrocks {
@@ -158,6 +160,18 @@ public:
     // Return false to filter out a data page.
     virtual bool bloom_filter(const BloomFilter* bf) const { return true; }
 
+    // Evaluate the predicate on the strings compressed by |table|, and set selection[i] to 0 if the string of
+    // compressed_values[i] doesn't satisfy the predicate. Return false if the predicate can't be evaluated on the
+    // compressed strings, in which case the selection is untouched.
+    virtual bool evaluate_compressed(const FsstSymbolTable& table, const Slice* compressed_values, size_t num_values,
+                                     uint8_t* selection) const {
+        return false;
+    }
+
+    // Append the literals contained by every value satisfying the predicate, which are used to locate the rows by
+    // the n-gram index. Return false and leave |literals| untouched if the predicate is not a pattern match.
+    virtual bool get_pattern_literals(std::vector<PatternLiteral>* literals) const { return false; }
+
     [[nodiscard]] virtual Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange<>* range) const {
         return Status::Cancelled("not implemented");
     }
@@ -26,6 +26,7 @@
 #include "storage/rowset/bloom_filter.h"
 #include "storage/types.h"
 #include "storage/zone_map_detail.h"
+#include "util/fsst.h"
 #include "util/string_parser.hpp"
 
 namespace starrocks {
@@ -603,6 +604,23 @@ public:
         return bf->test_bytes(padded.data, padded.size);
     }
 
+    bool evaluate_compressed(const FsstSymbolTable& table, const Slice* compressed_values, size_t num_values,
+                             uint8_t* selection) const override {
+        // only the varchar pages are compressed by symbols
+        if constexpr (field_type != TYPE_VARCHAR) {
+            return false;
+        } else {
+            // the compression is deterministic, equal strings have equal compressed bytes
+            faststring compressed;
+            table.compress(this->_value, &compressed);
+            const Slice target(compressed.data(), compressed.size());
+            for (size_t i = 0; i < num_values; i++) {
+                selection[i] &= (compressed_values[i] == target);
+            }
+            return true;
+        }
+    }
+
     Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange<>* range) const override {
         // see the comment in `predicate_parser.cpp`.
         Slice padded_value(Base::_zero_padded_str);
@@ -18,6 +18,7 @@
 
 #include "common/config.h"
 #include "gen_cpp/AgentService_types.h"
+#include "gutil/strings/numbers.h"
 #include "gutil/strings/substitute.h"
 #include "storage/aggregate_type.h"
 #include "storage/olap_common.h"
@@ -165,6 +166,10 @@ Status t_column_to_pb_column(int32_t unique_id, const TColumn& t_column, ColumnP
     column_pb->set_is_key(t_column.is_key);
     column_pb->set_is_nullable(t_column.is_allow_null);
     column_pb->set_has_bitmap_index(t_column.has_bitmap_index);
+    column_pb->set_has_ngram_index(t_column.has_ngram_index);
+    if (t_column.__isset.ngram_index_gram_size) {
+        column_pb->set_ngram_index_gram_size(t_column.ngram_index_gram_size);
+    }
     column_pb->set_is_auto_increment(t_column.is_auto_increment);
     if (t_column.is_key) {
         auto agg_method = STORAGE_AGGREGATE_NONE;
@@ -264,6 +269,22 @@ Status convert_t_schema_to_pb_schema(const TTabletSchema& tablet_schema, uint32_
                         column->set_has_bitmap_index(true);
                         break;
                     }
+                } else if (index.index_type == TIndexType::type::NGRAM) {
+                    DCHECK_EQ(index.columns.size(), 1);
+                    if (boost::iequals(tcolumn.column_name, index.columns[0])) {
+                        column->set_has_ngram_index(true);
+                        auto iter = index.properties.find("gram_num");
+                        if (iter != index.properties.end()) {
+                            int32_t gram_size;
+                            if (!safe_strto32(iter->second, &gram_size) || gram_size < 0) {
+                                return Status::InvalidArgument(
+                                        strings::Substitute("invalid gram_num $0 of ngram index $1", iter->second,
+                                                            index.index_name));
+                            }
+                            column->set_ngram_index_gram_size(gram_size);
+                        }
+                        break;
+                    }
                 }
             }
         }
@@ -236,6 +236,9 @@ struct OlapReaderStatistics {
     int64_t vec_cond_chunk_copy_ns = 0;
     int64_t branchless_cond_evaluate_ns = 0;
     int64_t expr_cond_evaluate_ns = 0;
+    // the values of the columns skipped when the predicate columns are read one by one, since their rows have
+    // been filtered out by the predicates of the columns read before
+    int64_t rows_staged_read_skipped = 0;
 
     int64_t get_rowsets_ns = 0;
     int64_t get_delvec_ns = 0;
@@ -244,6 +247,7 @@ struct OlapReaderStatistics {
     int64_t column_iterator_init_ns = 0;
     int64_t bitmap_index_iterator_init_ns = 0;
     int64_t zone_map_filter_ns = 0;
+    int64_t predicate_selectivity_estimate_ns = 0;
     int64_t rows_key_range_filter_ns = 0;
     int64_t bf_filter_ns = 0;
 
@@ -261,6 +265,9 @@ struct OlapReaderStatistics {
     int64_t rows_bitmap_index_filtered = 0;
     int64_t bitmap_index_filter_timer = 0;
 
+    int64_t rows_ngram_index_filtered = 0;
+    int64_t ngram_index_filter_ns = 0;
+
     int64_t rows_del_vec_filtered = 0;
 
     int64_t rowsets_read_count = 0;
@@ -0,0 +1,388 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "column/column.h"
+#include "gutil/strings/substitute.h"
+#include "storage/olap_common.h"
+#include "storage/range.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_builder.h"
+#include "storage/rowset/page_decoder.h"
+#include "storage/type_traits.h"
+#include "storage/types.h"
+#include "util/bit_stream_utils.inline.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+
+namespace starrocks {
+
+// ALP page layout:
+//  | count(4) | exponent(1) | bit width(1) | reserved(2) | num exceptions(4) | min(8) | reserved(4) |
+//  | packed integers | exception positions(4 * num exceptions) | exception values(N * num exceptions) |
+// where N is the size of the value.
+//
+// The floating-point values with few decimal digits, e.g. prices and the measures of metrics, are encoded as the
+// integers of the values scaled by 10^exponent, which are encoded by frame-of-reference: the integers minus the min
+// integer are bit packed with the least bit width. A value which can't be restored exactly from its integer, e.g.
+// NaN, infinity, -0.0 or a value with more digits, is an exception stored as is.
+//
+// If the page is no smaller than the plain values, the exponent is ALP_RAW_EXPONENT and the header is followed by
+// the plain values.
+static const size_t ALP_PAGE_HEADER_SIZE = 24;
+static const uint8_t ALP_RAW_EXPONENT = 0xFF;
+
+template <typename CppType>
+struct AlpTraits {
+    // the max exponent of which the power of 10 is exact in the type
+    static constexpr int kMaxExponent = std::is_same_v<CppType, float> ? 10 : 18;
+    // the scaled values must fit in int64_t
+    static constexpr CppType kMaxScaled = static_cast<CppType>(1LL << 62);
+    // the number of values sampled from a page to pick the exponent
+    static constexpr size_t kNumSamples = 256;
+
+    static CppType pow10(int exponent) {
+        static const auto kPow10 = []() {
+            std::array<CppType, kMaxExponent + 1> pow10;
+            CppType value = 1;
+            for (int i = 0; i <= kMaxExponent; i++) {
+                pow10[i] = value;
+                value *= 10;
+            }
+            return pow10;
+        }();
+        return kPow10[exponent];
+    }
+
+    static CppType decode(int64_t encoded, CppType scale) { return static_cast<CppType>(encoded) / scale; }
+
+    // Return false if the value can't be restored exactly from the integer.
+    static bool encode(CppType value, CppType scale, int64_t* encoded) {
+        CppType scaled = value * scale;
+        if (!(std::abs(scaled) < kMaxScaled)) {
+            return false;
+        }
+        *encoded = std::llround(scaled);
+        CppType decoded = decode(*encoded, scale);
+        return memcmp(&decoded, &value, sizeof(CppType)) == 0;
+    }
+};
+
+template <LogicalType Type>
+class AlpPageBuilder final : public PageBuilder {
+public:
+    explicit AlpPageBuilder(const PageBuilderOptions& options) : _options(options) {
+        _max_count = std::max<size_t>(1, _options.data_page_size / sizeof(CppType));
+        _values.reserve(_max_count);
+    }
+
+    bool is_page_full() override { return _values.size() >= _max_count; }
+
+    uint32_t add(const uint8_t* vals, uint32_t count) override {
+        DCHECK(!_finished);
+        uint32_t to_add = std::min<size_t>(_max_count - _values.size(), count);
+        auto* new_vals = reinterpret_cast<const CppType*>(vals);
+        _values.insert(_values.end(), new_vals, new_vals + to_add);
+        return to_add;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        const size_t count = _values.size();
+        const int exponent = pick_exponent();
+        const CppType scale = Traits::pow10(exponent);
+
+        std::vector<int64_t> encoded(count);
+        std::vector<uint32_t> exception_positions;
+        int64_t min_value = std::numeric_limits<int64_t>::max();
+        int64_t max_value = std::numeric_limits<int64_t>::min();
+        for (size_t i = 0; i < count; i++) {
+            if (Traits::encode(_values[i], scale, &encoded[i])) {
+                min_value = std::min(min_value, encoded[i]);
+                max_value = std::max(max_value, encoded[i]);
+            } else {
+                exception_positions.push_back(i);
+            }
+        }
+        if (min_value > max_value) {
+            min_value = max_value = 0;
+        }
+        // the integers of the exceptions are the min, so they don't widen the bits
+        for (uint32_t pos : exception_positions) {
+            encoded[pos] = min_value;
+        }
+        const auto range = static_cast<uint64_t>(max_value) - static_cast<uint64_t>(min_value);
+        const int bit_width = range == 0 ? 0 : BitUtil::Log2Floor64(range) + 1;
+        const size_t num_exceptions = exception_positions.size();
+        const size_t encoded_size = ALP_PAGE_HEADER_SIZE + (count * bit_width + 7) / 8 +
+                                    num_exceptions * (sizeof(uint32_t) + sizeof(CppType));
+
+        _buffer.clear();
+        _buffer.resize(ALP_PAGE_HEADER_SIZE);
+        encode_fixed32_le(reinterpret_cast<uint8_t*>(_buffer.data()), count);
+        _buffer[5] = static_cast<uint8_t>(bit_width);
+        _buffer[6] = 0;
+        _buffer[7] = 0;
+        encode_fixed32_le(reinterpret_cast<uint8_t*>(_buffer.data()) + 8, num_exceptions);
+        encode_fixed64_le(reinterpret_cast<uint8_t*>(_buffer.data()) + 12, static_cast<uint64_t>(min_value));
+        encode_fixed32_le(reinterpret_cast<uint8_t*>(_buffer.data()) + 20, 0);
+        if (encoded_size >= ALP_PAGE_HEADER_SIZE + count * sizeof(CppType)) {
+            _buffer[4] = ALP_RAW_EXPONENT;
+            _buffer[5] = 0;
+            _buffer.append(_values.data(), count * sizeof(CppType));
+            return &_buffer;
+        }
+
+        _buffer[4] = static_cast<uint8_t>(exponent);
+        if (bit_width > 0) {
+            faststring packed;
+            BitWriter writer(&packed);
+            for (size_t i = 0; i < count; i++) {
+                writer.PutValue(static_cast<uint64_t>(encoded[i]) - static_cast<uint64_t>(min_value), bit_width);
+            }
+            writer.Flush();
+            _buffer.append(packed.data(), packed.size());
+        }
+        for (uint32_t pos : exception_positions) {
+            put_fixed32_le(&_buffer, pos);
+        }
+        for (uint32_t pos : exception_positions) {
+            _buffer.append(&_values[pos], sizeof(CppType));
+        }
+        DCHECK_EQ(encoded_size, _buffer.size());
+        return &_buffer;
+    }
+
+    void reset() override {
+        _values.clear();
+        _buffer.clear();
+        _finished = false;
+    }
+
+    uint32_t count() const override { return _values.size(); }
+
+    uint64_t size() const override {
+        return _finished ? _buffer.size() : ALP_PAGE_HEADER_SIZE + _values.size() * sizeof(CppType);
+    }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), sizeof(CppType));
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), sizeof(CppType));
+        return Status::OK();
+    }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    using Traits = AlpTraits<CppType>;
+
+    // Pick the exponent which encodes the sampled values into the least bytes. The smaller exponent wins the tie,
+    // since its integers are narrower for the other values of the page.
+    int pick_exponent() const {
+        const size_t count = _values.size();
+        const size_t step = std::max<size_t>(1, count / Traits::kNumSamples);
+        int best_exponent = 0;
+        size_t best_size = std::numeric_limits<size_t>::max();
+        for (int exponent = 0; exponent <= Traits::kMaxExponent; exponent++) {
+            const CppType scale = Traits::pow10(exponent);
+            int64_t min_value = std::numeric_limits<int64_t>::max();
+            int64_t max_value = std::numeric_limits<int64_t>::min();
+            size_t num_samples = 0;
+            size_t num_exceptions = 0;
+            for (size_t i = 0; i < count; i += step, num_samples++) {
+                int64_t encoded;
+                if (Traits::encode(_values[i], scale, &encoded)) {
+                    min_value = std::min(min_value, encoded);
+                    max_value = std::max(max_value, encoded);
+                } else {
+                    num_exceptions++;
+                }
+            }
+            int bit_width = 0;
+            if (min_value < max_value) {
+                auto range = static_cast<uint64_t>(max_value) - static_cast<uint64_t>(min_value);
+                bit_width = BitUtil::Log2Floor64(range) + 1;
+            }
+            size_t size = (num_samples * bit_width + 7) / 8 + num_exceptions * (sizeof(uint32_t) + sizeof(CppType));
+            if (size < best_size) {
+                best_size = size;
+                best_exponent = exponent;
+            }
+            if (num_exceptions == 0) {
+                // a larger exponent only widens the integers
+                break;
+            }
+        }
+        return best_exponent;
+    }
+
+    PageBuilderOptions _options;
+    size_t _max_count;
+    bool _finished = false;
+    std::vector<CppType> _values;
+    faststring _buffer;
+};
+
+// The decoder decodes the whole page in init(), so that seeking to any position in the page is as cheap as a plain
+// page. Restoring the values from the integers is a loop of conversions and divisions without branches, which is
+// vectorized by the compiler, and then the exceptions are patched.
+template <LogicalType Type>
+class AlpPageDecoder final : public PageDecoder {
+public:
+    explicit AlpPageDecoder(Slice data) : _data(data) {}
+
+    [[nodiscard]] Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < ALP_PAGE_HEADER_SIZE) {
+            return Status::Corruption(
+                    strings::Substitute("not enough bytes for header in alp page, size: $0", _data.size));
+        }
+        const auto* data = reinterpret_cast<const uint8_t*>(_data.data);
+        _num_elems = decode_fixed32_le(data);
+        const uint8_t exponent = data[4];
+        const int bit_width = data[5];
+        const size_t num_exceptions = decode_fixed32_le(data + 8);
+        const auto min_value = static_cast<int64_t>(decode_fixed64_le(data + 12));
+        const uint8_t* pos = data + ALP_PAGE_HEADER_SIZE;
+        _values.resize(_num_elems);
+
+        if (exponent == ALP_RAW_EXPONENT) {
+            if (_data.size != ALP_PAGE_HEADER_SIZE + _num_elems * sizeof(CppType)) {
+                return Status::Corruption(strings::Substitute("invalid raw alp page, size: $0, count: $1", _data.size,
+                                                              _num_elems));
+            }
+            if (_num_elems > 0) {
+                memcpy(_values.data(), pos, _num_elems * sizeof(CppType));
+            }
+            _parsed = true;
+            return Status::OK();
+        }
+
+        const size_t packed_size = (static_cast<size_t>(_num_elems) * bit_width + 7) / 8;
+        const size_t expected_size =
+                ALP_PAGE_HEADER_SIZE + packed_size + num_exceptions * (sizeof(uint32_t) + sizeof(CppType));
+        if (exponent > Traits::kMaxExponent || bit_width > 64 || num_exceptions > _num_elems ||
+            _data.size != expected_size) {
+            return Status::Corruption(
+                    strings::Substitute("invalid alp page, size: $0, count: $1, exponent: $2, bit width: $3",
+                                        _data.size, _num_elems, static_cast<int>(exponent), bit_width));
+        }
+
+        std::vector<uint64_t> encoded(_num_elems);
+        if (_num_elems > 0) {
+            int64_t num_unpacked = BitPacking::UnpackValues(bit_width, pos, packed_size, _num_elems, encoded.data())
+                                           .second;
+            if (num_unpacked != static_cast<int64_t>(_num_elems)) {
+                return Status::Corruption("failed to unpack the integers of alp page");
+            }
+        }
+        pos += packed_size;
+
+        const CppType scale = Traits::pow10(exponent);
+        CppType* values = _values.data();
+        const uint64_t* integers = encoded.data();
+        for (size_t i = 0; i < _num_elems; i++) {
+            values[i] = Traits::decode(static_cast<int64_t>(integers[i] + static_cast<uint64_t>(min_value)), scale);
+        }
+
+        const uint8_t* exception_values = pos + num_exceptions * sizeof(uint32_t);
+        for (size_t i = 0; i < num_exceptions; i++) {
+            uint32_t exception_pos = decode_fixed32_le(pos + i * sizeof(uint32_t));
+            if (exception_pos >= _num_elems) {
+                return Status::Corruption(strings::Substitute("invalid exception position $0 of alp page, count: $1",
+                                                              exception_pos, _num_elems));
+            }
+            memcpy(&values[exception_pos], exception_values + i * sizeof(CppType), sizeof(CppType));
+        }
+
+        _parsed = true;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status seek_to_position_in_page(uint32_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _num_elems);
+        _cur_idx = pos;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status next_batch(size_t* count, Column* dst) override {
+        SparseRange<> read_range;
+        uint32_t begin = current_index();
+        read_range.add(Range<>(begin, begin + *count));
+        RETURN_IF_ERROR(next_batch(read_range, dst));
+        *count = current_index() - begin;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status next_batch(const SparseRange<>& range, Column* dst) override {
+        DCHECK(_parsed);
+        size_t to_read = range.span_size();
+        if (PREDICT_FALSE(to_read == 0 || _cur_idx >= _num_elems)) {
+            return Status::OK();
+        }
+        SparseRangeIterator<> iter = range.new_iterator();
+        while (iter.has_more() && _cur_idx < _num_elems) {
+            _cur_idx = iter.begin();
+            Range<> r = iter.next(to_read);
+            uint32_t max_fetch = std::min(r.span_size(), _num_elems - _cur_idx);
+            int n = dst->append_numbers(&_values[_cur_idx], max_fetch * sizeof(CppType));
+            DCHECK_EQ(max_fetch, n);
+            _cur_idx += max_fetch;
+        }
+        return Status::OK();
+    }
+
+    uint32_t count() const override {
+        DCHECK(_parsed);
+        return _num_elems;
+    }
+
+    uint32_t current_index() const override {
+        DCHECK(_parsed);
+        return _cur_idx;
+    }
+
+    EncodingTypePB encoding_type() const override { return ALP_ENCODING; }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    using Traits = AlpTraits<CppType>;
+
+    Slice _data;
+    bool _parsed{false};
+    uint32_t _num_elems{0};
+    uint32_t _cur_idx{0};
+    std::vector<CppType> _values;
+};
+
+} // namespace starrocks
@@ -0,0 +1,201 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/binary_fsst_page.h"
+
+#include <cstring>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "gutil/strings/substitute.h"
+
+namespace starrocks {
+
+uint32_t BinaryFsstPageBuilder::add(const uint8_t* vals, uint32_t count) {
+    DCHECK(!_finished);
+    const auto* slices = reinterpret_cast<const Slice*>(vals);
+    for (uint32_t i = 0; i < count; i++) {
+        if (is_page_full()) {
+            return i;
+        }
+        _offsets.push_back(_raw.size());
+        _raw.append(slices[i].data, slices[i].size);
+        _size_estimate += slices[i].size + sizeof(uint32_t);
+    }
+    return count;
+}
+
+faststring* BinaryFsstPageBuilder::finish() {
+    DCHECK(!_finished);
+    _buffer.clear();
+    uint32_t symbol_table_size = 0;
+    std::vector<uint32_t> offsets;
+    if (!_offsets.empty()) {
+        // sample the strings evenly across the page
+        std::vector<Slice> samples;
+        const size_t step = _raw.size() / kSampleSize + 1;
+        for (size_t i = 0; i < _offsets.size(); i += step) {
+            samples.push_back(_raw_value(i));
+        }
+        FsstSymbolTable table = FsstSymbolTable::build(samples);
+        table.serialize(&_buffer);
+        symbol_table_size = _buffer.size();
+
+        offsets.reserve(_offsets.size());
+        for (size_t i = 0; i < _offsets.size(); i++) {
+            offsets.push_back(_buffer.size());
+            table.compress(_raw_value(i), &_buffer);
+        }
+        if (_buffer.size() >= _raw.size()) {
+            // the symbols don't pay off, store the strings as is
+            _buffer.clear();
+            symbol_table_size = 0;
+        }
+    }
+    if (symbol_table_size == 0) {
+        _buffer.append(_raw.data(), _raw.size());
+        offsets = _offsets;
+    }
+    for (uint32_t offset : offsets) {
+        put_fixed32_le(&_buffer, offset);
+    }
+    put_fixed32_le(&_buffer, symbol_table_size);
+    put_fixed32_le(&_buffer, offsets.size());
+    _finished = true;
+    return &_buffer;
+}
+
+void BinaryFsstPageBuilder::reset() {
+    _raw.clear();
+    _offsets.clear();
+    _buffer.clear();
+    _size_estimate = FSST_PAGE_TRAILER_SIZE;
+    _finished = false;
+}
+
+Status BinaryFsstPageBuilder::get_first_value(void* value) const {
+    DCHECK(_finished);
+    if (_offsets.empty()) {
+        return Status::NotFound("page is empty");
+    }
+    *reinterpret_cast<Slice*>(value) = _raw_value(0);
+    return Status::OK();
+}
+
+Status BinaryFsstPageBuilder::get_last_value(void* value) const {
+    DCHECK(_finished);
+    if (_offsets.empty()) {
+        return Status::NotFound("page is empty");
+    }
+    *reinterpret_cast<Slice*>(value) = _raw_value(_offsets.size() - 1);
+    return Status::OK();
+}
+
+Status BinaryFsstPageDecoder::init() {
+    RETURN_IF(_parsed, Status::OK());
+    if (_data.size < FSST_PAGE_TRAILER_SIZE) {
+        return Status::Corruption(
+                strings::Substitute("not enough bytes for trailer in BinaryFsstPageDecoder, size: $0", _data.size));
+    }
+    const auto* trailer = reinterpret_cast<const uint8_t*>(_data.data + _data.size - FSST_PAGE_TRAILER_SIZE);
+    _symbol_table_size = decode_fixed32_le(trailer);
+    _num_elems = decode_fixed32_le(trailer + sizeof(uint32_t));
+    const uint64_t trailer_size = FSST_PAGE_TRAILER_SIZE + static_cast<uint64_t>(_num_elems) * sizeof(uint32_t);
+    if (_data.size < trailer_size + _symbol_table_size) {
+        return Status::Corruption(strings::Substitute("invalid fsst page, size: $0, num elems: $1, symbol table: $2",
+                                                      _data.size, _num_elems, _symbol_table_size));
+    }
+    _offsets_pos = _data.size - trailer_size;
+    if (_symbol_table_size > 0) {
+        size_t consumed = 0;
+        RETURN_IF_ERROR(_symbol_table.deserialize(Slice(_data.data, _symbol_table_size), &consumed));
+        if (consumed != _symbol_table_size) {
+            return Status::Corruption("invalid symbol table size of fsst page");
+        }
+    }
+    for (uint32_t i = 0; i < _num_elems; i++) {
+        if (_offset(i) < _symbol_table_size || _offset(i) > _offset(i + 1)) {
+            return Status::Corruption("invalid string offsets of fsst page");
+        }
+    }
+    _parsed = true;
+    return Status::OK();
+}
+
+Status BinaryFsstPageDecoder::next_batch(size_t* count, Column* dst) {
+    SparseRange<> read_range;
+    uint32_t begin = current_index();
+    read_range.add(Range<>(begin, begin + *count));
+    RETURN_IF_ERROR(next_batch(read_range, dst));
+    *count = current_index() - begin;
+    return Status::OK();
+}
+
+Status BinaryFsstPageDecoder::next_batch(const SparseRange<>& range, Column* dst) {
+    DCHECK(_parsed);
+    if (PREDICT_FALSE(_cur_idx >= _num_elems)) {
+        return Status::OK();
+    }
+
+    auto* binary_column = down_cast<BinaryColumn*>(ColumnHelper::get_data_column(dst));
+    auto& bytes = binary_column->get_bytes();
+    auto& offsets = binary_column->get_offset();
+    size_t to_read = std::min(range.span_size(), _num_elems - _cur_idx);
+    size_t num_read = 0;
+    SparseRangeIterator<> iter = range.new_iterator();
+    while (to_read > 0) {
+        _cur_idx = iter.begin();
+        Range<> r = iter.next(to_read);
+        const uint32_t end = _cur_idx + r.span_size();
+        const uint32_t begin_offset = _offset(_cur_idx);
+        const uint32_t end_offset = _offset(end);
+        if (is_compressed()) {
+            // size the bytes exactly by a first pass over the codes, then decompress the strings one by one into
+            // them. The symbols copied as 8-byte words past the last string go to the padding of the bytes.
+            static_assert(FsstSymbolTable::kMaxSymbolLength - 1 <= 16, "padding of Bytes is too small");
+            size_t decompressed_size = 0;
+            for (uint32_t i = _cur_idx; i < end; i++) {
+                decompressed_size += _symbol_table.decompressed_size(compressed_value(i));
+            }
+            size_t bytes_size = bytes.size();
+            bytes.resize(bytes_size + decompressed_size);
+            for (; _cur_idx < end; _cur_idx++) {
+                bytes_size += _symbol_table.decompress(compressed_value(_cur_idx), bytes.data() + bytes_size);
+                offsets.push_back(bytes_size);
+            }
+            DCHECK_EQ(bytes_size, bytes.size());
+        } else {
+            const size_t bytes_size = bytes.size();
+            bytes.resize(bytes_size + end_offset - begin_offset);
+            memcpy(bytes.data() + bytes_size, _data.data + begin_offset, end_offset - begin_offset);
+            for (; _cur_idx < end; _cur_idx++) {
+                offsets.push_back(bytes_size + _offset(_cur_idx + 1) - begin_offset);
+            }
+        }
+        num_read += r.span_size();
+        to_read -= r.span_size();
+    }
+    if (dst->is_nullable()) {
+        auto& null_data = down_cast<NullableColumn*>(dst)->null_column_data();
+        null_data.resize(null_data.size() + num_read, 0);
+    }
+#ifndef NDEBUG
+    dst->check_or_die();
+#endif
+    return Status::OK();
+}
+
+} // namespace starrocks
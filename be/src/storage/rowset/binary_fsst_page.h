@@ -0,0 +1,148 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Page encoding for strings compressed by a FSST symbol table of the page.
+//
+// The page consists of:
+// Symbol table:
+//   the serialized FsstSymbolTable, absent if the strings are stored as is
+// Strings:
+//   the compressed strings, or the raw strings if the symbols don't make them smaller
+// Trailer
+//  Offsets:
+//    offsets pointing to the beginning of each string
+//  symbol table size (32-bit fixed), 0 if the strings are stored as is
+//  num_elems (32-bit fixed)
+//
+// Every string is compressed on its own, so the values could be decompressed one by one, and the equality
+// predicates could be evaluated on the compressed strings, see BinaryFsstPageDecoder::compressed_value().
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/logging.h"
+#include "storage/range.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_builder.h"
+#include "storage/rowset/page_decoder.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/fsst.h"
+
+namespace starrocks {
+
+class Column;
+
+static constexpr size_t FSST_PAGE_TRAILER_SIZE = 2 * sizeof(uint32_t);
+
+class BinaryFsstPageBuilder final : public PageBuilder {
+public:
+    // the max size of the strings sampled to build the symbol table
+    static constexpr size_t kSampleSize = 16 * 1024;
+
+    explicit BinaryFsstPageBuilder(const PageBuilderOptions& options) : _options(options) { reset(); }
+
+    bool is_page_full() override {
+        // data_page_size is 0, do not limit the page size
+        return (_options.data_page_size != 0) & (_size_estimate > _options.data_page_size);
+    }
+
+    uint32_t add(const uint8_t* vals, uint32_t count) override;
+
+    faststring* finish() override;
+
+    void reset() override;
+
+    uint32_t count() const override { return _offsets.size(); }
+
+    uint64_t size() const override { return _size_estimate; }
+
+    Status get_first_value(void* value) const override;
+
+    Status get_last_value(void* value) const override;
+
+private:
+    Slice _raw_value(size_t idx) const {
+        size_t end = (idx + 1) < _offsets.size() ? _offsets[idx + 1] : _raw.size();
+        return {_raw.data() + _offsets[idx], end - _offsets[idx]};
+    }
+
+    PageBuilderOptions _options;
+    // the raw strings added, which are compressed when the page is finished
+    faststring _raw;
+    std::vector<uint32_t> _offsets;
+    size_t _size_estimate{0};
+    faststring _buffer;
+    bool _finished{false};
+};
+
+class BinaryFsstPageDecoder final : public PageDecoder {
+public:
+    explicit BinaryFsstPageDecoder(Slice data) : _data(data) {}
+
+    [[nodiscard]] Status init() override;
+
+    [[nodiscard]] Status seek_to_position_in_page(uint32_t pos) override {
+        DCHECK_LE(pos, _num_elems);
+        _cur_idx = pos;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status next_batch(size_t* count, Column* dst) override;
+
+    [[nodiscard]] Status next_batch(const SparseRange<>& range, Column* dst) override;
+
+    uint32_t count() const override {
+        DCHECK(_parsed);
+        return _num_elems;
+    }
+
+    uint32_t current_index() const override {
+        DCHECK(_parsed);
+        return _cur_idx;
+    }
+
+    EncodingTypePB encoding_type() const override { return FSST_ENCODING; }
+
+    // Whether the strings of the page are compressed by symbol_table().
+    bool is_compressed() const { return _symbol_table_size > 0; }
+
+    const FsstSymbolTable& symbol_table() const { return _symbol_table; }
+
+    // The compressed bytes of the string at |idx|, which are equal to symbol_table().compress() of the string.
+    Slice compressed_value(uint32_t idx) const {
+        DCHECK_LT(idx, _num_elems);
+        const uint32_t start = _offset(idx);
+        return {&_data[start], _offset(idx + 1) - start};
+    }
+
+private:
+    uint32_t _offset(uint32_t idx) const {
+        return idx < _num_elems ? decode_fixed32_le(reinterpret_cast<const uint8_t*>(&_data[_offsets_pos]) + idx * 4)
+                                : _offsets_pos;
+    }
+
+    Slice _data;
+    bool _parsed{false};
+    uint32_t _num_elems{0};
+    uint32_t _offsets_pos{0};
+    uint32_t _symbol_table_size{0};
+    FsstSymbolTable _symbol_table;
+    // Index of the currently seeked element in the page.
+    uint32_t _cur_idx{0};
+};
+
+} // namespace starrocks
@@ -111,6 +111,31 @@ public:
         return Status::OK();
     }
 
+    // Narrow |row_ranges| to the rows containing the literals of the LIKE and REGEXP predicates by the n-gram index.
+    [[nodiscard]] virtual Status get_row_ranges_by_ngram_index(const std::vector<const ColumnPredicate*>& predicates,
+                                                               SparseRange<>* row_ranges) {
+        return Status::OK();
+    }
+
+    // Estimate the fraction of the rows in |row_ranges| selected by |predicates|, 1 if it's unknown.
+    [[nodiscard]] virtual Status estimate_selectivity(const std::vector<const ColumnPredicate*>& predicates,
+                                                      const SparseRange<>& row_ranges, double* selectivity) {
+        *selectivity = 1.0;
+        return Status::OK();
+    }
+
+    // return true iff the data pages of this column could be filtered by get_row_ranges_by_compressed_predicates.
+    virtual bool has_compressed_pages() const { return false; }
+
+    // Seek to |ord| and evaluate the predicates on the compressed strings of the data page containing it, without
+    // decompressing them. Set |page_end| to the end of the page, and add the rows of [ord, page_end) which may
+    // satisfy the predicates to |row_ranges|.
+    [[nodiscard]] virtual Status get_row_ranges_by_compressed_predicates(
+            const std::vector<const ColumnPredicate*>& predicates, rowid_t ord, rowid_t* page_end,
+            SparseRange<>* row_ranges) {
+        return Status::NotSupported("compressed predicates are not supported by the column iterator");
+    }
+
     // return true iff all data pages of this column are encoded as dictionary encoding.
     // NOTE: the ColumnIterator must have been initialized with `check_dict_encoding`,
     // otherwise this method will always return false.
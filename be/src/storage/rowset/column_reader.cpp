@@ -45,6 +45,7 @@
 #include "column/datum_convert.h"
 #include "common/logging.h"
 #include "storage/column_predicate.h"
+#include "storage/roaring2range.h"
 #include "storage/rowset/array_column_iterator.h"
 #include "storage/rowset/binary_dict_page.h"
 #include "storage/rowset/bitmap_index_reader.h"
@@ -52,6 +53,8 @@
 #include "storage/rowset/bloom_filter_index_reader.h"
 #include "storage/rowset/encoding_info.h"
 #include "storage/rowset/map_column_iterator.h"
+#include "storage/rowset/ngram_index_reader.h"
+#include "storage/rowset/ngram_tokenizer.h"
 #include "storage/rowset/page_handle.h"
 #include "storage/rowset/page_io.h"
 #include "storage/rowset/page_pointer.h"
@@ -104,6 +107,12 @@ ColumnReader::~ColumnReader() {
         _onetime_meta_bytes.fetch_sub(_bloom_filter_index_meta->SpaceUsedLong(), std::memory_order_relaxed);
         _bloom_filter_index_meta.reset(nullptr);
     }
+    if (_ngram_index_meta != nullptr) {
+        MEM_TRACKER_SAFE_RELEASE(GlobalEnv::GetInstance()->bitmap_index_mem_tracker(),
+                                 _ngram_index_meta->SpaceUsedLong());
+        _onetime_meta_bytes.fetch_sub(_ngram_index_meta->SpaceUsedLong(), std::memory_order_relaxed);
+        _ngram_index_meta.reset(nullptr);
+    }
     MEM_TRACKER_SAFE_RELEASE(GlobalEnv::GetInstance()->column_metadata_mem_tracker(), sizeof(ColumnReader));
 }
 
@@ -171,6 +180,13 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
                 _onetime_meta_bytes.fetch_add(_bloom_filter_index_meta->SpaceUsedLong(), std::memory_order_relaxed);
                 _bloom_filter_index = std::make_unique<BloomFilterIndexReader>();
                 break;
+            case NGRAM_INDEX:
+                _ngram_index_meta.reset(index_meta->release_ngram_index());
+                MEM_TRACKER_SAFE_CONSUME(GlobalEnv::GetInstance()->bitmap_index_mem_tracker(),
+                                         _ngram_index_meta->SpaceUsedLong());
+                _onetime_meta_bytes.fetch_add(_ngram_index_meta->SpaceUsedLong(), std::memory_order_relaxed);
+                _ngram_index = std::make_unique<NgramIndexReader>(_ngram_index_meta->gram_size());
+                break;
             case UNKNOWN_INDEX_TYPE:
                 return Status::Corruption(fmt::format("Bad file {}: unknown index type", file_name()));
             }
@@ -360,6 +376,86 @@ Status ColumnReader::bloom_filter(const std::vector<const ColumnPredicate*>& pre
     return Status::OK();
 }
 
+Status ColumnReader::estimate_selectivity(const std::vector<const ColumnPredicate*>& predicates,
+                                          const SparseRange<>& row_ranges, const IndexReadOptions& opts,
+                                          double* selectivity) {
+    *selectivity = 1.0;
+    RETURN_IF(row_ranges.empty(), Status::OK());
+    RETURN_IF_ERROR(_load_zonemap_index(opts));
+    const std::vector<ZoneMapPB>& zone_maps = _zonemap_index->page_zone_maps();
+
+    // the number of the rows of |row_ranges| in each page
+    std::vector<uint32_t> page_rows(zone_maps.size(), 0);
+    for (size_t i = 0; i < row_ranges.size(); ++i) {
+        Range<> r = row_ranges[i];
+        ordinal_t idx = r.begin();
+        auto iter = _ordinal_index->seek_at_or_before(r.begin());
+        while (idx < r.end() && iter.valid() && iter.page_index() < page_rows.size()) {
+            ordinal_t end = std::min<ordinal_t>(iter.last_ordinal() + 1, r.end());
+            page_rows[iter.page_index()] += end - idx;
+            idx = end;
+            iter.next();
+        }
+    }
+
+    // the number of the values matched by each predicate, 0 if unknown
+    std::vector<size_t> num_matched_values(predicates.size(), 0);
+    for (size_t i = 0; i < predicates.size(); ++i) {
+        if (predicates[i]->type() == PredicateType::kEQ) {
+            num_matched_values[i] = 1;
+        } else if (predicates[i]->type() == PredicateType::kInList) {
+            num_matched_values[i] = predicates[i]->values().size();
+        }
+    }
+
+    double num_rows = 0;
+    double num_selected_rows = 0;
+    for (size_t i = 0; i < zone_maps.size(); ++i) {
+        if (page_rows[i] == 0) {
+            continue;
+        }
+        const ZoneMapPB& zm = zone_maps[i];
+        ZoneMapDetail detail;
+        RETURN_IF_ERROR(_parse_zone_map(zm, &detail));
+        double page_selectivity = 1.0;
+        for (size_t j = 0; j < predicates.size(); ++j) {
+            if (!predicates[j]->zone_map_filter(detail)) {
+                page_selectivity = 0;
+                break;
+            }
+            if (num_matched_values[j] > 0 && zm.num_distinct_values() > 0) {
+                // assume that the distinct values are evenly distributed in the page
+                double ndv = zm.num_distinct_values();
+                page_selectivity *= std::min(1.0, num_matched_values[j] / ndv);
+            }
+        }
+        num_rows += page_rows[i];
+        num_selected_rows += page_rows[i] * page_selectivity;
+    }
+    if (num_rows > 0) {
+        *selectivity = num_selected_rows / num_rows;
+    }
+    return Status::OK();
+}
+
+Status ColumnReader::ngram_index_filter(const std::vector<const ColumnPredicate*>& predicates,
+                                        SparseRange<>* row_ranges, const IndexReadOptions& opts) {
+    std::vector<PatternLiteral> literals;
+    for (const auto* pred : predicates) {
+        pred->get_pattern_literals(&literals);
+    }
+    RETURN_IF(literals.empty(), Status::OK());
+    std::vector<std::string> grams;
+    _ngram_index->tokenizer().required_grams(literals, &grams);
+    RETURN_IF(grams.empty(), Status::OK());
+
+    RETURN_IF_ERROR(_load_ngram_index(opts));
+    Roaring rows;
+    RETURN_IF_ERROR(_ngram_index->read_rows(opts, grams, &rows));
+    *row_ranges = row_ranges->intersection(roaring2range(rows));
+    return Status::OK();
+}
+
 Status ColumnReader::load_ordinal_index(const IndexReadOptions& opts) {
     if (_ordinal_index == nullptr || _ordinal_index->loaded()) return Status::OK();
     SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(false);
@@ -569,6 +665,21 @@ StatusOr<std::unique_ptr<ColumnIterator>> ColumnReader::new_iterator(ColumnAcces
     }
 }
 
+Status ColumnReader::_load_ngram_index(const IndexReadOptions& opts) {
+    if (_ngram_index == nullptr || _ngram_index->loaded()) return Status::OK();
+    SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(false);
+    auto meta = _ngram_index_meta.get();
+    ASSIGN_OR_RETURN(auto first_load, _ngram_index->load(opts, *meta));
+    if (UNLIKELY(first_load)) {
+        MEM_TRACKER_SAFE_RELEASE(GlobalEnv::GetInstance()->bitmap_index_mem_tracker(),
+                                 _ngram_index_meta->SpaceUsedLong());
+        _onetime_meta_bytes.fetch_sub(_ngram_index_meta->SpaceUsedLong(), std::memory_order_relaxed);
+        _ngram_index_meta.reset();
+        _segment->update_cache_size();
+    }
+    return Status::OK();
+}
+
 size_t ColumnReader::mem_usage() {
     size_t size = sizeof(ColumnReader);
 
@@ -579,6 +690,7 @@ size_t ColumnReader::mem_usage() {
     size += _ordinal_index != nullptr ? _ordinal_index->mem_usage() : 0;
     size += _bitmap_index != nullptr ? _bitmap_index->mem_usage() : 0;
     size += _bloom_filter_index != nullptr ? _bloom_filter_index->mem_usage() : 0;
+    size += _ngram_index != nullptr ? _ngram_index->mem_usage() : 0;
 
     if (_sub_readers != nullptr) {
         for (auto& reader : *_sub_readers) {
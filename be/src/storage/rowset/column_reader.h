@@ -71,6 +71,7 @@ class BitmapIndexReader;
 class ColumnIterator;
 struct ColumnIteratorOptions;
 class EncodingInfo;
+class NgramIndexReader;
 class PageDecoder;
 class PagePointer;
 class ParsedPage;
@@ -123,6 +124,7 @@ public:
     bool has_zone_map() const { return _zonemap_index != nullptr; }
     bool has_bitmap_index() const { return _bitmap_index != nullptr; }
     bool has_bloom_filter_index() const { return _bloom_filter_index != nullptr; }
+    bool has_ngram_index() const { return _ngram_index != nullptr; }
 
     ZoneMapPB* segment_zone_map() const { return _segment_zone_map.get(); }
 
@@ -150,6 +152,18 @@ public:
     Status bloom_filter(const std::vector<const ::starrocks::ColumnPredicate*>& p, SparseRange<>* ranges,
                         const IndexReadOptions& opts);
 
+    // Estimate the fraction of the rows in |row_ranges| selected by |predicates| by the page zone maps: a page filtered
+    // out by the zone map selects no row, and an equality or IN predicate selects its values out of the distinct
+    // values of a page. The other predicates are taken as selecting all the rows of the pages they don't filter out.
+    // prerequisite: has_zone_map()
+    Status estimate_selectivity(const std::vector<const ::starrocks::ColumnPredicate*>& predicates,
+                                const SparseRange<>& row_ranges, const IndexReadOptions& opts, double* selectivity);
+
+    // Narrow |row_ranges| to the rows containing the literals of the pattern predicates in |predicates|.
+    // prerequisite: has_ngram_index()
+    Status ngram_index_filter(const std::vector<const ::starrocks::ColumnPredicate*>& predicates,
+                              SparseRange<>* row_ranges, const IndexReadOptions& opts);
+
     Status load_ordinal_index(const IndexReadOptions& opts);
 
     uint32_t num_rows() const { return _segment->num_rows(); }
@@ -172,6 +186,7 @@ private:
     Status _load_zonemap_index(const IndexReadOptions& opts);
     Status _load_bitmap_index(const IndexReadOptions& opts);
     Status _load_bloom_filter_index(const IndexReadOptions& opts);
+    Status _load_ngram_index(const IndexReadOptions& opts);
 
     Status _parse_zone_map(const ZoneMapPB& zm, ZoneMapDetail* detail) const;
 
@@ -195,11 +210,13 @@ private:
     std::unique_ptr<OrdinalIndexPB> _ordinal_index_meta;
     std::unique_ptr<BitmapIndexPB> _bitmap_index_meta;
     std::unique_ptr<BloomFilterIndexPB> _bloom_filter_index_meta;
+    std::unique_ptr<NgramIndexPB> _ngram_index_meta;
 
     std::unique_ptr<ZoneMapIndexReader> _zonemap_index;
     std::unique_ptr<OrdinalIndexReader> _ordinal_index;
     std::unique_ptr<BitmapIndexReader> _bitmap_index;
     std::unique_ptr<BloomFilterIndexReader> _bloom_filter_index;
+    std::unique_ptr<NgramIndexReader> _ngram_index;
 
     std::unique_ptr<ZoneMapPB> _segment_zone_map;
 
@@ -52,6 +52,7 @@
 #include "storage/rowset/bloom_filter_index_writer.h"
 #include "storage/rowset/encoding_info.h"
 #include "storage/rowset/map_column_writer.h"
+#include "storage/rowset/ngram_index_writer.h"
 #include "storage/rowset/options.h"
 #include "storage/rowset/ordinal_page_index.h"
 #include "storage/rowset/page_builder.h"
@@ -338,6 +339,13 @@ Status ScalarColumnWriter::init() {
         _has_index_builder = true;
         RETURN_IF_ERROR(BloomFilterIndexWriter::create(BloomFilterOptions(), _type_info, &_bloom_filter_index_builder));
     }
+    if (_opts.need_ngram_index) {
+        if (type_info()->type() != TYPE_VARCHAR) {
+            return Status::NotSupported("ngram index is only supported for varchar type");
+        }
+        _has_index_builder = true;
+        _ngram_index_builder = std::make_unique<NgramIndexWriter>(_opts.ngram_index_gram_size);
+    }
     return Status::OK();
 }
 
@@ -361,6 +369,9 @@ uint64_t ScalarColumnWriter::estimate_buffer_size() {
     if (_bloom_filter_index_builder != nullptr) {
         size += _bloom_filter_index_builder->size();
     }
+    if (_ngram_index_builder != nullptr) {
+        size += _ngram_index_builder->size();
+    }
     return size;
 }
 
@@ -447,7 +458,11 @@ Status ScalarColumnWriter::write_zone_map() {
 
 Status ScalarColumnWriter::write_bitmap_index() {
     if (_bitmap_index_builder != nullptr) {
-        return _bitmap_index_builder->finish(_wfile, _opts.meta->add_indexes());
+        RETURN_IF_ERROR(_bitmap_index_builder->finish(_wfile, _opts.meta->add_indexes()));
+    }
+    // the n-gram index is an inverted index of the same format, written next to the bitmap index
+    if (_ngram_index_builder != nullptr) {
+        RETURN_IF_ERROR(_ngram_index_builder->finish(_wfile, _opts.meta->add_indexes()));
     }
     return Status::OK();
 }
@@ -665,10 +680,12 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
                     INDEX_ADD_NULLS(_zone_map_index_builder, run);
                     INDEX_ADD_NULLS(_bitmap_index_builder, run);
                     INDEX_ADD_NULLS(_bloom_filter_index_builder, run);
+                    INDEX_ADD_NULLS(_ngram_index_builder, run);
                 } else {
                     INDEX_ADD_VALUES(_zone_map_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bitmap_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bloom_filter_index_builder, pdata, run);
+                    INDEX_ADD_VALUES(_ngram_index_builder, pdata, run);
                 }
                 pdata += type_info()->size() * run;
             }
@@ -676,6 +693,7 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
             INDEX_ADD_VALUES(_zone_map_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bitmap_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bloom_filter_index_builder, data, num_written);
+            INDEX_ADD_VALUES(_ngram_index_builder, data, num_written);
         }
 
         _next_rowid += num_written;
@@ -756,6 +774,10 @@ inline EncodingTypePB StringColumnWriter::speculate_string_encoding(const Binary
             size_t hash = SliceHash()(bin_col.get_slice(i));
             hash_set.insert(hash);
             if (hash_set.size() > max_card) {
+                // the strings of high cardinality are compressed by the symbols shared in the page instead
+                if (config::enable_segment_fsst_encoding && type_info()->type() == TYPE_VARCHAR) {
+                    return FSST_ENCODING;
+                }
                 return PLAIN_ENCODING;
             }
         }
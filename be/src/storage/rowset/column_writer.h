@@ -69,6 +69,9 @@ struct ColumnWriterOptions {
     bool need_zone_map = false;
     bool need_bitmap_index = false;
     bool need_bloom_filter = false;
+    // for varchar, build the n-gram index of the grams of ngram_index_gram_size bytes, or of the tokens if it's 0
+    bool need_ngram_index = false;
+    int32_t ngram_index_gram_size = 0;
     // for char/varchar will speculate encoding in append
     // for others will decide encoding in init method
     bool need_speculate_encoding = false;
@@ -85,6 +88,7 @@ class NullFlagsBuilder;
 class OrdinalIndexWriter;
 class PageBuilder;
 class BloomFilterIndexWriter;
+class NgramIndexWriter;
 class ZoneMapIndexWriter;
 
 class ColumnWriter {
@@ -243,7 +247,8 @@ private:
     std::unique_ptr<ZoneMapIndexWriter> _zone_map_index_builder;
     std::unique_ptr<BitmapIndexWriter> _bitmap_index_builder;
     std::unique_ptr<BloomFilterIndexWriter> _bloom_filter_index_builder;
-    // _zone_map_index_builder != NULL || _bitmap_index_builder != NULL || _bloom_filter_index_builder != NULL
+    std::unique_ptr<NgramIndexWriter> _ngram_index_builder;
+    // any of the index builders above is not NULL
     bool _has_index_builder = false;
     int64_t _element_ordinal = 0;
     int64_t _previous_ordinal = 0;
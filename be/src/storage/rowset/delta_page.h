@@ -0,0 +1,336 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <type_traits>
+#include <vector>
+
+#include "column/column.h"
+#include "gutil/strings/substitute.h"
+#include "storage/olap_common.h"
+#include "storage/range.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_builder.h"
+#include "storage/rowset/page_decoder.h"
+#include "storage/type_traits.h"
+#include "storage/types.h"
+#include "util/bit_stream_utils.inline.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+
+namespace starrocks {
+
+// Delta page layout:
+//  | count(4) | order(1) | bit width(1) | reserved(2) | heads(order * N) | min residual(N) | packed residuals |
+// where N is the size of the value.
+//
+// The values are differenced `order` times, e.g. order 1 stores the deltas of the adjacent values, which are
+// small for sorted values like auto-increment ids, and order 2 stores the deltas of the deltas, which are
+// almost zero for the values of fixed step like timestamps of events. The first value of each level of the
+// differences is kept as a head, and the remaining residuals are encoded by frame-of-reference: the residuals
+// minus the min residual are bit packed with the least bit width.
+//
+// The arithmetic wraps around in the unsigned type, so any values of the type round-trip.
+static const size_t DELTA_PAGE_HEADER_SIZE = 8;
+
+// The builder encodes each page with the order no larger than max_order which produces the smallest page,
+// order 0 being frame-of-reference of the values themselves, so the pages of unordered values don't regress.
+template <LogicalType Type>
+class DeltaPageBuilder final : public PageBuilder {
+public:
+    DeltaPageBuilder(const PageBuilderOptions& options, uint8_t max_order)
+            : _options(options), _max_order(max_order) {
+        _max_count = std::max<size_t>(1, _options.data_page_size / sizeof(CppType));
+        _values.reserve(_max_count);
+    }
+
+    bool is_page_full() override { return _values.size() >= _max_count; }
+
+    uint32_t add(const uint8_t* vals, uint32_t count) override {
+        DCHECK(!_finished);
+        uint32_t to_add = std::min<size_t>(_max_count - _values.size(), count);
+        auto* new_vals = reinterpret_cast<const CppType*>(vals);
+        _values.insert(_values.end(), new_vals, new_vals + to_add);
+        return to_add;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        const size_t count = _values.size();
+
+        std::vector<UnsignedType> residuals(_values.begin(), _values.end());
+        uint8_t order = 0;
+        size_t best_size = encoded_size(residuals, 0);
+        for (uint8_t k = 1; k <= _max_order && k < count; k++) {
+            difference(&residuals, k);
+            size_t size = encoded_size(residuals, k);
+            if (size < best_size) {
+                best_size = size;
+                order = k;
+            }
+        }
+        residuals.assign(_values.begin(), _values.end());
+        for (uint8_t k = 1; k <= order; k++) {
+            difference(&residuals, k);
+        }
+
+        UnsignedType min_residual = 0;
+        const int bit_width = residual_bit_width(residuals, order, &min_residual);
+
+        _buffer.clear();
+        _buffer.reserve(best_size);
+        _buffer.resize(DELTA_PAGE_HEADER_SIZE);
+        encode_fixed32_le(reinterpret_cast<uint8_t*>(_buffer.data()), count);
+        _buffer[4] = order;
+        _buffer[5] = static_cast<uint8_t>(bit_width);
+        _buffer[6] = 0;
+        _buffer[7] = 0;
+        _buffer.append(residuals.data(), order * sizeof(UnsignedType));
+        _buffer.append(&min_residual, sizeof(UnsignedType));
+        if (bit_width > 0) {
+            faststring packed;
+            BitWriter writer(&packed);
+            for (size_t i = order; i < count; i++) {
+                writer.PutValue(static_cast<uint64_t>(static_cast<UnsignedType>(residuals[i] - min_residual)),
+                                bit_width);
+            }
+            writer.Flush();
+            _buffer.append(packed.data(), packed.size());
+        }
+        DCHECK_EQ(best_size, _buffer.size());
+        return &_buffer;
+    }
+
+    void reset() override {
+        _values.clear();
+        _buffer.clear();
+        _finished = false;
+    }
+
+    uint32_t count() const override { return _values.size(); }
+
+    uint64_t size() const override {
+        return _finished ? _buffer.size() : DELTA_PAGE_HEADER_SIZE + _values.size() * sizeof(CppType);
+    }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), sizeof(CppType));
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), sizeof(CppType));
+        return Status::OK();
+    }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    using UnsignedType = std::make_unsigned_t<CppType>;
+    using SignedType = std::make_signed_t<CppType>;
+
+    // Difference the values of level order - 1 into the values of level order, the values before order are
+    // the heads of the levels and are kept.
+    static void difference(std::vector<UnsignedType>* values, uint8_t order) {
+        auto& data = *values;
+        for (size_t i = data.size() - 1; i >= order; i--) {
+            data[i] -= data[i - 1];
+        }
+    }
+
+    static int residual_bit_width(const std::vector<UnsignedType>& residuals, uint8_t order,
+                                  UnsignedType* min_residual) {
+        if (residuals.size() <= order) {
+            *min_residual = 0;
+            return 0;
+        }
+        auto min_value = static_cast<SignedType>(residuals[order]);
+        auto max_value = min_value;
+        for (size_t i = order + 1; i < residuals.size(); i++) {
+            auto value = static_cast<SignedType>(residuals[i]);
+            min_value = std::min(min_value, value);
+            max_value = std::max(max_value, value);
+        }
+        *min_residual = static_cast<UnsignedType>(min_value);
+        auto range = static_cast<uint64_t>(
+                static_cast<UnsignedType>(static_cast<UnsignedType>(max_value) - static_cast<UnsignedType>(min_value)));
+        return range == 0 ? 0 : BitUtil::Log2Floor64(range) + 1;
+    }
+
+    static size_t encoded_size(const std::vector<UnsignedType>& residuals, uint8_t order) {
+        UnsignedType min_residual;
+        const int bit_width = residual_bit_width(residuals, order, &min_residual);
+        const size_t num_packed = residuals.size() - std::min<size_t>(order, residuals.size());
+        return DELTA_PAGE_HEADER_SIZE + (order + 1) * sizeof(UnsignedType) + (num_packed * bit_width + 7) / 8;
+    }
+
+    PageBuilderOptions _options;
+    const uint8_t _max_order;
+    size_t _max_count;
+    bool _finished = false;
+    std::vector<CppType> _values;
+    faststring _buffer;
+};
+
+// The decoder decodes the whole page in init(), so that seeking to any position in the page, which is located
+// by the ordinal index, is as cheap as a plain page. Unpacking and adding the min residual process a batch of
+// values at a time, leaving only the prefix sums of the orders to be sequential.
+template <LogicalType Type>
+class DeltaPageDecoder final : public PageDecoder {
+public:
+    DeltaPageDecoder(Slice data, EncodingTypePB encoding) : _data(data), _encoding(encoding) {}
+
+    [[nodiscard]] Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < DELTA_PAGE_HEADER_SIZE) {
+            return Status::Corruption(
+                    strings::Substitute("not enough bytes for header in delta page, size: $0", _data.size));
+        }
+        const auto* data = reinterpret_cast<const uint8_t*>(_data.data);
+        _num_elems = decode_fixed32_le(data);
+        const uint8_t order = data[4];
+        const int bit_width = data[5];
+        const size_t num_heads = std::min<size_t>(order, _num_elems);
+        const size_t num_packed = _num_elems - num_heads;
+        const size_t expected_size = DELTA_PAGE_HEADER_SIZE + (order + 1) * sizeof(UnsignedType) +
+                                     (num_packed * bit_width + 7) / 8;
+        const int max_bit_width = sizeof(UnsignedType) * 8;
+        if (order > _num_elems || bit_width > max_bit_width || _data.size != expected_size) {
+            return Status::Corruption(strings::Substitute(
+                    "invalid delta page, size: $0, count: $1, order: $2, bit width: $3", _data.size, _num_elems,
+                    static_cast<int>(order), bit_width));
+        }
+
+        _values.resize(_num_elems);
+        UnsignedType* values = _values.data();
+        const uint8_t* pos = data + DELTA_PAGE_HEADER_SIZE;
+        if (num_heads > 0) {
+            memcpy(values, pos, num_heads * sizeof(UnsignedType));
+        }
+        pos += order * sizeof(UnsignedType);
+        UnsignedType min_residual;
+        memcpy(&min_residual, pos, sizeof(UnsignedType));
+        pos += sizeof(UnsignedType);
+
+        if (num_packed > 0) {
+            int64_t num_unpacked =
+                    BitPacking::UnpackValues(bit_width, pos, data + _data.size - pos, num_packed, values + num_heads)
+                            .second;
+            if (num_unpacked != static_cast<int64_t>(num_packed)) {
+                return Status::Corruption("failed to unpack the residuals of delta page");
+            }
+            for (size_t i = num_heads; i < _num_elems; i++) {
+                values[i] += min_residual;
+            }
+        }
+        for (size_t k = order; k >= 1; k--) {
+            for (size_t i = k; i < _num_elems; i++) {
+                values[i] += values[i - 1];
+            }
+        }
+
+        _parsed = true;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status seek_to_position_in_page(uint32_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _num_elems);
+        _cur_idx = pos;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status seek_at_or_after_value(const void* value, bool* exact_match) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (_num_elems == 0) {
+            return Status::NotFound("page is empty");
+        }
+        // find the first value >= target, the values are sorted if a value seek is issued
+        size_t left = 0;
+        size_t right = _num_elems;
+        while (left < right) {
+            size_t mid = left + (right - left) / 2;
+            if (TypeComparator<Type>::cmp(&_values[mid], value) < 0) {
+                left = mid + 1;
+            } else {
+                right = mid;
+            }
+        }
+        if (left >= _num_elems) {
+            return Status::NotFound("all value small than the value");
+        }
+        *exact_match = TypeComparator<Type>::cmp(&_values[left], value) == 0;
+        _cur_idx = left;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status next_batch(size_t* count, Column* dst) override {
+        SparseRange<> read_range;
+        uint32_t begin = current_index();
+        read_range.add(Range<>(begin, begin + *count));
+        RETURN_IF_ERROR(next_batch(read_range, dst));
+        *count = current_index() - begin;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status next_batch(const SparseRange<>& range, Column* dst) override {
+        DCHECK(_parsed);
+        size_t to_read = range.span_size();
+        if (PREDICT_FALSE(to_read == 0 || _cur_idx >= _num_elems)) {
+            return Status::OK();
+        }
+        SparseRangeIterator<> iter = range.new_iterator();
+        while (iter.has_more() && _cur_idx < _num_elems) {
+            _cur_idx = iter.begin();
+            Range<> r = iter.next(to_read);
+            uint32_t max_fetch = std::min(r.span_size(), _num_elems - _cur_idx);
+            int n = dst->append_numbers(&_values[_cur_idx], max_fetch * sizeof(CppType));
+            DCHECK_EQ(max_fetch, n);
+            _cur_idx += max_fetch;
+        }
+        return Status::OK();
+    }
+
+    uint32_t count() const override {
+        DCHECK(_parsed);
+        return _num_elems;
+    }
+
+    uint32_t current_index() const override {
+        DCHECK(_parsed);
+        return _cur_idx;
+    }
+
+    EncodingTypePB encoding_type() const override { return _encoding; }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    using UnsignedType = std::make_unsigned_t<CppType>;
+
+    Slice _data;
+    const EncodingTypePB _encoding;
+    bool _parsed{false};
+    uint32_t _num_elems{0};
+    uint32_t _cur_idx{0};
+    std::vector<UnsignedType> _values;
+};
+
+} // namespace starrocks
@@ -38,10 +38,13 @@
 
 #include "gutil/strings/substitute.h"
 #include "storage/olap_common.h"
+#include "storage/rowset/alp_page.h"
 #include "storage/rowset/binary_dict_page.h"
+#include "storage/rowset/binary_fsst_page.h"
 #include "storage/rowset/binary_plain_page.h"
 #include "storage/rowset/binary_prefix_page.h"
 #include "storage/rowset/bitshuffle_page.h"
+#include "storage/rowset/delta_page.h"
 #include "storage/rowset/frame_of_reference_page.h"
 #include "storage/rowset/plain_page.h"
 #include "storage/rowset/rle_page.h"
@@ -143,6 +146,57 @@ struct TypeEncodingTraits<type, FOR_ENCODING, CppType,
     }
 };
 
+template <LogicalType type, typename CppType>
+struct TypeEncodingTraits<type, DELTA_ENCODING, CppType,
+                          typename std::enable_if<std::is_integral<CppType>::value>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new DeltaPageBuilder<type>(opts, 1);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, PageDecoder** decoder) {
+        *decoder = new DeltaPageDecoder<type>(data, DELTA_ENCODING);
+        return Status::OK();
+    }
+};
+
+template <LogicalType type, typename CppType>
+struct TypeEncodingTraits<type, DELTA_OF_DELTA_ENCODING, CppType,
+                          typename std::enable_if<std::is_integral<CppType>::value>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new DeltaPageBuilder<type>(opts, 2);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, PageDecoder** decoder) {
+        *decoder = new DeltaPageDecoder<type>(data, DELTA_OF_DELTA_ENCODING);
+        return Status::OK();
+    }
+};
+
+template <LogicalType type, typename CppType>
+struct TypeEncodingTraits<type, ALP_ENCODING, CppType,
+                          typename std::enable_if<std::is_floating_point<CppType>::value>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new AlpPageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, PageDecoder** decoder) {
+        *decoder = new AlpPageDecoder<type>(data);
+        return Status::OK();
+    }
+};
+
+template <>
+struct TypeEncodingTraits<TYPE_VARCHAR, FSST_ENCODING, Slice> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new BinaryFsstPageBuilder(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, PageDecoder** decoder) {
+        *decoder = new BinaryFsstPageDecoder(data);
+        return Status::OK();
+    }
+};
+
 template <LogicalType type>
 struct TypeEncodingTraits<type, PREFIX_ENCODING, Slice> {
     static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
@@ -205,18 +259,26 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_TINYINT, BIT_SHUFFLE>();
     _add_map<TYPE_TINYINT, FOR_ENCODING, true>();
     _add_map<TYPE_TINYINT, PLAIN_ENCODING>();
+    _add_map<TYPE_TINYINT, DELTA_ENCODING>();
+    _add_map<TYPE_TINYINT, DELTA_OF_DELTA_ENCODING>();
 
     _add_map<TYPE_SMALLINT, BIT_SHUFFLE>();
     _add_map<TYPE_SMALLINT, FOR_ENCODING, true>();
     _add_map<TYPE_SMALLINT, PLAIN_ENCODING>();
+    _add_map<TYPE_SMALLINT, DELTA_ENCODING>();
+    _add_map<TYPE_SMALLINT, DELTA_OF_DELTA_ENCODING>();
 
     _add_map<TYPE_INT, BIT_SHUFFLE>();
     _add_map<TYPE_INT, FOR_ENCODING, true>();
     _add_map<TYPE_INT, PLAIN_ENCODING>();
+    _add_map<TYPE_INT, DELTA_ENCODING>();
+    _add_map<TYPE_INT, DELTA_OF_DELTA_ENCODING>();
 
     _add_map<TYPE_BIGINT, BIT_SHUFFLE>();
     _add_map<TYPE_BIGINT, FOR_ENCODING, true>();
     _add_map<TYPE_BIGINT, PLAIN_ENCODING>();
+    _add_map<TYPE_BIGINT, DELTA_ENCODING>();
+    _add_map<TYPE_BIGINT, DELTA_OF_DELTA_ENCODING>();
 
     _add_map<TYPE_LARGEINT, BIT_SHUFFLE>();
     _add_map<TYPE_LARGEINT, PLAIN_ENCODING>();
@@ -224,9 +286,11 @@ EncodingInfoResolver::EncodingInfoResolver() {
 
     _add_map<TYPE_FLOAT, BIT_SHUFFLE>();
     _add_map<TYPE_FLOAT, PLAIN_ENCODING>();
+    _add_map<TYPE_FLOAT, ALP_ENCODING>();
 
     _add_map<TYPE_DOUBLE, BIT_SHUFFLE>();
     _add_map<TYPE_DOUBLE, PLAIN_ENCODING>();
+    _add_map<TYPE_DOUBLE, ALP_ENCODING>();
 
     _add_map<TYPE_CHAR, DICT_ENCODING>();
     _add_map<TYPE_CHAR, PLAIN_ENCODING>();
@@ -235,6 +299,7 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_VARCHAR, DICT_ENCODING>();
     _add_map<TYPE_VARCHAR, PLAIN_ENCODING>();
     _add_map<TYPE_VARCHAR, PREFIX_ENCODING, true>();
+    _add_map<TYPE_VARCHAR, FSST_ENCODING>();
 
     _add_map<TYPE_BOOLEAN, RLE>();
     _add_map<TYPE_BOOLEAN, BIT_SHUFFLE>();
@@ -247,6 +312,8 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_DATE, BIT_SHUFFLE>();
     _add_map<TYPE_DATE, PLAIN_ENCODING>();
     _add_map<TYPE_DATE, FOR_ENCODING, true>();
+    _add_map<TYPE_DATE, DELTA_ENCODING>();
+    _add_map<TYPE_DATE, DELTA_OF_DELTA_ENCODING>();
 
     _add_map<TYPE_DATETIME_V1, BIT_SHUFFLE>();
     _add_map<TYPE_DATETIME_V1, PLAIN_ENCODING>();
@@ -255,6 +322,8 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_DATETIME, BIT_SHUFFLE>();
     _add_map<TYPE_DATETIME, PLAIN_ENCODING>();
     _add_map<TYPE_DATETIME, FOR_ENCODING, true>();
+    _add_map<TYPE_DATETIME, DELTA_ENCODING>();
+    _add_map<TYPE_DATETIME, DELTA_OF_DELTA_ENCODING>();
 
     _add_map<TYPE_DECIMAL, BIT_SHUFFLE, true>();
     _add_map<TYPE_DECIMAL, PLAIN_ENCODING>();
@@ -0,0 +1,53 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/ngram_index_reader.h"
+
+#include <memory>
+
+namespace starrocks {
+
+Status NgramIndexReader::read_rows(const IndexReadOptions& opts, const std::vector<std::string>& grams,
+                                   Roaring* rows) {
+    DCHECK(!grams.empty());
+    BitmapIndexIterator* iter_ptr = nullptr;
+    RETURN_IF_ERROR(_postings.new_iterator(opts, &iter_ptr));
+    std::unique_ptr<BitmapIndexIterator> iter(iter_ptr);
+
+    *rows = Roaring();
+    for (size_t i = 0; i < grams.size(); i++) {
+        Slice gram(grams[i]);
+        bool exact_match = false;
+        Status st = iter->seek_dictionary(&gram, &exact_match);
+        if (st.is_not_found() || (st.ok() && !exact_match)) {
+            // no value contains the gram
+            *rows = Roaring();
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(st);
+        Roaring posting;
+        RETURN_IF_ERROR(iter->read_bitmap(iter->current_ordinal(), &posting));
+        if (i == 0) {
+            *rows = std::move(posting);
+        } else {
+            *rows &= posting;
+        }
+        if (rows->isEmpty()) {
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
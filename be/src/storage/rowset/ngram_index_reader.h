@@ -0,0 +1,54 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <roaring/roaring.hh>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/segment.pb.h"
+#include "storage/rowset/bitmap_index_reader.h"
+#include "storage/rowset/common.h"
+#include "storage/rowset/ngram_tokenizer.h"
+
+namespace starrocks {
+
+// Reader of the index written by NgramIndexWriter.
+class NgramIndexReader {
+public:
+    explicit NgramIndexReader(int32_t gram_size) : _tokenizer(gram_size) {}
+
+    // Load index data into memory, see BitmapIndexReader::load().
+    StatusOr<bool> load(const IndexReadOptions& opts, const NgramIndexPB& meta) {
+        return _postings.load(opts, meta.postings());
+    }
+
+    bool loaded() const { return _postings.loaded(); }
+
+    const NgramTokenizer& tokenizer() const { return _tokenizer; }
+
+    // Set |rows| to the rows containing all of the non-empty |grams|.
+    // REQUIRES: the index data has been successfully `load()`ed into memory.
+    Status read_rows(const IndexReadOptions& opts, const std::vector<std::string>& grams, Roaring* rows);
+
+    size_t mem_usage() const { return sizeof(NgramIndexReader) - sizeof(BitmapIndexReader) + _postings.mem_usage(); }
+
+private:
+    NgramTokenizer _tokenizer;
+    BitmapIndexReader _postings;
+};
+
+} // namespace starrocks
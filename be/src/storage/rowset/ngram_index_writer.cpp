@@ -0,0 +1,112 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/ngram_index_writer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "fs/fs.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/rowset/indexed_column_writer.h"
+#include "storage/types.h"
+#include "util/faststring.h"
+#include "util/unaligned_access.h"
+
+namespace starrocks {
+
+void NgramIndexWriter::add_values(const void* values, size_t count) {
+    const auto* p = reinterpret_cast<const Slice*>(values);
+    for (size_t i = 0; i < count; i++) {
+        const Slice value = unaligned_load<Slice>(p + i);
+        _grams.clear();
+        _tokenizer.tokenize(value, &_grams);
+        for (const Slice& gram : _grams) {
+            auto it = _postings.find(gram);
+            if (it == _postings.end()) {
+                uint8_t* data = _pool.allocate(gram.size);
+                memcpy(data, gram.data, gram.size);
+                it = _postings.emplace(Slice(data, gram.size), Posting()).first;
+                _postings_size += sizeof(Slice) + sizeof(Posting);
+            }
+            if (it->second.end != _rid + 1) {
+                it->second.rows.add(_rid);
+                it->second.end = _rid + 1;
+                // the sparse posting lists take 2 bytes per row in the array containers
+                _postings_size += sizeof(uint16_t);
+            }
+        }
+        _rid++;
+    }
+}
+
+Status NgramIndexWriter::finish(WritableFile* wfile, ColumnIndexMetaPB* index_meta) {
+    index_meta->set_type(NGRAM_INDEX);
+    NgramIndexPB* meta = index_meta->mutable_ngram_index();
+    meta->set_gram_size(_tokenizer.gram_size());
+    BitmapIndexPB* postings_meta = meta->mutable_postings();
+    postings_meta->set_bitmap_type(BitmapIndexPB::ROARING_BITMAP);
+    postings_meta->set_has_null(false);
+
+    std::vector<std::pair<Slice, Roaring*>> postings;
+    postings.reserve(_postings.size());
+    for (auto& [gram, posting] : _postings) {
+        postings.emplace_back(gram, &posting.rows);
+    }
+    std::sort(postings.begin(), postings.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first.compare(rhs.first) < 0; });
+
+    TypeInfoPtr gram_typeinfo = get_type_info(TYPE_VARCHAR);
+    { // write dictionary
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = false;
+        options.write_value_index = true;
+        options.encoding = EncodingInfo::get_default_encoding(gram_typeinfo->type(), true);
+        options.compression = CompressionTypePB::LZ4;
+
+        IndexedColumnWriter dict_column_writer(options, gram_typeinfo, wfile);
+        RETURN_IF_ERROR(dict_column_writer.init());
+        for (const auto& posting : postings) {
+            RETURN_IF_ERROR(dict_column_writer.add(&posting.first));
+        }
+        RETURN_IF_ERROR(dict_column_writer.finish(postings_meta->mutable_dict_column()));
+    }
+    { // write posting lists
+        TypeInfoPtr bitmap_typeinfo = get_type_info(TYPE_OBJECT);
+
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = true;
+        options.write_value_index = false;
+        options.encoding = EncodingInfo::get_default_encoding(bitmap_typeinfo->type(), false);
+        // the bitmaps are compressed already
+        options.compression = NO_COMPRESSION;
+
+        IndexedColumnWriter bitmap_column_writer(options, bitmap_typeinfo, wfile);
+        RETURN_IF_ERROR(bitmap_column_writer.init());
+
+        faststring buf;
+        for (auto& posting : postings) {
+            Roaring* bitmap = posting.second;
+            bitmap->runOptimize();
+            buf.resize(bitmap->getSizeInBytes(false));
+            bitmap->write(reinterpret_cast<char*>(buf.data()), false);
+            Slice buf_slice(buf);
+            RETURN_IF_ERROR(bitmap_column_writer.add(&buf_slice));
+        }
+        RETURN_IF_ERROR(bitmap_column_writer.finish(postings_meta->mutable_bitmap_column()));
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
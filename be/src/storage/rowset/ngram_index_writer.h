@@ -0,0 +1,73 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <roaring/roaring.hh>
+#include <vector>
+
+#include "column/column_hash.h"
+#include "common/status.h"
+#include "gen_cpp/segment.pb.h"
+#include "runtime/mem_pool.h"
+#include "storage/rowset/common.h"
+#include "storage/rowset/ngram_tokenizer.h"
+#include "util/phmap/phmap.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+class WritableFile;
+
+// Builder of the n-gram index of a string column, which is an inverted index from the grams of the values to the
+// rows containing them, see NgramTokenizer for the grams.
+//
+// The index is stored in the format of the bitmap index, the ordered dictionary of the grams and the posting list
+// of each gram, so that it could be read by BitmapIndexReader. The null values have no grams.
+class NgramIndexWriter {
+public:
+    explicit NgramIndexWriter(int32_t gram_size) : _tokenizer(gram_size) {}
+
+    NgramIndexWriter(const NgramIndexWriter&) = delete;
+    const NgramIndexWriter& operator=(const NgramIndexWriter&) = delete;
+
+    // |values| points to |count| Slices.
+    void add_values(const void* values, size_t count);
+
+    void add_nulls(uint32_t count) { _rid += count; }
+
+    Status finish(WritableFile* wfile, ColumnIndexMetaPB* index_meta);
+
+    uint64_t size() const { return _postings_size + _pool.total_allocated_bytes(); }
+
+private:
+    using Roaring = roaring::Roaring;
+
+    struct Posting {
+        Roaring rows;
+        // the row id after the last row added, to skip the grams repeated in a value
+        rowid_t end = 0;
+    };
+
+    NgramTokenizer _tokenizer;
+    rowid_t _rid = 0;
+    // the grams are copied into _pool
+    phmap::flat_hash_map<Slice, Posting, SliceHash> _postings;
+    MemPool _pool;
+    // the estimated size of the posting lists
+    uint64_t _postings_size = 0;
+    std::vector<Slice> _grams;
+};
+
+} // namespace starrocks
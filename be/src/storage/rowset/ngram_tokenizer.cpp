@@ -0,0 +1,239 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/ngram_tokenizer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace starrocks {
+
+namespace {
+
+// Collect the literals while scanning a pattern.
+class LiteralCollector {
+public:
+    LiteralCollector(std::vector<PatternLiteral>* literals, bool at_begin) : _literals(literals), _at_begin(at_begin) {}
+
+    void append(char c) { _current.push_back(c); }
+
+    // Remove the last character of the current literal, which is made optional by a quantifier.
+    void remove_last_char() {
+        // remove the continuation bytes and the leading byte of an UTF-8 character
+        while (!_current.empty() && (static_cast<uint8_t>(_current.back()) & 0xC0) == 0x80) {
+            _current.pop_back();
+        }
+        if (!_current.empty()) {
+            _current.pop_back();
+        }
+    }
+
+    // Finish the current literal, the next one doesn't follow it immediately.
+    void finish(bool at_end) {
+        if (!_current.empty()) {
+            _literals->push_back({std::move(_current), _at_begin, at_end});
+        }
+        _current.clear();
+        _at_begin = false;
+    }
+
+private:
+    std::vector<PatternLiteral>* _literals;
+    std::string _current;
+    bool _at_begin;
+};
+
+} // namespace
+
+void NgramTokenizer::tokenize(const Slice& value, std::vector<Slice>* grams) const {
+    if (_gram_size > 0) {
+        const auto gram_size = static_cast<size_t>(_gram_size);
+        for (size_t i = 0; i + gram_size <= value.size; i++) {
+            grams->emplace_back(value.data + i, gram_size);
+        }
+        return;
+    }
+    const auto* data = reinterpret_cast<const uint8_t*>(value.data);
+    size_t i = 0;
+    while (i < value.size) {
+        while (i < value.size && !is_token_char(data[i])) {
+            i++;
+        }
+        const size_t begin = i;
+        while (i < value.size && is_token_char(data[i])) {
+            i++;
+        }
+        if (i > begin) {
+            grams->emplace_back(value.data + begin, i - begin);
+        }
+    }
+}
+
+void NgramTokenizer::required_grams(const std::vector<PatternLiteral>& literals,
+                                    std::vector<std::string>* grams) const {
+    grams->clear();
+    for (const auto& literal : literals) {
+        const std::string& text = literal.text;
+        if (_gram_size > 0) {
+            // the grams not overlapping each other, plus the last one, cover the literal and are selective enough
+            const auto gram_size = static_cast<size_t>(_gram_size);
+            if (text.size() < gram_size) {
+                continue;
+            }
+            for (size_t i = 0; i + gram_size < text.size(); i += gram_size) {
+                grams->emplace_back(text.substr(i, gram_size));
+            }
+            grams->emplace_back(text.substr(text.size() - gram_size));
+        } else {
+            // only the tokens delimited on both sides are the tokens of the values, the other ones may be a part
+            // of longer tokens
+            const auto* data = reinterpret_cast<const uint8_t*>(text.data());
+            size_t i = 0;
+            while (i < text.size()) {
+                while (i < text.size() && !is_token_char(data[i])) {
+                    i++;
+                }
+                const size_t begin = i;
+                while (i < text.size() && is_token_char(data[i])) {
+                    i++;
+                }
+                if (i > begin && (begin > 0 || literal.at_begin) && (i < text.size() || literal.at_end)) {
+                    grams->emplace_back(text.substr(begin, i - begin));
+                }
+            }
+        }
+    }
+    std::sort(grams->begin(), grams->end());
+    grams->erase(std::unique(grams->begin(), grams->end()), grams->end());
+}
+
+bool NgramTokenizer::extract_like_literals(const Slice& pattern, std::vector<PatternLiteral>* literals) {
+    LiteralCollector collector(literals, true);
+    for (size_t i = 0; i < pattern.size; i++) {
+        const char c = pattern.data[i];
+        if (c == '\\') {
+            if (i + 1 < pattern.size && (pattern.data[i + 1] == '%' || pattern.data[i + 1] == '_')) {
+                collector.append(pattern.data[++i]);
+            } else {
+                // the other escaped characters are matched differently by the substring search and the regular
+                // expression of LikePredicate, treat them as unknown characters.
+                collector.finish(false);
+                i++;
+            }
+        } else if (c == '%' || c == '_') {
+            collector.finish(false);
+        } else {
+            collector.append(c);
+        }
+    }
+    collector.finish(true);
+    return true;
+}
+
+bool NgramTokenizer::extract_regex_literals(const Slice& pattern, std::vector<PatternLiteral>* literals) {
+    const char* p = pattern.data;
+    const size_t n = pattern.size;
+    size_t i = 0;
+    if (n > 0 && p[0] == '^') {
+        i = 1;
+    }
+    LiteralCollector collector(literals, i == 1);
+    for (; i < n; i++) {
+        switch (p[i]) {
+        case '|':
+        case '(':
+        case ')':
+        case '^':
+            return false;
+        case '$':
+            if (i + 1 != n) {
+                return false;
+            }
+            collector.finish(true);
+            return true;
+        case '.':
+        case '+':
+            // the repeated character of '+' occurs at least once, but the following ones are not adjacent to it
+            collector.finish(false);
+            break;
+        case '*':
+        case '?':
+            collector.remove_last_char();
+            collector.finish(false);
+            break;
+        case '{': {
+            const char* close = static_cast<const char*>(memchr(p + i, '}', n - i));
+            if (close == nullptr) {
+                return false;
+            }
+            collector.remove_last_char();
+            collector.finish(false);
+            i = close - p;
+            break;
+        }
+        case '[': {
+            collector.finish(false);
+            size_t j = i + 1;
+            if (j < n && p[j] == '^') {
+                j++;
+            }
+            if (j < n && p[j] == ']') {
+                j++;
+            }
+            while (j < n && p[j] != ']') {
+                if (p[j] == '\\') {
+                    j += 2;
+                } else if (p[j] == '[' && j + 1 < n && p[j + 1] == ':') {
+                    // [:alpha:]
+                    const void* close = memmem(p + j + 2, n - j - 2, ":]", 2);
+                    if (close == nullptr) {
+                        return false;
+                    }
+                    j = static_cast<const char*>(close) - p + 2;
+                } else {
+                    j++;
+                }
+            }
+            if (j >= n) {
+                return false;
+            }
+            i = j;
+            break;
+        }
+        case '\\': {
+            if (i + 1 == n) {
+                return false;
+            }
+            const auto c = static_cast<uint8_t>(p[++i]);
+            if (is_token_char(c)) {
+                // the escapes of one character class or assertion, the others like \x41 and \pL span more
+                // characters and are not analyzed
+                if (c >= 0x80 || strchr("dDwWsSbBAzntrfva", c) == nullptr) {
+                    return false;
+                }
+                collector.finish(false);
+            } else {
+                collector.append(static_cast<char>(c));
+            }
+            break;
+        }
+        default:
+            collector.append(p[i]);
+        }
+    }
+    collector.finish(false);
+    return true;
+}
+
+} // namespace starrocks
@@ -0,0 +1,68 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "util/slice.h"
+
+namespace starrocks {
+
+// A literal contained by every value matched by a LIKE or regular expression pattern.
+struct PatternLiteral {
+    std::string text;
+    // whether the literal is at the beginning of the matched values
+    bool at_begin = false;
+    // whether the literal is at the end of the matched values
+    bool at_end = false;
+};
+
+// Split the strings into the grams indexed by the n-gram index.
+//
+// If gram_size is positive, the grams are all the substrings of gram_size bytes, and the values shorter than
+// gram_size have no grams. Otherwise, the grams are the tokens, which are the maximal runs of ASCII letters, ASCII
+// digits and non-ASCII bytes, so the multi-byte UTF-8 characters are never split.
+class NgramTokenizer {
+public:
+    explicit NgramTokenizer(int32_t gram_size) : _gram_size(gram_size) {}
+
+    int32_t gram_size() const { return _gram_size; }
+
+    // Append the grams of |value| to |grams|, which point into |value| and may be duplicated.
+    void tokenize(const Slice& value, std::vector<Slice>* grams) const;
+
+    // Set |grams| to the distinct grams that every value containing all of |literals| has. An empty |grams| means
+    // the literals are too short for the index to locate the values.
+    void required_grams(const std::vector<PatternLiteral>& literals, std::vector<std::string>* grams) const;
+
+    static bool is_token_char(uint8_t c) {
+        return c >= 0x80 || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    // Extract the literals of a LIKE pattern, which are separated by the wildcards '%' and '_', and '\' escapes
+    // the wildcards. Return false if the pattern could not be analyzed.
+    static bool extract_like_literals(const Slice& pattern, std::vector<PatternLiteral>* literals);
+
+    // Extract the literals that must occur in the values partially matched by a regular expression. The
+    // alternations and the groups are not analyzed, return false for them.
+    static bool extract_regex_literals(const Slice& pattern, std::vector<PatternLiteral>* literals);
+
+private:
+    int32_t _gram_size;
+};
+
+} // namespace starrocks
@@ -36,6 +36,7 @@
 
 #include "storage/column_predicate.h"
 #include "storage/rowset/binary_dict_page.h"
+#include "storage/rowset/binary_fsst_page.h"
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/encoding_info.h"
 #include "util/bitmap.h"
@@ -342,6 +343,83 @@ Status ScalarColumnIterator::get_row_ranges_by_bloom_filter(const std::vector<co
     return Status::OK();
 }
 
+Status ScalarColumnIterator::get_row_ranges_by_ngram_index(const std::vector<const ColumnPredicate*>& predicates,
+                                                           SparseRange<>* row_ranges) {
+    RETURN_IF(!_reader->has_ngram_index(), Status::OK());
+
+    IndexReadOptions opts;
+    opts.use_page_cache = !config::disable_storage_page_cache;
+    opts.kept_in_memory = false;
+    opts.skip_fill_data_cache = _skip_fill_data_cache();
+    opts.read_file = _opts.read_file;
+    opts.stats = _opts.stats;
+    RETURN_IF_ERROR(_reader->ngram_index_filter(predicates, row_ranges, opts));
+    return Status::OK();
+}
+
+Status ScalarColumnIterator::estimate_selectivity(const std::vector<const ColumnPredicate*>& predicates,
+                                                  const SparseRange<>& row_ranges, double* selectivity) {
+    *selectivity = 1.0;
+    RETURN_IF(!_reader->has_zone_map(), Status::OK());
+
+    IndexReadOptions opts;
+    opts.use_page_cache = config::enable_zonemap_index_memory_page_cache || !config::disable_storage_page_cache;
+    opts.kept_in_memory = config::enable_zonemap_index_memory_page_cache;
+    opts.skip_fill_data_cache = _skip_fill_data_cache();
+    opts.read_file = _opts.read_file;
+    opts.stats = _opts.stats;
+    return _reader->estimate_selectivity(predicates, row_ranges, opts, selectivity);
+}
+
+bool ScalarColumnIterator::has_compressed_pages() const {
+    return _reader->encoding_info()->encoding() == FSST_ENCODING;
+}
+
+Status ScalarColumnIterator::get_row_ranges_by_compressed_predicates(
+        const std::vector<const ColumnPredicate*>& predicates, rowid_t ord, rowid_t* page_end,
+        SparseRange<>* row_ranges) {
+    RETURN_IF_ERROR(seek_to_ordinal(ord));
+    const auto page_begin = static_cast<rowid_t>(_page->first_ordinal());
+    *page_end = page_begin + _page->num_rows();
+
+    auto* decoder = _page->data_decoder();
+    // the nulls of the pages of format v1 are not stored in the data, the rows could not be located
+    if (decoder->encoding_type() != FSST_ENCODING || decoder->count() != _page->num_rows() ||
+        !down_cast<BinaryFsstPageDecoder*>(decoder)->is_compressed()) {
+        row_ranges->add(Range<>(ord, *page_end));
+        return Status::OK();
+    }
+    auto* fsst_decoder = down_cast<BinaryFsstPageDecoder*>(decoder);
+    std::vector<Slice> values(*page_end - ord);
+    for (uint32_t j = 0; j < values.size(); j++) {
+        values[j] = fsst_decoder->compressed_value(ord - page_begin + j);
+    }
+    std::vector<uint8_t> selection(values.size(), 1);
+    bool evaluated = false;
+    for (const auto* pred : predicates) {
+        evaluated |= pred->evaluate_compressed(fsst_decoder->symbol_table(), values.data(), values.size(),
+                                               selection.data());
+    }
+    if (!evaluated) {
+        row_ranges->add(Range<>(ord, *page_end));
+        return Status::OK();
+    }
+    // add the runs of the selected rows
+    for (rowid_t row = ord; row < *page_end;) {
+        if (!selection[row - ord]) {
+            row++;
+            continue;
+        }
+        rowid_t run_end = row + 1;
+        while (run_end < *page_end && selection[run_end - ord]) {
+            run_end++;
+        }
+        row_ranges->add(Range<>(row, run_end));
+        row = run_end;
+    }
+    return Status::OK();
+}
+
 int ScalarColumnIterator::dict_lookup(const Slice& word) {
     DCHECK(all_page_dict_encoded());
     return (this->*_dict_lookup_func)(word);
@@ -70,6 +70,18 @@ public:
     [[nodiscard]] Status get_row_ranges_by_bloom_filter(const std::vector<const ColumnPredicate*>& predicates,
                                                         SparseRange<>* range) override;
 
+    [[nodiscard]] Status get_row_ranges_by_ngram_index(const std::vector<const ColumnPredicate*>& predicates,
+                                                       SparseRange<>* range) override;
+
+    [[nodiscard]] Status estimate_selectivity(const std::vector<const ColumnPredicate*>& predicates,
+                                              const SparseRange<>& row_ranges, double* selectivity) override;
+
+    bool has_compressed_pages() const override;
+
+    [[nodiscard]] Status get_row_ranges_by_compressed_predicates(const std::vector<const ColumnPredicate*>& predicates,
+                                                                 rowid_t ord, rowid_t* page_end,
+                                                                 SparseRange<>* range) override;
+
     bool all_page_dict_encoded() const override { return _all_dict_encoded; }
 
     [[nodiscard]] Status fetch_all_dict_words(std::vector<Slice>* words) const override;
@@ -112,6 +112,14 @@ protected:
     Status do_get_next(Chunk* chunk, std::vector<RowSourceMask>* source_masks) override { return do_get_next(chunk); }
 
 private:
+    // A predicate column read and filtered on its own, see `_read_by_stages`.
+    struct ReadStage {
+        // index of the column in |ScanContext::_column_iterators|
+        size_t column_index = 0;
+        std::vector<const ColumnPredicate*> vectorized_preds;
+        std::vector<const ColumnPredicate*> branchless_preds;
+    };
+
     struct ScanContext {
         ScanContext() = default;
 
@@ -183,6 +191,11 @@ private:
 
         // not all dict encode
         bool _has_force_dict_encode{false};
+
+        // if not empty, the predicate columns of the stages are read and filtered one after another, and the
+        // columns of |_rest_column_indexes| are read only for the rows surviving all the stages.
+        std::vector<ReadStage> _read_stages;
+        std::vector<size_t> _rest_column_indexes;
     };
 
     Status _init();
@@ -196,7 +209,11 @@ private:
     Status _get_row_ranges_by_short_key_ranges();
     Status _get_row_ranges_by_zone_map();
     Status _get_row_ranges_by_bloom_filter();
+    Status _get_row_ranges_by_ngram_index();
+    void _init_compressed_predicates();
+    Status _get_row_ranges_by_compressed_predicates(size_t* n);
     Status _get_row_ranges_by_rowid_range();
+    Status _estimate_predicate_selectivity();
 
     uint32_t segment_id() const { return _segment->id(); }
     uint32_t num_rows() const { return _segment->num_rows(); }
@@ -210,8 +227,24 @@ private:
     StatusOr<uint16_t> _filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t to);
     StatusOr<uint16_t> _filter_by_expr_predicates(Chunk* chunk, vector<rowid_t>* rowid);
 
+    // Evaluate the conjunction of the predicates on the rows [from, to) of |chunk|, and store the result
+    // in |_selection|.
+    Status _evaluate_predicates(Chunk* chunk, const std::vector<const ColumnPredicate*>& vectorized_preds,
+                                const std::vector<const ColumnPredicate*>& branchless_preds, uint16_t from,
+                                uint16_t to);
+
     void _init_column_predicates();
 
+    // The relative cost to read and evaluate a value of the predicate column |cid|.
+    double _predicate_column_cost(ColumnId cid) const;
+
+    void _init_read_stages(ScanContext* ctx);
+
+    StatusOr<uint16_t> _read_by_stages(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, size_t n);
+
+    Status _read_column_of_stage(size_t index, const SparseRange<>& range, const SparseRange<>& survivors,
+                                 uint16_t num_survivors, Chunk* chunk, uint16_t from);
+
     Status _init_context();
 
     template <bool late_materialization>
@@ -242,8 +275,15 @@ private:
 
     Status _init_bitmap_index_iterators();
 
+    Status _new_bitmap_index_iterator(ColumnId cid, ColumnUID ucid);
+
     Status _apply_bitmap_index();
 
+    // Get the rows selected by |predicates| on the bitmap index of column |cid|. Returns false and leaves
+    // |row_ranges| untouched if the column has no bitmap index or the bitmap index is not selective enough.
+    StatusOr<bool> _get_row_ranges_by_bitmap_index(ColumnId cid, const PredicateList& predicates,
+                                                   SparseRange<>* row_ranges);
+
     Status _apply_del_vector();
 
     Status _read(Chunk* chunk, vector<rowid_t>* rowid, size_t n);
@@ -302,6 +342,22 @@ private:
     // _selected_idx is used to store selected index when evaluating branchless predicate
     Buffer<uint16_t> _selected_idx;
 
+    // the estimated fraction of the rows of |_scan_range| selected by the predicates of each predicate column,
+    // empty if the predicates are not reordered.
+    std::unordered_map<ColumnId, double> _predicate_selectivity;
+    // the predicate columns in the order their predicates are evaluated.
+    std::vector<ColumnId> _predicate_column_order;
+
+    // the predicates of the columns of FSST pages, which are evaluated on the compressed strings of a page when the
+    // scan reaches it, see `_get_row_ranges_by_compressed_predicates`.
+    std::vector<std::pair<ColumnId, std::vector<const ColumnPredicate*>>> _compressed_predicates;
+    // the rows before it have been filtered by |_compressed_predicates|.
+    rowid_t _compressed_predicates_filtered_end = 0;
+
+    // the row ids of the range read by `_read_by_stages`, and whether each of them survives the stages
+    std::vector<rowid_t> _range_rowids;
+    Buffer<uint8_t> _range_selection;
+
     ScanContext _context_list[2];
     // points to |_context_list[0]| or |_context_list[1]| after `_init_context`.
     ScanContext* _context = nullptr;
@@ -399,6 +455,7 @@ Status SegmentIterator::_init() {
 
     _selection.resize(_reserve_chunk_size);
     _selected_idx.resize(_reserve_chunk_size);
+    _range_selection.resize(_reserve_chunk_size);
 
     StarRocksMetrics::instance()->segment_read_total.increment(1);
 
@@ -418,11 +475,17 @@ Status SegmentIterator::_init() {
     RETURN_IF_ERROR(_apply_bitmap_index());
     RETURN_IF_ERROR(_get_row_ranges_by_zone_map());
     RETURN_IF_ERROR(_get_row_ranges_by_bloom_filter());
+    RETURN_IF_ERROR(_get_row_ranges_by_ngram_index());
+    _init_compressed_predicates();
+    RETURN_IF_ERROR(_estimate_predicate_selectivity());
     // rewrite stage
     // Rewriting predicates using segment dictionary codes
     RETURN_IF_ERROR(_rewrite_predicates());
     RETURN_IF_ERROR(_init_context());
     _init_column_predicates();
+    for (auto& ctx : _context_list) {
+        _init_read_stages(&ctx);
+    }
     _range_iter = _scan_range.new_iterator();
 
     return Status::OK();
@@ -437,6 +500,14 @@ Status SegmentIterator::_try_to_update_ranges_by_runtime_filter() {
                 del_pred = iter != _del_predicates.end() ? &(iter->second) : nullptr;
                 SparseRange<> r;
                 RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_zone_map(predicates, del_pred, &r));
+                // the runtime filter may arrive after the bitmap indexes are applied, so use the bitmap index
+                // of its column here to skip the pages whose values only overlap [min, max] in the zone map.
+                SparseRange<> bitmap_range;
+                ASSIGN_OR_RETURN(bool use_bitmap_index,
+                                 _get_row_ranges_by_bitmap_index(cid, predicates, &bitmap_range));
+                if (use_bitmap_index) {
+                    r &= bitmap_range;
+                }
                 size_t prev_size = _scan_range.span_size();
                 SparseRange<> res;
                 _range_iter = _range_iter.intersection(r, &res);
@@ -631,8 +702,22 @@ bool SegmentIterator::need_early_materialize_subfield(const FieldPtr& field) {
 
 void SegmentIterator::_init_column_predicates() {
     DCHECK_EQ(_predicate_columns, _opts.predicates.size());
+    _predicate_column_order.reserve(_opts.predicates.size());
     for (const auto& pair : _opts.predicates) {
-        for (const ColumnPredicate* pred : pair.second) {
+        _predicate_column_order.push_back(pair.first);
+    }
+    if (!_predicate_selectivity.empty()) {
+        // evaluate the predicates filtering out more rows at less cost first
+        std::unordered_map<ColumnId, double> ranks;
+        for (ColumnId cid : _predicate_column_order) {
+            ranks[cid] = (1 - _predicate_selectivity[cid]) / _predicate_column_cost(cid);
+        }
+        std::stable_sort(_predicate_column_order.begin(), _predicate_column_order.end(),
+                         [&](ColumnId lhs, ColumnId rhs) { return ranks[lhs] > ranks[rhs]; });
+    }
+
+    for (ColumnId cid : _predicate_column_order) {
+        for (const ColumnPredicate* pred : _opts.predicates[cid]) {
             // If this predicate is generated by join runtime filter,
             // We only use it to compute segment row range.
             if (pred->is_index_filter_only()) {
@@ -652,6 +737,64 @@ void SegmentIterator::_init_column_predicates() {
     }
 }
 
+double SegmentIterator::_predicate_column_cost(ColumnId cid) const {
+    if (_predicate_need_rewrite[cid]) {
+        // the predicates are evaluated on the dictionary codes
+        return 1.0;
+    }
+    for (const FieldPtr& f : _schema.fields()) {
+        if (f->id() == cid) {
+            // the strings are decoded and compared byte by byte
+            return is_string_type(f->type()->type()) ? 4.0 : std::max(1.0, f->type()->size() / 8.0);
+        }
+    }
+    return 1.0;
+}
+
+// The predicate columns are read and filtered one by one only if their predicates are reordered, and at least two of
+// them have the predicates evaluated while reading.
+void SegmentIterator::_init_read_stages(ScanContext* ctx) {
+    if (_predicate_selectivity.empty() || ctx->_column_iterators.empty() || _opts.predicates.empty()) {
+        return;
+    }
+    std::vector<ReadStage> stages;
+    std::vector<bool> in_stage(ctx->_column_iterators.size(), false);
+    for (ColumnId cid : _predicate_column_order) {
+        ReadStage stage;
+        for (const ColumnPredicate* pred : _vectorized_preds) {
+            if (pred->column_id() == cid) {
+                stage.vectorized_preds.emplace_back(pred);
+            }
+        }
+        for (const ColumnPredicate* pred : _branchless_preds) {
+            if (pred->column_id() == cid) {
+                stage.branchless_preds.emplace_back(pred);
+            }
+        }
+        if (stage.vectorized_preds.empty() && stage.branchless_preds.empty()) {
+            continue;
+        }
+        // the predicate columns come first in the read schema of both the contexts
+        size_t index = 0;
+        while (index < _predicate_columns && ctx->_read_schema.field(index)->id() != cid) {
+            index++;
+        }
+        DCHECK_LT(index, _predicate_columns);
+        stage.column_index = index;
+        in_stage[index] = true;
+        stages.emplace_back(std::move(stage));
+    }
+    if (stages.size() < 2) {
+        return;
+    }
+    ctx->_read_stages = std::move(stages);
+    for (size_t i = 0; i < ctx->_column_iterators.size(); i++) {
+        if (!in_stage[i]) {
+            ctx->_rest_column_indexes.push_back(i);
+        }
+    }
+}
+
 Status SegmentIterator::_get_row_ranges_by_keys() {
     StarRocksMetrics::instance()->segment_row_total.increment(num_rows());
     SCOPED_RAW_TIMER(&_opts.stats->rows_key_range_filter_ns);
@@ -743,6 +886,29 @@ Status SegmentIterator::_get_row_ranges_by_short_key_ranges() {
     return Status::OK();
 }
 
+Status SegmentIterator::_estimate_predicate_selectivity() {
+    RETURN_IF(!config::enable_segment_predicate_reorder, Status::OK());
+    RETURN_IF(_opts.predicates.size() < 2 || _scan_range.empty(), Status::OK());
+
+    SCOPED_RAW_TIMER(&_opts.stats->predicate_selectivity_estimate_ns);
+    std::vector<const ColumnPredicate*> query_preds;
+    for (const auto& [cid, preds] : _opts.predicates) {
+        query_preds.clear();
+        for (const ColumnPredicate* pred : preds) {
+            // the predicates used to compute the row ranges only are not evaluated on the rows
+            if (!pred->is_index_filter_only()) {
+                query_preds.emplace_back(pred);
+            }
+        }
+        double selectivity = 1.0;
+        if (!query_preds.empty()) {
+            RETURN_IF_ERROR(_column_iterators[cid]->estimate_selectivity(query_preds, _scan_range, &selectivity));
+        }
+        _predicate_selectivity[cid] = selectivity;
+    }
+    return Status::OK();
+}
+
 Status SegmentIterator::_get_row_ranges_by_zone_map() {
     RETURN_IF(_scan_range.empty(), Status::OK());
 
@@ -1028,13 +1194,25 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
     uint16_t chunk_start = chunk->num_rows();
 
     while ((chunk_start < return_chunk_threshold) & _range_iter.has_more()) {
-        RETURN_IF_ERROR(_read(chunk, rowid, chunk_capacity - chunk_start));
-        chunk->check_or_die();
-        size_t next_start = chunk->num_rows();
-
-        if (has_predicate) {
-            ASSIGN_OR_RETURN(next_start, _filter(chunk, rowid, chunk_start, next_start));
+        size_t n = chunk_capacity - chunk_start;
+        RETURN_IF_ERROR(_get_row_ranges_by_compressed_predicates(&n));
+        if (!_range_iter.has_more()) {
+            break;
+        }
+        size_t next_start = 0;
+        if (!_context->_read_stages.empty()) {
+            // the predicates are evaluated while reading the columns
+            ASSIGN_OR_RETURN(next_start, _read_by_stages(chunk, rowid, chunk_start, n));
+            chunk->check_or_die();
+        } else {
+            RETURN_IF_ERROR(_read(chunk, rowid, n));
             chunk->check_or_die();
+            next_start = chunk->num_rows();
+
+            if (has_predicate) {
+                ASSIGN_OR_RETURN(next_start, _filter(chunk, rowid, chunk_start, next_start));
+                chunk->check_or_die();
+            }
         }
         chunk_start = next_start;
         DCHECK_EQ(chunk_start, chunk->num_rows());
@@ -1188,25 +1366,50 @@ StatusOr<uint16_t> SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid
 
     SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
 
+    RETURN_IF_ERROR(_evaluate_predicates(chunk, _vectorized_preds, _branchless_preds, from, to));
+
+    auto hit_count = SIMD::count_nonzero(&_selection[from], to - from);
+    uint16_t chunk_size = to;
+    SCOPED_RAW_TIMER(&_opts.stats->vec_cond_chunk_copy_ns);
+    if (hit_count == 0) {
+        chunk_size = from;
+        chunk->set_num_rows(chunk_size);
+        if (rowid != nullptr) {
+            rowid->resize(chunk_size);
+        }
+    } else if (hit_count != to - from) {
+        chunk_size = chunk->filter_range(_selection, from, to);
+        if (rowid != nullptr) {
+            auto size = ColumnHelper::filter_range<uint32_t>(_selection, rowid->data(), from, to);
+            rowid->resize(size);
+        }
+    }
+    _opts.stats->rows_vec_cond_filtered += (to - chunk_size);
+    return chunk_size;
+}
+
+Status SegmentIterator::_evaluate_predicates(Chunk* chunk, const std::vector<const ColumnPredicate*>& vectorized_preds,
+                                             const std::vector<const ColumnPredicate*>& branchless_preds,
+                                             uint16_t from, uint16_t to) {
     // first evaluate
-    if (!_vectorized_preds.empty()) {
+    if (!vectorized_preds.empty()) {
         SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
-        const ColumnPredicate* pred = _vectorized_preds[0];
+        const ColumnPredicate* pred = vectorized_preds[0];
         Column* c = chunk->get_column_by_id(pred->column_id()).get();
         RETURN_IF_ERROR(pred->evaluate(c, _selection.data(), from, to));
-        for (int i = 1; i < _vectorized_preds.size(); ++i) {
-            pred = _vectorized_preds[i];
+        for (int i = 1; i < vectorized_preds.size(); ++i) {
+            pred = vectorized_preds[i];
             c = chunk->get_column_by_id(pred->column_id()).get();
             RETURN_IF_ERROR(pred->evaluate_and(c, _selection.data(), from, to));
         }
     }
 
     // evaluate brachless
-    if (!_branchless_preds.empty()) {
+    if (!branchless_preds.empty()) {
         SCOPED_RAW_TIMER(&_opts.stats->branchless_cond_evaluate_ns);
 
         uint16_t selected_size = 0;
-        if (!_vectorized_preds.empty()) {
+        if (!vectorized_preds.empty()) {
             for (uint16_t i = from; i < to; ++i) {
                 _selected_idx[selected_size] = i;
                 selected_size += _selection[i];
@@ -1220,8 +1423,8 @@ StatusOr<uint16_t> SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid
             }
         }
 
-        for (size_t i = 0; selected_size > 0 && i < _branchless_preds.size(); ++i) {
-            const ColumnPredicate* pred = _branchless_preds[i];
+        for (size_t i = 0; selected_size > 0 && i < branchless_preds.size(); ++i) {
+            const ColumnPredicate* pred = branchless_preds[i];
             ColumnPtr& c = chunk->get_column_by_id(pred->column_id());
             ASSIGN_OR_RETURN(selected_size, pred->evaluate_branchless(c.get(), _selected_idx.data(), selected_size));
         }
@@ -1231,25 +1434,137 @@ StatusOr<uint16_t> SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid
             _selection[_selected_idx[i]] = 1;
         }
     }
+    return Status::OK();
+}
 
-    auto hit_count = SIMD::count_nonzero(&_selection[from], to - from);
-    uint16_t chunk_size = to;
-    SCOPED_RAW_TIMER(&_opts.stats->vec_cond_chunk_copy_ns);
-    if (hit_count == 0) {
-        chunk_size = from;
-        chunk->set_num_rows(chunk_size);
-        if (rowid != nullptr) {
-            rowid->resize(chunk_size);
+// Read the columns of the stages one by one, each for the rows surviving the predicates of the former ones, and then
+// the rest columns for the rows surviving all of them. Returns the number of rows of |chunk| after the new rows.
+StatusOr<uint16_t> SegmentIterator::_read_by_stages(Chunk* chunk, vector<rowid_t>* rowids, uint16_t from, size_t n) {
+    if (_cur_rowid != _range_iter.begin() || _cur_rowid == 0) {
+        _cur_rowid = _range_iter.begin();
+        _opts.stats->block_seek_num += 1;
+        SCOPED_RAW_TIMER(&_opts.stats->block_seek_ns);
+        RETURN_IF_ERROR(_context->seek_columns(_cur_rowid));
+    }
+
+    SparseRange<> range;
+    _range_iter.next_range(n, &range);
+    const auto num_rows = static_cast<uint16_t>(range.span_size());
+    const auto to = static_cast<uint16_t>(from + num_rows);
+
+    _range_rowids.clear();
+    SparseRangeIterator<> iter = range.new_iterator();
+    while (iter.has_more()) {
+        Range<> r = iter.next(num_rows);
+        for (uint32_t i = r.begin(); i < r.end(); i++) {
+            _range_rowids.push_back(i);
+        }
+    }
+    memset(&_range_selection[from], 1, num_rows);
+
+    _opts.stats->blocks_load += 1;
+    SparseRange<> survivors = range;
+    uint16_t num_survivors = num_rows;
+    std::vector<size_t> read_columns;
+    for (const ReadStage& stage : _context->_read_stages) {
+        RETURN_IF_ERROR(_read_column_of_stage(stage.column_index, range, survivors, num_survivors, chunk, from));
+        read_columns.push_back(stage.column_index);
+
+        SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
+        const auto end = static_cast<uint16_t>(from + num_survivors);
+        RETURN_IF_ERROR(_evaluate_predicates(chunk, stage.vectorized_preds, stage.branchless_preds, from, end));
+        auto hit_count = static_cast<uint16_t>(SIMD::count_nonzero(&_selection[from], num_survivors));
+        if (hit_count == num_survivors) {
+            continue;
         }
-    } else if (hit_count != to - from) {
-        chunk_size = chunk->filter_range(_selection, from, to);
-        if (rowid != nullptr) {
-            auto size = ColumnHelper::filter_range<uint32_t>(_selection, rowid->data(), from, to);
-            rowid->resize(size);
+        {
+            SCOPED_RAW_TIMER(&_opts.stats->vec_cond_chunk_copy_ns);
+            for (size_t index : read_columns) {
+                chunk->get_column_by_index(index)->filter_range(_selection, from, end);
+            }
+        }
+        // drop the rows filtered out by this stage from the survivors
+        for (uint16_t i = from, j = from; i < to; i++) {
+            if (_range_selection[i]) {
+                _range_selection[i] = _selection[j++];
+            }
         }
+        num_survivors = hit_count;
+        if (num_survivors == 0) {
+            break;
+        }
+        survivors.clear();
+        rowid_t run_begin = 0;
+        rowid_t run_end = 0;
+        for (uint16_t i = from; i < to; i++) {
+            if (!_range_selection[i]) {
+                continue;
+            }
+            rowid_t rowid = _range_rowids[i - from];
+            if (rowid != run_end) {
+                survivors.add(Range<>(run_begin, run_end));
+                run_begin = rowid;
+            }
+            run_end = rowid + 1;
+        }
+        survivors.add(Range<>(run_begin, run_end));
     }
-    _opts.stats->rows_vec_cond_filtered += (to - chunk_size);
-    return chunk_size;
+
+    bool may_has_del_row = chunk->delete_state() != DEL_NOT_SATISFIED;
+    if (num_survivors > 0) {
+        for (size_t index : _context->_rest_column_indexes) {
+            RETURN_IF_ERROR(_read_column_of_stage(index, range, survivors, num_survivors, chunk, from));
+            read_columns.push_back(index);
+        }
+    }
+    for (size_t index : read_columns) {
+        may_has_del_row |= (chunk->get_column_by_index(index)->delete_state() != DEL_NOT_SATISFIED);
+    }
+    chunk->set_delete_state(may_has_del_row ? DEL_PARTIAL_SATISFIED : DEL_NOT_SATISFIED);
+
+    if (rowids != nullptr) {
+        rowids->reserve(rowids->size() + num_survivors);
+        for (uint16_t i = from; i < to; i++) {
+            if (_range_selection[i]) {
+                rowids->push_back(_range_rowids[i - from]);
+            }
+        }
+    }
+
+    _cur_rowid = range.end();
+    _opts.stats->raw_rows_read += num_rows;
+    _opts.stats->rows_vec_cond_filtered += num_rows - num_survivors;
+    return static_cast<uint16_t>(from + num_survivors);
+}
+
+// Read the column |index| for the |num_survivors| rows of |survivors| out of |range|.
+Status SegmentIterator::_read_column_of_stage(size_t index, const SparseRange<>& range,
+                                              const SparseRange<>& survivors, uint16_t num_survivors, Chunk* chunk,
+                                              uint16_t from) {
+    ColumnIterator* iter = _context->_column_iterators[index];
+    Column* column = chunk->get_column_by_index(index).get();
+    const auto num_rows = static_cast<uint16_t>(range.span_size());
+    // reading the surviving rows range by range costs more than reading all the rows and filtering them, unless
+    // most of the rows have been filtered out.
+    const bool read_survivors = num_survivors * 2 < num_rows;
+    const SparseRange<>& read_range = read_survivors ? survivors : range;
+    // the columns are not read together, so their iterators may not stop at the same row.
+    if (iter->get_current_ordinal() != read_range.begin()) {
+        _opts.stats->block_seek_num += 1;
+        SCOPED_RAW_TIMER(&_opts.stats->block_seek_ns);
+        RETURN_IF_ERROR(iter->seek_to_ordinal(read_range.begin()));
+    }
+    {
+        SCOPED_RAW_TIMER(&_opts.stats->block_fetch_ns);
+        RETURN_IF_ERROR(iter->next_batch(read_range, column));
+    }
+    if (read_survivors) {
+        _opts.stats->rows_staged_read_skipped += num_rows - num_survivors;
+    } else if (num_survivors < num_rows) {
+        SCOPED_RAW_TIMER(&_opts.stats->vec_cond_chunk_copy_ns);
+        column->filter_range(_range_selection, from, from + num_rows);
+    }
+    return Status::OK();
 }
 
 StatusOr<uint16_t> SegmentIterator::_filter_by_expr_predicates(Chunk* chunk, vector<rowid_t>* rowid) {
@@ -1658,29 +1973,80 @@ Status SegmentIterator::_init_bitmap_index_iterators() {
     for (const auto& pair : _opts.predicates) {
         ColumnId cid = pair.first;
         if (_bitmap_index_iterators[cid] == nullptr) {
-            ColumnUID ucid = cid_2_ucid[cid];
-            // the column's index in this segment file
-            int32_t col_index = 0;
-            ASSIGN_OR_RETURN(std::shared_ptr<Segment> segment_ptr, _get_dcg_segment(ucid, &col_index));
-            if (segment_ptr == nullptr) {
-                // find segment from delta column group failed, using main segment
-                segment_ptr = _segment;
-                col_index = cid;
-            }
+            RETURN_IF_ERROR(_new_bitmap_index_iterator(cid, cid_2_ucid[cid]));
+        }
+    }
+    return Status::OK();
+}
 
-            IndexReadOptions opts;
-            opts.use_page_cache = config::enable_bitmap_index_memory_page_cache || !config::disable_storage_page_cache;
-            opts.kept_in_memory = config::enable_bitmap_index_memory_page_cache;
-            opts.skip_fill_data_cache = _skip_fill_data_cache();
-            opts.read_file = _column_files[cid].get();
-            opts.stats = _opts.stats;
+Status SegmentIterator::_new_bitmap_index_iterator(ColumnId cid, ColumnUID ucid) {
+    // the column's index in this segment file
+    int32_t col_index = 0;
+    ASSIGN_OR_RETURN(std::shared_ptr<Segment> segment_ptr, _get_dcg_segment(ucid, &col_index));
+    if (segment_ptr == nullptr) {
+        // find segment from delta column group failed, using main segment
+        segment_ptr = _segment;
+        col_index = cid;
+    }
+
+    IndexReadOptions opts;
+    opts.use_page_cache = config::enable_bitmap_index_memory_page_cache || !config::disable_storage_page_cache;
+    opts.kept_in_memory = config::enable_bitmap_index_memory_page_cache;
+    opts.skip_fill_data_cache = _skip_fill_data_cache();
+    opts.read_file = _column_files[cid].get();
+    opts.stats = _opts.stats;
+
+    RETURN_IF_ERROR(segment_ptr->new_bitmap_index_iterator(col_index, opts, &_bitmap_index_iterators[cid],
+                                                           _opts.tablet_schema));
+    _has_bitmap_index |= (_bitmap_index_iterators[cid] != nullptr);
+    return Status::OK();
+}
 
-            RETURN_IF_ERROR(segment_ptr->new_bitmap_index_iterator(col_index, opts, &_bitmap_index_iterators[cid],
-                                                                   _opts.tablet_schema));
-            _has_bitmap_index |= (_bitmap_index_iterators[cid] != nullptr);
+StatusOr<bool> SegmentIterator::_get_row_ranges_by_bitmap_index(ColumnId cid, const PredicateList& predicates,
+                                                                SparseRange<>* row_ranges) {
+    if (_bitmap_index_iterators.size() <= cid) {
+        _bitmap_index_iterators.resize(cid + 1, nullptr);
+    }
+    if (_bitmap_index_iterators[cid] == nullptr) {
+        auto field = std::find_if(_schema.fields().begin(), _schema.fields().end(),
+                                  [cid](const FieldPtr& f) { return f->id() == cid; });
+        if (field == _schema.fields().end() || _column_files.count(cid) == 0) {
+            return false;
         }
+        RETURN_IF_ERROR(_new_bitmap_index_iterator(cid, (*field)->uid()));
     }
-    return Status::OK();
+    BitmapIndexIterator* bitmap_iter = _bitmap_index_iterators[cid];
+    if (bitmap_iter == nullptr) {
+        return false;
+    }
+    SCOPED_RAW_TIMER(&_opts.stats->bitmap_index_filter_timer);
+
+    size_t cardinality = bitmap_iter->bitmap_nums();
+    SparseRange<> selected(0, cardinality);
+    for (const ColumnPredicate* pred : predicates) {
+        SparseRange<> r;
+        Status st = pred->seek_bitmap_dictionary(bitmap_iter, &r);
+        if (st.is_cancelled()) {
+            // not supported by bitmap index.
+            return false;
+        }
+        RETURN_IF_ERROR(st);
+        selected &= r;
+    }
+    // reading the bitmaps of lots of values costs more than reading the pages.
+    if (selected.span_size() * 1000 > cardinality * config::bitmap_max_filter_ratio) {
+        return false;
+    }
+
+    Roaring row_bitmap;
+    RETURN_IF_ERROR(bitmap_iter->read_union_bitmap(selected, &row_bitmap));
+    if (bitmap_iter->has_null_bitmap()) {
+        Roaring null_bitmap;
+        RETURN_IF_ERROR(bitmap_iter->read_null_bitmap(&null_bitmap));
+        row_bitmap -= null_bitmap;
+    }
+    *row_ranges = roaring2range(row_bitmap);
+    return true;
 }
 
 // filter rows by evaluating column predicates using bitmap indexes.
@@ -1808,6 +2174,78 @@ Status SegmentIterator::_get_row_ranges_by_bloom_filter() {
     return Status::OK();
 }
 
+Status SegmentIterator::_get_row_ranges_by_ngram_index() {
+    RETURN_IF(_scan_range.empty(), Status::OK());
+    RETURN_IF(_opts.predicates.empty(), Status::OK());
+    SCOPED_RAW_TIMER(&_opts.stats->ngram_index_filter_ns);
+    size_t prev_size = _scan_range.span_size();
+    for (const auto& [cid, preds] : _opts.predicates) {
+        ColumnIterator* column_iter = _column_iterators[cid].get();
+        RETURN_IF_ERROR(column_iter->get_row_ranges_by_ngram_index(preds, &_scan_range));
+        if (_scan_range.empty()) {
+            break;
+        }
+    }
+    _opts.stats->rows_ngram_index_filtered += prev_size - _scan_range.span_size();
+    return Status::OK();
+}
+
+void SegmentIterator::_init_compressed_predicates() {
+    if (!config::enable_segment_compressed_predicate_filter) {
+        return;
+    }
+    for (const auto& [cid, preds] : _opts.predicates) {
+        if (_column_iterators[cid]->has_compressed_pages()) {
+            _compressed_predicates.emplace_back(cid, preds);
+        }
+    }
+}
+
+// Evaluate the compressed predicates on the page of each FSST column at the next row to read, and remove the rows
+// filtered out from the scan range. A page is filtered only when the scan reaches it and is read right after, so
+// that it's loaded once for both. |n| is capped to the rows of the filtered pages.
+Status SegmentIterator::_get_row_ranges_by_compressed_predicates(size_t* n) {
+    RETURN_IF(_compressed_predicates.empty(), Status::OK());
+    while (_range_iter.has_more() && _range_iter.begin() >= _compressed_predicates_filtered_end) {
+        const rowid_t begin = _range_iter.begin();
+        rowid_t end = num_rows();
+        SparseRange<> selected(begin, end);
+        for (const auto& [cid, preds] : _compressed_predicates) {
+            rowid_t page_end = end;
+            SparseRange<> r;
+            RETURN_IF_ERROR(
+                    _column_iterators[cid]->get_row_ranges_by_compressed_predicates(preds, begin, &page_end, &r));
+            end = std::min(end, page_end);
+            selected &= r;
+        }
+        _compressed_predicates_filtered_end = end;
+
+        // keep the rows out of [begin, end)
+        SparseRange<> r;
+        if (begin > 0) {
+            r.add(Range<>(0, begin));
+        }
+        r |= selected.intersection(SparseRange<>(begin, end));
+        if (end < num_rows()) {
+            r.add(Range<>(end, num_rows()));
+        }
+        SparseRange<> res;
+        _range_iter = _range_iter.intersection(r, &res);
+        std::swap(res, _scan_range);
+        _range_iter.set_range(&_scan_range);
+    }
+
+    // the rows of the next pages are read after their pages are filtered
+    size_t rows = 0;
+    SparseRangeIterator<> iter = _range_iter;
+    while (rows < *n && iter.has_more() && iter.begin() < _compressed_predicates_filtered_end) {
+        const size_t size = std::min<size_t>(*n - rows, _compressed_predicates_filtered_end - iter.begin());
+        rows += iter.next(size).span_size();
+    }
+    *n = rows;
+    return Status::OK();
+}
+
 Status SegmentIterator::_get_row_ranges_by_rowid_range() {
     RETURN_IF(_opts.rowid_range_option == nullptr || _scan_range.empty(), Status::OK());
     _scan_range = _scan_range.intersection(*_opts.rowid_range_option);
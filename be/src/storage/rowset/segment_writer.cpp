@@ -34,6 +34,7 @@
 
 #include "storage/rowset/segment_writer.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -47,6 +48,7 @@
 #include "gen_cpp/segment.pb.h"
 #include "storage/row_store_encoder.h"
 #include "storage/rowset/column_writer.h" // ColumnWriter
+#include "storage/rowset/encoding_info.h"
 #include "storage/rowset/page_io.h"
 #include "storage/seek_tuple.h"
 #include "storage/short_key_index.h"
@@ -153,6 +155,16 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
         } else {
             _init_column_meta(opts.meta, column_index, column);
         }
+        // the key and sort key columns are mostly sorted or clustered, which compress well by deltas
+        if (config::enable_segment_delta_encoding && (column.is_key() || column.is_sort_key())) {
+            const EncodingInfo* encoding_info = nullptr;
+            if (EncodingInfo::get(column.type(), DELTA_OF_DELTA_ENCODING, &encoding_info).ok()) {
+                opts.meta->set_encoding(DELTA_OF_DELTA_ENCODING);
+            }
+        }
+        if (config::enable_segment_alp_encoding && (column.type() == TYPE_FLOAT || column.type() == TYPE_DOUBLE)) {
+            opts.meta->set_encoding(ALP_ENCODING);
+        }
 
         // now we create zone map for key columns
         // and not support zone map for array type.
@@ -168,6 +180,10 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
         }
         opts.need_bloom_filter = column.is_bf_column();
         opts.need_bitmap_index = column.has_bitmap_index();
+        if (column.has_ngram_index() && column.type() == LogicalType::TYPE_VARCHAR) {
+            opts.need_ngram_index = true;
+            opts.ngram_index_gram_size = column.ngram_index_gram_size();
+        }
         if (column.type() == LogicalType::TYPE_ARRAY) {
             if (opts.need_bloom_filter) {
                 return Status::NotSupported("Do not support bloom filter for array type");
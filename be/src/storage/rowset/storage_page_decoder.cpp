@@ -111,6 +111,10 @@ DataDecoder* DataDecoder::get_data_decoder(EncodingTypePB encoding) {
         return &g_binary_dict_decoder;
     }
     case FOR_ENCODING:
+    case DELTA_ENCODING:
+    case DELTA_OF_DELTA_ENCODING:
+    case ALP_ENCODING:
+    case FSST_ENCODING:
     case PLAIN_ENCODING:
     case PREFIX_ENCODING:
     case RLE: {
@@ -35,9 +35,11 @@
 #include "storage/rowset/zone_map_index.h"
 
 #include <bthread/sys_futex.h>
+#include <cmath>
 
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
+#include "common/config.h"
 #include "storage/chunk_helper.h"
 #include "storage/decimal_type_info.h"
 #include "storage/olap_define.h"
@@ -47,10 +49,33 @@
 #include "storage/rowset/indexed_column_writer.h"
 #include "storage/type_traits.h"
 #include "storage/types.h"
+#include "util/hash_util.hpp"
 #include "util/unaligned_access.h"
 
 namespace starrocks {
 
+uint32_t DistinctValueSketch::estimate(uint32_t num_values) const {
+    uint32_t num_unset = kNumBits;
+    for (uint64_t word : _bits) {
+        num_unset -= __builtin_popcountll(word);
+    }
+    if (num_unset == 0) {
+        // saturated, all the values are taken as distinct
+        return num_values;
+    }
+    double estimation = kNumBits * std::log(static_cast<double>(kNumBits) / num_unset);
+    return std::min<uint32_t>(num_values, std::max<uint32_t>(1, std::llround(estimation)));
+}
+
+template <typename T>
+static inline uint32_t zone_map_value_hash(const T& value) {
+    return HashUtil::murmur_hash3_32(&value, sizeof(T), 0);
+}
+
+static inline uint32_t zone_map_value_hash(const Slice& value) {
+    return HashUtil::murmur_hash3_32(value.data, static_cast<int32_t>(value.size), 0);
+}
+
 template <LogicalType type>
 struct ZoneMapDatumBase {
     using CppType = typename TypeTraits<type>::CppType;
@@ -168,13 +193,19 @@ private:
     ZoneMap<type> _page_zone_map;
     ZoneMap<type> _segment_zone_map;
 
+    const bool _estimate_ndv;
+    // the distinct not-null values of the current page
+    DistinctValueSketch _page_ndv_sketch;
+    uint32_t _page_num_values = 0;
+
     // serialized ZoneMapPB for each data page
     std::vector<std::string> _values;
     uint64_t _estimated_size = 0;
 };
 
 template <LogicalType type>
-ZoneMapIndexWriterImpl<type>::ZoneMapIndexWriterImpl(TypeInfo* type_info) : _type_info(type_info) {
+ZoneMapIndexWriterImpl<type>::ZoneMapIndexWriterImpl(TypeInfo* type_info)
+        : _type_info(type_info), _estimate_ndv(config::enable_zone_map_page_ndv) {
     _reset_zone_map(&_page_zone_map);
     _reset_zone_map(&_segment_zone_map);
 }
@@ -202,6 +233,13 @@ void ZoneMapIndexWriterImpl<type>::add_values(const void* values, size_t count)
             _type_info->direct_copy(&_page_zone_map.max_value.value, pmax);
         }
         _page_zone_map.has_not_null = true;
+
+        if (_estimate_ndv) {
+            for (size_t i = 0; i < count; i++) {
+                _page_ndv_sketch.add(zone_map_value_hash(unaligned_load<CppType>(vals + i)));
+            }
+            _page_num_values += count;
+        }
     }
 }
 
@@ -234,7 +272,12 @@ Status ZoneMapIndexWriterImpl<type>::flush() {
 
     ZoneMapPB zone_map_pb;
     _page_zone_map.to_proto(&zone_map_pb, _type_info);
+    if (_estimate_ndv && _page_zone_map.has_not_null) {
+        zone_map_pb.set_num_distinct_values(_page_ndv_sketch.estimate(_page_num_values));
+    }
     _reset_zone_map(&_page_zone_map);
+    _page_ndv_sketch.reset();
+    _page_num_values = 0;
 
     std::string serialized_zone_map;
     bool ret = zone_map_pb.SerializeToString(&serialized_zone_map);
@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -52,6 +53,25 @@ namespace starrocks {
 class FileSystem;
 class WritableFile;
 
+// Linear counting sketch to estimate the number of distinct values of a data page, which sets a bit of a fixed size
+// bitmap for each hash value and estimates the distinct values by the fraction of the bits still unset. It's accurate
+// to a few percent until the distinct values are several times the bits.
+class DistinctValueSketch {
+public:
+    void add(uint32_t hash) { _bits[(hash >> 6) & (kNumWords - 1)] |= uint64_t(1) << (hash & 63); }
+
+    void reset() { memset(_bits, 0, sizeof(_bits)); }
+
+    // |num_values| is the number of values added, which bounds the estimation.
+    uint32_t estimate(uint32_t num_values) const;
+
+private:
+    static constexpr uint32_t kNumWords = 32;
+    static constexpr uint32_t kNumBits = kNumWords * 64;
+
+    uint64_t _bits[kNumWords] = {};
+};
+
 // Zone map index is represented by an IndexedColumn with ordinal index.
 // The IndexedColumn stores serialized ZoneMapPB for each data page.
 // It also create and store the segment-level zone map in the index meta so that
@@ -779,6 +779,10 @@ Status SchemaChangeUtils::parse_request_normal(const TabletSchemaCSPtr& base_sch
             } else if (new_column.has_bitmap_index() != ref_column.has_bitmap_index()) {
                 *sc_directly = true;
                 return Status::OK();
+            } else if (new_column.has_ngram_index() != ref_column.has_ngram_index() ||
+                       new_column.ngram_index_gram_size() != ref_column.ngram_index_gram_size()) {
+                *sc_directly = true;
+                return Status::OK();
             }
         }
     }
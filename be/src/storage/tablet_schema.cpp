@@ -218,6 +218,10 @@ void TabletColumn::init_from_pb(const ColumnPB& column) {
     _set_flag(kIsNullableShift, column.is_nullable());
     _set_flag(kIsBfColumnShift, column.is_bf_column());
     _set_flag(kHasBitmapIndexShift, column.has_bitmap_index());
+    _set_flag(kHasNgramIndexShift, column.has_ngram_index());
+    if (column.has_ngram_index_gram_size()) {
+        set_ngram_index_gram_size(column.ngram_index_gram_size());
+    }
     _set_flag(kHasPrecisionShift, column.has_precision());
     _set_flag(kHasScaleShift, column.has_frac());
     _set_flag(kHasAutoIncrementShift, column.is_auto_increment());
@@ -277,6 +281,10 @@ void TabletColumn::to_schema_pb(ColumnPB* column) const {
     column->set_is_bf_column(is_bf_column());
     column->set_aggregation(get_string_by_aggregation_type(_aggregation));
     column->set_has_bitmap_index(has_bitmap_index());
+    column->set_has_ngram_index(has_ngram_index());
+    if (has_ngram_index()) {
+        column->set_ngram_index_gram_size(ngram_index_gram_size());
+    }
     for (int i = 0; i < subcolumn_count(); i++) {
         subcolumn(i).to_schema_pb(column->add_children_columns());
     }
@@ -601,6 +609,7 @@ bool operator==(const TabletColumn& a, const TabletColumn& b) {
     }
     if (a._length != b._length) return false;
     if (a._index_length != b._index_length) return false;
+    if (a.has_ngram_index() && a.ngram_index_gram_size() != b.ngram_index_gram_size()) return false;
     return true;
 }
 
@@ -633,7 +642,11 @@ std::string TabletColumn::debug_string() const {
        << ",precision=" << (has_precision() ? std::to_string(_precision) : "N/A")
        << ",frac=" << (has_scale() ? std::to_string(_scale) : "N/A") << ",length=" << _length
        << ",index_length=" << _index_length << ",is_bf_column=" << is_bf_column()
-       << ",has_bitmap_index=" << has_bitmap_index() << ")";
+       << ",has_bitmap_index=" << has_bitmap_index() << ",has_ngram_index=" << has_ngram_index();
+    if (has_ngram_index()) {
+        ss << ",ngram_index_gram_size=" << ngram_index_gram_size();
+    }
+    ss << ")";
     return ss.str();
 }
 
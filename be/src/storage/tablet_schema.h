@@ -57,10 +57,16 @@ class POlapTableIndexSchema;
 class TColumn;
 
 class TabletColumn {
+public:
+    // the gram size of the n-gram index if it's not set by the "gram_num" property of the index
+    constexpr static int32_t kDefaultNgramIndexGramSize = 3;
+
+private:
     struct ExtraFields {
         std::string default_value;
         std::vector<TabletColumn> sub_columns;
         bool has_default_value = false;
+        int32_t ngram_index_gram_size = kDefaultNgramIndexGramSize;
     };
 
 public:
@@ -118,6 +124,17 @@ public:
     bool has_bitmap_index() const { return _check_flag(kHasBitmapIndexShift); }
     void set_has_bitmap_index(bool value) { _set_flag(kHasBitmapIndexShift, value); }
 
+    bool has_ngram_index() const { return _check_flag(kHasNgramIndexShift); }
+    void set_has_ngram_index(bool value) { _set_flag(kHasNgramIndexShift, value); }
+
+    // the length in bytes of the grams of the n-gram index, or 0 to index the tokens of letters and digits
+    int32_t ngram_index_gram_size() const {
+        return _extra_fields ? _extra_fields->ngram_index_gram_size : kDefaultNgramIndexGramSize;
+    }
+    void set_ngram_index_gram_size(int32_t gram_size) {
+        _get_or_alloc_extra_fields()->ngram_index_gram_size = gram_size;
+    }
+
     bool is_sort_key() const { return _check_flag(kIsSortKey); }
     void set_is_sort_key(bool value) { _set_flag(kIsSortKey, value); }
 
@@ -187,6 +204,7 @@ private:
     constexpr static uint8_t kHasScaleShift = 5;
     constexpr static uint8_t kHasAutoIncrementShift = 6;
     constexpr static uint8_t kIsSortKey = 7;
+    constexpr static uint8_t kHasNgramIndexShift = 8;
 
     ExtraFields* _get_or_alloc_extra_fields() {
         if (_extra_fields == nullptr) {
@@ -221,7 +239,7 @@ private:
     ColumnPrecision _precision = 0;
     ColumnScale _scale = 0;
 
-    uint8_t _flags = 0;
+    uint16_t _flags = 0;
 
     ExtraFields* _extra_fields = nullptr;
 };
@@ -0,0 +1,280 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/fsst.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/compiler_util.h"
+#include "common/logging.h"
+#include "util/phmap/phmap.h"
+
+namespace starrocks {
+
+namespace {
+
+// the number of rounds of compressing the sample to refine the symbols
+constexpr size_t kBuildRounds = 5;
+// while building the table, the escaped byte b is counted as the code kLiteralCodeBase + b
+constexpr uint32_t kLiteralCodeBase = 256;
+
+inline uint64_t symbol_mask(uint32_t length) {
+    return length >= 8 ? ~uint64_t(0) : (uint64_t(1) << (8 * length)) - 1;
+}
+
+inline uint64_t load_word(const uint8_t* data, size_t size) {
+    uint64_t word = 0;
+    memcpy(&word, data, std::min<size_t>(size, sizeof(uint64_t)));
+    return word;
+}
+
+// the order of the symbols in the table
+inline bool symbol_before(uint64_t lhs_value, uint32_t lhs_length, uint64_t rhs_value, uint32_t rhs_length) {
+    const uint8_t lhs_first = lhs_value & 0xFF;
+    const uint8_t rhs_first = rhs_value & 0xFF;
+    if (lhs_first != rhs_first) {
+        return lhs_first < rhs_first;
+    }
+    if (lhs_length != rhs_length) {
+        return lhs_length > rhs_length;
+    }
+    return lhs_value < rhs_value;
+}
+
+} // namespace
+
+FsstSymbolTable::FsstSymbolTable() {
+    memset(_values, 0, sizeof(_values));
+    memset(_lengths, 0, sizeof(_lengths));
+    memset(_first_code, 0, sizeof(_first_code));
+}
+
+FsstSymbolTable FsstSymbolTable::build(const std::vector<Slice>& samples) {
+    struct Candidate {
+        Symbol symbol;
+        uint64_t gain;
+    };
+
+    FsstSymbolTable table;
+    std::vector<uint64_t> counts(2 * kLiteralCodeBase);
+    phmap::flat_hash_map<uint32_t, uint64_t> pair_counts;
+    std::vector<Candidate> candidates;
+    for (size_t round = 0; round < kBuildRounds; round++) {
+        std::fill(counts.begin(), counts.end(), 0);
+        pair_counts.clear();
+        for (const Slice& s : samples) {
+            const auto* data = reinterpret_cast<const uint8_t*>(s.data);
+            uint32_t prev_code = 0;
+            for (size_t pos = 0; pos < s.size;) {
+                uint32_t code = table._find_code(data + pos, s.size - pos);
+                uint32_t length = 1;
+                if (code == kEscapeCode) {
+                    code = kLiteralCodeBase + data[pos];
+                } else {
+                    length = table._lengths[code];
+                    // the first byte alone is also a candidate, in case the matched symbol is rarely used
+                    if (length > 1) {
+                        counts[kLiteralCodeBase + data[pos]]++;
+                    }
+                }
+                counts[code]++;
+                if (pos > 0) {
+                    pair_counts[(prev_code << 16) | code]++;
+                }
+                prev_code = code;
+                pos += length;
+            }
+        }
+
+        auto symbol_of = [&](uint32_t code) {
+            if (code >= kLiteralCodeBase) {
+                return Symbol{code - kLiteralCodeBase, 1};
+            }
+            return Symbol{table._values[code], table._lengths[code]};
+        };
+        candidates.clear();
+        for (uint32_t code = 0; code < counts.size(); code++) {
+            if (counts[code] > 0) {
+                Symbol symbol = symbol_of(code);
+                candidates.push_back({symbol, counts[code] * symbol.length});
+            }
+        }
+        for (const auto& [key, count] : pair_counts) {
+            Symbol first = symbol_of(key >> 16);
+            Symbol second = symbol_of(key & 0xFFFF);
+            if (first.length + second.length <= kMaxSymbolLength) {
+                Symbol symbol{first.value | (second.value << (8 * first.length)), first.length + second.length};
+                candidates.push_back({symbol, count * symbol.length});
+            }
+        }
+
+        // merge the gains of the same symbols, then pick the symbols of the most gains
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& lhs, const Candidate& rhs) {
+            return symbol_before(lhs.symbol.value, lhs.symbol.length, rhs.symbol.value, rhs.symbol.length);
+        });
+        size_t num_candidates = 0;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            if (num_candidates > 0 && candidates[num_candidates - 1].symbol.value == candidates[i].symbol.value &&
+                candidates[num_candidates - 1].symbol.length == candidates[i].symbol.length) {
+                candidates[num_candidates - 1].gain += candidates[i].gain;
+            } else {
+                candidates[num_candidates++] = candidates[i];
+            }
+        }
+        candidates.resize(num_candidates);
+        const size_t num_symbols = std::min<size_t>(num_candidates, kMaxSymbols);
+        std::partial_sort(candidates.begin(), candidates.begin() + num_symbols, candidates.end(),
+                          [](const Candidate& lhs, const Candidate& rhs) {
+                              if (lhs.gain != rhs.gain) {
+                                  return lhs.gain > rhs.gain;
+                              }
+                              return symbol_before(lhs.symbol.value, lhs.symbol.length, rhs.symbol.value,
+                                                   rhs.symbol.length);
+                          });
+
+        std::vector<Symbol> symbols;
+        symbols.reserve(num_symbols);
+        for (size_t i = 0; i < num_symbols; i++) {
+            symbols.push_back(candidates[i].symbol);
+        }
+        std::sort(symbols.begin(), symbols.end(), [](const Symbol& lhs, const Symbol& rhs) {
+            return symbol_before(lhs.value, lhs.length, rhs.value, rhs.length);
+        });
+        table._set_symbols(symbols);
+    }
+    return table;
+}
+
+void FsstSymbolTable::_set_symbols(const std::vector<Symbol>& symbols) {
+    DCHECK_LE(symbols.size(), kMaxSymbols);
+    _num_symbols = symbols.size();
+    memset(_first_code, 0, sizeof(_first_code));
+    for (uint32_t code = 0; code < _num_symbols; code++) {
+        _values[code] = symbols[code].value;
+        _lengths[code] = symbols[code].length;
+        _first_code[(symbols[code].value & 0xFF) + 1]++;
+    }
+    for (uint32_t b = 0; b < 256; b++) {
+        _first_code[b + 1] += _first_code[b];
+    }
+}
+
+uint8_t FsstSymbolTable::_find_code(const uint8_t* data, size_t size) const {
+    const uint64_t word = load_word(data, size);
+    for (uint32_t code = _first_code[data[0]]; code < _first_code[data[0] + 1]; code++) {
+        const uint32_t length = _lengths[code];
+        if (length <= size && ((word ^ _values[code]) & symbol_mask(length)) == 0) {
+            return code;
+        }
+    }
+    return kEscapeCode;
+}
+
+void FsstSymbolTable::compress(const Slice& s, faststring* dst) const {
+    const size_t old_size = dst->size();
+    // every byte takes two bytes at most
+    dst->resize(old_size + 2 * s.size);
+    const auto* data = reinterpret_cast<const uint8_t*>(s.data);
+    uint8_t* out = dst->data() + old_size;
+    for (size_t pos = 0; pos < s.size;) {
+        const uint8_t code = _find_code(data + pos, s.size - pos);
+        *out++ = code;
+        if (code == kEscapeCode) {
+            *out++ = data[pos++];
+        } else {
+            pos += _lengths[code];
+        }
+    }
+    dst->resize(out - dst->data());
+}
+
+size_t FsstSymbolTable::decompressed_size(const Slice& src) const {
+    const auto* in = reinterpret_cast<const uint8_t*>(src.data);
+    const auto* end = in + src.size;
+    size_t size = 0;
+    while (in < end) {
+        const uint8_t code = *in++;
+        if (code == kEscapeCode) {
+            if (LIKELY(in < end)) {
+                size++;
+                in++;
+            }
+        } else {
+            size += _lengths[code];
+        }
+    }
+    return size;
+}
+
+size_t FsstSymbolTable::decompress(const Slice& src, uint8_t* dst) const {
+    const auto* in = reinterpret_cast<const uint8_t*>(src.data);
+    const auto* end = in + src.size;
+    uint8_t* out = dst;
+    while (in < end) {
+        const uint8_t code = *in++;
+        if (code == kEscapeCode) {
+            if (LIKELY(in < end)) {
+                *out++ = *in++;
+            }
+        } else {
+            memcpy(out, &_values[code], sizeof(uint64_t));
+            out += _lengths[code];
+        }
+    }
+    return out - dst;
+}
+
+void FsstSymbolTable::serialize(faststring* dst) const {
+    dst->push_back(static_cast<char>(_num_symbols));
+    dst->append(_lengths, _num_symbols);
+    for (uint32_t code = 0; code < _num_symbols; code++) {
+        for (uint32_t i = 0; i < _lengths[code]; i++) {
+            dst->push_back(static_cast<char>(_values[code] >> (8 * i)));
+        }
+    }
+}
+
+Status FsstSymbolTable::deserialize(const Slice& src, size_t* consumed) {
+    const auto* data = reinterpret_cast<const uint8_t*>(src.data);
+    if (src.size < 1 || src.size < 1 + static_cast<size_t>(data[0])) {
+        return Status::Corruption("not enough bytes for the fsst symbol table");
+    }
+    const uint32_t num_symbols = data[0];
+    if (num_symbols > kMaxSymbols) {
+        return Status::Corruption("too many symbols in the fsst symbol table");
+    }
+    std::vector<Symbol> symbols(num_symbols);
+    size_t pos = 1 + num_symbols;
+    for (uint32_t code = 0; code < num_symbols; code++) {
+        Symbol& symbol = symbols[code];
+        symbol.length = data[1 + code];
+        if (symbol.length == 0 || symbol.length > kMaxSymbolLength || pos + symbol.length > src.size) {
+            return Status::Corruption("invalid symbol in the fsst symbol table");
+        }
+        for (uint32_t i = 0; i < symbol.length; i++) {
+            symbol.value |= static_cast<uint64_t>(data[pos + i]) << (8 * i);
+        }
+        pos += symbol.length;
+        if (code > 0 && !symbol_before(symbols[code - 1].value, symbols[code - 1].length, symbol.value,
+                                       symbol.length)) {
+            return Status::Corruption("unordered symbols in the fsst symbol table");
+        }
+    }
+    _set_symbols(symbols);
+    *consumed = pos;
+    return Status::OK();
+}
+
+} // namespace starrocks
@@ -0,0 +1,94 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "common/status.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+// The symbol table of FSST (Fast Static Symbol Table) string compression.
+//
+// The table maps up to 255 symbols of 1 to 8 bytes to the one-byte codes, and the code 255 escapes the next byte
+// as a literal. Every string is compressed on its own by replacing the longest symbol at each position with its
+// code, so a value could be decompressed without touching the others. Since the compression of a table is
+// deterministic and lossless, two strings are equal iff their compressed bytes are equal.
+//
+// The table is built from a sample of the strings, by iteratively compressing the sample with the current table
+// and picking the symbols and the concatenations of two adjacent symbols of the most saved bytes.
+class FsstSymbolTable {
+public:
+    static constexpr uint32_t kMaxSymbols = 255;
+    static constexpr uint32_t kMaxSymbolLength = 8;
+    static constexpr uint8_t kEscapeCode = 255;
+
+    FsstSymbolTable();
+
+    // Build a table from the sample of the strings to compress.
+    static FsstSymbolTable build(const std::vector<Slice>& samples);
+
+    uint32_t num_symbols() const { return _num_symbols; }
+
+    // Append the compressed bytes of |s| to |dst|.
+    void compress(const Slice& s, faststring* dst) const;
+
+    // The size of the buffer to decompress the bytes of |compressed_size|, which is larger than the decompressed
+    // size, because the symbols are copied as 8-byte words.
+    static size_t max_decompressed_size(size_t compressed_size) {
+        return compressed_size * kMaxSymbolLength + kMaxSymbolLength;
+    }
+
+    // The exact size of |src| decompressed.
+    size_t decompressed_size(const Slice& src) const;
+
+    // Decompress |src| into |dst|, and return the decompressed size. Since the symbols are copied as 8-byte words,
+    // |dst| must have kMaxSymbolLength - 1 writable bytes after the decompressed size, e.g. at least
+    // max_decompressed_size(src.size) bytes.
+    size_t decompress(const Slice& src, uint8_t* dst) const;
+
+    // The serialized table consists of the number of symbols (1 byte), the length of each symbol (1 byte each) and
+    // the bytes of the symbols.
+    void serialize(faststring* dst) const;
+
+    // Deserialize the table from the beginning of |src|, and set |consumed| to the size of the serialized table.
+    [[nodiscard]] Status deserialize(const Slice& src, size_t* consumed);
+
+private:
+    struct Symbol {
+        // the bytes of the symbol in little-endian, padded by zeros
+        uint64_t value = 0;
+        uint32_t length = 0;
+    };
+
+    // Set the symbols, which must be sorted by the first byte and then by the length in descending order, so that
+    // the longest matched symbol is the first matched one among the symbols of the same first byte.
+    void _set_symbols(const std::vector<Symbol>& symbols);
+
+    // Find the longest symbol at the beginning of the |size| bytes at |data|. Return kEscapeCode if there is none.
+    uint8_t _find_code(const uint8_t* data, size_t size) const;
+
+    uint32_t _num_symbols = 0;
+    uint64_t _values[kMaxSymbols + 1];
+    uint8_t _lengths[kMaxSymbols + 1];
+    // the codes of the symbols starting with byte b are in [_first_code[b], _first_code[b + 1])
+    uint16_t _first_code[257];
+};
+
+} // namespace starrocks
@@ -26,6 +26,7 @@
 #include "exec/aggregate/agg_hash_variant.h"
 #include "runtime/mem_pool.h"
 #include "runtime/runtime_state.h"
+#include "runtime/time_types.h"
 #include "types/logical_type.h"
 
 namespace starrocks {
@@ -175,6 +176,65 @@ TEST(HashMapTest, TwoLevelConvert) {
     }
 }
 
+TEST(HashMapTest, CompressedKey) {
+    CompressedKeyLayout layout;
+    layout.add_column(TYPE_INT, true, 0, 100);
+    layout.add_column(TYPE_DATE, false, 0, date::INVALID_DATE);
+    layout.add_column(TYPE_TINYINT, false, -128, 127);
+    layout.add_column(TYPE_BOOLEAN, true, 0, 1);
+    ASSERT_EQ(1 + 7 + 23 + 8 + 1 + 1, layout.total_bits);
+    ASSERT_EQ(8, layout.key_bytes());
+
+    const size_t num_rows = 6;
+    Columns columns;
+    columns.emplace_back(ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true));
+    columns.emplace_back(ColumnHelper::create_column(TypeDescriptor(TYPE_DATE), false));
+    columns.emplace_back(ColumnHelper::create_column(TypeDescriptor(TYPE_TINYINT), false));
+    columns.emplace_back(ColumnHelper::create_column(TypeDescriptor(TYPE_BOOLEAN), true));
+    for (size_t i = 0; i < num_rows; i++) {
+        // the last two rows are duplicates of the first two rows
+        size_t v = i % 4;
+        if (v == 1) {
+            columns[0]->append_nulls(1);
+        } else {
+            columns[0]->append_datum(Datum(int32_t(v * 33)));
+        }
+        DateValue date;
+        date.from_date(2020 + v, 1, 1);
+        columns[1]->append_datum(Datum(date));
+        columns[2]->append_datum(Datum(int8_t(v == 2 ? -128 : 127 - v)));
+        if (v == 3) {
+            columns[3]->append_nulls(1);
+        } else {
+            columns[3]->append_datum(Datum(uint8_t(v % 2)));
+        }
+    }
+
+    RuntimeProfile profile("CompressedKey");
+    AggStatistics statis(&profile);
+    AggHashMapWithCompressedKeyFixedSize<UInt64AggHashMap<PhmapSeed1>> key(num_rows, &statis);
+    key.layout = layout;
+    MemPool pool;
+    Buffer<AggDataPtr> agg_states(num_rows);
+    key.build_hash_map(num_rows, columns, &pool, [&](const auto& k) { return pool.allocate(16); }, &agg_states);
+    ASSERT_EQ(4, key.hash_map.size());
+    ASSERT_EQ(agg_states[0], agg_states[4]);
+    ASSERT_EQ(agg_states[1], agg_states[5]);
+
+    Columns result_columns;
+    for (const auto& column : columns) {
+        result_columns.emplace_back(column->clone_empty());
+    }
+    key.results.assign(key.keys.begin(), key.keys.end());
+    key.insert_keys_to_columns(key.results, result_columns, num_rows);
+    for (size_t i = 0; i < columns.size(); i++) {
+        ASSERT_EQ(num_rows, result_columns[i]->size());
+        for (size_t j = 0; j < num_rows; j++) {
+            ASSERT_EQ(columns[i]->debug_item(j), result_columns[i]->debug_item(j));
+        }
+    }
+}
+
 class AggHashMapKeyNotFoundsTest : public ::testing::Test {
 public:
     template <typename HashMapWithKey>
@@ -0,0 +1,135 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/aggregator.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+class AggrAutoContextTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _old_adaptive = config::enable_streaming_agg_adaptive_reduction;
+        _old_cache_size = config::streaming_agg_ht_cache_size;
+        config::enable_streaming_agg_adaptive_reduction = true;
+        config::streaming_agg_ht_cache_size = kCacheSize;
+    }
+    void TearDown() override {
+        config::enable_streaming_agg_adaptive_reduction = _old_adaptive;
+        config::streaming_agg_ht_cache_size = _old_cache_size;
+    }
+
+protected:
+    static constexpr size_t kCacheSize = 1024 * 1024;
+    static constexpr size_t kChunkSize = 4096;
+
+    bool _old_adaptive = false;
+    int64_t _old_cache_size = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(AggrAutoContextTest, update_reduction) {
+    AggrAutoContext ctx;
+    ctx.update_reduction(0, 0);
+    ASSERT_LT(ctx.avg_reduction, 0);
+    ASSERT_FALSE(ctx.has_low_avg_reduction(0));
+
+    // the first sample is taken as is, and the later ones are weighted by ReductionDecay
+    ctx.update_reduction(kChunkSize, kChunkSize);
+    ASSERT_DOUBLE_EQ(ctx.avg_reduction, 1.0);
+    ctx.update_reduction(0, kChunkSize);
+    ASSERT_DOUBLE_EQ(ctx.avg_reduction, 1 - AggrAutoContext::ReductionDecay);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggrAutoContextTest, low_reduction_leaves_preagg) {
+    AggrAutoContext ctx;
+    for (int i = 0; i < 10; i++) {
+        ctx.update_reduction(kChunkSize / 10, kChunkSize);
+    }
+    ASSERT_TRUE(ctx.has_low_avg_reduction(0));
+
+    // only after StableLimit aggregated chunks
+    ctx.preagg_count = AggrAutoContext::StableLimit - 1;
+    ASSERT_FALSE(ctx.should_leave_preagg(0));
+    ctx.preagg_count = AggrAutoContext::StableLimit;
+    ASSERT_TRUE(ctx.should_leave_preagg(0));
+    ctx.selective_preagg_count = AggrAutoContext::StableLimit;
+    ASSERT_TRUE(ctx.should_leave_selective_preagg(0));
+
+    config::enable_streaming_agg_adaptive_reduction = false;
+    ASSERT_FALSE(ctx.should_leave_preagg(0));
+    ASSERT_FALSE(ctx.should_leave_selective_preagg(0));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggrAutoContextTest, high_reduction_leaves_selective_preagg) {
+    AggrAutoContext ctx;
+    ctx.selective_preagg_count = AggrAutoContext::StableLimit;
+    for (int i = 0; i < 10; i++) {
+        ctx.update_reduction(kChunkSize * 95 / 100, kChunkSize);
+    }
+    ASSERT_TRUE(ctx.has_high_avg_reduction());
+    ASSERT_FALSE(ctx.should_leave_preagg(0));
+    ASSERT_TRUE(ctx.should_leave_selective_preagg(0));
+    // a too large hash table doesn't aggregate everything
+    ASSERT_FALSE(ctx.should_leave_selective_preagg(AggrAutoContext::MaxHtSize));
+
+    // neither low nor high
+    AggrAutoContext medium;
+    medium.selective_preagg_count = AggrAutoContext::StableLimit;
+    medium.update_reduction(kChunkSize / 2, kChunkSize);
+    ASSERT_FALSE(medium.should_leave_selective_preagg(0));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggrAutoContextTest, cache_size_boundary) {
+    // 30% of the rows hit the existing groups, which is low only if the hash table is out of the cache
+    AggrAutoContext ctx;
+    const size_t agg_count = kChunkSize * 3 / 10;
+    ctx.update_reduction(agg_count, kChunkSize);
+    ASSERT_FALSE(ctx.has_low_avg_reduction(kCacheSize));
+    ASSERT_TRUE(ctx.has_low_avg_reduction(kCacheSize + 1));
+    ASSERT_FALSE(ctx.is_low_reduction(agg_count, kChunkSize, kCacheSize));
+    ASSERT_TRUE(ctx.is_low_reduction(agg_count, kChunkSize, kCacheSize + 1));
+
+    config::enable_streaming_agg_adaptive_reduction = false;
+    ASSERT_FALSE(ctx.is_low_reduction(agg_count, kChunkSize, kCacheSize + 1));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggrAutoContextTest, backpressure_leaves_pass_through) {
+    AggrAutoContext ctx;
+    ctx.continuous_limit = 100;
+    ctx.backpressure_count = AggrAutoContext::StableLimit;
+    ASSERT_FALSE(ctx.is_backpressured(0));
+    // a quarter of the chunks passed through before shifting back to aggregation
+    ctx.backpressure_count = 25;
+    ASSERT_TRUE(ctx.is_backpressured(0));
+    ASSERT_FALSE(ctx.is_backpressured(AggrAutoContext::MaxHtSize));
+
+    ctx.continuous_limit = 8;
+    ctx.backpressure_count = AggrAutoContext::StableLimit - 1;
+    ASSERT_FALSE(ctx.is_backpressured(0));
+    ctx.backpressure_count = AggrAutoContext::StableLimit;
+    ASSERT_TRUE(ctx.is_backpressured(0));
+
+    config::enable_streaming_agg_adaptive_reduction = false;
+    ASSERT_FALSE(ctx.is_backpressured(0));
+}
+
+} // namespace starrocks
@@ -331,4 +331,71 @@ TEST_F(ChunksSorterHeapSortTest, single_column_order_by_nullable_test) {
     }
 }
 
+TEST_F(ChunksSorterHeapSortTest, shared_topn_threshold_test) {
+    std::vector<bool> is_asc = {true};
+    std::vector<bool> null_first = {true};
+    constexpr int kChunkSize = 1000;
+    constexpr int kLimit = 10;
+
+    std::vector<TypeDescriptor*> type_descs = {_pool.add(new TypeDescriptor(TYPE_INT))};
+    std::vector<Datum> descending_values;
+    std::vector<Datum> shifted_values;
+    for (int i = 0; i < kChunkSize; ++i) {
+        descending_values.emplace_back(kChunkSize - 1 - i);
+        shifted_values.emplace_back(i + 5);
+    }
+    FakeChunks descending_chunks(&_pool, type_descs, {{descending_values, false, false}});
+    FakeChunks shifted_chunks(&_pool, type_descs, {{shifted_values, false, false}});
+
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(_pool.add(new ExprContext(descending_chunks.slot_refs()[0])));
+    ASSERT_OK(Expr::prepare(sort_exprs, _runtime_state.get()));
+    ASSERT_OK(Expr::open(sort_exprs, _runtime_state.get()));
+
+    auto threshold = std::make_shared<SharedTopnThreshold>(SortDescs(is_asc, null_first));
+
+    // the first sorter publishes its heap top once the heap is full
+    ChunksSorterHeapSort sorter(_runtime_state.get(), &sort_exprs, &is_asc, &null_first, "", 0, kLimit);
+    sorter.set_shared_topn_threshold(threshold);
+    sorter.setup_runtime(_runtime_state.get(), _pool.add(new RuntimeProfile("")),
+                         _pool.add(new MemTracker(1L << 62, "parent", nullptr)));
+    ASSERT_OK(sorter.update(nullptr, descending_chunks.next_chunk(kChunkSize)));
+    ASSERT_OK(sorter.done(nullptr));
+
+    int64_t version = 0;
+    Columns threshold_columns;
+    ASSERT_TRUE(threshold->get(&version, &threshold_columns));
+    ASSERT_EQ(1, threshold_columns.size());
+    ASSERT_EQ(1, threshold_columns[0]->size());
+    ASSERT_EQ(kLimit - 1, threshold_columns[0]->get(0).get_int32());
+
+    ChunkPtr chunk;
+    bool eos = false;
+    ASSERT_OK(sorter.get_next(&chunk, &eos));
+    ASSERT_EQ(kLimit, chunk->num_rows());
+    for (int i = 0; i < kLimit; ++i) {
+        ASSERT_EQ(i, chunk->get_column_by_slot_id(0)->get(i).get_int32());
+    }
+
+    // the other sorter only keeps the rows preceding the shared threshold, i.e. 5, 6, 7 and 8
+    auto* other_profile = _pool.add(new RuntimeProfile(""));
+    ChunksSorterHeapSort other_sorter(_runtime_state.get(), &sort_exprs, &is_asc, &null_first, "", 0, kLimit);
+    other_sorter.set_shared_topn_threshold(threshold);
+    other_sorter.setup_runtime(_runtime_state.get(), other_profile,
+                               _pool.add(new MemTracker(1L << 62, "parent", nullptr)));
+    ASSERT_OK(other_sorter.update(nullptr, shifted_chunks.next_chunk(kChunkSize)));
+    ASSERT_OK(other_sorter.done(nullptr));
+
+    auto* filter_rows = other_profile->get_counter("SharedTopnFilterRows");
+    ASSERT_NE(nullptr, filter_rows);
+    ASSERT_EQ(kChunkSize - 4, filter_rows->value());
+
+    ASSERT_OK(other_sorter.get_next(&chunk, &eos));
+    ASSERT_FALSE(eos);
+    ASSERT_EQ(4, chunk->num_rows());
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(i + 5, chunk->get_column_by_slot_id(0)->get(i).get_int32());
+    }
+}
+
 } // namespace starrocks
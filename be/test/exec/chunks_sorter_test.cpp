@@ -20,6 +20,7 @@
 
 #include <cstdio>
 #include <memory>
+#include <random>
 #include <string_view>
 
 #include "column/column_helper.h"
@@ -38,6 +39,7 @@
 #include "runtime/runtime_state.h"
 #include "runtime/types.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
 #include "util/json.h"
 
 namespace starrocks {
@@ -463,6 +465,48 @@ TEST_F(ChunksSorterTest, topn_sort_with_limit) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, topn_shared_threshold) {
+    const std::vector<int32_t> expected{2, 4, 6, 12, 16, 24, 41, 49, 52, 54, 55, 56, 58, 69, 70, 71};
+    std::vector<bool> is_asc{true};
+    std::vector<bool> is_null_first{true};
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+    ASSERT_OK(Expr::prepare(sort_exprs, _runtime_state.get()));
+    ASSERT_OK(Expr::open(sort_exprs, _runtime_state.get()));
+
+    for (size_t limit = 1; limit < expected.size(); limit++) {
+        auto threshold = std::make_shared<SharedTopnThreshold>(SortDescs(is_asc, is_null_first));
+
+        // the first sorter sees all the rows and publishes its boundary
+        ChunksSorterTopn sorter(_runtime_state.get(), &sort_exprs, &is_asc, &is_null_first, "", 0, limit);
+        sorter.set_shared_topn_threshold(threshold);
+        ASSERT_OK(sorter.update(_runtime_state.get(), ChunkPtr(_chunk_1->clone_unique().release())));
+        ASSERT_OK(sorter.update(_runtime_state.get(), ChunkPtr(_chunk_2->clone_unique().release())));
+        ASSERT_OK(sorter.update(_runtime_state.get(), ChunkPtr(_chunk_3->clone_unique().release())));
+        ASSERT_OK(sorter.done(_runtime_state.get()));
+        ChunkPtr page = consume_page_from_sorter(sorter);
+        ASSERT_EQ(limit, page->num_rows());
+        for (size_t i = 0; i < page->num_rows(); ++i) {
+            EXPECT_EQ(expected[i], page->get(i).get(0).get_int32());
+        }
+
+        // the other sorter only keeps the rows not succeeding the boundary of the first one
+        ChunksSorterTopn other_sorter(_runtime_state.get(), &sort_exprs, &is_asc, &is_null_first, "", 0, limit);
+        other_sorter.set_shared_topn_threshold(threshold);
+        ASSERT_OK(other_sorter.update(_runtime_state.get(), ChunkPtr(_chunk_3->clone_unique().release())));
+        ASSERT_OK(other_sorter.done(_runtime_state.get()));
+        ChunkPtr other_page = consume_page_from_sorter(other_sorter);
+        if (other_page != nullptr) {
+            for (size_t i = 0; i < other_page->num_rows(); ++i) {
+                EXPECT_LE(other_page->get(i).get(0).get_int32(), expected[limit - 1]);
+            }
+        }
+    }
+
+    clear_sort_exprs(sort_exprs);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ChunksSorterTest, rank_topn) {
     std::vector<bool> is_asc{true};
@@ -854,6 +898,107 @@ TEST_F(ChunksSorterTest, stable_sort) {
     ASSERT_EQ(expect, result);
 }
 
+TEST_F(ChunksSorterTest, radix_sort) {
+    constexpr int N = 5000;
+    std::mt19937 rand(0);
+    ColumnPtr col1 = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+    ColumnPtr col2 = ColumnHelper::create_column(TypeDescriptor(TYPE_DATETIME), false);
+    for (int i = 0; i < N; i++) {
+        if (i % 17 == 0) {
+            col1->append_nulls(1);
+        } else {
+            // a large range of values with negatives and duplicates
+            col1->append_datum(Datum(static_cast<int32_t>(rand() % 100000) - 50000));
+        }
+        col2->append_datum(Datum(TimestampValue::create(2000 + rand() % 30, 1 + rand() % 12, 1, 0, 0, rand() % 60)));
+    }
+
+    const bool enable_sort_radix = config::enable_sort_radix;
+    DeferOp defer([&]() { config::enable_sort_radix = enable_sort_radix; });
+    for (bool radix : {true, false}) {
+        config::enable_sort_radix = radix;
+        for (bool asc : {true, false}) {
+            for (bool null_first : {true, false}) {
+                SortDescs sort_desc(std::vector<bool>{asc, !asc}, std::vector<bool>{null_first, null_first});
+                Columns columns{col1, col2};
+                Permutation perm;
+                ASSERT_OK(sort_and_tie_columns(false, columns, sort_desc, &perm));
+                ASSERT_EQ(N, perm.size());
+
+                std::vector<uint32_t> indexes;
+                for (int i = 0; i < N; i++) {
+                    indexes.push_back(perm[i].index_in_chunk);
+                    if (i > 0) {
+                        ASSERT_LE(compare_chunk_row(sort_desc, columns, columns, perm[i - 1].index_in_chunk,
+                                                    perm[i].index_in_chunk),
+                                  0)
+                                << "row " << i;
+                    }
+                }
+                std::sort(indexes.begin(), indexes.end());
+                for (int i = 0; i < N; i++) {
+                    ASSERT_EQ(i, indexes[i]);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(ChunksSorterTest, normalized_key_sort) {
+    constexpr int N = 1000;
+    ColumnPtr col1 = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+    ColumnPtr col2 = ColumnHelper::create_column(TypeDescriptor(TYPE_BIGINT), true);
+    ColumnPtr col3 = ColumnHelper::create_column(TypeDescriptor::create_varchar_type(10), false);
+    std::vector<std::string> strings;
+    for (int i = 0; i < N; i++) {
+        strings.emplace_back(std::to_string(i % 7));
+    }
+    for (int i = 0; i < N; i++) {
+        // a few distinct values with negatives and nulls, so that all the columns are needed to break the ties
+        if (i % 11 == 0) {
+            col1->append_nulls(1);
+        } else {
+            col1->append_datum(Datum(static_cast<int32_t>(i % 5) - 2));
+        }
+        if (i % 13 == 0) {
+            col2->append_nulls(1);
+        } else {
+            col2->append_datum(Datum(static_cast<int64_t>(i % 3) * (i % 2 == 0 ? -1 : 1) * (1LL << 40)));
+        }
+        col3->append_datum(Datum(Slice(strings[i])));
+    }
+    Columns columns{col1, col2, col3};
+
+    for (bool asc : {true, false}) {
+        for (bool null_first : {true, false}) {
+            SortDescs sort_desc(std::vector<bool>{asc, !asc, asc}, std::vector<bool>{null_first, !null_first, false});
+
+            SmallPermutation normalized_perm = create_small_permutation(N);
+            bool sorted = false;
+            ASSERT_OK(sort_and_tie_columns_by_normalized_key(false, columns, sort_desc, &normalized_perm, &sorted));
+            ASSERT_TRUE(sorted);
+
+            Permutation perm;
+            ASSERT_OK(sort_and_tie_columns(false, columns, sort_desc, &perm));
+            ASSERT_EQ(N, perm.size());
+            for (int i = 0; i < N; i++) {
+                for (const auto& column : columns) {
+                    ASSERT_EQ(0, column->compare_at(normalized_perm[i].index_in_chunk, perm[i].index_in_chunk,
+                                                    *column, 1))
+                            << "row " << i;
+                }
+            }
+        }
+    }
+
+    // a single leading column isn't sorted by the normalized key
+    SortDescs sort_desc(std::vector<bool>{true, true}, std::vector<bool>{true, true});
+    SmallPermutation perm = create_small_permutation(N);
+    bool sorted = true;
+    ASSERT_OK(sort_and_tie_columns_by_normalized_key(false, Columns{col1, col3}, sort_desc, &perm, &sorted));
+    ASSERT_FALSE(sorted);
+}
+
 void pack_nullable(const ChunkPtr& chunk) {
     for (auto& col : chunk->columns()) {
         col = std::make_shared<NullableColumn>(col, std::make_shared<NullColumn>(col->size()));
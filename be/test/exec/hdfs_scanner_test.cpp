@@ -1366,6 +1366,114 @@ TEST_F(HdfsScannerTest, TestParquetRuntimeFilter) {
     }
 }
 
+// A runtime filter arriving in the middle of the scan prunes the row groups not read yet.
+TEST_F(HdfsScannerTest, TestParquetLateRuntimeFilter) {
+    SlotDesc parquet_descs[] = {{"c1", TypeDescriptor::from_logical_type(LogicalType::TYPE_BIGINT)},
+                                {"c2", TypeDescriptor::from_logical_type(LogicalType::TYPE_BIGINT)},
+                                {"c3", TypeDescriptor::from_logical_type(LogicalType::TYPE_VARCHAR, 22)},
+                                {""}};
+
+    const std::string parquet_file = "./be/test/exec/test_data/parquet_scanner/small_row_group_data.parquet";
+
+    auto* range = _create_scan_range(parquet_file, 0, 0);
+    auto* tuple_desc = _create_tuple_desc(parquet_descs);
+    auto* param = _create_param(parquet_file, range, tuple_desc);
+
+    auto scanner = std::make_shared<HdfsParquetScanner>();
+
+    RuntimeFilterProbeCollector rf_collector;
+    RuntimeFilterProbeDescriptor rf_probe_desc;
+    ColumnRef c1ref(tuple_desc->slots()[0]);
+    ExprContext probe_expr_ctx(&c1ref);
+    ASSERT_OK(probe_expr_ctx.prepare(_runtime_state));
+    ASSERT_OK(probe_expr_ctx.open(_runtime_state));
+
+    // the runtime filter has not arrived when the scan starts
+    rf_probe_desc.init(0, &probe_expr_ctx);
+    rf_collector.add_descriptor(&rf_probe_desc);
+    param->runtime_filter_collector = &rf_collector;
+
+    Status status = scanner->init(_runtime_state, *param);
+    ASSERT_TRUE(status.ok()) << status.get_error_msg();
+    status = scanner->open(_runtime_state);
+    ASSERT_TRUE(status.ok()) << status.get_error_msg();
+
+    ChunkPtr chunk = ChunkHelper::new_chunk(*tuple_desc, 0);
+    ASSERT_OK(scanner->get_next(_runtime_state, &chunk));
+    uint64_t records = chunk->num_rows();
+    ASSERT_GT(records, 0);
+
+    // c1 is in [0, 99999], so the filter drops all the row groups not read yet.
+    JoinRuntimeFilter* f = RuntimeFilterHelper::create_join_runtime_filter(&_pool, LogicalType::TYPE_BIGINT);
+    f->init(10);
+    ColumnPtr column = ColumnHelper::create_column(tuple_desc->slots()[0]->type(), false);
+    auto c = ColumnHelper::cast_to_raw<LogicalType::TYPE_BIGINT>(column);
+    c->append(-10);
+    RuntimeFilterHelper::fill_runtime_bloom_filter(column, LogicalType::TYPE_BIGINT, f, 0, false);
+    rf_probe_desc.set_runtime_filter(f);
+
+    READ_SCANNER_RETURN_ROWS(scanner, records);
+    EXPECT_LT(records, 100000);
+    EXPECT_LT(scanner->raw_rows_read(), 100000);
+
+    scanner->close(_runtime_state);
+    probe_expr_ctx.close(_runtime_state);
+}
+
+// A runtime filter arriving in the middle of the scan prunes the stripes not read yet.
+TEST_F(HdfsScannerTest, TestOrcLateRuntimeFilter) {
+    SlotDesc string_key_value_orc_desc[] = {{"key", TypeDescriptor::from_logical_type(LogicalType::TYPE_VARCHAR)},
+                                            {"value", TypeDescriptor::from_logical_type(LogicalType::TYPE_VARCHAR)},
+                                            {""}};
+    const std::string string_key_value_orc_file = "./be/test/exec/test_data/orc_scanner/string_key_value_10k.orc.zstd";
+
+    auto scanner = std::make_shared<HdfsOrcScanner>();
+
+    auto* range = _create_scan_range(string_key_value_orc_file, 0, 0);
+    auto* tuple_desc = _create_tuple_desc(string_key_value_orc_desc);
+    auto* param = _create_param(string_key_value_orc_file, range, tuple_desc);
+
+    RuntimeFilterProbeCollector rf_collector;
+    RuntimeFilterProbeDescriptor rf_probe_desc;
+    ColumnRef key_ref(tuple_desc->slots()[0]);
+    ExprContext probe_expr_ctx(&key_ref);
+    ASSERT_OK(probe_expr_ctx.prepare(_runtime_state));
+    ASSERT_OK(probe_expr_ctx.open(_runtime_state));
+
+    // the runtime filter has not arrived when the scan starts
+    rf_probe_desc.init(0, &probe_expr_ctx);
+    rf_collector.add_descriptor(&rf_probe_desc);
+    param->runtime_filter_collector = &rf_collector;
+
+    Status status = scanner->init(_runtime_state, *param);
+    ASSERT_TRUE(status.ok()) << status.get_error_msg();
+    scanner->disable_use_orc_sargs();
+    status = scanner->open(_runtime_state);
+    ASSERT_TRUE(status.ok()) << status.get_error_msg();
+
+    // the first chunk is read from stripe 0 with keys in [aaaaaaaaaa, ffffffffff]
+    ChunkPtr chunk = ChunkHelper::new_chunk(*tuple_desc, 0);
+    ASSERT_OK(scanner->get_next(_runtime_state, &chunk));
+    uint64_t records = chunk->num_rows();
+    ASSERT_GT(records, 0);
+
+    // stripe 1 with keys in [ffffffffff, jjjjjjjjjj] is dropped by the filter.
+    JoinRuntimeFilter* f = RuntimeFilterHelper::create_join_runtime_filter(&_pool, LogicalType::TYPE_VARCHAR);
+    f->init(10);
+    ColumnPtr column = ColumnHelper::create_column(tuple_desc->slots()[0]->type(), false);
+    std::string value = "bbbbbbbbbb";
+    column->append_datum(Datum(Slice(value)));
+    RuntimeFilterHelper::fill_runtime_bloom_filter(column, LogicalType::TYPE_VARCHAR, f, 0, false);
+    rf_probe_desc.set_runtime_filter(f);
+
+    READ_SCANNER_RETURN_ROWS(scanner, records);
+    EXPECT_LT(records, 10000);
+    EXPECT_LT(scanner->raw_rows_read(), 10000);
+
+    scanner->close(_runtime_state);
+    probe_expr_ctx.close(_runtime_state);
+}
+
 // =============================================================================
 
 /*
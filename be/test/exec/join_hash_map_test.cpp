@@ -16,9 +16,13 @@
 
 #include <gtest/gtest.h>
 
+#include <future>
+#include <thread>
+
 #include "runtime/descriptor_helper.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
+#include "testutil/assert.h"
 
 namespace starrocks {
 class JoinHashMapTest : public ::testing::Test {
@@ -73,8 +77,9 @@ protected:
     static void check_build_index(const Buffer<uint32_t>& first, const Buffer<uint32_t>& next, uint32_t row_count);
     static void check_build_index(const Buffer<uint8_t>& nulls, const Buffer<uint32_t>& first,
                                   const Buffer<uint32_t>& next, uint32_t row_count);
-    static void check_build_slice(const Buffer<Slice>& slices, uint32_t row_count);
-    static void check_build_slice(const Buffer<uint8_t>& nulls, const Buffer<Slice>& slices, uint32_t row_count);
+    static void check_build_slice(const Buffer<JoinHashedSlice>& slices, uint32_t row_count);
+    static void check_build_slice(const Buffer<uint8_t>& nulls, const Buffer<JoinHashedSlice>& slices,
+                                  uint32_t row_count);
     static void check_build_column(const ColumnPtr& build_column, uint32_t row_count);
     static void check_build_column(const Buffer<uint8_t>& nulls, const ColumnPtr& build_column, uint32_t row_count);
 
@@ -297,9 +302,9 @@ void JoinHashMapTest::check_probe_index(const Buffer<uint32_t>& probe_index, uin
     }
 }
 
-void JoinHashMapTest::check_build_slice(const Buffer<Slice>& slices, uint32_t row_count) {
+void JoinHashMapTest::check_build_slice(const Buffer<JoinHashedSlice>& slices, uint32_t row_count) {
     ASSERT_EQ(slices.size(), row_count + 1);
-    ASSERT_EQ(slices[0], Slice());
+    ASSERT_EQ(slices[0].slice(), Slice());
 
     for (size_t i = 0; i < row_count; i++) {
         Buffer<uint8_t> buffer(1024);
@@ -319,13 +324,14 @@ void JoinHashMapTest::check_build_slice(const Buffer<Slice>& slices, uint32_t ro
         offset += len;
 
         // check
-        ASSERT_EQ(slices[index + 1], Slice(buffer.data(), offset));
+        ASSERT_EQ(slices[index + 1].slice(), Slice(buffer.data(), offset));
     }
 }
 
-void JoinHashMapTest::check_build_slice(const Buffer<uint8_t>& nulls, const Buffer<Slice>& slices, uint32_t row_count) {
+void JoinHashMapTest::check_build_slice(const Buffer<uint8_t>& nulls, const Buffer<JoinHashedSlice>& slices,
+                                        uint32_t row_count) {
     ASSERT_EQ(slices.size(), row_count + 1);
-    ASSERT_EQ(slices[0], Slice());
+    ASSERT_EQ(slices[0].slice(), Slice());
 
     for (size_t i = 0; i < row_count; i++) {
         Buffer<uint8_t> buffer(1024);
@@ -346,7 +352,7 @@ void JoinHashMapTest::check_build_slice(const Buffer<uint8_t>& nulls, const Buff
             offset += len;
 
             // check
-            ASSERT_EQ(slices[index + 1], Slice(buffer.data(), offset));
+            ASSERT_EQ(slices[index + 1].slice(), Slice(buffer.data(), offset));
         }
     }
 }
@@ -844,6 +850,72 @@ TEST_F(JoinHashMapTest, JoinKeyHash) {
     ASSERT_EQ(v3, 2777932099l);
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, JoinHashedSlice) {
+    std::string short_key = "abcd";
+    std::string long_key1 = "https://www.starrocks.io/a";
+    std::string long_key2 = "https://www.starrocks.io/b";
+
+    JoinHashedSlice key1(Slice(short_key));
+    ASSERT_EQ(key1.hash, JoinKeyHash<Slice>()(Slice(short_key)));
+    ASSERT_EQ(key1.slice(), Slice(short_key));
+    ASSERT_EQ(JoinKeyHash<JoinHashedSlice>()(key1), key1.hash);
+
+    // same bytes but different sizes
+    std::string padded_key("abcd\0", 5);
+    ASSERT_EQ(key1.prefix, JoinHashedSlice(Slice(padded_key)).prefix);
+    ASSERT_FALSE(key1 == JoinHashedSlice(Slice(padded_key)));
+
+    // keys with the same prefix are compared by the remaining bytes
+    std::string long_key1_copy = long_key1;
+    ASSERT_TRUE(JoinHashedSlice(Slice(long_key1)) == JoinHashedSlice(Slice(long_key1_copy)));
+    ASSERT_FALSE(JoinHashedSlice(Slice(long_key1)) == JoinHashedSlice(Slice(long_key2)));
+    ASSERT_TRUE(JoinHashedSlice() == JoinHashedSlice(Slice()));
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, StringKeyJoinBuildProbeFunc) {
+    auto runtime_state = create_runtime_state();
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+    uint32_t build_row_count = 1000;
+    uint32_t probe_row_count = 10;
+
+    prepare_table_items(&table_items, build_row_count);
+    prepare_probe_state(&probe_state, probe_row_count);
+
+    auto build_column = BinaryColumn::create();
+    build_column->append_default();
+    for (uint32_t i = 0; i < build_row_count; i++) {
+        build_column->append("key_of_build_row_" + std::to_string(i));
+    }
+    table_items.key_columns.emplace_back(build_column);
+    auto probe_column = BinaryColumn::create();
+    for (uint32_t i = 0; i < probe_row_count; i++) {
+        // odd rows are not found
+        probe_column->append("key_of_build_row_" + std::to_string(i % 2 == 0 ? i * 50 : i + build_row_count));
+    }
+    Columns probe_columns{probe_column};
+    probe_state.key_columns = &probe_columns;
+
+    JoinBuildFunc<TYPE_VARCHAR>::prepare(runtime_state.get(), &table_items);
+    JoinProbeFunc<TYPE_VARCHAR>::prepare(runtime_state.get(), &probe_state);
+    JoinBuildFunc<TYPE_VARCHAR>::construct_hash_table(runtime_state.get(), &table_items, &probe_state);
+    JoinProbeFunc<TYPE_VARCHAR>::lookup_init(table_items, &probe_state);
+
+    const auto& build_data = JoinBuildFunc<TYPE_VARCHAR>::get_key_data(table_items);
+    const auto& probe_data = JoinProbeFunc<TYPE_VARCHAR>::get_key_data(probe_state);
+    for (uint32_t i = 0; i < probe_row_count; i++) {
+        uint32_t found_row = 0;
+        for (uint32_t row = probe_state.next[i]; row != 0; row = table_items.next[row]) {
+            if (JoinProbeFunc<TYPE_VARCHAR>::equal(build_data[row], probe_data[i])) {
+                found_row = row;
+            }
+        }
+        ASSERT_EQ(found_row, i % 2 == 0 ? i * 50 + 1 : 0);
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, CalcBucketNum) {
     uint32_t bucket_num = JoinHashMapHelper::calc_bucket_num(1, 4);
@@ -1297,6 +1369,103 @@ TEST_F(JoinHashMapTest, FixedSizeJoinBuildProbeFuncNullable) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, FixedSize256JoinBuildProbeFunc) {
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+    auto runtime_state = create_runtime_state();
+    runtime_state->init_instance_mem_tracker();
+
+    // five int keys take 20 bytes, which exceeds fixed128.
+    Columns probe_columns;
+    for (uint32_t k = 0; k < 5; k++) {
+        auto build_column = ColumnHelper::create_column(_int_type, false);
+        build_column->append_default();
+        build_column->append(*JoinHashMapTest::create_int32_column(10, k * 100), 0, 10);
+        table_items.key_columns.emplace_back(build_column);
+        table_items.join_keys.emplace_back(JoinKeyDesc{&_int_type, false, nullptr});
+        probe_columns.emplace_back(JoinHashMapTest::create_int32_column(10, k * 100));
+    }
+
+    table_items.row_count = 10;
+    probe_state.probe_row_count = 10;
+    probe_state.buckets.resize(config::vector_chunk_size);
+    probe_state.next.resize(config::vector_chunk_size, 0);
+    probe_state.key_columns = &probe_columns;
+
+    FixedSize256JoinBuildFunc::prepare(runtime_state.get(), &table_items);
+    FixedSize256JoinProbeFunc::prepare(runtime_state.get(), &probe_state);
+    FixedSize256JoinBuildFunc::construct_hash_table(runtime_state.get(), &table_items, &probe_state);
+    FixedSize256JoinProbeFunc::lookup_init(table_items, &probe_state);
+
+    const auto& build_data = FixedSize256JoinBuildFunc::get_key_data(table_items);
+    const auto& probe_data = FixedSize256JoinProbeFunc::get_key_data(probe_state);
+    for (size_t i = 0; i < 10; i++) {
+        size_t found_count = 0;
+        size_t probe_index = probe_state.next[i];
+        while (probe_index != 0) {
+            if (build_data[probe_index] == probe_data[i]) {
+                ASSERT_EQ(probe_index, i + 1);
+                found_count++;
+            }
+            probe_index = table_items.next[probe_index];
+        }
+        ASSERT_EQ(found_count, 1);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, FixedSize256JoinBuildProbeFuncNullSafeEqual) {
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+    auto runtime_state = create_runtime_state();
+    runtime_state->init_instance_mem_tracker();
+
+    // the first key is null safe equal, its null flag is packed into the null bitmap.
+    Columns probe_columns;
+    auto build_column = ColumnHelper::create_column(_int_type, true);
+    build_column->append_default();
+    build_column->append(*JoinHashMapTest::create_int32_nullable_column(10, 0), 0, 10);
+    table_items.key_columns.emplace_back(build_column);
+    table_items.join_keys.emplace_back(JoinKeyDesc{&_int_type, true, nullptr});
+    probe_columns.emplace_back(JoinHashMapTest::create_int32_nullable_column(10, 0));
+    for (uint32_t k = 1; k < 5; k++) {
+        build_column = ColumnHelper::create_column(_int_type, false);
+        build_column->append_default();
+        build_column->append(*JoinHashMapTest::create_int32_column(10, k * 100), 0, 10);
+        table_items.key_columns.emplace_back(build_column);
+        table_items.join_keys.emplace_back(JoinKeyDesc{&_int_type, false, nullptr});
+        probe_columns.emplace_back(JoinHashMapTest::create_int32_column(10, k * 100));
+    }
+
+    table_items.row_count = 10;
+    probe_state.probe_row_count = 10;
+    probe_state.buckets.resize(config::vector_chunk_size);
+    probe_state.next.resize(config::vector_chunk_size, 0);
+    probe_state.key_columns = &probe_columns;
+
+    FixedSize256JoinBuildFunc::prepare(runtime_state.get(), &table_items);
+    FixedSize256JoinProbeFunc::prepare(runtime_state.get(), &probe_state);
+    FixedSize256JoinBuildFunc::construct_hash_table(runtime_state.get(), &table_items, &probe_state);
+    FixedSize256JoinProbeFunc::lookup_init(table_items, &probe_state);
+
+    const auto& build_data = FixedSize256JoinBuildFunc::get_key_data(table_items);
+    const auto& probe_data = FixedSize256JoinProbeFunc::get_key_data(probe_state);
+    for (size_t i = 0; i < 10; i++) {
+        size_t found_count = 0;
+        size_t probe_index = probe_state.next[i];
+        while (probe_index != 0) {
+            if (build_data[probe_index] == probe_data[i]) {
+                ASSERT_EQ(probe_index, i + 1);
+                found_count++;
+            }
+            probe_index = table_items.next[probe_index];
+        }
+        // null equals to null for null safe equal key.
+        ASSERT_EQ(found_count, 1);
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFunc) {
     auto runtime_state = create_runtime_state();
@@ -1342,7 +1511,8 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFunc) {
         size_t probe_index = probe_state.next[i];
         auto data = table_items.build_slice;
         while (probe_index != 0) {
-            if (JoinHashMapHelper::get_hash_key(*probe_state.key_columns, i, buffer.data()) == data[probe_index]) {
+            auto probe_slice = JoinHashMapHelper::get_hash_key(*probe_state.key_columns, i, buffer.data());
+            if (probe_slice == data[probe_index].slice()) {
                 found_count++;
             }
             probe_index = table_items.next[probe_index];
@@ -1405,7 +1575,7 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFuncNullable) {
         auto data = table_items.build_slice;
         while (probe_index != 0) {
             auto probe_slice = JoinHashMapHelper::get_hash_key(probe_data_columns, i, buffer.data());
-            if (probe_slice == data[probe_index]) {
+            if (probe_slice == data[probe_index].slice()) {
                 found_count++;
             }
             probe_index = table_items.next[probe_index];
@@ -2227,6 +2397,220 @@ TEST_F(JoinHashMapTest, FixedSizeJoinBuildFuncForPartialNullableColumn) {
     check_build_column(nulls, table_items.build_key_column, build_row_count);
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, PartitionBuildRows) {
+    // the helpers of a stage are submitted by the thread which finishes the previous stage
+    std::mutex helpers_mutex;
+    std::vector<std::thread> helpers;
+    JoinBuildTaskSubmitter thread_submitter = [&helpers, &helpers_mutex](std::function<void()>&& task) {
+        std::lock_guard<std::mutex> l(helpers_mutex);
+        helpers.emplace_back(std::move(task));
+        return true;
+    };
+    // a helper may submit other helpers until it exits
+    auto join_helpers = [&helpers, &helpers_mutex]() {
+        while (true) {
+            std::vector<std::thread> threads;
+            {
+                std::lock_guard<std::mutex> l(helpers_mutex);
+                threads.swap(helpers);
+            }
+            if (threads.empty()) {
+                break;
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+    };
+
+    // serial build, and parallel build with 4 threads
+    for (int32_t parallelism : {1, 4}) {
+        JoinHashTableItems table_items;
+        HashTableProbeState probe_state;
+        uint32_t build_row_count = 9000;
+
+        prepare_table_items(&table_items, build_row_count);
+        prepare_probe_state(&probe_state, 10);
+        table_items.build_task_submitter = parallelism > 1 ? thread_submitter : nullptr;
+        table_items.build_parallelism = parallelism;
+
+        // one third of keys are null
+        auto nulls = create_bools(build_row_count, 3);
+        auto key_column = create_nullable_column(TYPE_INT);
+        key_column->append_datum(0);
+        key_column->append(*create_nullable_column(TYPE_INT, nulls, 0, build_row_count));
+        table_items.key_columns.emplace_back(key_column);
+        table_items.join_keys.emplace_back(JoinKeyDesc{&_int_type, false, nullptr});
+
+        table_items.build_chunk = std::make_shared<Chunk>();
+        table_items.build_chunk->append_column(key_column->clone_shared(), 0);
+
+        table_items.partitioned_build = true;
+        table_items.build_buckets.assign(build_row_count + 1, table_items.bucket_size);
+        JoinBuildFunc<TYPE_INT>::construct_hash_table(_runtime_state.get(), &table_items, &probe_state);
+        // rows are not linked before partitioning
+        ASSERT_EQ(std::count(table_items.first.begin(), table_items.first.end(), 0), table_items.bucket_size);
+
+        // 16 buckets per partition
+        auto old_buckets_per_partition = config::hash_join_partitioned_build_buckets_per_partition;
+        config::hash_join_partitioned_build_buckets_per_partition = 16;
+        std::promise<Status> build_status;
+        table_items.build_callback = [&build_status](const Status& status) { build_status.set_value(status); };
+        ASSERT_OK(table_items.partition_build_rows(true, nullptr));
+        if (table_items.build_pending) {
+            ASSERT_OK(build_status.get_future().get());
+        }
+        config::hash_join_partitioned_build_buckets_per_partition = old_buckets_per_partition;
+        join_helpers();
+        ASSERT_FALSE(table_items.build_runner->has_running_helpers());
+
+        ASSERT_EQ(table_items.partition_num, table_items.bucket_size / 16);
+        ASSERT_EQ(table_items.build_chunk->num_rows(), build_row_count + 1);
+        ASSERT_GT(table_items.used_buckets, 0);
+
+        // build chunk and key column are reordered in the same way
+        auto* build_column =
+                ColumnHelper::as_raw_column<NullableColumn>(table_items.build_chunk->get_column_by_slot_id(0));
+        auto* reordered_key_column = ColumnHelper::as_raw_column<NullableColumn>(table_items.key_columns[0]);
+        for (uint32_t i = 0; i <= build_row_count; i++) {
+            ASSERT_EQ(build_column->get(i).is_null(), reordered_key_column->get(i).is_null());
+            if (!build_column->is_null(i)) {
+                ASSERT_EQ(build_column->get(i).get_int32(), reordered_key_column->get(i).get_int32());
+            }
+        }
+
+        // rows of the same bucket are contiguous, and every not null key can be found
+        const auto& data = JoinBuildFunc<TYPE_INT>::get_key_data(table_items);
+        uint32_t linked_rows = 0;
+        for (uint32_t bucket = 0; bucket < table_items.bucket_size; bucket++) {
+            for (uint32_t row = table_items.first[bucket]; row != 0; row = table_items.next[row]) {
+                ASSERT_EQ(bucket, JoinHashMapHelper::calc_bucket_num<int32_t>(data[row], table_items.bucket_size));
+                ASSERT_TRUE(table_items.next[row] == 0 || table_items.next[row] == row + 1);
+                ASSERT_FALSE(reordered_key_column->is_null(row));
+                linked_rows++;
+            }
+        }
+        ASSERT_EQ(linked_rows, build_row_count - SIMD::count_nonzero(nulls));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, JoinBuildStageRunner) {
+    std::mutex helpers_mutex;
+    std::vector<std::thread> helpers;
+    JoinBuildTaskSubmitter thread_submitter = [&helpers, &helpers_mutex](std::function<void()>&& task) {
+        std::lock_guard<std::mutex> l(helpers_mutex);
+        helpers.emplace_back(std::move(task));
+        return true;
+    };
+    // a helper may submit other helpers until it exits
+    auto join_helpers = [&helpers, &helpers_mutex]() {
+        while (true) {
+            std::vector<std::thread> threads;
+            {
+                std::lock_guard<std::mutex> l(helpers_mutex);
+                threads.swap(helpers);
+            }
+            if (threads.empty()) {
+                break;
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+    };
+    auto run = [&](std::vector<JoinBuildStage> stages, JoinBuildCancelChecker cancel_checker = nullptr) {
+        auto runner = std::make_shared<JoinBuildStageRunner>(std::move(stages), thread_submitter, 4,
+                                                             std::move(cancel_checker));
+        std::promise<Status> callback_status;
+        Status status;
+        if (!runner->run([&callback_status](const Status& st) { callback_status.set_value(st); }, &status)) {
+            status = callback_status.get_future().get();
+        }
+        join_helpers();
+        EXPECT_FALSE(runner->has_running_helpers());
+        return status;
+    };
+
+    // a stage starts after all the tasks of the previous stage are finished
+    const size_t num_stages = 3;
+    const size_t num_tasks = 64;
+    std::atomic<size_t> finished_tasks[num_stages];
+    std::vector<size_t> finished_stages;
+    std::vector<JoinBuildStage> stages(num_stages);
+    for (size_t s = 0; s < num_stages; s++) {
+        finished_tasks[s] = 0;
+        stages[s].num_tasks = num_tasks;
+        stages[s].task = [&, s](size_t) {
+            ASSERT_EQ(finished_stages.size(), s);
+            finished_tasks[s]++;
+        };
+        stages[s].finish = [&, s]() {
+            ASSERT_EQ(finished_tasks[s], num_tasks);
+            finished_stages.push_back(s);
+        };
+    }
+    ASSERT_OK(run(std::move(stages)));
+    ASSERT_EQ(finished_stages.size(), num_stages);
+
+    // the stages after a failed one are skipped
+    std::atomic<size_t> skipped_tasks = 0;
+    stages.assign(2, JoinBuildStage{});
+    stages[0].num_tasks = num_tasks;
+    stages[0].task = [](size_t i) {
+        if (i == 1) {
+            throw std::bad_alloc();
+        }
+    };
+    stages[1].num_tasks = num_tasks;
+    stages[1].task = [&](size_t) { skipped_tasks++; };
+    ASSERT_TRUE(run(std::move(stages)).is_mem_limit_exceeded());
+    ASSERT_EQ(skipped_tasks, 0);
+
+    // the tasks left are skipped once the query is cancelled
+    std::atomic<bool> cancelled = false;
+    std::atomic<size_t> run_tasks = 0;
+    stages.assign(2, JoinBuildStage{});
+    stages[0].num_tasks = num_tasks;
+    stages[0].task = [&](size_t) {
+        run_tasks++;
+        cancelled = true;
+    };
+    stages[1].num_tasks = num_tasks;
+    stages[1].task = [&](size_t) { run_tasks++; };
+    ASSERT_TRUE(run(std::move(stages), [&cancelled]() { return cancelled.load(); }).is_cancelled());
+    ASSERT_LT(run_tasks, num_tasks);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, LookupFirstBuildRows) {
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+    uint32_t probe_row_count = config::vector_chunk_size;
+
+    prepare_table_items(&table_items, 1 << 20);
+    prepare_probe_state(&probe_state, probe_row_count);
+    for (uint32_t i = 0; i < table_items.bucket_size; i++) {
+        table_items.first[i] = i % 1000;
+    }
+    for (uint32_t i = 0; i < probe_row_count; i++) {
+        probe_state.buckets[i] = (i * 7919) & (table_items.bucket_size - 1);
+        probe_state.is_nulls[i] = i % 3 == 0;
+    }
+
+    // the result is the same whether prefetch or not
+    for (bool prefetch : {false, true}) {
+        table_items.probe_prefetch = prefetch;
+        JoinHashMapHelper::lookup_first_build_rows(table_items, &probe_state, probe_row_count,
+                                                   probe_state.is_nulls.data());
+        ASSERT_EQ(probe_state.prefetch_distance, prefetch ? config::join_probe_prefetch_distance : 0U);
+        for (uint32_t i = 0; i < probe_row_count; i++) {
+            ASSERT_EQ(probe_state.next[i], i % 3 == 0 ? 0U : table_items.first[probe_state.buckets[i]]);
+        }
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, SerializedJoinBuildFuncForNotNullableColumn) {
     JoinHashTableItems table_items;
@@ -0,0 +1,284 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/pipeline/aggregate/aggregate_partitioned_merge_source_operator.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <tuple>
+
+#include "column/chunk.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
+#include "testutil/assert.h"
+#include "testutil/column_test_helper.h"
+#include "testutil/exprs_test_helper.h"
+
+namespace starrocks::pipeline {
+
+// key -> (sum(v), count(v))
+using AggResult = std::map<int64_t, std::tuple<int64_t, int64_t>>;
+
+// select k, sum(v), count(v) from t group by k
+class AggregatePartitionedMergeTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+protected:
+    static constexpr TupleId kInputTupleId = 0;
+    static constexpr TupleId kAggTupleId = 1;
+    static constexpr SlotId kKeySlotId = 1;
+    static constexpr SlotId kValueSlotId = 2;
+    static constexpr SlotId kSumSlotId = 3;
+    static constexpr SlotId kCountSlotId = 4;
+
+    ChunkPtr _create_chunk(int64_t start, size_t num_rows, int64_t num_keys) const;
+
+    // Each driver aggregates the rows shuffled to it by the key, which is what happens without partitioned merge.
+    AggResult _run_with_local_shuffle(const std::vector<ChunkPtr>& chunks, int32_t dop);
+    // Each driver aggregates its own chunks, and the partial results are merged partition by partition.
+    AggResult _run_with_partitioned_merge(const std::vector<std::vector<ChunkPtr>>& driver_chunks, int32_t dop);
+
+    static void _collect_result(const ChunkPtr& chunk, AggResult* result);
+
+    RuntimeState* _runtime_state = nullptr;
+    ObjectPool _obj_pool;
+    TPlanNode _tnode;
+    int32_t _next_operator_id = 0;
+};
+
+void AggregatePartitionedMergeTest::SetUp() {
+    TQueryOptions query_options;
+    query_options.__set_batch_size(1024);
+    _runtime_state = _obj_pool.add(new RuntimeState(TUniqueId(), query_options, TQueryGlobals(), nullptr));
+
+    auto bigint_type = ExprsTestHelper::create_scalar_type_desc(TPrimitiveType::BIGINT);
+
+    // Like the plans of FE, the group by slot of the aggregation tuple shares the id of the input slot, so the
+    // group by exprs could be evaluated on both the input and the intermediate chunks.
+    std::vector<TSlotDescriptor> slot_descs;
+    slot_descs.emplace_back(ExprsTestHelper::create_slot_desc(bigint_type, kInputTupleId, kKeySlotId, "k"));
+    slot_descs.emplace_back(ExprsTestHelper::create_slot_desc(bigint_type, kInputTupleId, kValueSlotId, "v"));
+    slot_descs.emplace_back(ExprsTestHelper::create_slot_desc(bigint_type, kAggTupleId, kKeySlotId, "k"));
+    slot_descs.emplace_back(ExprsTestHelper::create_slot_desc(bigint_type, kAggTupleId, kSumSlotId, "sum"));
+    slot_descs.emplace_back(ExprsTestHelper::create_slot_desc(bigint_type, kAggTupleId, kCountSlotId, "count"));
+    auto t_desc_table = ExprsTestHelper::create_table_desc(
+            {ExprsTestHelper::create_tuple_desc(kInputTupleId), ExprsTestHelper::create_tuple_desc(kAggTupleId)},
+            slot_descs);
+    DescriptorTbl* desc_tbl = nullptr;
+    ASSERT_OK(DescriptorTbl::create(_runtime_state, &_obj_pool, t_desc_table, &desc_tbl, config::vector_chunk_size));
+    _runtime_state->set_desc_tbl(desc_tbl);
+
+    auto key_slot = ExprsTestHelper::create_slot_expr_node(kInputTupleId, kKeySlotId, bigint_type, false);
+    auto value_slot = ExprsTestHelper::create_slot_expr_node(kInputTupleId, kValueSlotId, bigint_type, false);
+
+    _tnode.node_id = 1;
+    _tnode.node_type = TPlanNodeType::AGGREGATION_NODE;
+    _tnode.limit = -1;
+    auto& agg_node = _tnode.agg_node;
+    agg_node.need_finalize = true;
+    agg_node.intermediate_tuple_id = kAggTupleId;
+    agg_node.output_tuple_id = kAggTupleId;
+    agg_node.streaming_preaggregation_mode = TStreamingPreaggregationMode::AUTO;
+    agg_node.grouping_exprs.emplace_back(ExprsTestHelper::create_slot_expr(key_slot));
+    for (const auto& name : {"sum", "count"}) {
+        auto fn = ExprsTestHelper::create_builtin_function(name, {bigint_type}, bigint_type, bigint_type);
+        agg_node.aggregate_functions.emplace_back(ExprsTestHelper::create_aggregate_expr(fn, {value_slot}));
+    }
+    for (SlotId slot_id : {kSumSlotId, kCountSlotId}) {
+        auto slot = ExprsTestHelper::create_slot_expr_node(kAggTupleId, slot_id, bigint_type, false);
+        agg_node.intermediate_aggr_exprs.emplace_back(ExprsTestHelper::create_slot_expr(slot));
+    }
+    agg_node.__isset.intermediate_aggr_exprs = true;
+}
+
+ChunkPtr AggregatePartitionedMergeTest::_create_chunk(int64_t start, size_t num_rows, int64_t num_keys) const {
+    std::vector<int64_t> keys(num_rows);
+    std::vector<int64_t> values(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        int64_t row = start + i;
+        keys[i] = (row * 7919) % num_keys;
+        values[i] = row;
+    }
+    auto chunk = std::make_shared<Chunk>();
+    chunk->append_column(ColumnTestHelper::build_column<int64_t>(keys), kKeySlotId);
+    chunk->append_column(ColumnTestHelper::build_column<int64_t>(values), kValueSlotId);
+    return chunk;
+}
+
+void AggregatePartitionedMergeTest::_collect_result(const ChunkPtr& chunk, AggResult* result) {
+    if (chunk == nullptr) {
+        return;
+    }
+    const auto& keys = chunk->get_column_by_slot_id(kKeySlotId);
+    const auto& sums = chunk->get_column_by_slot_id(kSumSlotId);
+    const auto& counts = chunk->get_column_by_slot_id(kCountSlotId);
+    for (size_t i = 0; i < chunk->num_rows(); i++) {
+        int64_t key = keys->get(i).get_int64();
+        bool inserted =
+                result->emplace(key, std::make_tuple(sums->get(i).get_int64(), counts->get(i).get_int64())).second;
+        // every group should be output by exactly one driver
+        ASSERT_TRUE(inserted) << "duplicated key " << key;
+    }
+}
+
+AggResult AggregatePartitionedMergeTest::_run_with_local_shuffle(const std::vector<ChunkPtr>& chunks, int32_t dop) {
+    auto aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+    AggregateBlockingSinkOperatorFactory sink_factory(++_next_operator_id, _tnode.node_id, aggregator_factory, nullptr);
+    AggregateBlockingSourceOperatorFactory source_factory(++_next_operator_id, _tnode.node_id, aggregator_factory);
+
+    std::vector<OperatorPtr> sinks;
+    std::vector<OperatorPtr> sources;
+    for (int32_t i = 0; i < dop; i++) {
+        sinks.emplace_back(sink_factory.create(dop, i));
+        sources.emplace_back(source_factory.create(dop, i));
+        CHECK_OK(sinks[i]->prepare(_runtime_state));
+        CHECK_OK(sources[i]->prepare(_runtime_state));
+    }
+
+    std::vector<uint32_t> selection;
+    for (const auto& chunk : chunks) {
+        const auto& keys = chunk->get_column_by_slot_id(kKeySlotId);
+        for (int32_t i = 0; i < dop; i++) {
+            selection.clear();
+            for (uint32_t row = 0; row < chunk->num_rows(); row++) {
+                if (keys->get(row).get_int64() % dop == i) {
+                    selection.push_back(row);
+                }
+            }
+            if (!selection.empty()) {
+                ChunkPtr shuffled = chunk->clone_empty_with_slot(selection.size());
+                shuffled->append_selective(*chunk, selection.data(), 0, selection.size());
+                CHECK_OK(sinks[i]->push_chunk(_runtime_state, shuffled));
+            }
+        }
+    }
+
+    AggResult result;
+    for (int32_t i = 0; i < dop; i++) {
+        CHECK_OK(sinks[i]->set_finishing(_runtime_state));
+        while (!sources[i]->is_finished()) {
+            auto chunk_or = sources[i]->pull_chunk(_runtime_state);
+            CHECK_OK(chunk_or.status());
+            _collect_result(chunk_or.value(), &result);
+        }
+    }
+    for (int32_t i = 0; i < dop; i++) {
+        sinks[i]->close(_runtime_state);
+        sources[i]->close(_runtime_state);
+    }
+    return result;
+}
+
+AggResult AggregatePartitionedMergeTest::_run_with_partitioned_merge(
+        const std::vector<std::vector<ChunkPtr>>& driver_chunks, int32_t dop) {
+    auto merge_context = std::make_shared<AggregatePartitionedMergeContext>(dop);
+    auto aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+    aggregator_factory->set_aggr_mode(AM_BLOCKING_PRE_CACHE);
+    auto merge_aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+    merge_aggregator_factory->set_aggr_mode(AM_BLOCKING_POST_CACHE);
+
+    AggregateBlockingSinkOperatorFactory sink_factory(++_next_operator_id, _tnode.node_id, aggregator_factory, nullptr);
+    sink_factory.set_partitioned_merge_context(merge_context);
+    AggregatePartitionedMergeSourceOperatorFactory source_factory(++_next_operator_id, _tnode.node_id,
+                                                                  merge_aggregator_factory, merge_context);
+
+    std::vector<OperatorPtr> sinks;
+    std::vector<OperatorPtr> sources;
+    for (int32_t i = 0; i < dop; i++) {
+        sinks.emplace_back(sink_factory.create(dop, i));
+        sources.emplace_back(source_factory.create(dop, i));
+        CHECK_OK(sinks[i]->prepare(_runtime_state));
+        CHECK_OK(sources[i]->prepare(_runtime_state));
+    }
+
+    for (int32_t i = 0; i < dop; i++) {
+        for (const auto& chunk : driver_chunks[i]) {
+            CHECK_OK(sinks[i]->push_chunk(_runtime_state, chunk));
+        }
+        CHECK_OK(sinks[i]->set_finishing(_runtime_state));
+        // the sources can't start merging until all the sinks have finished
+        EXPECT_EQ(i + 1 == dop, merge_context->is_sink_complete());
+        EXPECT_EQ(i + 1 == dop, sources[0]->has_output());
+    }
+
+    AggResult result;
+    for (int32_t i = 0; i < dop; i++) {
+        while (!sources[i]->is_finished()) {
+            auto chunk_or = sources[i]->pull_chunk(_runtime_state);
+            CHECK_OK(chunk_or.status());
+            _collect_result(chunk_or.value(), &result);
+        }
+    }
+    for (int32_t i = 0; i < dop; i++) {
+        sinks[i]->close(_runtime_state);
+        sources[i]->close(_runtime_state);
+    }
+    return result;
+}
+
+TEST_F(AggregatePartitionedMergeTest, test_same_result_as_local_shuffle) {
+    const int32_t dop = 4;
+    const size_t chunk_size = _runtime_state->chunk_size();
+    // more groups than chunk_size, so each partition of a driver holds several chunks
+    const int64_t num_keys = 5000;
+
+    std::vector<ChunkPtr> chunks;
+    std::vector<std::vector<ChunkPtr>> driver_chunks(dop);
+    AggResult expected;
+    int64_t start = 0;
+    for (size_t i = 0; i < 24; i++) {
+        auto chunk = _create_chunk(start, chunk_size, num_keys);
+        start += chunk_size;
+        chunks.emplace_back(chunk);
+        driver_chunks[i % dop].emplace_back(chunk);
+    }
+    for (int64_t row = 0; row < start; row++) {
+        auto& [sum, count] = expected[(row * 7919) % num_keys];
+        sum += row;
+        count++;
+    }
+
+    auto local_shuffle_result = _run_with_local_shuffle(chunks, dop);
+    auto partitioned_merge_result = _run_with_partitioned_merge(driver_chunks, dop);
+    ASSERT_EQ(num_keys, static_cast<int64_t>(partitioned_merge_result.size()));
+    ASSERT_EQ(expected, local_shuffle_result);
+    ASSERT_EQ(local_shuffle_result, partitioned_merge_result);
+}
+
+TEST_F(AggregatePartitionedMergeTest, test_skewed_input) {
+    const int32_t dop = 3;
+    const int64_t num_keys = 10;
+
+    // only the first driver has input, the other drivers output empty partitions.
+    std::vector<ChunkPtr> chunks{_create_chunk(0, 100, num_keys), _create_chunk(100, 100, num_keys)};
+    std::vector<std::vector<ChunkPtr>> driver_chunks(dop);
+    driver_chunks[0] = chunks;
+
+    auto local_shuffle_result = _run_with_local_shuffle(chunks, dop);
+    auto partitioned_merge_result = _run_with_partitioned_merge(driver_chunks, dop);
+    ASSERT_EQ(num_keys, static_cast<int64_t>(partitioned_merge_result.size()));
+    ASSERT_EQ(local_shuffle_result, partitioned_merge_result);
+}
+
+TEST_F(AggregatePartitionedMergeTest, test_empty_input) {
+    const int32_t dop = 2;
+    std::vector<std::vector<ChunkPtr>> driver_chunks(dop);
+
+    auto partitioned_merge_result = _run_with_partitioned_merge(driver_chunks, dop);
+    ASSERT_TRUE(partitioned_merge_result.empty());
+}
+
+} // namespace starrocks::pipeline
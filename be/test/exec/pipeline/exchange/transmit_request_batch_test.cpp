@@ -0,0 +1,116 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/pipeline/exchange/transmit_request_batch.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks::pipeline {
+
+class TransmitRequestBatchTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _max_bytes = config::max_transmit_batched_bytes;
+        _max_rows = config::max_transmit_batched_rows;
+        _max_delay_ms = config::max_transmit_batched_delay_ms;
+        config::max_transmit_batched_bytes = 1000;
+        config::max_transmit_batched_rows = 0;
+        config::max_transmit_batched_delay_ms = 0;
+    }
+
+    void TearDown() override {
+        config::max_transmit_batched_bytes = _max_bytes;
+        config::max_transmit_batched_rows = _max_rows;
+        config::max_transmit_batched_delay_ms = _max_delay_ms;
+    }
+
+private:
+    int64_t _max_bytes = 0;
+    int64_t _max_rows = 0;
+    int64_t _max_delay_ms = 0;
+};
+
+TEST_F(TransmitRequestBatchTest, bounded_by_bytes) {
+    TransmitRequestBatch batch;
+    batch.add(600, 10, 0);
+    ASSERT_FALSE(batch.is_full(0));
+    batch.add(600, 10, 0);
+    ASSERT_TRUE(batch.is_full(0));
+    ASSERT_EQ(1200, batch.bytes());
+    ASSERT_EQ(20, batch.rows());
+
+    batch.reset();
+    ASSERT_EQ(0, batch.bytes());
+    ASSERT_EQ(0, batch.rows());
+    ASSERT_FALSE(batch.is_full(0));
+}
+
+TEST_F(TransmitRequestBatchTest, grow_past_bytes_until_rows) {
+    config::max_transmit_batched_rows = 100;
+    TransmitRequestBatch batch;
+    // the request of wide rows keeps growing past the byte threshold
+    batch.add(1200, 10, 0);
+    ASSERT_FALSE(batch.is_full(0));
+    batch.add(1200, 10, 0);
+    ASSERT_FALSE(batch.is_full(0));
+    batch.add(600, 80, 0);
+    ASSERT_TRUE(batch.is_full(0));
+
+    // a request of narrow rows is sent at the byte threshold as before
+    batch.reset();
+    batch.add(1200, 200, 0);
+    ASSERT_TRUE(batch.is_full(0));
+
+    // the growth is bounded by bytes
+    batch.reset();
+    batch.add(1000 * TransmitRequestBatch::kMaxCoalescedBytesFactor, 10, 0);
+    ASSERT_FALSE(batch.is_full(0));
+    batch.add(1, 1, 0);
+    ASSERT_TRUE(batch.is_full(0));
+}
+
+TEST_F(TransmitRequestBatchTest, grow_past_bytes_until_delay) {
+    config::max_transmit_batched_rows = 100;
+    config::max_transmit_batched_delay_ms = 50;
+    TransmitRequestBatch batch;
+    batch.add(1200, 10, 100);
+    ASSERT_FALSE(batch.is_full(120));
+    ASSERT_TRUE(batch.is_full(150));
+}
+
+TEST_F(TransmitRequestBatchTest, stale_rows) {
+    TransmitRequestBatch batch;
+    ASSERT_FALSE(batch.is_stale(1000));
+    batch.add(10, 1, 100);
+    // no delay threshold, the rows are never stale
+    ASSERT_FALSE(batch.is_stale(100000));
+
+    config::max_transmit_batched_delay_ms = 50;
+    ASSERT_FALSE(batch.is_stale(149));
+    ASSERT_TRUE(batch.is_stale(150));
+    // the age is counted from the first rows of the request
+    batch.add(10, 1, 140);
+    ASSERT_EQ(100, batch.start_ms());
+    ASSERT_TRUE(batch.is_stale(150));
+    // stale rows below the byte threshold do not make the request full, they are sent by the stale flush
+    ASSERT_FALSE(batch.is_full(150));
+
+    batch.reset();
+    ASSERT_FALSE(batch.is_stale(1000));
+    batch.add(10, 1, 1000);
+    ASSERT_FALSE(batch.is_stale(1049));
+    ASSERT_TRUE(TransmitRequestBatch::is_stale_since(1000, 1050));
+}
+
+} // namespace starrocks::pipeline
@@ -22,6 +22,7 @@
 #include "column/fixed_length_column.h"
 #include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
+#include "exec/aggregate/columnar_agg_states.h"
 #include "exprs/agg/aggregate_factory.h"
 #include "exprs/agg/any_value.h"
 #include "exprs/agg/array_agg.h"
@@ -2513,4 +2514,71 @@ TEST_F(AggregateTest, test_array_agg_nullable_distinct) {
     ASSERT_EQ(26, offsets->get_data().back());
 }
 
+TEST_F(AggregateTest, test_columnar_agg_states) {
+    const AggregateFunction* sum = get_aggregate_function("sum", TYPE_BIGINT, TYPE_BIGINT, false);
+    const AggregateFunction* count = get_aggregate_function("count", TYPE_BIGINT, TYPE_BIGINT, false);
+    std::vector<const AggregateFunction*> functions{sum, count};
+
+    MemPool mem_pool;
+    ColumnarAggStates states;
+    states.init(functions, &mem_pool);
+
+    // more than one block of groups
+    const size_t num_groups = ColumnarAggStates::BLOCK_SIZE * 2 + 100;
+    for (size_t i = 0; i < num_groups; i++) {
+        uint32_t group_id = states.allocate();
+        ASSERT_EQ(i, group_id);
+        for (size_t j = 0; j < functions.size(); j++) {
+            functions[j]->create(ctx, states.state(j, group_id));
+        }
+    }
+    ASSERT_EQ(num_groups, states.num_groups());
+
+    // row i belongs to group i % num_groups
+    const size_t num_rows = num_groups * 3;
+    auto data = Int64Column::create();
+    std::vector<uint32_t> group_ids(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        data->append(i);
+        group_ids[i] = i % num_groups;
+    }
+    const Column* column = data.get();
+    Buffer<AggDataPtr> agg_states(num_rows);
+    for (size_t j = 0; j < functions.size(); j++) {
+        states.gather(j, group_ids.data(), num_rows, agg_states.data());
+        functions[j]->update_batch(ctx, num_rows, 0, &column, agg_states.data());
+    }
+
+    // the contiguous serialization is the same as the serialization of the gathered states
+    std::vector<uint32_t> output_group_ids;
+    for (uint32_t i = 0; i < num_groups; i++) {
+        // a gap breaks the consecutive groups
+        if (i != 10) {
+            output_group_ids.emplace_back(i);
+        }
+    }
+    for (size_t j = 0; j < functions.size(); j++) {
+        auto expected = Int64Column::create();
+        states.gather(j, output_group_ids.data(), output_group_ids.size(), agg_states.data());
+        functions[j]->batch_serialize(ctx, output_group_ids.size(), agg_states, 0, expected.get());
+
+        auto result = Int64Column::create();
+        states.serialize(functions[j], ctx, j, output_group_ids.data(), output_group_ids.size(), result.get());
+        ASSERT_EQ(output_group_ids.size(), result->size());
+        for (size_t i = 0; i < output_group_ids.size(); i++) {
+            ASSERT_EQ(expected->get_data()[i], result->get_data()[i]);
+        }
+    }
+
+    for (size_t i = 0; i < output_group_ids.size(); i++) {
+        int64_t group_id = output_group_ids[i];
+        ASSERT_EQ(group_id * 3 + num_groups * 3, *reinterpret_cast<int64_t*>(states.state(0, group_id)));
+        ASSERT_EQ(3, *reinterpret_cast<int64_t*>(states.state(1, group_id)));
+    }
+
+    // a rolled back group is allocated again
+    states.rollback();
+    ASSERT_EQ(num_groups - 1, states.allocate());
+}
+
 } // namespace starrocks
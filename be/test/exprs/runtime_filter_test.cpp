@@ -21,11 +21,17 @@
 #include <utility>
 
 #include "column/column_helper.h"
+#include "exprs/column_ref.h"
 #include "exprs/runtime_filter_bank.h"
+#include "runtime/runtime_state.h"
 #include "simd/simd.h"
+#include "testutil/assert.h"
+#include "util/runtime_profile.h"
 
 namespace starrocks {
 
+ColumnPtr CreateSeriesColumnInt32(int32_t num_rows, bool nullable);
+
 class RuntimeFilterTest : public ::testing::Test {
 public:
     void SetUp() override {}
@@ -183,6 +189,136 @@ TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterSlice) {
     }
 }
 
+TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterMinMaxOnly) {
+    // sparse keys keep the bloom filter.
+    RuntimeBloomFilter<TYPE_INT> sparse_bf;
+    sparse_bf.init(100);
+    for (int i = 0; i <= 200; i += 17) {
+        sparse_bf.insert(i);
+    }
+    sparse_bf.use_min_max_only_if_dense(12);
+    EXPECT_FALSE(sparse_bf.min_max_only());
+
+    // half of the values in [min, max] are missing, the bloom filter still drops the probe rows in the holes.
+    RuntimeBloomFilter<TYPE_INT> half_bf;
+    half_bf.init(500);
+    for (int i = 0; i < 1000; i += 2) {
+        half_bf.insert(i);
+    }
+    half_bf.use_min_max_only_if_dense(500);
+    EXPECT_FALSE(half_bf.min_max_only());
+
+    // a few values in [min, max] are missing, only min/max is kept.
+    RuntimeBloomFilter<TYPE_INT> almost_dense_bf;
+    almost_dense_bf.init(1000);
+    for (int i = 0; i < 1040; i++) {
+        if (i % 26 != 1) {
+            almost_dense_bf.insert(i);
+        }
+    }
+    almost_dense_bf.use_min_max_only_if_dense(1000);
+    EXPECT_TRUE(almost_dense_bf.min_max_only());
+
+    // dense keys only keep min/max.
+    RuntimeBloomFilter<TYPE_INT> bf;
+    JoinRuntimeFilter* rf = &bf;
+    bf.init(1000);
+    for (int i = 100; i < 1100; i++) {
+        bf.insert(i);
+    }
+    bf.use_min_max_only_if_dense(1000);
+    EXPECT_TRUE(rf->min_max_only());
+    EXPECT_EQ(bf.min_value(), 100);
+    EXPECT_EQ(bf.max_value(), 1099);
+
+    TypeDescriptor type_desc(TYPE_INT);
+    ColumnPtr column = ColumnHelper::create_column(type_desc, false);
+    auto* col = ColumnHelper::as_raw_column<RunTimeTypeTraits<TYPE_INT>::ColumnType>(column);
+    for (int i = 0; i < 2000; i++) {
+        col->append(i);
+    }
+    JoinRuntimeFilter::RunningContext ctx;
+    ctx.use_merged_selection = false;
+    rf->compute_hash({column.get()}, &ctx);
+    rf->evaluate(column.get(), &ctx);
+    EXPECT_EQ(SIMD::count_nonzero(ctx.selection), 1000);
+
+    // the full bloom filter is recognized after deserialization.
+    size_t max_size = RuntimeFilterHelper::max_runtime_filter_serialized_size(rf);
+    std::vector<uint8_t> buffer(max_size, 0);
+    size_t actual_size = RuntimeFilterHelper::serialize_runtime_filter(RF_VERSION_V2, rf, buffer.data());
+    JoinRuntimeFilter* rf1 = nullptr;
+    ObjectPool pool;
+    RuntimeFilterHelper::deserialize_runtime_filter(&pool, &rf1, buffer.data(), actual_size);
+    EXPECT_TRUE(rf1->check_equal(*rf));
+    EXPECT_TRUE(rf1->min_max_only());
+}
+
+TEST_F(RuntimeFilterTest, TestEstimateRuntimeBloomFilterNdv) {
+    TypeDescriptor type_desc(TYPE_INT);
+    ColumnPtr column = ColumnHelper::create_column(type_desc, true);
+    // the first row is skipped as the dummy row of hash table.
+    column->append_datum(Datum(int32_t(-1)));
+    for (int i = 0; i < 10000; i++) {
+        column->append_datum(Datum(int32_t(i % 1000)));
+        column->append_nulls(1);
+    }
+    size_t ndv = RuntimeFilterHelper::estimate_runtime_bloom_filter_ndv({column, column}, TYPE_INT, 1);
+    EXPECT_GE(ndv, 950);
+    EXPECT_LE(ndv, 1050);
+
+    ColumnPtr small_column = ColumnHelper::create_column(type_desc, false);
+    for (int i = 0; i < 10; i++) {
+        small_column->append_datum(Datum(int32_t(i % 3)));
+    }
+    EXPECT_EQ(RuntimeFilterHelper::estimate_runtime_bloom_filter_ndv({small_column}, TYPE_INT, 0), 3);
+}
+
+TEST_F(RuntimeFilterTest, TestProbeCollectorSkipUselessFilter) {
+    ObjectPool pool;
+    RuntimeState state;
+    RuntimeProfile profile("test");
+    const SlotId slot_id = 1;
+    const int num_rows = 4096;
+    const int num_chunks = 64;
+
+    // filter 1 passes all the rows, filter 2 only passes [0, 100).
+    std::vector<RuntimeBloomFilter<TYPE_INT>*> filters;
+    RuntimeFilterProbeCollector collector;
+    for (int32_t filter_id : {1, 2}) {
+        auto* filter = pool.add(new RuntimeBloomFilter<TYPE_INT>());
+        int max_value = filter_id == 1 ? num_rows : 100;
+        filter->init(max_value);
+        for (int i = 0; i < max_value; i++) {
+            filter->insert(i);
+        }
+        filters.emplace_back(filter);
+        auto* probe_expr = pool.add(new ColumnRef(TypeDescriptor(TYPE_INT), slot_id));
+        auto* desc = pool.add(new RuntimeFilterProbeDescriptor());
+        ASSERT_OK(desc->init(filter_id, pool.add(new ExprContext(probe_expr))));
+        collector.add_descriptor(desc);
+    }
+    ASSERT_OK(collector.prepare(&state, RowDescriptor(), &profile));
+    ASSERT_OK(collector.open(&state));
+    for (auto& [filter_id, desc] : collector.descriptors()) {
+        desc->set_runtime_filter(filters[filter_id - 1]);
+    }
+
+    for (int i = 0; i < num_chunks; i++) {
+        ColumnPtr column = CreateSeriesColumnInt32(num_rows, false);
+        Chunk chunk;
+        chunk.append_column(column, slot_id);
+        collector.evaluate(&chunk);
+        ASSERT_EQ(chunk.num_rows(), 100);
+    }
+    // filter 1 is useless in the first sampling round, and skipped in the second one.
+    ASSERT_EQ(profile.get_counter("JoinRuntimeFilter/1/InputRows")->value(), num_rows);
+    ASSERT_EQ(profile.get_counter("JoinRuntimeFilter/1/SkippedRows")->value(), (num_chunks - 1) * num_rows);
+    ASSERT_EQ(profile.get_counter("JoinRuntimeFilter/2/InputRows")->value(), num_chunks * num_rows);
+    ASSERT_EQ(profile.get_counter("JoinRuntimeFilter/2/SkippedRows")->value(), 0);
+    collector.close(&state);
+}
+
 TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterSerialize) {
     RuntimeBloomFilter<TYPE_INT> bf0;
     JoinRuntimeFilter* rf0 = &bf0;
@@ -18,10 +18,12 @@
 #include <filesystem>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
 #include "column/array_column.h"
+#include "column/binary_column.h"
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/column_visitor_adapter.h"
@@ -169,7 +171,7 @@ class SpillTest : public ::testing::Test {
 public:
     void SetUp() override {
         TUniqueId dummy_query_id = generate_uuid();
-        auto path = config::storage_root_path + "/spill_test_data/" + print_id(dummy_query_id);
+        path = config::storage_root_path + "/spill_test_data/" + print_id(dummy_query_id);
         auto fs = FileSystem::Default();
         ASSERT_OK(fs->create_dir_recursive(path));
         LOG(WARNING) << "TRACE:" << path;
@@ -184,6 +186,7 @@ public:
         metrics = SpillProcessMetrics(&dummy_profile, &spill_bytes);
     }
     void TearDown() override {}
+    std::string path;
     std::unique_ptr<spill::DirManager> dummy_dir_mgr;
     std::unique_ptr<spill::LogBlockManager> dummy_block_mgr;
     RuntimeState dummy_rt_st;
@@ -438,6 +441,471 @@ TEST_F(SpillTest, order_by_process) {
     }
 }
 
+static std::vector<int32_t> int_values(const ChunkPtr& chunk) {
+    const auto& data = down_cast<Int32Column*>(chunk->get_column_by_index(0).get())->get_data();
+    return {data.begin(), data.end()};
+}
+
+TEST_F(SpillTest, sorted_run_readers_process) {
+    ObjectPool pool;
+    TExprBuilder order_by_slots_builder;
+    order_by_slots_builder << TYPE_INT;
+    auto order_by_slots = order_by_slots_builder.get_res();
+    std::vector<bool> nullables = {false, false};
+    TExprBuilder tuple_slots_builder;
+    tuple_slots_builder << TYPE_INT << TYPE_SMALLINT;
+    auto tuple_slots = tuple_slots_builder.get_res();
+
+    auto ctx_st = no_partition_context(&pool, &dummy_rt_st, order_by_slots, tuple_slots);
+    ASSERT_OK(ctx_st.status());
+    auto ctx = ctx_st.value();
+    auto& tuple = ctx->sort_exprs.sort_tuple_slot_expr_ctxs();
+
+    RandomChunkBuilder chunk_builder;
+    auto factory = spill::make_spilled_factory();
+
+    SpilledOptions spill_options(&ctx->sort_exprs, &ctx->sort_descs);
+    spill_options.mem_table_pool_size = 2;
+    // a sorted run every about 10 chunks
+    spill_options.spill_mem_table_bytes_size = 256 * 1024;
+    spill_options.spill_type = spill::SpillFormaterType::SPILL_BY_COLUMN;
+    spill_options.block_manager = dummy_block_mgr.get();
+
+    // the runs are restored one by one if there are not too many, otherwise they are merged by the spiller
+    for (size_t max_runs : {64, 1}) {
+        auto spiller = factory->create(spill_options);
+        spiller->set_metrics(metrics);
+        SpillerCaller<spill::RawSpillerWriter*, spill::SpillerReader*> caller(spiller.get());
+        ASSERT_OK(spiller->prepare(&dummy_rt_st));
+        spiller->set_restore_by_sorted_runs(max_runs);
+
+        SyncExecutor executor;
+        std::vector<int32_t> input;
+        for (size_t i = 0; i < 64; ++i) {
+            auto chunk = chunk_builder.gen(tuple, nullables);
+            auto values = int_values(chunk);
+            input.insert(input.end(), values.begin(), values.end());
+            ASSERT_OK(caller.spill(&dummy_rt_st, chunk, executor, EmptyMemGuard{}));
+            ASSERT_OK(spiller->_spilled_task_status);
+        }
+        ASSERT_OK(caller.flush(&dummy_rt_st, executor, EmptyMemGuard{}));
+        bool flushed = false;
+        ASSERT_OK(spiller->set_flush_all_call_back(
+                [&flushed]() {
+                    flushed = true;
+                    return Status::OK();
+                },
+                &dummy_rt_st, executor, EmptyMemGuard{}));
+        ASSERT_TRUE(flushed);
+        ASSERT_GT(spiller->num_sorted_runs(), 1);
+        std::sort(input.begin(), input.end());
+
+        std::vector<int32_t> output;
+        if (max_runs == 1) {
+            // the ordered stream is restored by the flush-all callback
+            ASSERT_FALSE(spiller->restore_by_sorted_runs());
+            while (true) {
+                auto chunk_st = caller.restore(&dummy_rt_st, executor, EmptyMemGuard{});
+                if (chunk_st.status().is_end_of_file()) {
+                    break;
+                }
+                ASSERT_OK(chunk_st.status());
+                if (chunk_st.value() != nullptr) {
+                    auto values = int_values(chunk_st.value());
+                    output.insert(output.end(), values.begin(), values.end());
+                }
+            }
+        } else {
+            ASSERT_TRUE(spiller->restore_by_sorted_runs());
+            auto readers_st = spiller->get_sorted_run_readers();
+            ASSERT_OK(readers_st.status());
+            ASSERT_EQ(readers_st.value().size(), spiller->num_sorted_runs());
+            for (auto& reader : readers_st.value()) {
+                ASSERT_OK(reader->trigger_restore(&dummy_rt_st, executor, EmptyMemGuard{}));
+                std::vector<int32_t> run;
+                while (true) {
+                    auto chunk_st = reader->restore(&dummy_rt_st, executor, EmptyMemGuard{});
+                    if (chunk_st.status().is_end_of_file()) {
+                        break;
+                    }
+                    ASSERT_OK(chunk_st.status());
+                    if (chunk_st.value() != nullptr) {
+                        auto values = int_values(chunk_st.value());
+                        run.insert(run.end(), values.begin(), values.end());
+                    }
+                }
+                // every run is sorted, and merging the runs gets all the rows in order
+                ASSERT_TRUE(std::is_sorted(run.begin(), run.end()));
+                std::vector<int32_t> merged;
+                std::merge(output.begin(), output.end(), run.begin(), run.end(), std::back_inserter(merged));
+                output = std::move(merged);
+            }
+        }
+        ASSERT_OK(spiller->task_status());
+        ASSERT_EQ(input, output);
+    }
+}
+
+TEST_F(SpillTest, sorted_run_readers_io_error) {
+    ObjectPool pool;
+    TExprBuilder order_by_slots_builder;
+    order_by_slots_builder << TYPE_INT;
+    auto order_by_slots = order_by_slots_builder.get_res();
+    std::vector<bool> nullables = {false, false};
+    TExprBuilder tuple_slots_builder;
+    tuple_slots_builder << TYPE_INT << TYPE_SMALLINT;
+    auto tuple_slots = tuple_slots_builder.get_res();
+
+    auto ctx_st = no_partition_context(&pool, &dummy_rt_st, order_by_slots, tuple_slots);
+    ASSERT_OK(ctx_st.status());
+    auto ctx = ctx_st.value();
+    auto& tuple = ctx->sort_exprs.sort_tuple_slot_expr_ctxs();
+
+    RandomChunkBuilder chunk_builder;
+    auto factory = spill::make_spilled_factory();
+
+    SpilledOptions spill_options(&ctx->sort_exprs, &ctx->sort_descs);
+    spill_options.mem_table_pool_size = 2;
+    spill_options.spill_mem_table_bytes_size = 256 * 1024;
+    spill_options.spill_type = spill::SpillFormaterType::SPILL_BY_COLUMN;
+    spill_options.block_manager = dummy_block_mgr.get();
+
+    auto spiller = factory->create(spill_options);
+    spiller->set_metrics(metrics);
+    SpillerCaller<spill::RawSpillerWriter*, spill::SpillerReader*> caller(spiller.get());
+    ASSERT_OK(spiller->prepare(&dummy_rt_st));
+    spiller->set_restore_by_sorted_runs(64);
+
+    SyncExecutor executor;
+    for (size_t i = 0; i < 32; ++i) {
+        ASSERT_OK(caller.spill(&dummy_rt_st, chunk_builder.gen(tuple, nullables), executor, EmptyMemGuard{}));
+    }
+    ASSERT_OK(caller.flush(&dummy_rt_st, executor, EmptyMemGuard{}));
+    ASSERT_OK(spiller->set_flush_all_call_back([]() { return Status::OK(); }, &dummy_rt_st, executor,
+                                               EmptyMemGuard{}));
+    ASSERT_TRUE(spiller->restore_by_sorted_runs());
+
+    // the spilled files are lost, and the failed restore task is reported by the spiller
+    ASSERT_OK(FileSystem::Default()->delete_dir_recursive(path));
+    auto readers_st = spiller->get_sorted_run_readers();
+    ASSERT_OK(readers_st.status());
+    ASSERT_FALSE(readers_st.value().empty());
+    ASSERT_OK(readers_st.value()[0]->trigger_restore(&dummy_rt_st, executor, EmptyMemGuard{}));
+    ASSERT_FALSE(spiller->task_status().ok());
+}
+
+TEST_F(SpillTest, read_ahead_budget) {
+    DeferOp defer([old = config::spill_read_ahead_chunks]() { config::spill_read_ahead_chunks = old; });
+    config::spill_read_ahead_chunks = 4;
+
+    spill::ReadAheadBudget budget;
+    budget.add_stream();
+    // limited by the number of chunks only
+    ASSERT_FALSE(budget.is_full(3, 1L << 30));
+    ASSERT_TRUE(budget.is_full(4, 0));
+
+    // limited by the memory budget too, but at least one chunk is buffered
+    budget.set_max_bytes(1000);
+    ASSERT_EQ(1000, budget.stream_max_bytes());
+    ASSERT_FALSE(budget.is_full(0, 0));
+    ASSERT_FALSE(budget.is_full(1, 999));
+    ASSERT_TRUE(budget.is_full(1, 1000));
+    ASSERT_TRUE(budget.is_full(4, 10));
+
+    // the memory budget is divided among the streams
+    budget.add_stream();
+    budget.add_stream();
+    budget.add_stream();
+    ASSERT_EQ(250, budget.stream_max_bytes());
+    ASSERT_FALSE(budget.is_full(0, 0));
+    ASSERT_FALSE(budget.is_full(1, 249));
+    ASSERT_TRUE(budget.is_full(1, 250));
+
+    budget.remove_stream();
+    budget.remove_stream();
+    ASSERT_EQ(500, budget.stream_max_bytes());
+    ASSERT_FALSE(budget.is_full(1, 250));
+}
+
+TEST_F(SpillTest, read_ahead_chunks) {
+    DeferOp defer([old = config::spill_read_ahead_chunks]() { config::spill_read_ahead_chunks = old; });
+
+    ObjectPool pool;
+    TExprBuilder order_by_slots_builder;
+    order_by_slots_builder << TYPE_INT;
+    auto order_by_slots = order_by_slots_builder.get_res();
+    std::vector<bool> nullables = {false, false};
+    TExprBuilder tuple_slots_builder;
+    tuple_slots_builder << TYPE_INT << TYPE_SMALLINT;
+    auto tuple_slots = tuple_slots_builder.get_res();
+
+    auto ctx_st = no_partition_context(&pool, &dummy_rt_st, order_by_slots, tuple_slots);
+    ASSERT_OK(ctx_st.status());
+    auto ctx = ctx_st.value();
+    auto& tuple = ctx->sort_exprs.sort_tuple_slot_expr_ctxs();
+
+    RandomChunkBuilder chunk_builder;
+    auto factory = spill::make_spilled_factory();
+
+    SpilledOptions spill_options;
+    spill_options.mem_table_pool_size = 2;
+    spill_options.spill_mem_table_bytes_size = 1 * 1024 * 1024;
+    spill_options.spill_type = spill::SpillFormaterType::SPILL_BY_COLUMN;
+    spill_options.block_manager = dummy_block_mgr.get();
+
+    auto spiller = factory->create(spill_options);
+    spiller->set_metrics(metrics);
+    SpillerCaller<spill::RawSpillerWriter*, spill::SpillerReader*> caller(spiller.get());
+    ASSERT_OK(spiller->prepare(&dummy_rt_st));
+
+    for (size_t i = 0; i < 64; ++i) {
+        ASSERT_OK(caller.spill(&dummy_rt_st, chunk_builder.gen(tuple, nullables), SyncExecutor{}, EmptyMemGuard{}));
+    }
+    ASSERT_OK(caller.flush(&dummy_rt_st, SyncExecutor{}, EmptyMemGuard{}));
+    ASSERT_OK(spiller->_spilled_task_status);
+
+    auto& block_group = spiller->writer()->as<spill::RawSpillerWriter*>()->block_group();
+    auto new_stream = [&]() {
+        auto stream_st = block_group.as_unordered_stream(spiller->serde(), spiller.get());
+        CHECK_OK(stream_st.status());
+        return stream_st.value();
+    };
+    // run a restore task, and take the chunks it read ahead
+    auto prefetch = [](const spill::InputStreamPtr& stream) {
+        spill::SerdeContext ctx;
+        CHECK_OK(stream->prefetch(ctx));
+        std::vector<size_t> chunk_bytes;
+        while (stream->is_ready() && !stream->eof()) {
+            auto chunk_st = stream->get_next(ctx);
+            CHECK_OK(chunk_st.status());
+            chunk_bytes.push_back(chunk_st.value()->memory_usage());
+        }
+        return chunk_bytes;
+    };
+    // the restore task stops right after the buffered chunks reach the memory budget of the stream
+    auto check_budget = [](const std::vector<size_t>& chunk_bytes, size_t max_bytes) {
+        ASSERT_FALSE(chunk_bytes.empty());
+        size_t total_bytes = std::accumulate(chunk_bytes.begin(), chunk_bytes.end(), size_t(0));
+        ASSERT_GE(total_bytes, max_bytes);
+        ASSERT_LT(total_bytes - chunk_bytes.back(), max_bytes);
+    };
+    const auto& budget = spiller->read_ahead_budget();
+
+    // limited by the number of chunks
+    config::spill_read_ahead_chunks = 4;
+    budget->set_max_bytes(0);
+    size_t chunk_bytes = 0;
+    {
+        auto stream = new_stream();
+        ASSERT_EQ(1, budget->num_streams());
+        auto read_ahead = prefetch(stream);
+        ASSERT_EQ(4, read_ahead.size());
+        chunk_bytes = read_ahead[0];
+    }
+    // the stream gives its share back when it's destroyed
+    ASSERT_EQ(0, budget->num_streams());
+
+    // limited by the memory budget
+    config::spill_read_ahead_chunks = 16;
+    budget->set_max_bytes(chunk_bytes * 3);
+    size_t one_stream_chunks = 0;
+    {
+        auto stream = new_stream();
+        auto read_ahead = prefetch(stream);
+        check_budget(read_ahead, chunk_bytes * 3);
+        ASSERT_LT(read_ahead.size(), 16);
+        one_stream_chunks = read_ahead.size();
+    }
+
+    // the memory budget is divided among the streams being read
+    {
+        auto stream1 = new_stream();
+        auto stream2 = new_stream();
+        ASSERT_EQ(2, budget->num_streams());
+        auto read_ahead1 = prefetch(stream1);
+        auto read_ahead2 = prefetch(stream2);
+        check_budget(read_ahead1, budget->stream_max_bytes());
+        check_budget(read_ahead2, budget->stream_max_bytes());
+        ASSERT_LT(read_ahead1.size(), one_stream_chunks);
+    }
+
+    // at least one chunk is read ahead even if it exceeds the budget
+    budget->set_max_bytes(1);
+    {
+        auto stream = new_stream();
+        ASSERT_EQ(1, prefetch(stream).size());
+    }
+
+    // a stream reaching EOF gives its share back even if it's still referenced
+    budget->set_max_bytes(0);
+    {
+        auto stream = new_stream();
+        spill::SerdeContext ctx;
+        while (!stream->eof()) {
+            ASSERT_OK(stream->prefetch(ctx));
+            while (stream->is_ready() && !stream->eof()) {
+                ASSERT_OK(stream->get_next(ctx).status());
+            }
+        }
+        ASSERT_EQ(0, budget->num_streams());
+    }
+}
+
+TEST_F(SpillTest, compressed_unsorted_process) {
+    ObjectPool pool;
+
+    TExprBuilder order_by_slots_builder;
+    order_by_slots_builder << TYPE_INT;
+    auto order_by_slots = order_by_slots_builder.get_res();
+    std::vector<bool> nullables = {false, true};
+    TExprBuilder tuple_slots_builder;
+    tuple_slots_builder << TYPE_INT << TYPE_BIGINT;
+    auto tuple_slots = tuple_slots_builder.get_res();
+
+    auto ctx_st = no_partition_context(&pool, &dummy_rt_st, order_by_slots, tuple_slots);
+    ASSERT_OK(ctx_st.status());
+    auto ctx = ctx_st.value();
+    auto& tuple = ctx->sort_exprs.sort_tuple_slot_expr_ctxs();
+
+    RandomChunkBuilder chunk_builder;
+    auto factory = spill::make_spilled_factory();
+
+    for (auto compress_type : {CompressionTypePB::LZ4, CompressionTypePB::ZSTD}) {
+        for (int encode_level : {0, 7}) {
+            SpilledOptions spill_options;
+            spill_options.mem_table_pool_size = 2;
+            spill_options.spill_mem_table_bytes_size = 1 * 1024 * 1024;
+            spill_options.spill_type = spill::SpillFormaterType::SPILL_BY_COLUMN;
+            spill_options.block_manager = dummy_block_mgr.get();
+            spill_options.compress_type = compress_type;
+            spill_options.encode_level = encode_level;
+
+            auto spiller = factory->create(spill_options);
+            spiller->set_metrics(metrics);
+            SpillerCaller<spill::RawSpillerWriter*, spill::SpillerReader*> caller(spiller.get());
+            ASSERT_OK(spiller->prepare(&dummy_rt_st));
+
+            // the first half chunks are well compressible, the others are random
+            size_t test_loop = 64;
+            int64_t input_sum = 0;
+            size_t input_rows = 0;
+            for (size_t i = 0; i < test_loop; ++i) {
+                auto chunk = chunk_builder.gen(tuple, nullables);
+                auto& data = down_cast<Int32Column*>(chunk->get_column_by_index(0).get())->get_data();
+                if (i < test_loop / 2) {
+                    for (size_t j = 0; j < data.size(); ++j) {
+                        data[j] = j % 16;
+                    }
+                }
+                input_sum = std::accumulate(data.begin(), data.end(), input_sum);
+                input_rows += chunk->num_rows();
+                ASSERT_OK(caller.spill(&dummy_rt_st, chunk, SyncExecutor{}, EmptyMemGuard{}));
+                ASSERT_OK(spiller->_spilled_task_status);
+            }
+            ASSERT_OK(caller.flush(&dummy_rt_st, SyncExecutor{}, EmptyMemGuard{}));
+
+            int64_t output_sum = 0;
+            size_t output_rows = 0;
+            ASSERT_OK(caller.trigger_restore(&dummy_rt_st, SyncExecutor{}, EmptyMemGuard{}));
+            while (true) {
+                auto chunk_st = caller.restore(&dummy_rt_st, SyncExecutor{}, EmptyMemGuard{});
+                if (chunk_st.status().is_end_of_file()) {
+                    break;
+                }
+                ASSERT_OK(chunk_st.status());
+                ASSERT_OK(spiller->_spilled_task_status);
+                if (chunk_st.value() != nullptr) {
+                    const auto& data =
+                            down_cast<Int32Column*>(chunk_st.value()->get_column_by_index(0).get())->get_data();
+                    output_sum = std::accumulate(data.begin(), data.end(), output_sum);
+                    output_rows += chunk_st.value()->num_rows();
+                }
+            }
+            ASSERT_EQ(input_rows, output_rows);
+            ASSERT_EQ(input_sum, output_sum);
+        }
+    }
+}
+
+TEST_F(SpillTest, encoded_unsorted_process) {
+    ObjectPool pool;
+
+    TExprBuilder order_by_slots_builder;
+    order_by_slots_builder << TYPE_INT;
+    auto order_by_slots = order_by_slots_builder.get_res();
+    std::vector<bool> nullables = {false, true, true};
+    TExprBuilder tuple_slots_builder;
+    tuple_slots_builder << TYPE_INT << TYPE_BIGINT << TYPE_VARCHAR;
+    auto tuple_slots = tuple_slots_builder.get_res();
+
+    auto ctx_st = no_partition_context(&pool, &dummy_rt_st, order_by_slots, tuple_slots);
+    ASSERT_OK(ctx_st.status());
+    auto ctx = ctx_st.value();
+    auto& tuple = ctx->sort_exprs.sort_tuple_slot_expr_ctxs();
+
+    RandomChunkBuilder chunk_builder;
+    auto factory = spill::make_spilled_factory();
+
+    for (auto compress_type : {CompressionTypePB::NO_COMPRESSION, CompressionTypePB::LZ4}) {
+        SpilledOptions spill_options;
+        spill_options.mem_table_pool_size = 2;
+        spill_options.spill_mem_table_bytes_size = 1 * 1024 * 1024;
+        spill_options.spill_type = spill::SpillFormaterType::SPILL_BY_COLUMN;
+        spill_options.block_manager = dummy_block_mgr.get();
+        spill_options.compress_type = compress_type;
+        spill_options.serde_type = spill::SerdeType::ENCODED_BY_COLUMN;
+
+        auto spiller = factory->create(spill_options);
+        spiller->set_metrics(metrics);
+        SpillerCaller<spill::RawSpillerWriter*, spill::SpillerReader*> caller(spiller.get());
+        ASSERT_OK(spiller->prepare(&dummy_rt_st));
+
+        // the first half chunks have narrow integers and low cardinality strings, the others are random
+        size_t test_loop = 16;
+        std::vector<std::string> input_rows;
+        for (size_t i = 0; i < test_loop; ++i) {
+            auto chunk = chunk_builder.gen(tuple, nullables);
+            auto& data = down_cast<Int32Column*>(chunk->get_column_by_index(0).get())->get_data();
+            auto* strings = down_cast<BinaryColumn*>(
+                    down_cast<NullableColumn*>(chunk->get_column_by_index(2).get())->mutable_data_column());
+            strings->reset_column();
+            for (size_t j = 0; j < data.size(); ++j) {
+                if (i < test_loop / 2) {
+                    data[j] = j % 16;
+                    strings->append_string("value_" + std::to_string(j % 8));
+                } else {
+                    strings->append_string("value_" + std::to_string(rand()));
+                }
+            }
+            for (size_t j = 0; j < chunk->num_rows(); ++j) {
+                input_rows.emplace_back(chunk->debug_row(j));
+            }
+            ASSERT_OK(caller.spill(&dummy_rt_st, chunk, SyncExecutor{}, EmptyMemGuard{}));
+            ASSERT_OK(spiller->_spilled_task_status);
+        }
+        ASSERT_OK(caller.flush(&dummy_rt_st, SyncExecutor{}, EmptyMemGuard{}));
+
+        std::vector<std::string> output_rows;
+        ASSERT_OK(caller.trigger_restore(&dummy_rt_st, SyncExecutor{}, EmptyMemGuard{}));
+        while (true) {
+            auto chunk_st = caller.restore(&dummy_rt_st, SyncExecutor{}, EmptyMemGuard{});
+            if (chunk_st.status().is_end_of_file()) {
+                break;
+            }
+            ASSERT_OK(chunk_st.status());
+            ASSERT_OK(spiller->_spilled_task_status);
+            if (chunk_st.value() != nullptr) {
+                for (size_t j = 0; j < chunk_st.value()->num_rows(); ++j) {
+                    output_rows.emplace_back(chunk_st.value()->debug_row(j));
+                }
+            }
+        }
+        std::sort(input_rows.begin(), input_rows.end());
+        std::sort(output_rows.begin(), output_rows.end());
+        ASSERT_EQ(input_rows, output_rows);
+    }
+}
+
 /*
 TEST_F(SpillTest, file_group_test) {
     auto chunk = std::make_unique<Chunk>();
@@ -0,0 +1,166 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/alp_page.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+#include "storage/chunk_helper.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/rowset/options.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class AlpPageTest : public testing::Test {
+public:
+    template <LogicalType Type>
+    OwnedSlice encode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        AlpPageBuilder<Type> builder(builder_options);
+        size_t added = builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        EXPECT_EQ(src.size(), added);
+        EXPECT_EQ(src.size(), builder.count());
+        return builder.finish()->build();
+    }
+
+    template <LogicalType Type>
+    void test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        using CppType = typename TypeTraits<Type>::CppType;
+        OwnedSlice page = encode<Type>(src);
+
+        AlpPageDecoder<Type> decoder(page.slice());
+        ASSERT_OK(decoder.init());
+        ASSERT_EQ(src.size(), decoder.count());
+
+        auto column = ChunkHelper::column_from_field_type(Type, false);
+        size_t n = src.size();
+        ASSERT_OK(decoder.next_batch(&n, column.get()));
+        ASSERT_EQ(src.size(), n);
+        // the values must be restored bit by bit, including NaN and -0.0
+        ASSERT_EQ(0, memcmp(src.data(), column->raw_data(), src.size() * sizeof(CppType)));
+
+        if (src.empty()) {
+            return;
+        }
+        std::mt19937 rng(0);
+        for (int i = 0; i < 100; i++) {
+            uint32_t pos = rng() % src.size();
+            ASSERT_OK(decoder.seek_to_position_in_page(pos));
+            auto one = ChunkHelper::column_from_field_type(Type, false);
+            size_t one_row = 1;
+            ASSERT_OK(decoder.next_batch(&one_row, one.get()));
+            ASSERT_EQ(1, one_row);
+            ASSERT_EQ(0, memcmp(&src[pos], one->raw_data(), sizeof(CppType)));
+        }
+    }
+};
+
+TEST_F(AlpPageTest, test_decimal_doubles) {
+    std::mt19937 rng(0);
+    std::vector<double> prices;
+    for (int i = 0; i < 10000; i++) {
+        prices.push_back(static_cast<double>(rng() % 1000000) / 100);
+    }
+    test_encode_decode<TYPE_DOUBLE>(prices);
+
+    // two decimal digits, integers below 10^6 are packed in 20 bits
+    OwnedSlice page = encode<TYPE_DOUBLE>(prices);
+    ASSERT_EQ(2, page.slice().data[4]);
+    ASSERT_EQ(20, page.slice().data[5]);
+    ASSERT_EQ(ALP_PAGE_HEADER_SIZE + (prices.size() * 20 + 7) / 8, page.slice().size);
+}
+
+TEST_F(AlpPageTest, test_decimal_floats) {
+    std::vector<float> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(static_cast<float>(i % 1000) / 10);
+    }
+    test_encode_decode<TYPE_FLOAT>(values);
+
+    OwnedSlice page = encode<TYPE_FLOAT>(values);
+    ASSERT_EQ(1, page.slice().data[4]);
+    ASSERT_LT(page.slice().size, values.size() * sizeof(float) / 2);
+}
+
+TEST_F(AlpPageTest, test_exceptions) {
+    std::vector<double> values;
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(i * 0.5);
+    }
+    values[3] = std::numeric_limits<double>::quiet_NaN();
+    values[10] = std::numeric_limits<double>::infinity();
+    values[20] = -std::numeric_limits<double>::infinity();
+    values[30] = -0.0;
+    values[40] = M_PI;
+    values[50] = 1e300;
+    test_encode_decode<TYPE_DOUBLE>(values);
+
+    OwnedSlice page = encode<TYPE_DOUBLE>(values);
+    ASSERT_EQ(1, page.slice().data[4]);
+    ASSERT_EQ(6, decode_fixed32_le(reinterpret_cast<const uint8_t*>(page.slice().data) + 8));
+}
+
+TEST_F(AlpPageTest, test_random_doubles) {
+    std::mt19937_64 rng(0);
+    std::vector<double> values;
+    for (int i = 0; i < 10000; i++) {
+        uint64_t bits = rng();
+        double value;
+        memcpy(&value, &bits, sizeof(double));
+        values.push_back(value);
+    }
+    test_encode_decode<TYPE_DOUBLE>(values);
+
+    // the values of full precision are stored as is
+    OwnedSlice page = encode<TYPE_DOUBLE>(values);
+    ASSERT_EQ(ALP_RAW_EXPONENT, static_cast<uint8_t>(page.slice().data[4]));
+    ASSERT_EQ(ALP_PAGE_HEADER_SIZE + values.size() * sizeof(double), page.slice().size);
+}
+
+TEST_F(AlpPageTest, test_small_pages) {
+    test_encode_decode<TYPE_DOUBLE>({});
+    test_encode_decode<TYPE_DOUBLE>({1.25});
+    test_encode_decode<TYPE_DOUBLE>({-1.5, -1.5, -1.5});
+    test_encode_decode<TYPE_FLOAT>({std::numeric_limits<float>::quiet_NaN()});
+}
+
+TEST_F(AlpPageTest, test_corrupted_page) {
+    std::vector<double> values;
+    for (int i = 0; i < 100; i++) {
+        values.push_back(i * 0.25);
+    }
+    OwnedSlice page = encode<TYPE_DOUBLE>(values);
+    Slice truncated(page.slice().data, page.slice().size - 1);
+    AlpPageDecoder<TYPE_DOUBLE> decoder(truncated);
+    ASSERT_TRUE(decoder.init().is_corruption());
+}
+
+TEST_F(AlpPageTest, test_encoding_info) {
+    for (auto type : {TYPE_FLOAT, TYPE_DOUBLE}) {
+        const EncodingInfo* info = nullptr;
+        ASSERT_OK(EncodingInfo::get(type, ALP_ENCODING, &info));
+        ASSERT_EQ(ALP_ENCODING, info->encoding());
+        // the default encoding is unchanged
+        ASSERT_EQ(BIT_SHUFFLE, EncodingInfo::get_default_encoding(type, false));
+    }
+}
+
+} // namespace starrocks
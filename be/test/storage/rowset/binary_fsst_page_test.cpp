@@ -0,0 +1,246 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/binary_fsst_page.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/nullable_column.h"
+#include "storage/column_predicate.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/types.h"
+#include "testutil/assert.h"
+#include "util/fsst.h"
+
+namespace starrocks {
+
+class BinaryFsstPageTest : public testing::Test {
+public:
+    static std::vector<std::string> make_urls(size_t n) {
+        std::mt19937 rng(0);
+        static const char* hosts[] = {"www.starrocks.io", "docs.starrocks.io", "github.com", "example.com"};
+        static const char* paths[] = {"/docs/loading/", "/blog/", "/starrocks/starrocks/issues/", "/zh/docs/"};
+        std::vector<std::string> urls;
+        for (size_t i = 0; i < n; i++) {
+            urls.push_back(std::string("https://") + hosts[rng() % 4] + paths[rng() % 4] + std::to_string(rng()) +
+                           "?utm_source=" + std::to_string(rng() % 100));
+        }
+        return urls;
+    }
+
+    OwnedSlice encode(const std::vector<std::string>& strs) {
+        std::vector<Slice> slices(strs.begin(), strs.end());
+        PageBuilderOptions options;
+        options.data_page_size = 1024 * 1024;
+        BinaryFsstPageBuilder builder(options);
+        EXPECT_EQ(slices.size(), builder.add(reinterpret_cast<const uint8_t*>(slices.data()), slices.size()));
+        EXPECT_EQ(slices.size(), builder.count());
+        OwnedSlice page = builder.finish()->build();
+        if (!strs.empty()) {
+            Slice first;
+            Slice last;
+            EXPECT_OK(builder.get_first_value(&first));
+            EXPECT_OK(builder.get_last_value(&last));
+            EXPECT_EQ(strs.front(), first.to_string());
+            EXPECT_EQ(strs.back(), last.to_string());
+        }
+        return page;
+    }
+
+    void test_encode_decode(const std::vector<std::string>& strs) {
+        OwnedSlice page = encode(strs);
+        BinaryFsstPageDecoder decoder(page.slice());
+        ASSERT_OK(decoder.init());
+        ASSERT_EQ(strs.size(), decoder.count());
+
+        auto column = BinaryColumn::create();
+        size_t n = strs.size();
+        ASSERT_OK(decoder.next_batch(&n, column.get()));
+        ASSERT_EQ(strs.size(), n);
+        for (size_t i = 0; i < strs.size(); i++) {
+            ASSERT_EQ(strs[i], column->get_slice(i).to_string()) << "at " << i;
+        }
+
+        if (strs.empty()) {
+            return;
+        }
+        std::mt19937 rng(0);
+        for (int i = 0; i < 100; i++) {
+            uint32_t pos = rng() % strs.size();
+            ASSERT_OK(decoder.seek_to_position_in_page(pos));
+            auto one = BinaryColumn::create();
+            size_t one_row = 1;
+            ASSERT_OK(decoder.next_batch(&one_row, one.get()));
+            ASSERT_EQ(1, one_row);
+            ASSERT_EQ(strs[pos], one->get_slice(0).to_string());
+        }
+    }
+};
+
+TEST_F(BinaryFsstPageTest, test_symbol_table) {
+    std::vector<std::string> urls = make_urls(1000);
+    std::vector<Slice> samples(urls.begin(), urls.end());
+    FsstSymbolTable table = FsstSymbolTable::build(samples);
+    ASSERT_GT(table.num_symbols(), 0);
+    ASSERT_LE(table.num_symbols(), FsstSymbolTable::kMaxSymbols);
+
+    faststring serialized;
+    table.serialize(&serialized);
+    FsstSymbolTable restored;
+    size_t consumed = 0;
+    ASSERT_OK(restored.deserialize(Slice(serialized.data(), serialized.size()), &consumed));
+    ASSERT_EQ(serialized.size(), consumed);
+
+    size_t raw_size = 0;
+    size_t compressed_size = 0;
+    std::vector<std::string> strs = urls;
+    strs.emplace_back("");
+    strs.emplace_back(std::string("\0\xff\x01", 3));
+    strs.emplace_back("not in the sample at all");
+    for (const auto& s : strs) {
+        faststring compressed;
+        table.compress(s, &compressed);
+        faststring compressed_by_restored;
+        restored.compress(s, &compressed_by_restored);
+        ASSERT_EQ(compressed.ToString(), compressed_by_restored.ToString());
+
+        std::vector<uint8_t> buffer(FsstSymbolTable::max_decompressed_size(compressed.size()));
+        size_t size = restored.decompress(Slice(compressed.data(), compressed.size()), buffer.data());
+        ASSERT_EQ(s, std::string(reinterpret_cast<const char*>(buffer.data()), size));
+        ASSERT_EQ(s.size(), restored.decompressed_size(Slice(compressed.data(), compressed.size())));
+        raw_size += s.size();
+        compressed_size += compressed.size();
+    }
+    ASSERT_LT(compressed_size, raw_size / 2);
+
+    ASSERT_TRUE(restored.deserialize(Slice(serialized.data(), serialized.size() - 1), &consumed).is_corruption());
+}
+
+TEST_F(BinaryFsstPageTest, test_encode_decode) {
+    std::vector<std::string> urls = make_urls(10000);
+    test_encode_decode(urls);
+
+    size_t raw_size = 0;
+    for (const auto& url : urls) {
+        raw_size += url.size();
+    }
+    OwnedSlice page = encode(urls);
+    BinaryFsstPageDecoder decoder(page.slice());
+    ASSERT_OK(decoder.init());
+    ASSERT_TRUE(decoder.is_compressed());
+    ASSERT_LT(page.slice().size, raw_size / 2 + urls.size() * sizeof(uint32_t));
+}
+
+TEST_F(BinaryFsstPageTest, test_incompressible_strings) {
+    std::mt19937 rng(0);
+    std::vector<std::string> strs;
+    for (int i = 0; i < 1000; i++) {
+        std::string s(1 + rng() % 32, '\0');
+        for (auto& c : s) {
+            c = static_cast<char>(rng());
+        }
+        strs.push_back(s);
+    }
+    test_encode_decode(strs);
+
+    // the strings are stored as is
+    OwnedSlice page = encode(strs);
+    BinaryFsstPageDecoder decoder(page.slice());
+    ASSERT_OK(decoder.init());
+    ASSERT_FALSE(decoder.is_compressed());
+}
+
+TEST_F(BinaryFsstPageTest, test_small_pages) {
+    test_encode_decode({});
+    test_encode_decode({""});
+    test_encode_decode({"a"});
+    test_encode_decode({"", "abc", "", "abcabcabcabc"});
+}
+
+TEST_F(BinaryFsstPageTest, test_sparse_range) {
+    std::vector<std::string> urls = make_urls(1000);
+    OwnedSlice page = encode(urls);
+    BinaryFsstPageDecoder decoder(page.slice());
+    ASSERT_OK(decoder.init());
+
+    SparseRange<> range;
+    range.add(Range<>(10, 20));
+    range.add(Range<>(500, 505));
+    auto column = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    ASSERT_OK(decoder.next_batch(range, column.get()));
+    ASSERT_EQ(15, column->size());
+    ASSERT_EQ(urls[10], column->get(0).get_slice().to_string());
+    ASSERT_EQ(urls[19], column->get(9).get_slice().to_string());
+    ASSERT_EQ(urls[500], column->get(10).get_slice().to_string());
+    ASSERT_EQ(505, decoder.current_index());
+}
+
+TEST_F(BinaryFsstPageTest, test_compressed_predicates) {
+    std::vector<std::string> urls = make_urls(1000);
+    OwnedSlice page = encode(urls);
+    BinaryFsstPageDecoder decoder(page.slice());
+    ASSERT_OK(decoder.init());
+    ASSERT_TRUE(decoder.is_compressed());
+
+    std::vector<Slice> values;
+    for (uint32_t i = 0; i < decoder.count(); i++) {
+        values.push_back(decoder.compressed_value(i));
+    }
+    auto expect_selection = [&](const ColumnPredicate* pred, const std::vector<std::string>& targets) {
+        std::vector<uint8_t> selection(values.size(), 1);
+        ASSERT_TRUE(pred->evaluate_compressed(decoder.symbol_table(), values.data(), values.size(), selection.data()));
+        for (size_t i = 0; i < urls.size(); i++) {
+            bool matched = std::find(targets.begin(), targets.end(), urls[i]) != targets.end();
+            ASSERT_EQ(matched, selection[i] == 1) << "at " << i;
+        }
+    };
+
+    std::unique_ptr<ColumnPredicate> eq(new_column_eq_predicate(get_type_info(TYPE_VARCHAR), 0, urls[42]));
+    expect_selection(eq.get(), {urls[42]});
+    std::unique_ptr<ColumnPredicate> not_found(new_column_eq_predicate(get_type_info(TYPE_VARCHAR), 0, "https://"));
+    expect_selection(not_found.get(), {});
+    std::unique_ptr<ColumnPredicate> in(
+            new_column_in_predicate(get_type_info(TYPE_VARCHAR), 0, {urls[1], urls[7], "unknown"}));
+    expect_selection(in.get(), {urls[1], urls[7]});
+
+    // the char values are padded in the pages, which are never compressed
+    std::unique_ptr<ColumnPredicate> char_eq(new_column_eq_predicate(get_type_info(TYPE_CHAR), 0, urls[42]));
+    std::vector<uint8_t> selection(values.size(), 1);
+    ASSERT_FALSE(char_eq->evaluate_compressed(decoder.symbol_table(), values.data(), values.size(), selection.data()));
+}
+
+TEST_F(BinaryFsstPageTest, test_corrupted_page) {
+    OwnedSlice page = encode(make_urls(100));
+    Slice truncated(page.slice().data, page.slice().size - 1);
+    BinaryFsstPageDecoder decoder(truncated);
+    ASSERT_TRUE(decoder.init().is_corruption());
+}
+
+TEST_F(BinaryFsstPageTest, test_encoding_info) {
+    const EncodingInfo* info = nullptr;
+    ASSERT_OK(EncodingInfo::get(TYPE_VARCHAR, FSST_ENCODING, &info));
+    ASSERT_EQ(FSST_ENCODING, info->encoding());
+    ASSERT_FALSE(EncodingInfo::get(TYPE_CHAR, FSST_ENCODING, &info).ok());
+    // the default encoding is unchanged
+    ASSERT_EQ(DICT_ENCODING, EncodingInfo::get_default_encoding(TYPE_VARCHAR, false));
+}
+
+} // namespace starrocks
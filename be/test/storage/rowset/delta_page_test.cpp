@@ -0,0 +1,210 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/delta_page.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <random>
+
+#include "storage/chunk_helper.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/rowset/options.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class DeltaPageTest : public testing::Test {
+public:
+    template <LogicalType Type>
+    OwnedSlice encode(const std::vector<typename TypeTraits<Type>::CppType>& src, uint8_t max_order) {
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        DeltaPageBuilder<Type> builder(builder_options, max_order);
+        size_t added = builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        EXPECT_EQ(src.size(), added);
+        EXPECT_EQ(src.size(), builder.count());
+        return builder.finish()->build();
+    }
+
+    template <LogicalType Type>
+    void test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src, uint8_t max_order) {
+        using CppType = typename TypeTraits<Type>::CppType;
+        OwnedSlice page = encode<Type>(src, max_order);
+
+        DeltaPageDecoder<Type> decoder(page.slice(), DELTA_OF_DELTA_ENCODING);
+        ASSERT_OK(decoder.init());
+        ASSERT_EQ(src.size(), decoder.count());
+        ASSERT_EQ(0, decoder.current_index());
+
+        auto column = ChunkHelper::column_from_field_type(Type, false);
+        size_t n = src.size();
+        ASSERT_OK(decoder.next_batch(&n, column.get()));
+        ASSERT_EQ(src.size(), n);
+        const auto* values = reinterpret_cast<const CppType*>(column->raw_data());
+        for (size_t i = 0; i < src.size(); i++) {
+            ASSERT_EQ(src[i], values[i]) << "at " << i;
+        }
+
+        if (src.empty()) {
+            return;
+        }
+        // seek to the positions located by the ordinal index
+        std::mt19937 rng(0);
+        for (int i = 0; i < 100; i++) {
+            uint32_t pos = rng() % src.size();
+            ASSERT_OK(decoder.seek_to_position_in_page(pos));
+            auto one = ChunkHelper::column_from_field_type(Type, false);
+            size_t one_row = 1;
+            ASSERT_OK(decoder.next_batch(&one_row, one.get()));
+            ASSERT_EQ(1, one_row);
+            ASSERT_EQ(src[pos], *reinterpret_cast<const CppType*>(one->raw_data()));
+            ASSERT_EQ(pos + 1, decoder.current_index());
+        }
+    }
+};
+
+TEST_F(DeltaPageTest, test_sorted_ids) {
+    std::vector<int64_t> ids;
+    for (int64_t i = 0; i < 10000; i++) {
+        ids.push_back(1000000 + i * 3 + (i % 7 == 0 ? 1 : 0));
+    }
+    test_encode_decode<TYPE_BIGINT>(ids, 1);
+    test_encode_decode<TYPE_BIGINT>(ids, 2);
+
+    // the deltas are in [2, 4], 2 bits each
+    OwnedSlice page = encode<TYPE_BIGINT>(ids, 1);
+    ASSERT_EQ(1, page.slice().data[4]);
+    ASSERT_EQ(2, page.slice().data[5]);
+    ASSERT_LT(page.slice().size, ids.size() / 4 + 64);
+}
+
+TEST_F(DeltaPageTest, test_fixed_step_timestamps) {
+    std::vector<int64_t> timestamps;
+    for (int64_t i = 0; i < 10000; i++) {
+        timestamps.push_back(1700000000000L + i * 1000);
+    }
+    test_encode_decode<TYPE_DATETIME>(timestamps, 2);
+
+    // the deltas are all the same, no bit is packed
+    OwnedSlice page = encode<TYPE_DATETIME>(timestamps, 2);
+    ASSERT_EQ(DELTA_PAGE_HEADER_SIZE + 2 * sizeof(int64_t), page.slice().size);
+    ASSERT_EQ(1, page.slice().data[4]);
+}
+
+TEST_F(DeltaPageTest, test_growing_steps) {
+    std::vector<int64_t> values;
+    for (int64_t i = 0; i < 10000; i++) {
+        values.push_back(i * (i + 1) / 2);
+    }
+    test_encode_decode<TYPE_BIGINT>(values, 1);
+    test_encode_decode<TYPE_BIGINT>(values, 2);
+
+    // the deltas of deltas are all one, no bit is packed
+    OwnedSlice page = encode<TYPE_BIGINT>(values, 2);
+    ASSERT_EQ(DELTA_PAGE_HEADER_SIZE + 3 * sizeof(int64_t), page.slice().size);
+    ASSERT_EQ(2, page.slice().data[4]);
+}
+
+TEST_F(DeltaPageTest, test_unordered_values) {
+    std::mt19937 rng(0);
+    std::vector<int32_t> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(static_cast<int32_t>(rng() % 1000) - 500);
+    }
+    test_encode_decode<TYPE_INT>(values, 2);
+
+    // the random values are encoded by frame-of-reference of the values themselves
+    OwnedSlice page = encode<TYPE_INT>(values, 2);
+    ASSERT_EQ(0, page.slice().data[4]);
+    ASSERT_LE(page.slice().size, DELTA_PAGE_HEADER_SIZE + sizeof(int32_t) + values.size() * 10 / 8 + 1);
+}
+
+TEST_F(DeltaPageTest, test_extreme_values) {
+    std::vector<int8_t> tinyints;
+    std::vector<int64_t> bigints;
+    for (int i = 0; i < 1000; i++) {
+        tinyints.push_back(i % 2 == 0 ? std::numeric_limits<int8_t>::min() : std::numeric_limits<int8_t>::max());
+        bigints.push_back(i % 3 == 0 ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max() - i);
+    }
+    test_encode_decode<TYPE_TINYINT>(tinyints, 2);
+    test_encode_decode<TYPE_BIGINT>(bigints, 2);
+    test_encode_decode<TYPE_SMALLINT>({-1, 0, 1, 32767, -32768}, 2);
+}
+
+TEST_F(DeltaPageTest, test_small_pages) {
+    test_encode_decode<TYPE_INT>({}, 2);
+    test_encode_decode<TYPE_INT>({42}, 2);
+    test_encode_decode<TYPE_INT>({42, 43}, 2);
+    test_encode_decode<TYPE_DATE>({738000, 738001, 738003}, 2);
+}
+
+TEST_F(DeltaPageTest, test_sparse_range_and_value_seek) {
+    std::vector<int32_t> values;
+    for (int32_t i = 0; i < 4096; i++) {
+        values.push_back(i * 2);
+    }
+    OwnedSlice page = encode<TYPE_INT>(values, 2);
+    DeltaPageDecoder<TYPE_INT> decoder(page.slice(), DELTA_OF_DELTA_ENCODING);
+    ASSERT_OK(decoder.init());
+
+    SparseRange<> range;
+    range.add(Range<>(10, 20));
+    range.add(Range<>(100, 105));
+    auto column = ChunkHelper::column_from_field_type(TYPE_INT, false);
+    ASSERT_OK(decoder.next_batch(range, column.get()));
+    ASSERT_EQ(15, column->size());
+    const auto* data = reinterpret_cast<const int32_t*>(column->raw_data());
+    ASSERT_EQ(20, data[0]);
+    ASSERT_EQ(38, data[9]);
+    ASSERT_EQ(200, data[10]);
+    ASSERT_EQ(105, decoder.current_index());
+
+    bool exact_match = false;
+    int32_t target = 301;
+    ASSERT_OK(decoder.seek_at_or_after_value(&target, &exact_match));
+    ASSERT_FALSE(exact_match);
+    ASSERT_EQ(151, decoder.current_index());
+    target = 302;
+    ASSERT_OK(decoder.seek_at_or_after_value(&target, &exact_match));
+    ASSERT_TRUE(exact_match);
+    ASSERT_EQ(151, decoder.current_index());
+    target = 10000;
+    ASSERT_TRUE(decoder.seek_at_or_after_value(&target, &exact_match).is_not_found());
+}
+
+TEST_F(DeltaPageTest, test_corrupted_page) {
+    OwnedSlice page = encode<TYPE_INT>({1, 2, 3, 4}, 2);
+    Slice truncated(page.slice().data, page.slice().size - 1);
+    DeltaPageDecoder<TYPE_INT> decoder(truncated, DELTA_OF_DELTA_ENCODING);
+    ASSERT_TRUE(decoder.init().is_corruption());
+}
+
+TEST_F(DeltaPageTest, test_encoding_info) {
+    for (auto type : {TYPE_TINYINT, TYPE_SMALLINT, TYPE_INT, TYPE_BIGINT, TYPE_DATE, TYPE_DATETIME}) {
+        for (auto encoding : {DELTA_ENCODING, DELTA_OF_DELTA_ENCODING}) {
+            const EncodingInfo* info = nullptr;
+            ASSERT_OK(EncodingInfo::get(type, encoding, &info));
+            ASSERT_EQ(encoding, info->encoding());
+        }
+    }
+    const EncodingInfo* info = nullptr;
+    ASSERT_FALSE(EncodingInfo::get(TYPE_DOUBLE, DELTA_ENCODING, &info).ok());
+    // the default encodings are unchanged
+    ASSERT_EQ(BIT_SHUFFLE, EncodingInfo::get_default_encoding(TYPE_BIGINT, false));
+}
+
+} // namespace starrocks
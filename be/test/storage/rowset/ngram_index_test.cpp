@@ -0,0 +1,241 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "fs/fs_memory.h"
+#include "runtime/mem_tracker.h"
+#include "storage/olap_common.h"
+#include "storage/page_cache.h"
+#include "storage/rowset/ngram_index_reader.h"
+#include "storage/rowset/ngram_index_writer.h"
+#include "storage/rowset/ngram_tokenizer.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class NgramIndexTest : public testing::Test {
+public:
+    const std::string kTestDir = "/ngram_index_test";
+
+protected:
+    void SetUp() override {
+        StoragePageCache::create_global_cache(&_tracker, 1000000000);
+        _fs = std::make_shared<MemoryFileSystem>();
+        ASSERT_OK(_fs->create_dir(kTestDir));
+
+        _opts.use_page_cache = true;
+        _opts.kept_in_memory = false;
+        _opts.skip_fill_data_cache = false;
+        _opts.stats = &_stats;
+    }
+
+    void TearDown() override { StoragePageCache::release_global_cache(); }
+
+    static std::vector<std::string> make_logs(size_t n) {
+        std::mt19937 rng(0);
+        static const char* levels[] = {"INFO", "WARN", "ERROR"};
+        static const char* messages[] = {"connection reset by peer", "query finished", "timeout after retries",
+                                         "slow scan of tablet"};
+        std::vector<std::string> logs;
+        for (size_t i = 0; i < n; i++) {
+            logs.push_back(std::string(levels[rng() % 3]) + " [" + std::to_string(rng() % 1000) + "] " +
+                           messages[rng() % 4] + " id=" + std::to_string(rng()));
+        }
+        return logs;
+    }
+
+    // Write the index of |values|, of which the positions in |nulls| are null.
+    void write_index(const std::string& file_name, int32_t gram_size, const std::vector<std::string>& values,
+                     const std::vector<size_t>& nulls, ColumnIndexMetaPB* meta) {
+        ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+        NgramIndexWriter writer(gram_size);
+        for (size_t i = 0; i < values.size(); i++) {
+            if (std::find(nulls.begin(), nulls.end(), i) != nulls.end()) {
+                writer.add_nulls(1);
+            } else {
+                Slice value(values[i]);
+                writer.add_values(&value, 1);
+            }
+        }
+        ASSERT_GT(writer.size(), 0);
+        ASSERT_OK(writer.finish(wfile.get(), meta));
+        ASSERT_EQ(NGRAM_INDEX, meta->type());
+        ASSERT_EQ(gram_size, meta->ngram_index().gram_size());
+        ASSERT_OK(wfile->close());
+    }
+
+    std::unique_ptr<NgramIndexReader> load_index(RandomAccessFile* rfile, const ColumnIndexMetaPB& meta) {
+        _opts.read_file = rfile;
+        auto reader = std::make_unique<NgramIndexReader>(meta.ngram_index().gram_size());
+        auto loaded = reader->load(_opts, meta.ngram_index());
+        EXPECT_TRUE(loaded.ok());
+        EXPECT_TRUE(reader->loaded());
+        return reader;
+    }
+
+    std::shared_ptr<MemoryFileSystem> _fs = nullptr;
+    MemTracker _tracker;
+    IndexReadOptions _opts;
+    OlapReaderStatistics _stats;
+};
+
+static std::string literals_to_string(const std::vector<PatternLiteral>& literals) {
+    std::string s;
+    for (const auto& literal : literals) {
+        s += "[";
+        s += literal.at_begin ? "^" : "";
+        s += literal.text;
+        s += literal.at_end ? "$" : "";
+        s += "]";
+    }
+    return s;
+}
+
+static std::string like_literals(const std::string& pattern) {
+    std::vector<PatternLiteral> literals;
+    EXPECT_TRUE(NgramTokenizer::extract_like_literals(pattern, &literals));
+    return literals_to_string(literals);
+}
+
+static std::string regex_literals(const std::string& pattern) {
+    std::vector<PatternLiteral> literals;
+    if (!NgramTokenizer::extract_regex_literals(pattern, &literals)) {
+        return "unsupported";
+    }
+    return literals_to_string(literals);
+}
+
+TEST_F(NgramIndexTest, test_extract_literals) {
+    ASSERT_EQ("[error]", like_literals("%error%"));
+    ASSERT_EQ("[^abc$]", like_literals("abc"));
+    ASSERT_EQ("[^ab][cd][ef$]", like_literals("ab_cd%ef"));
+    ASSERT_EQ("[^a%b]", like_literals("a\\%b%"));
+    // the other escaped characters are unknown
+    ASSERT_EQ("[a][c]", like_literals("%a\\bc%"));
+    ASSERT_EQ("", like_literals("%"));
+
+    ASSERT_EQ("[error]", regex_literals("error"));
+    ASSERT_EQ("[^foo][bar$]", regex_literals("^foo.*bar$"));
+    ASSERT_EQ("[ab][d]", regex_literals("abc*d"));
+    ASSERT_EQ("[x][yz]", regex_literals("x[a-z]+yz"));
+    ASSERT_EQ("[ms]", regex_literals("\\d+ms"));
+    ASSERT_EQ("[a.][c]", regex_literals("a\\.b{2,3}c"));
+    ASSERT_EQ("[abc]", regex_literals("[[:alpha:]]abc"));
+    ASSERT_EQ("[bcd]", regex_literals("[]a]bcd"));
+    // the multi-byte character made optional is removed entirely
+    ASSERT_EQ("[中][x]", regex_literals("中文?x"));
+    ASSERT_EQ("unsupported", regex_literals("a|b"));
+    ASSERT_EQ("unsupported", regex_literals("(?i)abc"));
+    ASSERT_EQ("unsupported", regex_literals("\\x41bc"));
+}
+
+TEST_F(NgramIndexTest, test_required_grams) {
+    std::vector<PatternLiteral> literals;
+    ASSERT_TRUE(NgramTokenizer::extract_like_literals("%foo bar baz%", &literals));
+    std::vector<std::string> grams;
+    NgramTokenizer(3).required_grams(literals, &grams);
+    ASSERT_EQ((std::vector<std::string>{" ba", "baz", "foo", "r b"}), grams);
+    // only the tokens delimited on both sides are required
+    NgramTokenizer(0).required_grams(literals, &grams);
+    ASSERT_EQ((std::vector<std::string>{"bar"}), grams);
+
+    literals.clear();
+    ASSERT_TRUE(NgramTokenizer::extract_like_literals("foo bar%", &literals));
+    NgramTokenizer(0).required_grams(literals, &grams);
+    ASSERT_EQ((std::vector<std::string>{"foo"}), grams);
+
+    // too short for the index
+    literals.clear();
+    ASSERT_TRUE(NgramTokenizer::extract_like_literals("%ab%", &literals));
+    NgramTokenizer(3).required_grams(literals, &grams);
+    ASSERT_TRUE(grams.empty());
+
+    std::vector<Slice> tokens;
+    std::string value = "GET /api/v1?x=中文 200";
+    NgramTokenizer(0).tokenize(value, &tokens);
+    std::vector<std::string> token_strs;
+    for (const auto& token : tokens) {
+        token_strs.push_back(token.to_string());
+    }
+    ASSERT_EQ((std::vector<std::string>{"GET", "api", "v1", "x", "中文", "200"}), token_strs);
+}
+
+TEST_F(NgramIndexTest, test_read_rows) {
+    std::vector<std::string> logs = make_logs(5000);
+    const std::vector<size_t> nulls = {3, 100, 4999};
+    for (int32_t gram_size : {0, 3}) {
+        std::string file_name = kTestDir + "/ngram_" + std::to_string(gram_size);
+        ColumnIndexMetaPB meta;
+        write_index(file_name, gram_size, logs, nulls, &meta);
+        ASSIGN_OR_ABORT(auto rfile, _fs->new_random_access_file(file_name));
+        auto reader = load_index(rfile.get(), meta);
+        const NgramTokenizer& tokenizer = reader->tokenizer();
+
+        for (const std::string pattern : {"%ERROR [7%", "%reset by%", "% timeout %", "WARN%scan%", "%id=12%"}) {
+            std::vector<PatternLiteral> literals;
+            ASSERT_TRUE(NgramTokenizer::extract_like_literals(pattern, &literals));
+            std::vector<std::string> grams;
+            tokenizer.required_grams(literals, &grams);
+            if (grams.empty()) {
+                continue;
+            }
+            Roaring rows;
+            ASSERT_OK(reader->read_rows(_opts, grams, &rows));
+
+            for (uint32_t i = 0; i < logs.size(); i++) {
+                bool is_null = std::find(nulls.begin(), nulls.end(), i) != nulls.end();
+                // the rows of all the grams, which is a superset of the rows matched by the pattern
+                bool has_grams = !is_null;
+                std::vector<Slice> value_grams;
+                tokenizer.tokenize(logs[i], &value_grams);
+                for (const auto& gram : grams) {
+                    has_grams &= std::find(value_grams.begin(), value_grams.end(), Slice(gram)) != value_grams.end();
+                }
+                ASSERT_EQ(has_grams, rows.contains(i)) << pattern << " at " << i << ": " << logs[i];
+                bool matched = !is_null;
+                for (const auto& literal : literals) {
+                    matched &= logs[i].find(literal.text) != std::string::npos;
+                }
+                if (matched) {
+                    ASSERT_TRUE(rows.contains(i)) << pattern << " at " << i << ": " << logs[i];
+                }
+            }
+        }
+
+        // the gram absent from the dictionary
+        Roaring rows;
+        ASSERT_OK(reader->read_rows(_opts, {"FATAL"}, &rows));
+        ASSERT_TRUE(rows.isEmpty());
+    }
+}
+
+TEST_F(NgramIndexTest, test_no_grams) {
+    std::string file_name = kTestDir + "/no_grams";
+    ColumnIndexMetaPB meta;
+    // the values shorter than the grams have no grams
+    write_index(file_name, 8, {"a", "bc", ""}, {1}, &meta);
+    ASSIGN_OR_ABORT(auto rfile, _fs->new_random_access_file(file_name));
+    auto reader = load_index(rfile.get(), meta);
+    Roaring rows;
+    ASSERT_OK(reader->read_rows(_opts, {"abcdefgh"}, &rows));
+    ASSERT_TRUE(rows.isEmpty());
+}
+
+} // namespace starrocks
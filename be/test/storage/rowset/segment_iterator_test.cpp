@@ -17,16 +17,22 @@
 #include <fmt/core.h>
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <unordered_map>
 
+#include "column/column_helper.h"
 #include "common/object_pool.h"
+#include "exprs/runtime_filter_bank.h"
 #include "fs/fs_memory.h"
 #include "gen_cpp/tablet_schema.pb.h"
 #include "gtest/gtest.h"
 #include "storage/chunk_helper.h"
 #include "storage/olap_common.h"
+#include "storage/olap_runtime_range_pruner.hpp"
+#include "storage/predicate_parser.h"
 #include "storage/rowset/column_iterator.h"
 #include "storage/rowset/segment.h"
 #include "storage/rowset/segment_options.h"
@@ -97,6 +103,10 @@ public:
         _column_pbs.back().set_length(length);
         return *this;
     }
+    TabletSchemaBuilder& set_bitmap_index() {
+        _column_pbs.back().set_has_bitmap_index(true);
+        return *this;
+    }
 
     std::unique_ptr<TabletSchema> build() { return TabletSchemaHelper::create_tablet_schema(_column_pbs); }
 };
@@ -529,4 +539,305 @@ TEST_F(SegmentIteratorTest, TestGlobalDictNoLocalDict) {
     res_chunk->reset();
 }
 
+// NOLINTNEXTLINE
+TEST_F(SegmentIteratorTest, TestPredicateReorder) {
+    using namespace starrocks::test;
+
+    std::string file_name = kSegmentDir + "/predicate_reorder";
+    ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+    SegmentWriterOptions opts;
+    TabletSchemaBuilder builder;
+    std::shared_ptr<TabletSchema> tablet_schema = builder.create(1, false, TYPE_INT, true)
+                                                          .create(2, false, TYPE_INT)
+                                                          .create(3, false, TYPE_INT)
+                                                          .create(4, false, TYPE_VARCHAR)
+                                                          .build();
+    // the distinct values of the pages tell the selectivity of c1 = 3
+    config::enable_zone_map_page_ndv = true;
+    SegmentWriter writer(std::move(wfile), 0, tablet_schema, opts);
+    ASSERT_OK(writer.init());
+
+    const int32_t chunk_size = config::vector_chunk_size;
+    const int32_t num_rows = 100000;
+    std::vector<std::string> values(64);
+    for (int i = 0; i < values.size(); ++i) {
+        values[i] = fmt::format("prefix-{}", i);
+    }
+    auto chunk = ChunkHelper::new_chunk(ChunkHelper::convert_schema(tablet_schema), num_rows);
+    for (int32_t i = 0; i < num_rows; ++i) {
+        auto& cols = chunk->columns();
+        cols[0]->append_datum(Datum(i));
+        cols[1]->append_datum(Datum(i % 7));
+        cols[2]->append_datum(Datum(i));
+        cols[3]->append_datum(Datum(Slice(values[i % values.size()])));
+    }
+    ASSERT_OK(writer.append_chunk(*chunk));
+    uint64_t file_size = 0;
+    uint64_t index_size = 0;
+    uint64_t footer_position = 0;
+    ASSERT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+    config::enable_zone_map_page_ndv = false;
+
+    auto segment = *Segment::open(_fs, file_name, 0, tablet_schema);
+    ASSERT_EQ(segment->num_rows(), num_rows);
+
+    VecSchemaBuilder schema_builder;
+    schema_builder.add(0, "c0", TYPE_INT).add(1, "c1", TYPE_INT).add(2, "c2", TYPE_INT).add(3, "c3", TYPE_VARCHAR);
+    auto vec_schema = schema_builder.build();
+
+    // c1 = 3 selects 1/7 of the rows, while c2 < 90000 selects most of them
+    std::unique_ptr<ColumnPredicate> eq_predicate(new_column_eq_predicate(get_type_info(TYPE_INT), 1, "3"));
+    std::unique_ptr<ColumnPredicate> lt_predicate(new_column_lt_predicate(get_type_info(TYPE_INT), 2, "90000"));
+
+    auto read_rows = [&](bool reorder, OlapReaderStatistics* stats, std::vector<std::string>* rows) {
+        config::enable_segment_predicate_reorder = reorder;
+        SegmentReadOptions seg_opts;
+        seg_opts.fs = _fs;
+        seg_opts.stats = stats;
+        seg_opts.tablet_schema = tablet_schema;
+        seg_opts.predicates[2].push_back(lt_predicate.get());
+        seg_opts.predicates[1].push_back(eq_predicate.get());
+
+        auto chunk_iter = new_segment_iterator(segment, vec_schema, seg_opts);
+        auto res_chunk = ChunkHelper::new_chunk(vec_schema, chunk_size);
+        while (true) {
+            res_chunk->reset();
+            auto st = chunk_iter->get_next(res_chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_OK(st);
+            for (size_t i = 0; i < res_chunk->num_rows(); ++i) {
+                rows->emplace_back(res_chunk->debug_row(i));
+            }
+        }
+        chunk_iter->close();
+    };
+
+    OlapReaderStatistics stats;
+    std::vector<std::string> rows;
+    read_rows(false, &stats, &rows);
+    ASSERT_EQ(0, stats.rows_staged_read_skipped);
+    ASSERT_EQ(0, stats.predicate_selectivity_estimate_ns);
+
+    OlapReaderStatistics reorder_stats;
+    std::vector<std::string> reorder_rows;
+    read_rows(true, &reorder_stats, &reorder_rows);
+    config::enable_segment_predicate_reorder = false;
+    // c2 is read only for the rows of c1 = 3
+    ASSERT_GT(reorder_stats.rows_staged_read_skipped, 0);
+
+    ASSERT_EQ(90000 / 7, rows.size());
+    ASSERT_EQ(rows, reorder_rows);
+    ASSERT_EQ(stats.raw_rows_read, reorder_stats.raw_rows_read);
+    ASSERT_EQ(stats.rows_vec_cond_filtered, reorder_stats.rows_vec_cond_filtered);
+}
+
+// The equality predicate on the FSST pages skips the rows of each page by the compressed strings before the page
+// is read.
+// NOLINTNEXTLINE
+TEST_F(SegmentIteratorTest, TestCompressedPredicateFilter) {
+    using namespace starrocks::test;
+
+    std::string file_name = kSegmentDir + "/compressed_predicate_filter";
+    ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+    SegmentWriterOptions opts;
+    TabletSchemaBuilder builder;
+    std::shared_ptr<TabletSchema> tablet_schema =
+            builder.create(1, false, TYPE_INT, true).create(2, false, TYPE_VARCHAR).build();
+    config::enable_segment_fsst_encoding = true;
+    SegmentWriter writer(std::move(wfile), 0, tablet_schema, opts);
+    ASSERT_OK(writer.init());
+
+    const int32_t num_rows = 100000;
+    auto chunk = ChunkHelper::new_chunk(ChunkHelper::convert_schema(tablet_schema), num_rows);
+    std::vector<std::string> values(num_rows);
+    for (int32_t i = 0; i < num_rows; ++i) {
+        values[i] = fmt::format("https://www.starrocks.io/docs/page/{}", i);
+        chunk->columns()[0]->append_datum(Datum(i));
+        chunk->columns()[1]->append_datum(Datum(Slice(values[i])));
+    }
+    ASSERT_OK(writer.append_chunk(*chunk));
+    uint64_t file_size = 0;
+    uint64_t index_size = 0;
+    uint64_t footer_position = 0;
+    ASSERT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+    config::enable_segment_fsst_encoding = false;
+
+    auto segment = *Segment::open(_fs, file_name, 0, tablet_schema);
+    ASSERT_EQ(segment->num_rows(), num_rows);
+
+    VecSchemaBuilder schema_builder;
+    schema_builder.add(0, "c0", TYPE_INT).add(1, "c1", TYPE_VARCHAR);
+    auto vec_schema = schema_builder.build();
+    std::unique_ptr<ColumnPredicate> eq_predicate(
+            new_column_eq_predicate(get_type_info(TYPE_VARCHAR), 1, "https://www.starrocks.io/docs/page/4242"));
+
+    auto read_rows = [&](bool filter, OlapReaderStatistics* stats, std::vector<std::string>* rows) {
+        config::enable_segment_compressed_predicate_filter = filter;
+        SegmentReadOptions seg_opts;
+        seg_opts.fs = _fs;
+        seg_opts.stats = stats;
+        seg_opts.tablet_schema = tablet_schema;
+        seg_opts.predicates[1].push_back(eq_predicate.get());
+
+        auto chunk_iter = new_segment_iterator(segment, vec_schema, seg_opts);
+        auto res_chunk = ChunkHelper::new_chunk(vec_schema, config::vector_chunk_size);
+        while (true) {
+            res_chunk->reset();
+            auto st = chunk_iter->get_next(res_chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_OK(st);
+            for (size_t i = 0; i < res_chunk->num_rows(); ++i) {
+                rows->emplace_back(res_chunk->debug_row(i));
+            }
+        }
+        chunk_iter->close();
+    };
+
+    OlapReaderStatistics stats;
+    std::vector<std::string> rows;
+    read_rows(false, &stats, &rows);
+    ASSERT_EQ(num_rows, stats.raw_rows_read);
+
+    OlapReaderStatistics filter_stats;
+    std::vector<std::string> filter_rows;
+    read_rows(true, &filter_stats, &filter_rows);
+    config::enable_segment_compressed_predicate_filter = false;
+
+    std::vector<std::string> expected{"[4242, 'https://www.starrocks.io/docs/page/4242']"};
+    ASSERT_EQ(expected, rows);
+    ASSERT_EQ(expected, filter_rows);
+    // only the matched row is read
+    ASSERT_EQ(1, filter_stats.raw_rows_read);
+}
+
+// A min/max runtime filter arriving after the segment iterator is inited prunes the rows by the bitmap index,
+// even if the zone maps of all the pages overlap the filter.
+// NOLINTNEXTLINE
+TEST_F(SegmentIteratorTest, TestLateRuntimeFilterByBitmapIndex) {
+    using namespace starrocks::test;
+
+    const int32_t num_rows = 100000;
+    const int32_t cardinality = 2000;
+    const int32_t filter_value = 5;
+
+    auto write_segment = [&](const std::string& file_name, bool bitmap_index) {
+        ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+        TabletSchemaBuilder builder;
+        builder.create(1, false, TYPE_INT, true).create(2, false, TYPE_INT);
+        if (bitmap_index) {
+            builder.set_bitmap_index();
+        }
+        std::shared_ptr<TabletSchema> tablet_schema = builder.build();
+        SegmentWriterOptions opts;
+        SegmentWriter writer(std::move(wfile), 0, tablet_schema, opts);
+        CHECK_OK(writer.init());
+
+        // every page holds all the values of c1, so the zone maps can't filter any page.
+        auto chunk = ChunkHelper::new_chunk(ChunkHelper::convert_schema(tablet_schema), num_rows);
+        for (int32_t i = 0; i < num_rows; ++i) {
+            auto& cols = chunk->columns();
+            cols[0]->append_datum(Datum(i));
+            cols[1]->append_datum(Datum(i % cardinality));
+        }
+        CHECK_OK(writer.append_chunk(*chunk));
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        uint64_t footer_position = 0;
+        CHECK_OK(writer.finalize(&file_size, &index_size, &footer_position));
+        return std::make_pair(*Segment::open(_fs, file_name, 0, tablet_schema), tablet_schema);
+    };
+
+    VecSchemaBuilder schema_builder;
+    schema_builder.add(0, "c0", TYPE_INT).add(1, "c1", TYPE_INT);
+    auto vec_schema = schema_builder.build();
+
+    ObjectPool pool;
+    SlotDescriptor slot_desc(1, "2", TypeDescriptor(TYPE_INT));
+
+    // Returns the c0 of the rows read, the filter c1 = 5 arrives after the first chunk is read.
+    auto read_rows = [&](const std::shared_ptr<Segment>& segment, const std::shared_ptr<TabletSchema>& tablet_schema,
+                         OlapReaderStatistics* stats, size_t* first_chunk_rows) {
+        PredicateParser parser(tablet_schema);
+        RuntimeFilterProbeDescriptor rf_desc;
+        UnarrivedRuntimeFilterList unarrived_rfs;
+        unarrived_rfs.add_unarrived_rf(&rf_desc, &slot_desc);
+
+        SegmentReadOptions seg_opts;
+        seg_opts.fs = _fs;
+        seg_opts.stats = stats;
+        seg_opts.tablet_schema = tablet_schema;
+        seg_opts.runtime_range_pruner = OlapRuntimeScanRangePruner(&parser, unarrived_rfs);
+
+        std::vector<int32_t> rows;
+        auto chunk_iter = new_segment_iterator(segment, vec_schema, seg_opts);
+        auto res_chunk = ChunkHelper::new_chunk(vec_schema, config::vector_chunk_size);
+        while (true) {
+            res_chunk->reset();
+            auto st = chunk_iter->get_next(res_chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            CHECK_OK(st);
+            for (size_t i = 0; i < res_chunk->num_rows(); ++i) {
+                rows.emplace_back(res_chunk->get_column_by_index(0)->get(i).get_int32());
+            }
+            if (rf_desc.runtime_filter() == nullptr) {
+                *first_chunk_rows = rows.size();
+                JoinRuntimeFilter* rf = RuntimeFilterHelper::create_join_runtime_filter(&pool, TYPE_INT);
+                rf->init(1);
+                ColumnPtr column = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false);
+                ColumnHelper::cast_to_raw<TYPE_INT>(column)->append(filter_value);
+                CHECK_OK(RuntimeFilterHelper::fill_runtime_bloom_filter(column, TYPE_INT, rf, 0, false));
+                rf_desc.set_runtime_filter(rf);
+            }
+        }
+        chunk_iter->close();
+        return rows;
+    };
+
+    // only the rows of c1 = 5 are read after the filter arrives.
+    auto expect_pruned_rows = [&](size_t first_chunk_rows) {
+        std::vector<int32_t> rows(first_chunk_rows);
+        std::iota(rows.begin(), rows.end(), 0);
+        for (int32_t i = first_chunk_rows; i < num_rows; ++i) {
+            if (i % cardinality == filter_value) {
+                rows.emplace_back(i);
+            }
+        }
+        return rows;
+    };
+
+    auto [segment, tablet_schema] = write_segment(kSegmentDir + "/late_rf_bitmap_index", true);
+    OlapReaderStatistics stats;
+    size_t first_chunk_rows = 0;
+    auto rows = read_rows(segment, tablet_schema, &stats, &first_chunk_rows);
+    ASSERT_GT(first_chunk_rows, 0);
+    ASSERT_LT(first_chunk_rows, num_rows);
+    ASSERT_EQ(expect_pruned_rows(first_chunk_rows), rows);
+    ASSERT_EQ(rows.size(), stats.raw_rows_read);
+    ASSERT_GT(stats.runtime_stats_filtered, 0);
+
+    // without the bitmap index, the filter can't prune any page by the zone maps.
+    auto [no_index_segment, no_index_schema] = write_segment(kSegmentDir + "/late_rf_no_bitmap_index", false);
+    OlapReaderStatistics no_index_stats;
+    size_t no_index_first_chunk_rows = 0;
+    auto no_index_rows = read_rows(no_index_segment, no_index_schema, &no_index_stats, &no_index_first_chunk_rows);
+    ASSERT_EQ(num_rows, no_index_rows.size());
+    ASSERT_EQ(num_rows, no_index_stats.raw_rows_read);
+
+    // the runtime filter is only used by the indexes, all the rows matching it are read in both cases.
+    auto matched = [&](const std::vector<int32_t>& c0s) {
+        std::vector<int32_t> res;
+        std::copy_if(c0s.begin(), c0s.end(), std::back_inserter(res),
+                     [&](int32_t c0) { return c0 % cardinality == filter_value; });
+        return res;
+    };
+    ASSERT_EQ(num_rows / cardinality, matched(rows).size());
+    ASSERT_EQ(matched(no_index_rows), matched(rows));
+}
+
 } // namespace starrocks
@@ -39,6 +39,7 @@
 #include <memory>
 #include <string>
 
+#include "common/config.h"
 #include "fs/fs_memory.h"
 #include "storage/page_cache.h"
 #include "storage/tablet_schema_helper.h"
@@ -349,6 +350,50 @@ TEST_F(ColumnZoneMapTest, NormalTestIntPage) {
     check_result(zone_maps[2], false, false, "", "", true, false);
 }
 
+TEST_F(ColumnZoneMapTest, PageDistinctValues) {
+    std::string filename = kTestDir + "/PageDistinctValues";
+
+    TabletColumn int_column = create_int_key(0);
+    TypeInfoPtr type_info = get_type_info(int_column);
+
+    config::enable_zone_map_page_ndv = true;
+    std::unique_ptr<ZoneMapIndexWriter> builder = ZoneMapIndexWriter::create(type_info.get());
+    config::enable_zone_map_page_ndv = false;
+    for (int i = 0; i < 1000; i++) {
+        int value = i % 10;
+        builder->add_values((const uint8_t*)&value, 1);
+    }
+    builder->add_nulls(10);
+    builder->flush();
+    for (int i = 0; i < 4000; i++) {
+        int value = i * 7;
+        builder->add_values((const uint8_t*)&value, 1);
+    }
+    builder->flush();
+    builder->add_nulls(6);
+    builder->flush();
+    ColumnIndexMetaPB index_meta;
+    write_file(*builder, index_meta, filename);
+
+    ZoneMapIndexReader column_zone_map;
+    load_zone_map(column_zone_map, index_meta, filename);
+    const std::vector<ZoneMapPB>& zone_maps = column_zone_map.page_zone_maps();
+    ASSERT_EQ(3, zone_maps.size());
+    ASSERT_EQ(10, zone_maps[0].num_distinct_values());
+    ASSERT_NEAR(4000, zone_maps[1].num_distinct_values(), 200);
+    ASSERT_FALSE(zone_maps[2].has_num_distinct_values());
+
+    // the saturated sketch takes all the values as distinct
+    DistinctValueSketch sketch;
+    for (uint32_t i = 0; i < 100000; i++) {
+        sketch.add(i * 2654435761U);
+    }
+    ASSERT_EQ(100000, sketch.estimate(100000));
+    sketch.reset();
+    sketch.add(12345);
+    ASSERT_EQ(1, sketch.estimate(100));
+}
+
 // Test for string
 TEST_F(ColumnZoneMapTest, NormalTestVarcharPage) {
     TabletColumn varchar_column = create_varchar_key(0);
@@ -229,6 +229,68 @@ TEST(TabletMetaTest, test_create) {
     ASSERT_EQ(23724, binlog_config_ptr->binlog_max_size);
 }
 
+// NOLINTNEXTLINE
+TEST(TabletMetaTest, test_create_with_ngram_index) {
+    TCreateTabletReq request;
+    request.__set_tablet_id(1000002);
+    request.__set_partition_id(1);
+    request.__set_tablet_type(TTabletType::TABLET_TYPE_DISK);
+    request.__set_tablet_schema(TTabletSchema());
+
+    TTabletSchema& schema = request.tablet_schema;
+    schema.__set_schema_hash(12345);
+    schema.__set_keys_type(TKeysType::DUP_KEYS);
+    schema.__set_short_key_column_count(1);
+
+    // c0 varchar(10) key, c1 varchar(10)
+    for (const char* name : {"c0", "c1"}) {
+        TTypeNode type;
+        type.__set_type(TTypeNodeType::SCALAR);
+        type.__set_scalar_type(TScalarType());
+        type.scalar_type.__set_type(TPrimitiveType::VARCHAR);
+        type.scalar_type.__set_len(10);
+
+        schema.columns.emplace_back();
+        schema.columns.back().__set_column_name(name);
+        schema.columns.back().__set_is_key(schema.columns.size() == 1);
+        schema.columns.back().__set_aggregation_type(TAggregationType::NONE);
+        schema.columns.back().__set_is_allow_null(true);
+        schema.columns.back().__set_type_desc(TTypeDesc());
+        schema.columns.back().type_desc.__set_types({type});
+    }
+    TOlapTableIndex index;
+    index.__set_index_name("idx_c1");
+    index.__set_columns({"c1"});
+    index.__set_index_type(TIndexType::NGRAM);
+    index.__set_properties({{"gram_num", "2"}});
+    schema.__set_indexes({index});
+
+    std::unordered_map<uint32_t, uint32_t> col_ordinal_to_unique_id;
+    col_ordinal_to_unique_id[0] = 10000;
+    col_ordinal_to_unique_id[1] = 10001;
+
+    TabletMetaSharedPtr tablet_meta;
+    ASSERT_TRUE(TabletMeta::create(request, TabletUid(321, 456), 987 /*shared_id*/, 20000 /*next_unique_id*/,
+                                   col_ordinal_to_unique_id, &tablet_meta)
+                        .ok());
+
+    const TabletSchema& tablet_schema = tablet_meta->tablet_schema();
+    ASSERT_EQ(2, tablet_schema.num_columns());
+    ASSERT_FALSE(tablet_schema.column(0).has_ngram_index());
+    ASSERT_TRUE(tablet_schema.column(1).has_ngram_index());
+    ASSERT_EQ(2, tablet_schema.column(1).ngram_index_gram_size());
+    ASSERT_FALSE(tablet_schema.column(1).has_bitmap_index());
+
+    ColumnPB column_pb;
+    tablet_schema.column(1).to_schema_pb(&column_pb);
+    ASSERT_TRUE(column_pb.has_ngram_index());
+    ASSERT_EQ(2, column_pb.ngram_index_gram_size());
+    TabletColumn column(column_pb);
+    ASSERT_TRUE(column.has_ngram_index());
+    ASSERT_EQ(2, column.ngram_index_gram_size());
+    ASSERT_EQ(tablet_schema.column(1), column);
+}
+
 TEST(TabletMetaTest, test_init_from_pb) {
     TabletMetaSharedPtr tablet_meta = TabletMeta::create();
     std::shared_ptr<BinlogConfig> binlog_config_ptr = tablet_meta->get_binlog_config();
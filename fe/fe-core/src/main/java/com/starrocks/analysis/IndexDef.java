@@ -42,21 +42,38 @@ import com.starrocks.sql.analyzer.SemanticException;
 import com.starrocks.sql.parser.NodePosition;
 
 import java.util.List;
+import java.util.Map;
+import java.util.TreeMap;
 import java.util.TreeSet;
 
 public class IndexDef implements ParseNode {
+    // the length in bytes of the grams of the ngram index, 0 means to index the tokens of letters and digits
+    public static final String NGRAM_GRAM_NUM = "gram_num";
+    public static final int MAX_NGRAM_GRAM_NUM = 32;
+
     private String indexName;
     private List<String> columns;
     private IndexType indexType;
     private String comment;
+    private Map<String, String> properties;
 
     private final NodePosition pos;
 
     public IndexDef (String indexName, List<String> columns, IndexType indexType, String comment) {
-        this(indexName, columns, indexType, comment, NodePosition.ZERO);
+        this(indexName, columns, indexType, comment, null, NodePosition.ZERO);
+    }
+
+    public IndexDef(String indexName, List<String> columns, IndexType indexType, String comment,
+                    Map<String, String> properties) {
+        this(indexName, columns, indexType, comment, properties, NodePosition.ZERO);
     }
 
     public IndexDef(String indexName, List<String> columns, IndexType indexType, String comment, NodePosition pos) {
+        this(indexName, columns, indexType, comment, null, pos);
+    }
+
+    public IndexDef(String indexName, List<String> columns, IndexType indexType, String comment,
+                    Map<String, String> properties, NodePosition pos) {
         this.pos = pos;
         this.indexName = indexName;
         this.columns = columns;
@@ -70,12 +87,17 @@ public class IndexDef implements ParseNode {
         } else {
             this.comment = comment;
         }
+        // the property names are case-insensitive, they are stored in lower case
+        this.properties = new TreeMap<>();
+        if (properties != null) {
+            properties.forEach((key, value) -> this.properties.put(key.toLowerCase(), value));
+        }
     }
 
     public void analyze() {
-        if (indexType == IndexDef.IndexType.BITMAP) {
+        if (indexType == IndexDef.IndexType.BITMAP || indexType == IndexDef.IndexType.NGRAM) {
             if (columns == null || columns.size() != 1) {
-                throw new SemanticException("bitmap index can only apply to a single column.");
+                throw new SemanticException(indexType.name().toLowerCase() + " index can only apply to a single column.");
             }
             if (Strings.isNullOrEmpty(indexName)) {
                 throw new SemanticException("index name cannot be blank.");
@@ -89,6 +111,25 @@ public class IndexDef implements ParseNode {
                 throw new SemanticException("columns of index has duplicated.");
             }
         }
+        analyzeProperties();
+    }
+
+    private void analyzeProperties() {
+        for (Map.Entry<String, String> entry : properties.entrySet()) {
+            if (indexType != IndexType.NGRAM || !entry.getKey().equals(NGRAM_GRAM_NUM)) {
+                throw new SemanticException("Unknown property " + entry.getKey() + " of " + indexType + " index.");
+            }
+            int gramNum;
+            try {
+                gramNum = Integer.parseInt(entry.getValue());
+            } catch (NumberFormatException e) {
+                throw new SemanticException(NGRAM_GRAM_NUM + " must be an integer, but got " + entry.getValue());
+            }
+            if (gramNum < 0 || gramNum > MAX_NGRAM_GRAM_NUM) {
+                throw new SemanticException(
+                        NGRAM_GRAM_NUM + " must be between 0 and " + MAX_NGRAM_GRAM_NUM + ", but got " + gramNum);
+            }
+        }
     }
 
     @Override
@@ -121,6 +162,7 @@ public class IndexDef implements ParseNode {
         if (indexType != null) {
             sb.append(" USING ").append(indexType.toString());
         }
+        appendProperties(sb, properties);
         if (comment != null) {
             sb.append(" COMMENT '" + comment + "'");
         }
@@ -148,6 +190,27 @@ public class IndexDef implements ParseNode {
         return comment;
     }
 
+    public Map<String, String> getProperties() {
+        return properties;
+    }
+
+    public static void appendProperties(StringBuilder sb, Map<String, String> properties) {
+        if (properties == null || properties.isEmpty()) {
+            return;
+        }
+        sb.append(" (");
+        boolean first = true;
+        for (Map.Entry<String, String> entry : properties.entrySet()) {
+            if (first) {
+                first = false;
+            } else {
+                sb.append(", ");
+            }
+            sb.append("\"").append(entry.getKey()).append("\" = \"").append(entry.getValue()).append("\"");
+        }
+        sb.append(")");
+    }
+
     // new planner framework use SemanticException instead of AnalysisException, this code will remove in future
     @Deprecated
     public void checkColumn(Column column, KeysType keysType) {
@@ -164,6 +227,17 @@ public class IndexDef implements ParseNode {
                         "BITMAP index only used in columns of DUP_KEYS/PRIMARY_KEYS table or key columns of"
                                 + " UNIQUE_KEYS/AGG_KEYS table. invalid column: " + indexColName);
             }
+        } else if (indexType == IndexType.NGRAM) {
+            String indexColName = column.getName();
+            PrimitiveType colType = column.getPrimitiveType();
+            if (colType != PrimitiveType.VARCHAR) {
+                throw new SemanticException(colType + " is not supported in NGRAM index. "
+                        + "invalid column: " + indexColName);
+            } else if ((keysType == KeysType.AGG_KEYS || keysType == KeysType.UNIQUE_KEYS) && !column.isKey()) {
+                throw new SemanticException(
+                        "NGRAM index only used in columns of DUP_KEYS/PRIMARY_KEYS table or key columns of"
+                                + " UNIQUE_KEYS/AGG_KEYS table. invalid column: " + indexColName);
+            }
         } else {
             throw new SemanticException("Unsupported index type: " + indexType);
         }
@@ -171,5 +245,7 @@ public class IndexDef implements ParseNode {
 
     public enum IndexType {
         BITMAP,
+        // n-gram inverted index of a varchar column, used to skip the rows not matched by LIKE and REGEXP
+        NGRAM,
     }
 }
@@ -796,6 +796,15 @@ public class Column implements Writable, GsonPreProcessable, GsonPostProcessable
                 if (tColumn.getColumn_name().equals(columns.get(0))) {
                     tColumn.setHas_bitmap_index(true);
                 }
+            } else if (index.getIndexType() == IndexDef.IndexType.NGRAM) {
+                List<String> columns = index.getColumns();
+                if (tColumn.getColumn_name().equals(columns.get(0))) {
+                    tColumn.setHas_ngram_index(true);
+                    Integer gramNum = index.getNgramGramNum();
+                    if (gramNum != null) {
+                        tColumn.setNgram_index_gram_size(gramNum);
+                    }
+                }
             }
         }
         if (bfColumns != null && bfColumns.contains(this.name)) {
@@ -46,8 +46,11 @@ import java.io.DataInput;
 import java.io.DataOutput;
 import java.io.IOException;
 import java.util.ArrayList;
+import java.util.HashMap;
 import java.util.List;
+import java.util.Map;
 import java.util.Objects;
+import java.util.TreeMap;
 
 /**
  * Internal representation of index, including index type, name, columns and comments.
@@ -62,12 +65,22 @@ public class Index implements Writable {
     private IndexDef.IndexType indexType;
     @SerializedName(value = "comment")
     private String comment;
+    @SerializedName(value = "properties")
+    private Map<String, String> properties;
 
     public Index(String indexName, List<String> columns, IndexDef.IndexType indexType, String comment) {
+        this(indexName, columns, indexType, comment, null);
+    }
+
+    public Index(String indexName, List<String> columns, IndexDef.IndexType indexType, String comment,
+                 Map<String, String> properties) {
         this.indexName = indexName;
         this.columns = columns;
         this.indexType = indexType;
         this.comment = comment;
+        if (properties != null && !properties.isEmpty()) {
+            this.properties = new TreeMap<>(properties);
+        }
     }
 
     public Index() {
@@ -109,6 +122,19 @@ public class Index implements Writable {
         this.comment = comment;
     }
 
+    public Map<String, String> getProperties() {
+        return properties == null ? new HashMap<>() : properties;
+    }
+
+    // return the gram size of the ngram index, or null if it's not specified
+    public Integer getNgramGramNum() {
+        if (indexType != IndexDef.IndexType.NGRAM || properties == null) {
+            return null;
+        }
+        String gramNum = properties.get(IndexDef.NGRAM_GRAM_NUM);
+        return gramNum == null ? null : Integer.parseInt(gramNum);
+    }
+
     @Override
     public void write(DataOutput out) throws IOException {
         Text.writeString(out, GsonUtils.GSON.toJson(this));
@@ -136,12 +162,12 @@ public class Index implements Writable {
 
         Index other = (Index) obj;
         return Objects.equals(indexName, other.indexName) && Objects.equals(columns, other.columns)
-                && Objects.equals(indexType, other.indexType);
+                && Objects.equals(indexType, other.indexType) && Objects.equals(getProperties(), other.getProperties());
 
     }
 
     public Index clone() {
-        return new Index(indexName, new ArrayList<>(columns), indexType, comment);
+        return new Index(indexName, new ArrayList<>(columns), indexType, comment, properties);
     }
 
     @Override
@@ -166,6 +192,7 @@ public class Index implements Writable {
         if (indexType != null) {
             sb.append(" USING ").append(indexType.toString());
         }
+        IndexDef.appendProperties(sb, properties);
         if (comment != null) {
             sb.append(" COMMENT '" + comment + "'");
         }
@@ -180,6 +207,9 @@ public class Index implements Writable {
         if (columns != null) {
             tIndex.setComment(comment);
         }
+        if (properties != null && !properties.isEmpty()) {
+            tIndex.setProperties(properties);
+        }
         return tIndex;
     }
 }
@@ -70,6 +70,25 @@ public class CompressionUtils {
         }
     }
 
+    // Return TCompressionType according to input name for the block compression of spilled data.
+    // Return null if input name is an invalid or unsupported compression type.
+    public static TCompressionType getSpillCompressTypeByName(String name) {
+        TCompressionType compressionType = T_COMPRESSION_BY_NAME.get(name);
+
+        // Only no_compression, lz4, zstd is available.
+        if (compressionType == TCompressionType.NO_COMPRESSION
+                || compressionType == TCompressionType.LZ4
+                || compressionType == TCompressionType.ZSTD) {
+            return compressionType;
+        } else {
+            return null;
+        }
+    }
+
+    public static List<String> getSupportedSpillCompressionNames() {
+        return Arrays.asList("NO_COMPRESSION", "LZ4", "ZSTD");
+    }
+
     public static List<String> getSupportedCompressionNames() {
         return new ArrayList<>(T_COMPRESSION_BY_NAME.keySet());
     }
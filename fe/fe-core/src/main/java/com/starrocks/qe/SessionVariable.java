@@ -475,6 +475,8 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     public static final String SPILL_OPERATOR_MAX_BYTES = "spill_operator_max_bytes";
     public static final String SPILL_REVOCABLE_MAX_BYTES = "spill_revocable_max_bytes";
     public static final String SPILL_ENCODE_LEVEL = "spill_encode_level";
+    public static final String SPILL_COMPRESSION_TYPE = "spill_compression_type";
+    public static final String ENABLE_SPILL_COLUMN_ENCODING = "enable_spill_column_encoding";
 
     // full_sort_max_buffered_{rows,bytes} are thresholds that limits input size of partial_sort
     // in full sort.
@@ -880,6 +882,14 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     // see more details in the comment above transmissionEncodeLevel
     @VarAttr(name = SPILL_ENCODE_LEVEL)
     private int spillEncodeLevel = 7;
+    // the block compression applied on spilled data after encoding, e.g. LZ4 or ZSTD.
+    // chunks that can hardly be compressed are still spilled uncompressed.
+    @VarAttr(name = SPILL_COMPRESSION_TYPE)
+    private String spillCompressionType = "LZ4";
+    // spill chunks with per-column encodings: dictionary for low cardinality strings,
+    // frame-of-reference and bit-packing for integers.
+    @VarAttr(name = ENABLE_SPILL_COLUMN_ENCODING)
+    private boolean enableSpillColumnEncoding = false;
 
     @VarAttr(name = ENABLE_AGG_SPILL_PREAGGREGATION, flag = VariableMgr.INVISIBLE)
     public boolean enableAggSpillPreaggregation = true;
@@ -2741,6 +2751,11 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
             tResult.setSpill_operator_max_bytes(spillOperatorMaxBytes);
             tResult.setSpill_revocable_max_bytes(spillRevocableMaxBytes);
             tResult.setSpill_encode_level(spillEncodeLevel);
+            TCompressionType spillCompression = CompressionUtils.getSpillCompressTypeByName(spillCompressionType);
+            if (spillCompression != null) {
+                tResult.setSpill_compression_type(spillCompression);
+            }
+            tResult.setEnable_spill_column_encoding(enableSpillColumnEncoding);
             tResult.setSpillable_operator_mask(spillableOperatorMask);
             tResult.setEnable_agg_spill_preaggregation(enableAggSpillPreaggregation);
         }
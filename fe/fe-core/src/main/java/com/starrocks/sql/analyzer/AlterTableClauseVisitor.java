@@ -103,7 +103,7 @@ public class AlterTableClauseVisitor extends AstVisitor<Void, ConnectContext> {
         IndexDef indexDef = clause.getIndexDef();
         indexDef.analyze();
         clause.setIndex(new Index(indexDef.getIndexName(), indexDef.getColumns(),
-                indexDef.getIndexType(), indexDef.getComment()));
+                indexDef.getIndexType(), indexDef.getComment(), indexDef.getProperties()));
         return null;
     }
 
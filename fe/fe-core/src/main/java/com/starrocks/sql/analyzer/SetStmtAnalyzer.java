@@ -186,6 +186,16 @@ public class SetStmtAnalyzer {
             }
         }
 
+        if (variable.equalsIgnoreCase(SessionVariable.SPILL_COMPRESSION_TYPE)) {
+            String compressionName = resolvedExpression.getStringValue();
+            TCompressionType compressionType = CompressionUtils.getSpillCompressTypeByName(compressionName);
+            if (compressionType == null) {
+                throw new SemanticException(String.format("Unsupported spill compression type: %s, supported list is %s",
+                        compressionName, StringUtils.join(CompressionUtils.getSupportedSpillCompressionNames(), ",")));
+            }
+            resolvedExpression = new StringLiteral(compressionType.name());
+        }
+
         if (variable.equalsIgnoreCase(SessionVariable.ADAPTIVE_DOP_MAX_BLOCK_ROWS_PER_DRIVER_SEQ)) {
             checkRangeLongVariable(resolvedExpression, SessionVariable.ADAPTIVE_DOP_MAX_BLOCK_ROWS_PER_DRIVER_SEQ, 1L, null);
         }
@@ -19,6 +19,7 @@ import com.google.common.base.Preconditions;
 import com.google.common.base.Strings;
 import com.google.common.collect.Lists;
 import com.starrocks.analysis.Expr;
+import com.starrocks.analysis.IndexDef;
 import com.starrocks.analysis.SlotRef;
 import com.starrocks.analysis.SubfieldExpr;
 import com.starrocks.analysis.TableName;
@@ -783,6 +784,7 @@ public class DesensitizedSQLBuilder {
             if (index.getIndexType() != null) {
                 sb.append(" USING ").append(index.getIndexType().toString());
             }
+            IndexDef.appendProperties(sb, index.getProperties());
             return sb.toString();
         }
 
@@ -813,12 +813,27 @@ public class AstBuilder extends StarRocksBaseVisitor<ParseNode> {
                     context.comment() != null ? ((StringLiteral) visit(context.comment())).getStringValue() : null;
             final IndexDef indexDef =
                     new IndexDef(indexName, columnList.stream().map(Identifier::getValue).collect(toList()),
-                            IndexDef.IndexType.BITMAP, comment, createPos(context));
+                            getIndexType(context.indexType()), comment, getIndexProperties(context.indexType()),
+                            createPos(context));
             indexDefList.add(indexDef);
         }
         return indexDefList;
     }
 
+    private IndexDef.IndexType getIndexType(StarRocksParser.IndexTypeContext context) {
+        if (context != null && context.NGRAM() != null) {
+            return IndexDef.IndexType.NGRAM;
+        }
+        return IndexDef.IndexType.BITMAP;
+    }
+
+    private Map<String, String> getIndexProperties(StarRocksParser.IndexTypeContext context) {
+        if (context == null || context.propertyList() == null) {
+            return null;
+        }
+        return getPropertyList(context.propertyList());
+    }
+
     private List<ColumnDef> getColumnDefs(List<StarRocksParser.ColumnDescContext> columnDesc) {
         return columnDesc.stream().map(context -> getColumnDef(context)).collect(toList());
     }
@@ -1310,8 +1325,8 @@ public class AstBuilder extends StarRocksBaseVisitor<ParseNode> {
 
         IndexDef indexDef = new IndexDef(indexName,
                 columnList.stream().map(Identifier::getValue).collect(toList()),
-                IndexDef.IndexType.BITMAP,
-                comment, idxPos);
+                getIndexType(context.indexType()),
+                comment, getIndexProperties(context.indexType()), idxPos);
 
         CreateIndexClause createIndexClause = new CreateIndexClause(indexDef, idxPos);
 
@@ -3520,8 +3535,8 @@ public class AstBuilder extends StarRocksBaseVisitor<ParseNode> {
 
         IndexDef indexDef = new IndexDef(indexName,
                 columnList.stream().map(Identifier::getValue).collect(toList()),
-                IndexDef.IndexType.BITMAP,
-                comment, createPos(start, stop));
+                getIndexType(context.indexType()),
+                comment, getIndexProperties(context.indexType()), createPos(start, stop));
 
         return new CreateIndexClause(indexDef, createPos(context));
     }
@@ -266,6 +266,7 @@ MONTH: 'MONTH';
 NAME: 'NAME';
 NAMES: 'NAMES';
 NEGATIVE: 'NEGATIVE';
+NGRAM: 'NGRAM';
 NO: 'NO';
 NODE: 'NODE';
 NODES: 'NODES';
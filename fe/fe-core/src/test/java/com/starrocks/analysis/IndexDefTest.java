@@ -17,12 +17,19 @@
 
 package com.starrocks.analysis;
 
+import com.google.common.collect.ImmutableMap;
 import com.google.common.collect.Lists;
+import com.starrocks.catalog.Column;
+import com.starrocks.catalog.Index;
+import com.starrocks.catalog.KeysType;
+import com.starrocks.catalog.Type;
 import com.starrocks.sql.analyzer.SemanticException;
 import org.junit.Assert;
 import org.junit.Before;
 import org.junit.Test;
 
+import java.util.Map;
+
 public class IndexDefTest {
     private IndexDef def;
 
@@ -61,6 +68,57 @@ public class IndexDefTest {
         }
     }
 
+    @Test
+    public void testNgramIndex() {
+        IndexDef ngramDef = new IndexDef("index2", Lists.newArrayList("col2"), IndexDef.IndexType.NGRAM, null);
+        ngramDef.analyze();
+        Assert.assertEquals("INDEX index2 (`col2`) USING NGRAM", ngramDef.toSql());
+        ngramDef.checkColumn(new Column("col2", Type.VARCHAR), KeysType.DUP_KEYS);
+        try {
+            ngramDef.checkColumn(new Column("col2", Type.INT), KeysType.DUP_KEYS);
+            Assert.fail("No exception throws.");
+        } catch (SemanticException e) {
+            Assert.assertTrue(e.getMessage().contains("not supported in NGRAM index"));
+        }
+        try {
+            ngramDef = new IndexDef("index2", Lists.newArrayList("col1", "col2"), IndexDef.IndexType.NGRAM, null);
+            ngramDef.analyze();
+            Assert.fail("No exception throws.");
+        } catch (SemanticException e) {
+            Assert.assertTrue(e.getMessage().contains("ngram index can only apply to a single column"));
+        }
+    }
+
+    @Test
+    public void testNgramIndexProperties() {
+        IndexDef ngramDef = new IndexDef("index2", Lists.newArrayList("col2"), IndexDef.IndexType.NGRAM, null,
+                ImmutableMap.of("GRAM_NUM", "4"));
+        ngramDef.analyze();
+        Assert.assertEquals("INDEX index2 (`col2`) USING NGRAM (\"gram_num\" = \"4\")", ngramDef.toSql());
+        Index index = new Index(ngramDef.getIndexName(), ngramDef.getColumns(), ngramDef.getIndexType(),
+                ngramDef.getComment(), ngramDef.getProperties());
+        Assert.assertEquals(Integer.valueOf(4), index.getNgramGramNum());
+        Assert.assertEquals("4", index.toThrift().getProperties().get("gram_num"));
+
+        for (Map<String, String> properties : Lists.newArrayList(ImmutableMap.of("gram_num", "-1"),
+                ImmutableMap.of("gram_num", "abc"), ImmutableMap.of("gram_size", "3"))) {
+            try {
+                new IndexDef("index2", Lists.newArrayList("col2"), IndexDef.IndexType.NGRAM, null, properties)
+                        .analyze();
+                Assert.fail("No exception throws.");
+            } catch (SemanticException e) {
+                Assert.assertTrue(e instanceof SemanticException);
+            }
+        }
+        try {
+            new IndexDef("index1", Lists.newArrayList("col1"), IndexDef.IndexType.BITMAP, null,
+                    ImmutableMap.of("gram_num", "3")).analyze();
+            Assert.fail("No exception throws.");
+        } catch (SemanticException e) {
+            Assert.assertTrue(e.getMessage().contains("Unknown property gram_num of BITMAP index"));
+        }
+    }
+
     @Test
     public void toSql() {
         Assert.assertEquals("INDEX index1 (`col1`) USING BITMAP COMMENT 'balabala'", def.toSql());
@@ -19,6 +19,7 @@ import com.starrocks.catalog.ResourceGroupMgr;
 import com.starrocks.server.GlobalStateMgr;
 import com.starrocks.sql.ast.SetPassVar;
 import com.starrocks.sql.ast.SetStmt;
+import com.starrocks.sql.ast.SystemVariable;
 import com.starrocks.sql.ast.UserVariable;
 import com.starrocks.thrift.TWorkGroup;
 import com.starrocks.utframe.UtFrameUtils;
@@ -258,4 +259,23 @@ public class AnalyzeSetVariableTest {
         sql = "SET runtime_adaptive_dop_max_block_rows_per_driver_seq = 1";
         analyzeSuccess(sql);
     }
+
+    @Test
+    public void testSetSpillCompressionType() {
+        String sql;
+
+        sql = "SET spill_compression_type = 'zstd'";
+        SetStmt setStmt = (SetStmt) analyzeSuccess(sql);
+        SystemVariable var = (SystemVariable) setStmt.getSetListItems().get(0);
+        Assert.assertEquals("ZSTD", var.getResolvedExpression().getStringValue());
+
+        sql = "SET spill_compression_type = 'no_compression'";
+        analyzeSuccess(sql);
+
+        sql = "SET spill_compression_type = 'bzip2'";
+        analyzeFail(sql, "Unsupported spill compression type: bzip2");
+
+        sql = "SET spill_compression_type = 'lzo'";
+        analyzeFail(sql, "Unsupported spill compression type: lzo");
+    }
 }
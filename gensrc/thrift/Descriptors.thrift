@@ -175,7 +175,8 @@ enum THdfsCompression {
 }
 
 enum TIndexType {
-  BITMAP
+  BITMAP,
+  NGRAM
 }
 
 // Mapping from names defined by Avro to the enum.
@@ -203,6 +204,8 @@ struct TColumn {
     9: optional bool is_auto_increment
     10: optional i32 col_unique_id  = -1
     11: optional bool has_bitmap_index = false
+    12: optional bool has_ngram_index = false
+    13: optional i32 ngram_index_gram_size
                                                                                                       
     // How many bytes used for short key index encoding.
     // For fixed-length column, this value may be ignored by BE when creating a tablet.
@@ -286,6 +289,7 @@ struct TOlapTableIndex {
   2: optional list<string> columns
   3: optional TIndexType index_type
   4: optional string comment
+  5: optional map<string, string> properties
 }
 
 struct TTabletLocation {
@@ -230,6 +230,9 @@ struct TQueryOptions {
   105: optional bool use_column_pool = true;
 
   106: optional bool enable_agg_spill_preaggregation;
+
+  107: optional Types.TCompressionType spill_compression_type;
+  108: optional bool enable_spill_column_encoding;
 }
 
 